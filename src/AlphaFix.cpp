@@ -0,0 +1,364 @@
+#include "AlphaFix.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DX11RENDERING2DDEMO_ALPHA_FIX_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+// GCC和Clang只允许在启用了对应指令集的函数中使用其内建函数，MSVC不需要
+#if defined(__GNUC__) || defined(__clang__)
+#define DX11RENDERING2DDEMO_TARGET_SSE2 __attribute__((target("sse2")))
+#define DX11RENDERING2DDEMO_TARGET_AVX2 __attribute__((target("avx2")))
+#define DX11RENDERING2DDEMO_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define DX11RENDERING2DDEMO_TARGET_SSE2
+#define DX11RENDERING2DDEMO_TARGET_AVX2
+#define DX11RENDERING2DDEMO_TARGET_AVX512
+#endif
+#endif
+
+// AArch64上NEON是基本指令集，不需要运行时检测
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define DX11RENDERING2DDEMO_ALPHA_FIX_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    using RowFunction = void (*)(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width, std::uint8_t alpha_increment) noexcept;
+
+    void IncreaseAlphaRowScalar(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width, std::uint8_t alpha_increment) noexcept
+    {
+        for (std::uint32_t x = 0; x < width; ++x, p_source += 4, p_target += 4)
+        {
+            p_target[0] = p_source[0];
+            p_target[1] = p_source[1];
+            p_target[2] = p_source[2];
+            p_target[3] = static_cast<std::uint8_t>((std::min)(255u, static_cast<std::uint32_t>(p_source[3]) + alpha_increment));
+        }
+    }
+
+#ifdef DX11RENDERING2DDEMO_ALPHA_FIX_X86
+    struct CpuFeatures
+    {
+        bool m_has_sse2{};
+        bool m_has_avx2{};
+        bool m_has_avx512{};
+    };
+
+    struct CpuidRegisters
+    {
+        std::uint32_t m_eax{};
+        std::uint32_t m_ebx{};
+        std::uint32_t m_ecx{};
+        std::uint32_t m_edx{};
+    };
+
+    auto Cpuid(std::uint32_t leaf, std::uint32_t subleaf) noexcept
+        -> CpuidRegisters
+    {
+        CpuidRegisters registers{};
+#ifdef _MSC_VER
+        int values[4]{};
+        ::__cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+        registers.m_eax = static_cast<std::uint32_t>(values[0]);
+        registers.m_ebx = static_cast<std::uint32_t>(values[1]);
+        registers.m_ecx = static_cast<std::uint32_t>(values[2]);
+        registers.m_edx = static_cast<std::uint32_t>(values[3]);
+#else
+        __cpuid_count(leaf, subleaf, registers.m_eax, registers.m_ebx, registers.m_ecx, registers.m_edx);
+#endif
+        return registers;
+    }
+
+    /**
+     * @brief 读取XCR0，得到操作系统在线程切换时保存的寄存器状态
+     */
+    auto ReadXcr0() noexcept
+        -> std::uint64_t
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        std::uint32_t eax{};
+        std::uint32_t edx{};
+        __asm__ volatile("xgetbv"
+                         : "=a"(eax), "=d"(edx)
+                         : "c"(0));
+        return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#else
+        return ::_xgetbv(0);
+#endif
+    }
+
+    bool HasBit(std::uint32_t value, std::uint32_t bit) noexcept
+    {
+        return (value >> bit & 1) != 0;
+    }
+
+    auto DetectCpuFeatures() noexcept
+        -> CpuFeatures
+    {
+        CpuFeatures features{};
+        const auto max_leaf = Cpuid(0, 0).m_eax;
+        if (max_leaf < 1)
+        {
+            return features;
+        }
+        const auto leaf1 = Cpuid(1, 0);
+        features.m_has_sse2 = HasBit(leaf1.m_edx, 26);
+        // CPU支持AVX还不够，操作系统还要通过XSAVE保存YMM/ZMM寄存器
+        if (!HasBit(leaf1.m_ecx, 27) || !HasBit(leaf1.m_ecx, 28) || max_leaf < 7)
+        {
+            return features;
+        }
+        const auto xcr0 = ReadXcr0();
+        constexpr std::uint64_t YMM_STATE = 0x6;
+        constexpr std::uint64_t ZMM_STATE = 0xE6;
+        const auto leaf7 = Cpuid(7, 0);
+        features.m_has_avx2 = (xcr0 & YMM_STATE) == YMM_STATE && HasBit(leaf7.m_ebx, 5);
+        features.m_has_avx512 = (xcr0 & ZMM_STATE) == ZMM_STATE && HasBit(leaf7.m_ebx, 16) && HasBit(leaf7.m_ebx, 30);
+        return features;
+    }
+
+    auto GetCpuFeatures() noexcept
+        -> const CpuFeatures&
+    {
+        static const auto features = DetectCpuFeatures();
+        return features;
+    }
+
+    // 每个32位元素只有最高字节即alpha加上增量，无符号饱和加法就是min(255, alpha + increment)
+
+    DX11RENDERING2DDEMO_TARGET_SSE2 void IncreaseAlphaRowSse2(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width, std::uint8_t alpha_increment) noexcept
+    {
+        const auto increment = _mm_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(alpha_increment) << 24));
+        std::uint32_t x = 0;
+        for (; x + 16 <= width; x += 16)
+        {
+            const auto* p_source_vector = reinterpret_cast<const __m128i*>(p_source + static_cast<std::size_t>(x) * 4);
+            auto* p_target_vector = reinterpret_cast<__m128i*>(p_target + static_cast<std::size_t>(x) * 4);
+            const auto pixels0 = _mm_loadu_si128(p_source_vector + 0);
+            const auto pixels1 = _mm_loadu_si128(p_source_vector + 1);
+            const auto pixels2 = _mm_loadu_si128(p_source_vector + 2);
+            const auto pixels3 = _mm_loadu_si128(p_source_vector + 3);
+            _mm_storeu_si128(p_target_vector + 0, _mm_adds_epu8(pixels0, increment));
+            _mm_storeu_si128(p_target_vector + 1, _mm_adds_epu8(pixels1, increment));
+            _mm_storeu_si128(p_target_vector + 2, _mm_adds_epu8(pixels2, increment));
+            _mm_storeu_si128(p_target_vector + 3, _mm_adds_epu8(pixels3, increment));
+        }
+        for (; x + 4 <= width; x += 4)
+        {
+            const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_source + static_cast<std::size_t>(x) * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p_target + static_cast<std::size_t>(x) * 4), _mm_adds_epu8(pixels, increment));
+        }
+        IncreaseAlphaRowScalar(p_source + static_cast<std::size_t>(x) * 4, p_target + static_cast<std::size_t>(x) * 4, width - x, alpha_increment);
+    }
+
+    DX11RENDERING2DDEMO_TARGET_AVX2 void IncreaseAlphaRowAvx2(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width, std::uint8_t alpha_increment) noexcept
+    {
+        const auto increment = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(alpha_increment) << 24));
+        std::uint32_t x = 0;
+        for (; x + 32 <= width; x += 32)
+        {
+            const auto* p_source_vector = reinterpret_cast<const __m256i*>(p_source + static_cast<std::size_t>(x) * 4);
+            auto* p_target_vector = reinterpret_cast<__m256i*>(p_target + static_cast<std::size_t>(x) * 4);
+            const auto pixels0 = _mm256_loadu_si256(p_source_vector + 0);
+            const auto pixels1 = _mm256_loadu_si256(p_source_vector + 1);
+            const auto pixels2 = _mm256_loadu_si256(p_source_vector + 2);
+            const auto pixels3 = _mm256_loadu_si256(p_source_vector + 3);
+            _mm256_storeu_si256(p_target_vector + 0, _mm256_adds_epu8(pixels0, increment));
+            _mm256_storeu_si256(p_target_vector + 1, _mm256_adds_epu8(pixels1, increment));
+            _mm256_storeu_si256(p_target_vector + 2, _mm256_adds_epu8(pixels2, increment));
+            _mm256_storeu_si256(p_target_vector + 3, _mm256_adds_epu8(pixels3, increment));
+        }
+        for (; x + 8 <= width; x += 8)
+        {
+            const auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_source + static_cast<std::size_t>(x) * 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_target + static_cast<std::size_t>(x) * 4), _mm256_adds_epu8(pixels, increment));
+        }
+        IncreaseAlphaRowScalar(p_source + static_cast<std::size_t>(x) * 4, p_target + static_cast<std::size_t>(x) * 4, width - x, alpha_increment);
+    }
+
+    DX11RENDERING2DDEMO_TARGET_AVX512 void IncreaseAlphaRowAvx512(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width, std::uint8_t alpha_increment) noexcept
+    {
+        const auto increment = _mm512_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(alpha_increment) << 24));
+        std::uint32_t x = 0;
+        for (; x + 64 <= width; x += 64)
+        {
+            auto* p_source_pixels = p_source + static_cast<std::size_t>(x) * 4;
+            auto* p_target_pixels = p_target + static_cast<std::size_t>(x) * 4;
+            const auto pixels0 = _mm512_loadu_si512(p_source_pixels + 0);
+            const auto pixels1 = _mm512_loadu_si512(p_source_pixels + 64);
+            const auto pixels2 = _mm512_loadu_si512(p_source_pixels + 128);
+            const auto pixels3 = _mm512_loadu_si512(p_source_pixels + 192);
+            _mm512_storeu_si512(p_target_pixels + 0, _mm512_adds_epu8(pixels0, increment));
+            _mm512_storeu_si512(p_target_pixels + 64, _mm512_adds_epu8(pixels1, increment));
+            _mm512_storeu_si512(p_target_pixels + 128, _mm512_adds_epu8(pixels2, increment));
+            _mm512_storeu_si512(p_target_pixels + 192, _mm512_adds_epu8(pixels3, increment));
+        }
+        for (; x + 16 <= width; x += 16)
+        {
+            const auto pixels = _mm512_loadu_si512(p_source + static_cast<std::size_t>(x) * 4);
+            _mm512_storeu_si512(p_target + static_cast<std::size_t>(x) * 4, _mm512_adds_epu8(pixels, increment));
+        }
+        // 剩余不足16个像素时用掩码读写，不会越过行尾
+        if (x < width)
+        {
+            const auto mask = static_cast<__mmask16>((1u << (width - x)) - 1);
+            const auto pixels = _mm512_maskz_loadu_epi32(mask, p_source + static_cast<std::size_t>(x) * 4);
+            _mm512_mask_storeu_epi32(p_target + static_cast<std::size_t>(x) * 4, mask, _mm512_adds_epu8(pixels, increment));
+        }
+    }
+#endif
+
+#ifdef DX11RENDERING2DDEMO_ALPHA_FIX_NEON
+    void IncreaseAlphaRowNeon(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width, std::uint8_t alpha_increment) noexcept
+    {
+        // 小端序下alpha是每个32位元素的最高字节
+        const auto increment = vreinterpretq_u8_u32(vdupq_n_u32(static_cast<std::uint32_t>(alpha_increment) << 24));
+        std::uint32_t x = 0;
+        for (; x + 16 <= width; x += 16)
+        {
+            const auto* p_source_pixels = p_source + static_cast<std::size_t>(x) * 4;
+            auto* p_target_pixels = p_target + static_cast<std::size_t>(x) * 4;
+            const auto pixels0 = vld1q_u8(p_source_pixels + 0);
+            const auto pixels1 = vld1q_u8(p_source_pixels + 16);
+            const auto pixels2 = vld1q_u8(p_source_pixels + 32);
+            const auto pixels3 = vld1q_u8(p_source_pixels + 48);
+            vst1q_u8(p_target_pixels + 0, vqaddq_u8(pixels0, increment));
+            vst1q_u8(p_target_pixels + 16, vqaddq_u8(pixels1, increment));
+            vst1q_u8(p_target_pixels + 32, vqaddq_u8(pixels2, increment));
+            vst1q_u8(p_target_pixels + 48, vqaddq_u8(pixels3, increment));
+        }
+        for (; x + 4 <= width; x += 4)
+        {
+            const auto pixels = vld1q_u8(p_source + static_cast<std::size_t>(x) * 4);
+            vst1q_u8(p_target + static_cast<std::size_t>(x) * 4, vqaddq_u8(pixels, increment));
+        }
+        IncreaseAlphaRowScalar(p_source + static_cast<std::size_t>(x) * 4, p_target + static_cast<std::size_t>(x) * 4, width - x, alpha_increment);
+    }
+#endif
+
+    /**
+     * @brief 返回该实现的逐行函数，当前平台没有编译该实现时返回nullptr
+     */
+    auto GetRowFunction(AlphaFixKernel kernel) noexcept
+        -> RowFunction
+    {
+        switch (kernel)
+        {
+        case AlphaFixKernel::Scalar:
+            return &IncreaseAlphaRowScalar;
+#ifdef DX11RENDERING2DDEMO_ALPHA_FIX_X86
+        case AlphaFixKernel::Sse2:
+            return &IncreaseAlphaRowSse2;
+        case AlphaFixKernel::Avx2:
+            return &IncreaseAlphaRowAvx2;
+        case AlphaFixKernel::Avx512:
+            return &IncreaseAlphaRowAvx512;
+#endif
+#ifdef DX11RENDERING2DDEMO_ALPHA_FIX_NEON
+        case AlphaFixKernel::Neon:
+            return &IncreaseAlphaRowNeon;
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    void IncreaseAlphaRows(RowFunction row_function, const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment) noexcept
+    {
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            row_function(p_source + static_cast<std::size_t>(y) * source_row_pitch,
+                         p_target + static_cast<std::size_t>(y) * target_row_pitch,
+                         width,
+                         alpha_increment);
+        }
+    }
+}
+
+auto GetAlphaFixKernelName(AlphaFixKernel kernel) noexcept
+    -> const char*
+{
+    switch (kernel)
+    {
+    case AlphaFixKernel::Scalar:
+        return "scalar";
+    case AlphaFixKernel::Sse2:
+        return "sse2";
+    case AlphaFixKernel::Avx2:
+        return "avx2";
+    case AlphaFixKernel::Avx512:
+        return "avx512";
+    case AlphaFixKernel::Neon:
+        return "neon";
+    }
+    return "unknown";
+}
+
+bool AlphaFix::IsKernelSupported(AlphaFixKernel kernel) noexcept
+{
+    switch (kernel)
+    {
+    case AlphaFixKernel::Scalar:
+        return true;
+#ifdef DX11RENDERING2DDEMO_ALPHA_FIX_X86
+    case AlphaFixKernel::Sse2:
+        return GetCpuFeatures().m_has_sse2;
+    case AlphaFixKernel::Avx2:
+        return GetCpuFeatures().m_has_avx2;
+    case AlphaFixKernel::Avx512:
+        return GetCpuFeatures().m_has_avx512;
+#endif
+#ifdef DX11RENDERING2DDEMO_ALPHA_FIX_NEON
+    case AlphaFixKernel::Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+auto AlphaFix::GetBestKernel() noexcept
+    -> AlphaFixKernel
+{
+    static const auto best_kernel = []()
+    {
+        for (const auto kernel : {AlphaFixKernel::Avx512, AlphaFixKernel::Avx2, AlphaFixKernel::Neon, AlphaFixKernel::Sse2})
+        {
+            if (IsKernelSupported(kernel))
+            {
+                return kernel;
+            }
+        }
+        return AlphaFixKernel::Scalar;
+    }();
+    return best_kernel;
+}
+
+void AlphaFix::IncreaseAlphaScalar(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment) noexcept
+{
+    IncreaseAlphaRows(&IncreaseAlphaRowScalar, p_source, source_row_pitch, p_target, target_row_pitch, width, height, alpha_increment);
+}
+
+void AlphaFix::IncreaseAlpha(AlphaFixKernel kernel, const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment)
+{
+    if (!IsKernelSupported(kernel))
+    {
+        throw std::invalid_argument{"Alpha fix kernel is not supported on this CPU."};
+    }
+    IncreaseAlphaRows(GetRowFunction(kernel), p_source, source_row_pitch, p_target, target_row_pitch, width, height, alpha_increment);
+}
+
+void AlphaFix::IncreaseAlpha(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment) noexcept
+{
+    // 选出的实现一定受支持
+    static const auto row_function = GetRowFunction(GetBestKernel());
+    IncreaseAlphaRows(row_function, p_source, source_row_pitch, p_target, target_row_pitch, width, height, alpha_increment);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+enum class AlphaFixKernel : std::uint8_t
+{
+    Scalar,
+    Sse2,
+    Avx2,
+    /**
+     * @brief 需要AVX-512F和AVX-512BW
+     */
+    Avx512,
+    Neon,
+};
+
+constexpr std::size_t ALPHA_FIX_KERNEL_COUNT = 5;
+
+auto GetAlphaFixKernelName(AlphaFixKernel kernel) noexcept
+    -> const char*;
+
+/**
+ * @brief 在CPU上执行PsGdiTexturePreprocessor的alpha修正：color.w = min(1, color.w + increment)，b、g、r不变 \n
+ * 增量以1/255为单位，结果与着色器写入UNORM纹理后一致；目标可以与源相同，即原地修正
+ */
+namespace AlphaFix
+{
+    /**
+     * @brief 当前CPU和操作系统是否支持该实现，由CPUID和XGETBV检测
+     */
+    bool IsKernelSupported(AlphaFixKernel kernel) noexcept;
+    /**
+     * @brief 支持的实现中最快的一个，只检测一次
+     */
+    auto GetBestKernel() noexcept
+        -> AlphaFixKernel;
+
+    /**
+     * @brief 逐像素的参考实现
+     */
+    void IncreaseAlphaScalar(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment) noexcept;
+    /**
+     * @brief 使用指定的实现，结果与IncreaseAlphaScalar完全一致；当前CPU不支持该实现时抛出std::invalid_argument
+     */
+    void IncreaseAlpha(AlphaFixKernel kernel, const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment);
+    /**
+     * @brief 使用GetBestKernel选出的实现
+     */
+    void IncreaseAlpha(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height, std::uint8_t alpha_increment) noexcept;
+}
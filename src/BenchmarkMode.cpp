@@ -0,0 +1,1473 @@
+#include "BenchmarkMode.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+#include "AlphaFix.h"
+#include "CCapturingDeviceContext.h"
+#include "CCoverageImage.h"
+#include "CCpuCompositor.h"
+#include "CCpuGpuTimerBackend.h"
+#include "CCpuReadbackBackend.h"
+#include "CCpuUploadBackend.h"
+#include "CDrawQueue.h"
+#include "CGpuMemoryBudget.h"
+#include "CGpuTimerRing.h"
+#include "CInstrumentedDeviceContext.h"
+#include "CMappedFile.h"
+#include "CMappedSurface.h"
+#include "CMockD3D11Device.h"
+#include "CMockFrameTraceBackend.h"
+#include "CMockManifestBackend.h"
+#include "CReadbackRing.h"
+#include "CRenderGraph.h"
+#include "CRenderThread.h"
+#include "CResolutionGovernor.h"
+#include "CSharedFrameRing.h"
+#include "CSoftwareRenderer.h"
+#include "CSpscQueue.h"
+#include "CTimingWheel.h"
+#include "CTripleBuffer.h"
+#include "CUploadEngine.h"
+#include "CompositorCostModel.h"
+#include "MockComposition.h"
+#include "PerfLint.h"
+#include "CoverageConversion.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 执行function若干次，返回平均每次耗时，单位为微秒
+     */
+    template <class Function>
+    double MeasureAverageMicroseconds(std::uint32_t iterations, Function function)
+    {
+        const auto begin = Clock::now();
+        for (std::uint32_t i = 0; i < iterations; ++i)
+        {
+            function();
+        }
+        const auto end = Clock::now();
+        return std::chrono::duration<double, std::micro>(end - begin).count() / iterations;
+    }
+
+    void RunDrawSortBenchmark()
+    {
+        constexpr std::array<std::uint32_t, 3> DRAW_COUNTS{1'000, 10'000, 100'000};
+        std::mt19937 random_engine{42};
+        for (auto draw_count : DRAW_COUNTS)
+        {
+            std::uniform_int_distribution<std::uint32_t> shader_distribution{0, 15};
+            std::uniform_int_distribution<std::uint32_t> texture_distribution{0, 255};
+            std::uniform_int_distribution<std::uint32_t> state_distribution{0, 7};
+            std::uniform_int_distribution<std::uint32_t> layer_distribution{0, 3};
+            std::bernoulli_distribution translucent_distribution{0.2};
+
+            CDrawQueue queue{};
+            queue.Reserve(draw_count);
+            for (std::uint32_t i = 0; i < draw_count; ++i)
+            {
+                DrawCommand command{};
+                command.m_shader = shader_distribution(random_engine);
+                command.m_texture = texture_distribution(random_engine);
+                command.m_state = state_distribution(random_engine);
+                command.m_index_count = 6;
+                queue.Submit(command, layer_distribution(random_engine), translucent_distribution(random_engine));
+            }
+            const auto unsorted_items = queue.GetSortedItems();
+            const auto unsorted_state_changes = queue.CountStateChanges(false);
+
+            std::vector<DrawSortItem> items{};
+            std::vector<DrawSortItem> scratch{};
+            const auto iterations = (std::max)(1u, 2'000'000u / draw_count);
+            auto radix_sort = [&]()
+            {
+                items = unsorted_items;
+                RadixSort::SortByKey(items, scratch);
+            };
+            auto std_stable_sort = [&]()
+            {
+                items = unsorted_items;
+                std::stable_sort(items.begin(), items.end(), [](const DrawSortItem& lhs, const DrawSortItem& rhs)
+                                 { return lhs.m_key < rhs.m_key; });
+            };
+            auto copy_only = [&]()
+            {
+                items = unsorted_items;
+            };
+            const auto radix_us = MeasureAverageMicroseconds(iterations, radix_sort);
+            const auto std_sort_us = MeasureAverageMicroseconds(iterations, std_stable_sort);
+            const auto copy_us = MeasureAverageMicroseconds(iterations, copy_only);
+            queue.Sort();
+            std::printf("draw-sort %6u draws: radix %9.2f us, std::stable_sort %9.2f us, state changes %u -> %u\n",
+                        draw_count,
+                        radix_us - copy_us,
+                        std_sort_us - copy_us,
+                        unsorted_state_changes,
+                        queue.CountStateChanges(true));
+        }
+    }
+
+    void RunRenderGraphBenchmark()
+    {
+        constexpr std::array<std::uint32_t, 4> EFFECT_COUNTS{1, 4, 16, 64};
+        const TextureDescription widget_texture{350, 100, GpuFormat::B8G8R8A8_UNORM};
+        for (auto effect_count : EFFECT_COUNTS)
+        {
+            // GDI纹理 -> alpha修正 -> effect_count个特效 -> 后台缓冲区，另有一条不被使用的调试分支
+            CRenderGraph graph{};
+            auto build_graph = [&]()
+            {
+                graph.Clear();
+                const auto gdi_texture = graph.ImportTexture("GdiInitial", widget_texture, 0);
+                const auto back_buffer = graph.ImportTexture("BackBuffer", widget_texture, 1);
+                graph.MarkOutput(back_buffer);
+                auto previous = graph.CreateTexture("GdiFinal", widget_texture);
+                graph.AddPass(
+                    "AlphaIncrease", [&](CRenderGraph::CPassBuilder& builder)
+                    { builder.Read(gdi_texture).Write(previous); },
+                    {});
+                for (std::uint32_t i = 0; i < effect_count; ++i)
+                {
+                    const auto current = graph.CreateTexture("Effect" + std::to_string(i), widget_texture);
+                    graph.AddPass(
+                        "Effect" + std::to_string(i), [&](CRenderGraph::CPassBuilder& builder)
+                        { builder.Read(previous).Write(current); },
+                        {});
+                    previous = current;
+                }
+                const auto debug_view = graph.CreateTexture("DebugView", widget_texture);
+                graph.AddPass(
+                    "DebugView", [&](CRenderGraph::CPassBuilder& builder)
+                    { builder.Read(previous).Write(debug_view); },
+                    {});
+                graph.AddPass(
+                    "Blit", [&](CRenderGraph::CPassBuilder& builder)
+                    { builder.Read(previous).Write(back_buffer); },
+                    {});
+                graph.Compile();
+            };
+            const auto build_us = MeasureAverageMicroseconds(1000, build_graph);
+            const auto& statistics = graph.GetStatistics();
+            std::printf("render-graph %2u effects: %u/%u passes alive, %u transient -> %u physical textures, %llu -> %llu bytes, build+compile %.2f us\n",
+                        effect_count,
+                        statistics.m_declared_pass_count - statistics.m_culled_pass_count,
+                        statistics.m_declared_pass_count,
+                        statistics.m_transient_texture_count,
+                        statistics.m_physical_texture_count,
+                        static_cast<unsigned long long>(statistics.m_total_transient_bytes),
+                        static_cast<unsigned long long>(statistics.m_physical_bytes),
+                        build_us);
+        }
+    }
+
+    void RunUploadBenchmark()
+    {
+        constexpr std::uint32_t FRAME_COUNT = 200;
+        constexpr std::uint32_t UPLOADS_PER_FRAME = 256;
+        constexpr std::uint32_t TILE_SIZE = 32;
+        constexpr std::uint32_t DESTINATION_SIZE = 1024;
+        // 模拟GPU落后CPU两帧
+        constexpr std::uint64_t GPU_FRAME_LAG = 2;
+
+        const CBgraImage source{TILE_SIZE, TILE_SIZE};
+        for (const auto ring_depth : {1u, 3u})
+        {
+            CBgraImage destination{DESTINATION_SIZE, DESTINATION_SIZE};
+            CCpuUploadBackend backend{};
+            const auto destination_index = backend.RegisterDestination(destination);
+            CCpuFrameFence fence{};
+            UploadEngineConfig config{};
+            config.m_ring_depth = ring_depth;
+            CUploadEngine engine{backend, fence, config};
+            std::mt19937 random_engine{42};
+            std::uniform_int_distribution<std::uint32_t> position_distribution{0, DESTINATION_SIZE - TILE_SIZE};
+
+            auto upload_frame = [&]()
+            {
+                for (std::uint32_t i = 0; i < UPLOADS_PER_FRAME; ++i)
+                {
+                    engine.Upload(destination_index,
+                                  position_distribution(random_engine),
+                                  position_distribution(random_engine),
+                                  TILE_SIZE,
+                                  TILE_SIZE,
+                                  source.GetData(),
+                                  source.GetRowPitch());
+                }
+                engine.Submit();
+                const auto signaled_value = fence.Signal();
+                if (signaled_value > GPU_FRAME_LAG)
+                {
+                    fence.Complete(signaled_value - GPU_FRAME_LAG);
+                }
+            };
+            const auto frame_us = MeasureAverageMicroseconds(FRAME_COUNT, upload_frame);
+            const auto& statistics = engine.GetStatistics();
+            const auto bytes_per_frame = static_cast<double>(statistics.m_bytes_uploaded) / FRAME_COUNT;
+            std::printf("upload ring depth %u: %.2f us/frame, %.1f MB/s, %llu bytes, %llu copies in %llu submits, %zu blocks, %llu ring exhausted, %llu rejected\n",
+                        ring_depth,
+                        frame_us,
+                        bytes_per_frame / frame_us,
+                        static_cast<unsigned long long>(statistics.m_bytes_uploaded),
+                        static_cast<unsigned long long>(statistics.m_copy_count),
+                        static_cast<unsigned long long>(statistics.m_submit_count),
+                        engine.GetBlockCount(),
+                        static_cast<unsigned long long>(statistics.m_ring_exhausted_count),
+                        static_cast<unsigned long long>(statistics.m_rejected_upload_count));
+        }
+    }
+
+    void RunMappedSurfaceBenchmark()
+    {
+        constexpr std::uint32_t FRAME_COUNT = 200;
+        constexpr std::uint32_t DIRTY_RECTS_PER_FRAME = 8;
+        constexpr SurfaceRect TEXT_RUN{0, 0, 64, 16};
+        constexpr std::array<std::array<std::uint32_t, 2>, 2> SURFACE_SIZES{{{350, 100}, {3840, 2160}}};
+
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            CBgraImage destination{width, height};
+            CCpuUploadBackend backend{};
+            const auto destination_index = backend.RegisterDestination(destination);
+            CCpuFrameFence fence{};
+            // 4K整帧上传每帧需要约32个暂存块，单线程的CPU栅栏无法在帧内推进，暂存块不够时整帧上传会被拒绝
+            UploadEngineConfig config{};
+            config.m_max_block_count = 64;
+            CUploadEngine engine{backend, fence, config};
+            CAlignedSurfaceMemory memory{};
+            CMappedSurface surface{memory, width, height};
+            std::vector<std::uint8_t> full_copy(static_cast<std::size_t>(width) * height * MappedSurfaceBuffer::BYTES_PER_PIXEL);
+            std::mt19937 random_engine{42};
+            std::uniform_int_distribution<std::uint32_t> x_distribution{0, width - TEXT_RUN.m_width};
+            std::uniform_int_distribution<std::uint32_t> y_distribution{0, height - TEXT_RUN.m_height};
+
+            auto draw_text_runs = [&]()
+            {
+                const auto& back_buffer = surface.GetBackBuffer();
+                for (std::uint32_t i = 0; i < DIRTY_RECTS_PER_FRAME; ++i)
+                {
+                    const SurfaceRect rect{x_distribution(random_engine), y_distribution(random_engine), TEXT_RUN.m_width, TEXT_RUN.m_height};
+                    for (std::uint32_t row = rect.m_y; row < rect.m_y + rect.m_height; ++row)
+                    {
+                        std::memset(back_buffer.m_p_data + static_cast<std::size_t>(row) * back_buffer.m_row_pitch + static_cast<std::size_t>(rect.m_x) * MappedSurfaceBuffer::BYTES_PER_PIXEL,
+                                    0xFF,
+                                    static_cast<std::size_t>(rect.m_width) * MappedSurfaceBuffer::BYTES_PER_PIXEL);
+                    }
+                    surface.MarkDirty(rect);
+                }
+            };
+            auto end_frame = [&]()
+            {
+                engine.Submit();
+                fence.Complete(fence.Signal());
+            };
+            auto flush_dirty_rects = [&]()
+            {
+                draw_text_runs();
+                surface.Flush();
+                surface.UploadFlushedRects(engine, destination_index);
+                end_frame();
+            };
+            // 旧路径：每帧把整个表面复制到中间缓冲区后整体上传
+            auto copy_full_surface = [&]()
+            {
+                draw_text_runs();
+                surface.Flush();
+                const auto& front_buffer = surface.GetFrontBuffer();
+                const auto row_size = static_cast<std::size_t>(width) * MappedSurfaceBuffer::BYTES_PER_PIXEL;
+                for (std::uint32_t row = 0; row < height; ++row)
+                {
+                    std::memcpy(full_copy.data() + row * row_size, front_buffer.m_p_data + static_cast<std::size_t>(row) * front_buffer.m_row_pitch, row_size);
+                }
+                engine.Upload(destination_index, 0, 0, width, height, full_copy.data(), static_cast<std::uint32_t>(row_size));
+                end_frame();
+            };
+            surface.Flush();
+            const auto initial_bytes = engine.GetStatistics().m_bytes_uploaded;
+            const auto dirty_us = MeasureAverageMicroseconds(FRAME_COUNT, flush_dirty_rects);
+            const auto dirty_bytes = engine.GetStatistics().m_bytes_uploaded - initial_bytes;
+            const auto full_us = MeasureAverageMicroseconds(FRAME_COUNT, copy_full_surface);
+            const auto full_bytes = engine.GetStatistics().m_bytes_uploaded - initial_bytes - dirty_bytes;
+            std::printf("mapped-surface %ux%u: dirty rects %.2f us/frame (%llu bytes/frame), full copy %.2f us/frame (%llu bytes/frame)\n",
+                        width,
+                        height,
+                        dirty_us,
+                        static_cast<unsigned long long>(dirty_bytes / FRAME_COUNT),
+                        full_us,
+                        static_cast<unsigned long long>(full_bytes / FRAME_COUNT));
+        }
+    }
+
+    void RunCoverageBenchmark()
+    {
+        constexpr std::array<std::array<std::uint32_t, 2>, 2> SURFACE_SIZES{{{350, 100}, {3840, 2160}}};
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            // 模拟GDI在黑色背景上绘制白色文字：b=g=r=覆盖率，alpha为0
+            CBgraImage gdi_output{width, height};
+            std::mt19937 random_engine{42};
+            std::uniform_int_distribution<std::uint32_t> coverage_distribution{0, 255};
+            for (std::uint32_t y = 0; y < height; ++y)
+            {
+                for (std::uint32_t x = 0; x < width; ++x)
+                {
+                    auto* p_pixel = gdi_output.GetPixel(x, y);
+                    p_pixel[0] = p_pixel[1] = p_pixel[2] = static_cast<std::uint8_t>(coverage_distribution(random_engine));
+                }
+            }
+            CCoverageImage scalar_coverage{width, height};
+            CCoverageImage coverage{width, height};
+            const auto iterations = (std::max)(1u, 200'000'000u / (width * height));
+            auto convert_scalar = [&]()
+            {
+                CoverageConversion::ConvertBgraToCoverageScalar(gdi_output.GetData(), gdi_output.GetRowPitch(), scalar_coverage.GetData(), scalar_coverage.GetRowPitch(), width, height);
+            };
+            auto convert = [&]()
+            {
+                CoverageConversion::ConvertBgraToCoverage(gdi_output.GetData(), gdi_output.GetRowPitch(), coverage.GetData(), coverage.GetRowPitch(), width, height);
+            };
+            const auto scalar_us = MeasureAverageMicroseconds(iterations, convert_scalar);
+            const auto simd_us = MeasureAverageMicroseconds(iterations, convert);
+
+            CSoftwareRenderer renderer{};
+            CBgraImage bgra_target{width, height};
+            CBgraImage coverage_target{width, height};
+            auto render_bgra = [&]()
+            {
+                renderer.RenderAlphaIncreasePass(gdi_output, bgra_target);
+            };
+            auto render_coverage = [&]()
+            {
+                renderer.RenderCoverageAlphaIncreasePass(coverage, coverage_target);
+            };
+            const auto render_iterations = (std::max)(1u, iterations / 10);
+            const auto bgra_us = MeasureAverageMicroseconds(render_iterations, render_bgra);
+            const auto coverage_us = MeasureAverageMicroseconds(render_iterations, render_coverage);
+
+            const auto source_bytes = static_cast<double>(gdi_output.GetSizeInBytes());
+            std::printf("coverage %ux%u: convert scalar %.2f us (%.2f GB/s), simd %.2f us (%.2f GB/s)\n",
+                        width,
+                        height,
+                        scalar_us,
+                        source_bytes / scalar_us / 1000.0,
+                        simd_us,
+                        source_bytes / simd_us / 1000.0);
+            std::printf("coverage %ux%u: texture %zu -> %zu bytes, cpu pass bgra %.2f us, coverage %.2f us\n",
+                        width,
+                        height,
+                        gdi_output.GetSizeInBytes(),
+                        coverage.GetSizeInBytes(),
+                        bgra_us,
+                        coverage_us);
+        }
+    }
+
+    void RunCompositorBenchmark()
+    {
+        auto measure_cpu_compositor = [](std::uint32_t width, std::uint32_t height, std::uint32_t draw_count)
+        {
+            return CCpuCompositor::MeasureMicroseconds(width, height, draw_count);
+        };
+        const auto cpu_cost = CompositorCostModel::Calibrate(measure_cpu_compositor);
+        std::printf("compositor cpu: fixed %.3f us, per draw %.3f us, per pixel %.3f ns\n",
+                    cpu_cost.m_fixed_us,
+                    cpu_cost.m_per_draw_us,
+                    cpu_cost.m_per_pixel_us * 1000.0);
+        constexpr std::array<std::array<std::uint32_t, 2>, 4> SURFACE_SIZES{{{350, 100}, {700, 200}, {1920, 1080}, {3840, 2160}}};
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            const auto estimated_us = cpu_cost.EstimateMicroseconds(static_cast<std::uint64_t>(width) * height, 1);
+            const auto measured_us = CCpuCompositor::MeasureMicroseconds(width, height, 1);
+            std::printf("compositor cpu %ux%u: estimated %.2f us, measured %.2f us\n", width, height, estimated_us, measured_us);
+        }
+    }
+
+    void RunResolutionGovernorBenchmark()
+    {
+        struct LoadPhase
+        {
+            const char* m_p_name;
+            std::uint32_t m_frame_count;
+            /**
+             * @brief 全分辨率下的帧耗时与预算之比
+             */
+            double m_pressure;
+        };
+        constexpr std::array LOAD_PHASES{
+            LoadPhase{"idle", 300, 0.5},
+            LoadPhase{"saturated", 600, 1.6},
+            LoadPhase{"borderline", 600, 0.95},
+            LoadPhase{"recovered", 600, 0.5}};
+
+        ResolutionGovernorConfig config{};
+        CResolutionGovernor governor{config};
+        std::mt19937 random_engine{42};
+        std::normal_distribution<double> noise_distribution{1.0, 0.1};
+        std::uint64_t total_frame_count = 0;
+        double total_update_us = 0.0;
+        for (const auto& phase : LOAD_PHASES)
+        {
+            const auto phase_begin_statistics = governor.GetStatistics();
+            double scale_sum = 0.0;
+            for (std::uint32_t i = 0; i < phase.m_frame_count; ++i)
+            {
+                // 固定开销加上与像素数成正比的开销
+                const double scale = governor.GetScale();
+                FrameLoadSample sample{};
+                sample.m_cpu_frame_ms = config.m_frame_budget_ms * phase.m_pressure * (0.1 + 0.9 * scale * scale) * noise_distribution(random_engine);
+                auto update = [&]()
+                {
+                    governor.Update(sample);
+                };
+                total_update_us += MeasureAverageMicroseconds(1, update);
+                scale_sum += scale;
+            }
+            total_frame_count += phase.m_frame_count;
+            const auto& statistics = governor.GetStatistics();
+            std::printf("resolution-governor %-10s: average scale %.3f, final scale %.2f, %llu downscales, %llu upscales\n",
+                        phase.m_p_name,
+                        scale_sum / phase.m_frame_count,
+                        governor.GetScale(),
+                        static_cast<unsigned long long>(statistics.m_downscale_count - phase_begin_statistics.m_downscale_count),
+                        static_cast<unsigned long long>(statistics.m_upscale_count - phase_begin_statistics.m_upscale_count));
+        }
+        for (const auto& decision : governor.GetRecentDecisions())
+        {
+            std::printf("resolution-governor decision at frame %llu: %.2f -> %.2f, smoothed load %.2f\n",
+                        static_cast<unsigned long long>(decision.m_frame_index),
+                        decision.m_old_scale,
+                        decision.m_new_scale,
+                        decision.m_smoothed_load);
+        }
+        std::printf("resolution-governor update: %.3f us/frame\n", total_update_us / total_frame_count);
+    }
+
+    void RunSpscQueueBenchmark()
+    {
+        // 生产者写入递增序号，消费者不断取出，直到取完所有序号
+        constexpr std::uint64_t ITEM_COUNT = 4'000'000;
+        constexpr std::array<std::size_t, 3> CAPACITIES{16, 256, 4096};
+        for (const auto capacity : CAPACITIES)
+        {
+            CSpscQueue<std::uint64_t> queue{capacity};
+            const auto begin = Clock::now();
+            std::thread consumer{
+                [&queue]()
+                {
+                    std::uint64_t pop_count = 0;
+                    std::uint64_t value = 0;
+                    while (pop_count < ITEM_COUNT)
+                    {
+                        if (!queue.TryPop(value))
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        ++pop_count;
+                    }
+                }};
+            for (std::uint64_t i = 0; i < ITEM_COUNT; ++i)
+            {
+                while (!queue.TryPush(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            consumer.join();
+            const auto end = Clock::now();
+            const auto seconds = std::chrono::duration<double>(end - begin).count();
+            const auto statistics = queue.GetStatistics();
+            std::printf("spsc-queue capacity %zu: %.2f M items/s, %.1f ns/item, max depth %llu, %llu full\n",
+                        capacity,
+                        ITEM_COUNT / seconds / 1e6,
+                        seconds * 1e9 / ITEM_COUNT,
+                        static_cast<unsigned long long>(statistics.m_max_depth),
+                        static_cast<unsigned long long>(statistics.m_full_count));
+        }
+
+        // 模拟UI线程在渲染线程忙于构建帧时连续发送命令
+        constexpr std::uint32_t COMMAND_COUNT = 20'000;
+        std::uint32_t handled_count = 0;
+        CRenderThread render_thread{
+            [&handled_count](const RenderCommand&)
+            {
+                ++handled_count;
+            },
+            []()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds{200});
+                return true;
+            },
+            64};
+        for (std::uint32_t i = 1; i <= COMMAND_COUNT; ++i)
+        {
+            render_thread.Post({RenderCommandType::SetAlphaIncrement, static_cast<float>(i)});
+        }
+        while (render_thread.GetStatistics().m_queue_depth != 0)
+        {
+            std::this_thread::yield();
+        }
+        const auto statistics = render_thread.GetStatistics();
+        render_thread.Stop();
+        std::printf("spsc-queue render thread: %u commands, %llu frames, max depth %llu, %llu full, %llu blocked posts\n",
+                    handled_count,
+                    static_cast<unsigned long long>(statistics.m_frame_count),
+                    static_cast<unsigned long long>(statistics.m_queue.m_max_depth),
+                    static_cast<unsigned long long>(statistics.m_queue.m_full_count),
+                    static_cast<unsigned long long>(statistics.m_blocked_post_count));
+    }
+
+    void RunTripleBufferBenchmark()
+    {
+        // 64字节的控件快照，大小与真实的控件状态相当
+        struct WidgetSnapshot
+        {
+            std::uint64_t m_sequence{};
+            std::array<std::uint64_t, 7> m_values{};
+        };
+        auto make_snapshot = [](std::uint64_t sequence)
+        {
+            WidgetSnapshot snapshot{};
+            snapshot.m_sequence = sequence;
+            snapshot.m_values.fill(sequence);
+            return snapshot;
+        };
+
+        constexpr std::uint32_t ITERATIONS = 1'000'000;
+        {
+            CTripleBuffer<WidgetSnapshot> buffer{};
+            std::uint64_t sequence = 0;
+            const auto publish_us = MeasureAverageMicroseconds(
+                ITERATIONS,
+                [&]()
+                {
+                    buffer.Publish(make_snapshot(++sequence));
+                });
+            std::uint64_t sum = 0;
+            const auto consume_us = MeasureAverageMicroseconds(
+                ITERATIONS,
+                [&]()
+                {
+                    buffer.Publish(make_snapshot(++sequence));
+                    buffer.Update();
+                    sum += buffer.Get().m_sequence;
+                });
+            const auto unchanged_us = MeasureAverageMicroseconds(
+                ITERATIONS,
+                [&]()
+                {
+                    buffer.Publish(make_snapshot(sequence));
+                    sum += buffer.Update() ? 1 : 0;
+                });
+            std::printf("triple-buffer single thread: publish %.1f ns, publish + consume %.1f ns, unchanged publish + update %.1f ns (%llu)\n",
+                        publish_us * 1000.0,
+                        consume_us * 1000.0,
+                        unchanged_us * 1000.0,
+                        static_cast<unsigned long long>(sum));
+        }
+
+        // 生产者持续发布，消费者模拟渲染循环不断取最新快照
+        constexpr std::uint64_t PUBLISH_COUNT = 2'000'000;
+        CTripleBuffer<WidgetSnapshot> buffer{};
+        std::atomic<bool> is_producer_done{false};
+        std::uint64_t last_sequence = 0;
+        std::uint64_t unchanged_frame_count = 0;
+        const auto begin = Clock::now();
+        std::thread consumer{
+            [&]()
+            {
+                auto consume = [&]()
+                {
+                    if (!buffer.Update())
+                    {
+                        ++unchanged_frame_count;
+                        return;
+                    }
+                    last_sequence = buffer.Get().m_sequence;
+                };
+                while (!is_producer_done.load(std::memory_order_acquire))
+                {
+                    consume();
+                }
+                consume();
+            }};
+        for (std::uint64_t i = 1; i <= PUBLISH_COUNT; ++i)
+        {
+            buffer.Publish(make_snapshot(i));
+        }
+        is_producer_done.store(true, std::memory_order_release);
+        consumer.join();
+        const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        const auto statistics = buffer.GetStatistics();
+        std::printf("triple-buffer concurrent: %.1f ns/publish, %llu consumed, %llu overwritten, %llu unchanged frames, last %llu\n",
+                    seconds * 1e9 / PUBLISH_COUNT,
+                    static_cast<unsigned long long>(statistics.m_consume_count),
+                    static_cast<unsigned long long>(statistics.m_overwritten_count),
+                    static_cast<unsigned long long>(unchanged_frame_count),
+                    static_cast<unsigned long long>(last_sequence));
+    }
+
+    void RunTimingWheelBenchmark()
+    {
+        TimingWheelConfig config{};
+        config.m_initial_capacity = 16384;
+        const auto start_time = CTimingWheel::Clock::now();
+        auto time_at_tick = [&](std::uint64_t tick)
+        {
+            return start_time + tick * config.m_tick_duration;
+        };
+
+        // 三个控件各自的刷新周期，同一时间槽到期的合并为一次重绘
+        {
+            struct WidgetTimer
+            {
+                const char* m_p_name;
+                std::chrono::milliseconds m_interval;
+            };
+            constexpr std::array WIDGET_TIMERS{
+                WidgetTimer{"traffic", std::chrono::milliseconds{1000}},
+                WidgetTimer{"cpu", std::chrono::milliseconds{250}},
+                WidgetTimer{"memory", std::chrono::milliseconds{5000}}};
+            CTimingWheel wheel{start_time, config};
+            for (std::size_t i = 0; i < WIDGET_TIMERS.size(); ++i)
+            {
+                wheel.Schedule(WIDGET_TIMERS[i].m_interval, WIDGET_TIMERS[i].m_interval, i);
+            }
+            // 模拟渲染循环：每次睡到时间轮给出的截止时间
+            std::array<std::uint64_t, WIDGET_TIMERS.size()> fire_counts{};
+            std::uint64_t wakeup_count = 0;
+            std::uint64_t redraw_count = 0;
+            // 60 Hz下的60秒
+            const auto end_time = time_at_tick(3600);
+            for (auto deadline = wheel.GetNextDeadline(); deadline && *deadline <= end_time; deadline = wheel.GetNextDeadline())
+            {
+                ++wakeup_count;
+                const auto& expired_timers = wheel.Advance(*deadline);
+                for (const auto& expired_timer : expired_timers)
+                {
+                    ++fire_counts[expired_timer.m_user_data];
+                }
+                redraw_count += expired_timers.empty() ? 0 : 1;
+            }
+            for (std::size_t i = 0; i < WIDGET_TIMERS.size(); ++i)
+            {
+                std::printf("timing-wheel widget %-7s: %llu updates in 60 s\n",
+                            WIDGET_TIMERS[i].m_p_name,
+                            static_cast<unsigned long long>(fire_counts[i]));
+            }
+            std::printf("timing-wheel widgets: %llu wakeups, %llu redraws, %llu expiries coalesced\n",
+                        static_cast<unsigned long long>(wakeup_count),
+                        static_cast<unsigned long long>(redraw_count),
+                        static_cast<unsigned long long>(wheel.GetStatistics().m_fired_count - redraw_count));
+        }
+
+        // 10k个周期从250ms到一小时不等的定时器，逐帧推进
+        constexpr std::uint32_t TIMER_COUNT = 10'000;
+        constexpr std::uint64_t TICK_COUNT = 20'000;
+        CTimingWheel wheel{start_time, config};
+        std::mt19937 random_engine{42};
+        std::uniform_real_distribution<double> exponent_distribution{0.0, 1.0};
+        std::vector<std::uint64_t> period_ticks(TIMER_COUNT);
+        std::vector<TimerHandle> handles(TIMER_COUNT);
+        for (std::uint32_t i = 0; i < TIMER_COUNT; ++i)
+        {
+            // 周期取对数均匀分布，覆盖时间轮的每一层
+            period_ticks[i] = static_cast<std::uint64_t>(15.0 * std::pow(14'400.0, exponent_distribution(random_engine)));
+        }
+        const auto schedule_us = MeasureAverageMicroseconds(
+            1,
+            [&]()
+            {
+                for (std::uint32_t i = 0; i < TIMER_COUNT; ++i)
+                {
+                    handles[i] = wheel.Schedule(period_ticks[i] * config.m_tick_duration, period_ticks[i] * config.m_tick_duration, i);
+                }
+            });
+        std::vector<std::uint64_t> fire_counts(TIMER_COUNT);
+        std::uint64_t tick = 0;
+        const auto advance_us = MeasureAverageMicroseconds(
+            static_cast<std::uint32_t>(TICK_COUNT),
+            [&]()
+            {
+                ++tick;
+                for (const auto& expired_timer : wheel.Advance(time_at_tick(tick)))
+                {
+                    ++fire_counts[expired_timer.m_user_data];
+                }
+            });
+        const auto cancel_us = MeasureAverageMicroseconds(
+            1,
+            [&]()
+            {
+                for (const auto handle : handles)
+                {
+                    wheel.Cancel(handle);
+                }
+            });
+        const auto& statistics = wheel.GetStatistics();
+        std::printf("timing-wheel %u timers: schedule %.1f ns, cancel %.1f ns, advance %.1f ns/tick (%.1f ns/expiry), %llu fired, %llu cascaded, %zu left\n",
+                    TIMER_COUNT,
+                    schedule_us * 1000.0 / TIMER_COUNT,
+                    cancel_us * 1000.0 / TIMER_COUNT,
+                    advance_us * 1000.0,
+                    advance_us * 1000.0 * TICK_COUNT / static_cast<double>((std::max)(std::uint64_t{1}, statistics.m_fired_count)),
+                    static_cast<unsigned long long>(statistics.m_fired_count),
+                    static_cast<unsigned long long>(statistics.m_cascaded_count),
+                    wheel.GetActiveCount());
+    }
+
+    void RunReadbackBenchmark()
+    {
+        // 模拟GPU落后CPU两帧执行复制命令，读回时按视图的行距逐行读取
+        constexpr std::uint64_t GPU_LATENCY_FRAMES = 2;
+        constexpr std::uint32_t FRAME_COUNT = 240;
+        constexpr std::array<std::array<std::uint32_t, 2>, 3> SURFACE_SIZES{{{350, 100}, {1920, 1080}, {3840, 2160}}};
+        constexpr std::array<std::uint32_t, 3> RING_DEPTHS{1, 2, 3};
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            CBgraImage source{width, height};
+            for (const auto ring_depth : RING_DEPTHS)
+            {
+                CCpuReadbackBackend backend{};
+                const auto source_id = backend.RegisterSource(source);
+                ReadbackRingConfig config{};
+                config.m_width = width;
+                config.m_height = height;
+                config.m_ring_depth = ring_depth;
+                CReadbackRing ring{backend, config};
+                std::vector<std::uint64_t> submitted_counts(FRAME_COUNT + 1);
+                std::uint64_t checksum = 0;
+                const auto begin = Clock::now();
+                for (std::uint32_t frame = 1; frame <= FRAME_COUNT; ++frame)
+                {
+                    ring.Request(source_id);
+                    submitted_counts[frame] = backend.GetSubmittedCount();
+                    if (frame > GPU_LATENCY_FRAMES)
+                    {
+                        backend.Complete(submitted_counts[frame - GPU_LATENCY_FRAMES]);
+                    }
+                    if (const auto view = ring.TryAcquireLatest())
+                    {
+                        for (std::uint32_t y = 0; y < view->m_height; ++y)
+                        {
+                            const auto* p_row = view->GetRow(y);
+                            checksum += p_row[0] + p_row[static_cast<std::size_t>(view->m_width - 1) * view->m_bytes_per_pixel];
+                        }
+                        ring.Release();
+                    }
+                }
+                const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+                const auto& statistics = ring.GetStatistics();
+                std::printf("readback %ux%u depth %u: %llu/%u frames read, %llu skipped, %llu superseded, latency avg %.2f max %llu frames, %.2f GB/s, %.1f us/frame (%llu)\n",
+                            width,
+                            height,
+                            ring_depth,
+                            static_cast<unsigned long long>(statistics.m_acquired_count),
+                            FRAME_COUNT,
+                            static_cast<unsigned long long>(statistics.m_skipped_count),
+                            static_cast<unsigned long long>(statistics.m_superseded_count),
+                            statistics.m_acquired_count == 0 ? 0.0 : static_cast<double>(statistics.m_total_latency_frames) / statistics.m_acquired_count,
+                            static_cast<unsigned long long>(statistics.m_max_latency_frames),
+                            statistics.m_bytes_read / seconds / 1e9,
+                            seconds * 1e6 / FRAME_COUNT,
+                            static_cast<unsigned long long>(checksum));
+            }
+        }
+    }
+
+    void RunSharedFrameBenchmark()
+    {
+        // 写入者和读者各自映射同一块共享内存，写入者不限速地发布帧，读者读取脏矩形（跳过帧时整帧）
+        constexpr auto DURATION = std::chrono::milliseconds{500};
+        struct Case
+        {
+            std::uint32_t m_width;
+            std::uint32_t m_height;
+            // 为0时每帧整帧都是脏的
+            std::uint32_t m_dirty_width;
+            std::uint32_t m_dirty_height;
+        };
+        constexpr std::array<Case, 4> CASES{{{350, 100, 0, 0}, {350, 100, 64, 16}, {3840, 2160, 0, 0}, {3840, 2160, 256, 64}}};
+        for (const auto& test_case : CASES)
+        {
+            const auto name = "DX11Rendering2DDemoBenchmark" + std::to_string(Clock::now().time_since_epoch().count());
+            CSharedFrameWriter writer{name, test_case.m_width, test_case.m_height};
+            CBgraImage source{test_case.m_width, test_case.m_height};
+            std::vector<SurfaceRect> dirty_rects{};
+            if (test_case.m_dirty_width != 0)
+            {
+                dirty_rects.push_back({0, 0, test_case.m_dirty_width, test_case.m_dirty_height});
+            }
+
+            std::atomic<bool> is_writing{true};
+            std::uint64_t read_count = 0;
+            std::uint64_t torn_count = 0;
+            std::uint64_t bytes_read = 0;
+            std::thread reader_thread{[&]()
+                                      {
+                                          CSharedFrameReader reader{name};
+                                          std::vector<std::uint8_t> copy(static_cast<std::size_t>(reader.GetWidth()) * reader.GetHeight() * 4);
+                                          std::uint64_t last_sequence = 0;
+                                          while (is_writing.load(std::memory_order_acquire))
+                                          {
+                                              const auto view = reader.TryAcquireLatest(last_sequence);
+                                              if (!view)
+                                              {
+                                                  std::this_thread::yield();
+                                                  continue;
+                                              }
+                                              const auto copy_rect = [&](const SurfaceRect& rect)
+                                              {
+                                                  for (auto y = rect.m_y; y < rect.m_y + rect.m_height; ++y)
+                                                  {
+                                                      std::memcpy(copy.data() + (static_cast<std::size_t>(y) * view->m_width + rect.m_x) * 4,
+                                                                  view->GetRow(y) + static_cast<std::size_t>(rect.m_x) * 4,
+                                                                  static_cast<std::size_t>(rect.m_width) * 4);
+                                                  }
+                                                  bytes_read += static_cast<std::uint64_t>(rect.m_width) * rect.m_height * 4;
+                                              };
+                                              if (view->m_sequence == last_sequence + 1)
+                                              {
+                                                  std::for_each(view->m_p_dirty_rects, view->m_p_dirty_rects + view->m_dirty_rect_count, copy_rect);
+                                              }
+                                              else
+                                              {
+                                                  copy_rect({0, 0, view->m_width, view->m_height});
+                                              }
+                                              if (!reader.Validate(*view))
+                                              {
+                                                  ++torn_count;
+                                                  continue;
+                                              }
+                                              last_sequence = view->m_sequence;
+                                              ++read_count;
+                                          }
+                                      }};
+
+            const auto begin = Clock::now();
+            while (Clock::now() - begin < DURATION)
+            {
+                writer.Publish(source.GetRow(0), source.GetRowPitch(), dirty_rects);
+            }
+            const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+            is_writing.store(false, std::memory_order_release);
+            reader_thread.join();
+
+            const auto& statistics = writer.GetStatistics();
+            std::printf("shared-frame %ux%u %s: write %.0f fps (%.2f GB/s, %llu full copies), read %.0f fps (%.2f GB/s), %llu torn\n",
+                        test_case.m_width,
+                        test_case.m_height,
+                        test_case.m_dirty_width == 0 ? "full frame" : "dirty rect",
+                        statistics.m_frame_count / seconds,
+                        statistics.m_bytes_copied / seconds / 1e9,
+                        static_cast<unsigned long long>(statistics.m_full_copy_count),
+                        read_count / seconds,
+                        bytes_read / seconds / 1e9,
+                        static_cast<unsigned long long>(torn_count));
+        }
+    }
+
+    /**
+     * @brief 模拟按页分配的图集：页面被逐出后下次使用时重新生成
+     */
+    class CBenchmarkAtlasCache final : public IGpuMemoryEvictor
+    {
+    public:
+        std::vector<GpuAllocationHandle> m_page_allocations{};
+        std::uint64_t m_resident_page_count{};
+
+        explicit CBenchmarkAtlasCache(std::uint32_t page_count)
+            : m_page_allocations(page_count)
+        {
+        }
+
+        void Evict(GpuAllocationHandle, std::uint64_t user_data) override
+        {
+            m_page_allocations[user_data] = {};
+            --m_resident_page_count;
+        }
+    };
+
+    void RunGpuMemoryBudgetBenchmark()
+    {
+        // 256x256的BGRA图集页，工作集为预算的四倍，访问集中在少数页面上
+        constexpr std::uint32_t PAGE_SIZE = 256;
+        constexpr std::uint32_t PAGE_COUNT = 512;
+        constexpr std::uint32_t ACCESS_COUNT = 1'000'000;
+        constexpr std::uint64_t INTERMEDIATE_BYTES = 8ull << 20;
+        const auto page_bytes = EstimateTexture2DBytes(PAGE_SIZE, PAGE_SIZE, GpuFormat::B8G8R8A8_UNORM, 1, 1);
+
+        GpuMemoryBudgetConfig config{};
+        config.m_budget_bytes = 32ull << 20;
+        config.m_hard_limit_bytes = 48ull << 20;
+        CGpuMemoryBudget budget{config};
+        budget.Reserve(GpuMemoryCategory::Intermediate, INTERMEDIATE_BYTES);
+        CBenchmarkAtlasCache atlas{PAGE_COUNT};
+
+        std::mt19937 random_engine{7};
+        std::uniform_real_distribution<double> distribution{0.0, 1.0};
+        std::vector<std::uint32_t> accesses(ACCESS_COUNT);
+        for (auto& page : accesses)
+        {
+            page = (std::min)(PAGE_COUNT - 1, static_cast<std::uint32_t>(std::pow(distribution(random_engine), 3.0) * PAGE_COUNT));
+        }
+        std::uint64_t hit_count = 0;
+        const auto begin = Clock::now();
+        for (const auto page : accesses)
+        {
+            auto& allocation = atlas.m_page_allocations[page];
+            if (!allocation.IsNull())
+            {
+                budget.Touch(allocation);
+                ++hit_count;
+                continue;
+            }
+            allocation = budget.TryReserve(GpuMemoryCategory::Atlas, page_bytes, &atlas, page);
+            atlas.m_resident_page_count += allocation.IsNull() ? 0 : 1;
+        }
+        const auto elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        const auto& statistics = budget.GetStatistics();
+        const auto& atlas_usage = statistics.m_categories[static_cast<std::size_t>(GpuMemoryCategory::Atlas)];
+        std::printf("gpu-budget atlas: %u accesses, hit rate %.1f%%, %llu evicted (%.1f MiB), %llu resident pages, %.1f ns/access\n",
+                    ACCESS_COUNT,
+                    100.0 * hit_count / ACCESS_COUNT,
+                    static_cast<unsigned long long>(statistics.m_evicted_count),
+                    statistics.m_evicted_bytes / 1048576.0,
+                    static_cast<unsigned long long>(atlas.m_resident_page_count),
+                    elapsed_ns / ACCESS_COUNT);
+
+        // 不可逐出的分配在硬上限处被拒绝，可逐出的图集页先让出空间
+        std::uint32_t accepted_count = 0;
+        while (!budget.TryReserve(GpuMemoryCategory::Intermediate, INTERMEDIATE_BYTES).IsNull())
+        {
+            ++accepted_count;
+        }
+        std::printf("gpu-budget hard limit: %u more intermediates accepted, %llu rejected, atlas %.1f MiB, total %.1f/%.1f MiB\n",
+                    accepted_count,
+                    static_cast<unsigned long long>(statistics.m_rejected_count),
+                    atlas_usage.m_current_bytes / 1048576.0,
+                    statistics.m_current_bytes / 1048576.0,
+                    config.m_hard_limit_bytes / 1048576.0);
+    }
+
+    void RunPerfLintBenchmark()
+    {
+        // 每条规则一个违反的描述和一个修正后的描述，前三组来自main中原先的设置
+        const std::array<PerfLintSubject, 14> subjects{{
+            LintDeviceDescription{GpuDeviceCreationFlag::DEBUG_LAYER | GpuDeviceCreationFlag::BGRA_SUPPORT, false},
+            LintBufferDescription{12, GpuUsage::DEFAULT, GpuBindFlag::INDEX_BUFFER, 0, true},
+            LintSamplerDescription{GpuFilter::MIN_MAG_MIP_LINEAR, 1, 1.0f},
+            LintTextureDescription{256, 256, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0, true},
+            LintTextureDescription{256, 256, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::DEFAULT, GpuBindFlag::RENDER_TARGET, 0, true},
+            LintTextureDescription{256, 256, 0, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::STAGING, 0, 0, false},
+            LintBlendDescription{true, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD},
+            LintDeviceDescription{GpuDeviceCreationFlag::DEBUG_LAYER | GpuDeviceCreationFlag::BGRA_SUPPORT, true},
+            LintBufferDescription{12, GpuUsage::IMMUTABLE, GpuBindFlag::INDEX_BUFFER, 0, true},
+            LintSamplerDescription{GpuFilter::MIN_MAG_MIP_POINT, 1, 1.0f},
+            LintSamplerDescription{GpuFilter::MIN_MAG_MIP_LINEAR, 1, 0.0f},
+            LintTextureDescription{350, 100, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0, false},
+            LintTextureDescription{256, 256, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::STAGING, 0, 0, false},
+            LintBlendDescription{true, 5, 8, GpuBlend::OP_ADD, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD},
+        }};
+
+        std::uint64_t warning_count = 0;
+        CPerfLinter linter{[&warning_count](const PerfLintWarning&)
+                           { ++warning_count; }};
+        constexpr std::uint32_t ITERATIONS = 10'000;
+        const auto check_us = MeasureAverageMicroseconds(ITERATIONS, [&]()
+                                                         {
+                                                             for (const auto& subject : subjects)
+                                                             {
+                                                                 linter.Check(subject);
+                                                             }
+                                                         });
+        std::printf("perf-lint: %zu rules, %.1f ns per check, %llu warnings reported\n",
+                    PerfLint::GetRules().size(),
+                    check_us * 1000.0 / subjects.size(),
+                    static_cast<unsigned long long>(warning_count));
+    }
+
+    /**
+     * @brief 只记录调用次数的设备上下文，提供装饰器基准用到的成员函数
+     */
+    struct NullDeviceContext
+    {
+        std::uint64_t m_call_count{};
+
+        void IASetPrimitiveTopology(std::uint32_t) noexcept { ++m_call_count; }
+        void IASetInputLayout(const void*) noexcept { ++m_call_count; }
+        void IASetVertexBuffers(std::uint32_t, std::uint32_t, const void* const*, const std::uint32_t*, const std::uint32_t*) noexcept { ++m_call_count; }
+        void IASetIndexBuffer(const void*, std::uint32_t, std::uint32_t) noexcept { ++m_call_count; }
+        void VSSetShader(const void*, const void* const*, std::uint32_t) noexcept { ++m_call_count; }
+        void PSSetShader(const void*, const void* const*, std::uint32_t) noexcept { ++m_call_count; }
+        void VSSetConstantBuffers(std::uint32_t, std::uint32_t, const void* const*) noexcept { ++m_call_count; }
+        void PSSetShaderResources(std::uint32_t, std::uint32_t, const void* const*) noexcept { ++m_call_count; }
+        void PSSetSamplers(std::uint32_t, std::uint32_t, const void* const*) noexcept { ++m_call_count; }
+        void OMSetBlendState(const void*, const float*, std::uint32_t) noexcept { ++m_call_count; }
+        void OMSetRenderTargets(std::uint32_t, const void* const*, const void*) noexcept { ++m_call_count; }
+        void RSSetViewports(std::uint32_t, const void*) noexcept { ++m_call_count; }
+        void DrawIndexed(std::uint32_t, std::uint32_t, std::int32_t) noexcept { ++m_call_count; }
+    };
+
+    template <class Context>
+    void SubmitDeviceContextFrame(Context& context, std::uint32_t quad_count)
+    {
+        // 与main中一帧的调用序列相同：绑定管线后每个四边形重新绑定纹理和着色器再绘制
+        static const int dummy_objects[4]{};
+        const void* const p_buffer = &dummy_objects[0];
+        const void* const p_shader_a = &dummy_objects[1];
+        const void* const p_shader_b = &dummy_objects[2];
+        const void* const p_view = &dummy_objects[3];
+        const std::uint32_t stride = 8;
+        const std::uint32_t offset = 0;
+        context.RSSetViewports(1u, p_view);
+        context.OMSetRenderTargets(1u, &p_view, nullptr);
+        context.IASetPrimitiveTopology(4u);
+        context.IASetInputLayout(p_buffer);
+        context.IASetVertexBuffers(0u, 1u, &p_buffer, &stride, &offset);
+        context.IASetIndexBuffer(p_buffer, 57u, 0u);
+        context.VSSetConstantBuffers(0u, 1u, &p_buffer);
+        context.OMSetBlendState(p_view, nullptr, 0xFFFFFFFFu);
+        for (std::uint32_t i = 0; i < quad_count; ++i)
+        {
+            context.VSSetShader(p_shader_a, nullptr, 0u);
+            context.PSSetShader((i & 1) == 0 ? p_shader_a : p_shader_b, nullptr, 0u);
+            context.PSSetShaderResources(0u, 1u, &p_view);
+            context.PSSetSamplers(0u, 1u, &p_view);
+            context.DrawIndexed(6u, 0u, 0);
+        }
+    }
+
+    void RunDeviceContextBenchmark()
+    {
+        constexpr std::uint32_t QUAD_COUNT = 64;
+        constexpr std::uint32_t ITERATIONS = 20'000;
+        NullDeviceContext null_context{};
+        CInstrumentedDeviceContext<NullDeviceContext, false> plain_context{&null_context};
+        CInstrumentedDeviceContext<NullDeviceContext, true> instrumented_context{&null_context};
+        const auto plain_us = MeasureAverageMicroseconds(ITERATIONS, [&]()
+                                                         {
+                                                             SubmitDeviceContextFrame(plain_context, QUAD_COUNT);
+                                                             plain_context.EndFrame(); });
+        const auto instrumented_us = MeasureAverageMicroseconds(ITERATIONS, [&]()
+                                                                {
+                                                                    SubmitDeviceContextFrame(instrumented_context, QUAD_COUNT);
+                                                                    instrumented_context.RecordUploadedBytes(256);
+                                                                    instrumented_context.EndFrame(); });
+        const auto& frames = instrumented_context.GetFrames();
+        const auto& last_frame = frames.GetFrame(0);
+        const auto calls_per_frame = 8 + QUAD_COUNT * 5;
+        std::printf("device-context: %u calls per frame, disabled %.2f us, enabled %.2f us per frame (%.1f ns per call overhead)\n",
+                    calls_per_frame,
+                    plain_us,
+                    instrumented_us,
+                    (instrumented_us - plain_us) * 1000.0 / calls_per_frame);
+        for (std::size_t i = 0; i < CONTEXT_CALL_CATEGORY_COUNT; ++i)
+        {
+            const auto& counters = last_frame.m_categories[i];
+            std::printf("device-context %-14s %4u calls, %.2f us\n",
+                        GetContextCallCategoryName(static_cast<ContextCallCategory>(i)),
+                        counters.m_call_count,
+                        counters.m_cpu_ns / 1000.0);
+        }
+        std::printf("device-context: frame %llu, %u shader switches, %u redundant shader binds, %llu indices, %llu bytes uploaded, %zu frames in ring, %llu calls forwarded\n",
+                    static_cast<unsigned long long>(last_frame.m_frame_index),
+                    last_frame.m_shader_switch_count,
+                    last_frame.m_redundant_shader_bind_count,
+                    static_cast<unsigned long long>(last_frame.m_index_count),
+                    static_cast<unsigned long long>(last_frame.m_uploaded_bytes),
+                    frames.GetCount(),
+                    static_cast<unsigned long long>(null_context.m_call_count));
+    }
+
+    void RunMockDeviceBenchmark()
+    {
+        constexpr std::uint32_t SETUP_ITERATIONS = 2'000;
+        const auto setup_us = MeasureAverageMicroseconds(SETUP_ITERATIONS, []()
+                                                         {
+                                                             CMockD3D11Device device{};
+                                                             MockComposition composition{device};
+                                                         });
+
+        std::uint64_t lint_warning_count = 0;
+        CPerfLinter perf_linter{[&lint_warning_count](const PerfLintWarning&)
+                                { ++lint_warning_count; }};
+        CMockD3D11Device device{};
+        device.SetPerfLinter(&perf_linter);
+        const MockComposition composition{device};
+        CBgraImage surface{MOCK_SURFACE_WIDTH, MOCK_SURFACE_HEIGHT};
+        auto& mock_context = device.GetImmediateContext();
+        CInstrumentedDeviceContext<CMockD3D11DeviceContext> context{&mock_context};
+        composition.m_pipeline.Bind(context);
+        constexpr std::uint32_t FRAME_COUNT = 20'000;
+        std::uint32_t frame_index = 0;
+        const auto frame_us = MeasureAverageMicroseconds(FRAME_COUNT, [&]()
+                                                         {
+                                                             CompositeMockFrame(context, composition, surface, (frame_index++ & 1) != 0 ? 0.5f : 1.0f);
+                                                             context.EndFrame(); });
+
+        mock_context.SetRecording(true);
+        CompositeMockFrame(mock_context, composition, surface, 0.5f);
+        const auto recorded_call_count = mock_context.GetCalls().size();
+
+        const auto& device_statistics = device.GetStatistics();
+        const auto& context_statistics = mock_context.GetStatistics();
+        const auto context_sum = context.GetFrames().Sum();
+        std::printf("mock-device: pipeline setup %.2f us (%llu objects, %.1f KiB backing), %llu lint warnings\n",
+                    setup_us,
+                    static_cast<unsigned long long>(device_statistics.m_created_count),
+                    device_statistics.m_backing_bytes / 1024.0,
+                    static_cast<unsigned long long>(lint_warning_count));
+        std::printf("mock-device: %.2f us per frame, %.1f calls per frame, %llu draws, %llu invalid draws, %llu binding hazards, %.1f MiB uploaded, %zu calls recorded in a scaled frame\n",
+                    frame_us,
+                    [&]()
+                    {
+                        std::uint64_t call_count = 0;
+                        for (const auto& category : context_sum.m_categories)
+                        {
+                            call_count += category.m_call_count;
+                        }
+                        return static_cast<double>(call_count) / context.GetFrames().GetCount();
+                    }(),
+                    static_cast<unsigned long long>(context_statistics.m_call_counts[static_cast<std::size_t>(MockCallType::DrawIndexed)]),
+                    static_cast<unsigned long long>(context_statistics.m_invalid_draw_count),
+                    static_cast<unsigned long long>(context_statistics.m_binding_hazard_count),
+                    context_statistics.m_uploaded_bytes / 1048576.0,
+                    recorded_call_count);
+    }
+
+    void RunRecoveryBenchmark()
+    {
+        // 模拟设备丢失：每次都在新设备上按清单重建全部资源，旧设备随后销毁
+        auto p_device = std::make_unique<CMockD3D11Device>();
+        MockComposition composition{*p_device};
+        constexpr std::uint32_t RECOVERY_ITERATIONS = 2'000;
+        ManifestRecoveryStatistics recovery_sum{};
+        const auto recovery_us = MeasureAverageMicroseconds(RECOVERY_ITERATIONS, [&]()
+                                                            {
+                                                                auto p_new_device = std::make_unique<CMockD3D11Device>();
+                                                                const auto recovery = composition.m_manifest.Recreate(*p_new_device);
+                                                                p_device = std::move(p_new_device);
+                                                                recovery_sum.m_resource_count = recovery.m_resource_count;
+                                                                recovery_sum.m_worker_count = recovery.m_worker_count;
+                                                                recovery_sum.m_independent_phase_ms += recovery.m_independent_phase_ms;
+                                                                recovery_sum.m_dependent_phase_ms += recovery.m_dependent_phase_ms;
+                                                                recovery_sum.m_total_ms += recovery.m_total_ms; });
+
+        // 与main相同，交换链在新设备上重新创建，然后重新绑定管线并合成
+        GpuTexture2DDescription back_buffer_description{};
+        back_buffer_description.m_width = MOCK_SURFACE_WIDTH;
+        back_buffer_description.m_height = MOCK_SURFACE_HEIGHT;
+        back_buffer_description.m_bind_flags = GpuBindFlag::RENDER_TARGET;
+        composition.m_p_back_buffer = p_device->CreateTexture2D(back_buffer_description, nullptr);
+        composition.m_p_back_buffer_rtv = p_device->CreateRenderTargetView(composition.m_p_back_buffer);
+        CBgraImage surface{MOCK_SURFACE_WIDTH, MOCK_SURFACE_HEIGHT};
+        auto& context = p_device->GetImmediateContext();
+        composition.m_pipeline.Bind(context);
+        const auto first_frame_us = MeasureAverageMicroseconds(1, [&]()
+                                                               { CompositeMockFrame(context, composition, surface, 1.0f); });
+
+        std::printf("recovery: %u resources restored in %.2f us (manifest %.2f us: independent %.2f us, views %.2f us, %u workers), first frame after recovery %.2f us\n",
+                    recovery_sum.m_resource_count,
+                    recovery_us,
+                    recovery_sum.m_total_ms * 1000.0 / RECOVERY_ITERATIONS,
+                    recovery_sum.m_independent_phase_ms * 1000.0 / RECOVERY_ITERATIONS,
+                    recovery_sum.m_dependent_phase_ms * 1000.0 / RECOVERY_ITERATIONS,
+                    recovery_sum.m_worker_count,
+                    first_frame_us);
+    }
+
+    void RunFrameTraceBenchmark()
+    {
+        CMockD3D11Device device{};
+        const MockComposition composition{device};
+        CBgraImage surface{MOCK_SURFACE_WIDTH, MOCK_SURFACE_HEIGHT};
+        auto& mock_context = device.GetImmediateContext();
+
+        // 与main相同：先记录清单中的全部资源，再记录交换链的后台缓冲区
+        CFrameTraceWriter writer{};
+        composition.m_manifest.RecordToTrace(writer);
+        const auto& back_buffer_description = std::get<GpuTexture2DDescription>(composition.m_p_back_buffer->m_description);
+        writer.CreateTexture2D(composition.m_p_back_buffer, back_buffer_description, nullptr);
+        writer.CreateView(composition.m_p_back_buffer_rtv, MockObjectType::RenderTargetView, composition.m_p_back_buffer);
+        writer.BeginFrame();
+        CCapturingDeviceContext<CMockD3D11DeviceContext> context{&mock_context};
+        context.StartCapture(writer);
+        composition.m_pipeline.Bind(context);
+        CompositeMockFrame(context, composition, surface, 0.5f);
+        context.StopCapture();
+        const auto writer_statistics = writer.GetStatistics();
+
+        // 同一帧直接提交的耗时，以及不捕获时装饰器的开销
+        constexpr std::uint32_t FRAME_COUNT = 20'000;
+        const auto direct_us = MeasureAverageMicroseconds(FRAME_COUNT, [&]()
+                                                          {
+                                                              composition.m_pipeline.Bind(mock_context);
+                                                              CompositeMockFrame(mock_context, composition, surface, 0.5f); });
+        const auto idle_capture_us = MeasureAverageMicroseconds(FRAME_COUNT, [&]()
+                                                                {
+                                                                    composition.m_pipeline.Bind(context);
+                                                                    CompositeMockFrame(context, composition, surface, 0.5f); });
+
+        const auto path = (std::filesystem::temp_directory_path() / "frame-trace-benchmark.ftrc").string();
+        writer.WriteToFile(path);
+        FrameTraceReplayStatistics replay{};
+        FrameTraceReplayStatistics timed_replay{};
+        std::size_t file_size = 0;
+        MockContextStatistics replay_context_statistics{};
+        {
+            const auto file = CMappedFile::Open(path);
+            file_size = file.GetSize();
+            const CFrameTraceReader reader{file.GetData(), file.GetSize()};
+            CMockD3D11Device replay_device{};
+            CMockFrameTraceBackend backend{replay_device};
+            replay = FrameTraceReplay::Replay(reader, backend, FRAME_COUNT);
+            replay_context_statistics = replay_device.GetImmediateContext().GetStatistics();
+            timed_replay = FrameTraceReplay::Replay(reader, backend, FRAME_COUNT / 10, true);
+        }
+        std::filesystem::remove(path);
+
+        std::printf("frame-trace: captured %u commands, %u objects (%u unknown), %.1f KiB file\n",
+                    writer_statistics.m_command_count,
+                    writer_statistics.m_object_count,
+                    writer_statistics.m_unknown_object_count,
+                    file_size / 1024.0);
+        std::printf("frame-trace: direct %.2f us per frame, through idle capturing context %.2f us per frame\n", direct_us, idle_capture_us);
+        std::printf("frame-trace: replay setup %.3f ms, %u frames avg %.2f us (min %.2f, max %.2f), %llu draws, %llu invalid draws, %.1f KiB uploaded per frame\n",
+                    replay.m_setup_ms,
+                    replay.m_frame_count,
+                    replay.m_average_frame_ms * 1000.0,
+                    replay.m_min_frame_ms * 1000.0,
+                    replay.m_max_frame_ms * 1000.0,
+                    static_cast<unsigned long long>(replay_context_statistics.m_call_counts[static_cast<std::size_t>(MockCallType::DrawIndexed)]),
+                    static_cast<unsigned long long>(replay_context_statistics.m_invalid_draw_count),
+                    replay_context_statistics.m_uploaded_bytes / 1024.0 / replay.m_frame_count);
+        for (std::size_t i = 0; i < timed_replay.m_opcode_timings.size(); ++i)
+        {
+            const auto& timing = timed_replay.m_opcode_timings[i];
+            if (timing.m_count == 0)
+            {
+                continue;
+            }
+            std::printf("frame-trace   %-24s %8llu calls %8.1f ns each\n",
+                        GetFrameTraceOpcodeName(static_cast<FrameTraceOpcode>(i)),
+                        static_cast<unsigned long long>(timing.m_count),
+                        static_cast<double>(timing.m_total_ns) / timing.m_count);
+        }
+    }
+
+    void RunGpuTimerBenchmark()
+    {
+        // 用CPU时钟代替GPU时间戳，各阶段忙等已知的时长，模拟GPU落后CPU两帧执行完
+        constexpr std::uint64_t GPU_LATENCY_FRAMES = 2;
+        constexpr std::uint32_t FRAME_COUNT = 600;
+        constexpr std::uint32_t DISJOINT_FRAME_INTERVAL = 100;
+        struct SimulatedPass
+        {
+            const char* m_p_name;
+            std::chrono::microseconds m_duration;
+        };
+        constexpr std::array SIMULATED_PASSES{
+            SimulatedPass{"alpha-increase", std::chrono::microseconds{200}},
+            SimulatedPass{"blit", std::chrono::microseconds{80}},
+            SimulatedPass{"present", std::chrono::microseconds{30}}};
+        auto spin_for = [](std::chrono::microseconds duration)
+        {
+            const auto deadline = Clock::now() + duration;
+            while (Clock::now() < deadline)
+            {
+            }
+        };
+        constexpr std::array<std::uint32_t, 3> RING_DEPTHS{2, 3, 4};
+        for (const auto ring_depth : RING_DEPTHS)
+        {
+            CCpuGpuTimerBackend backend{};
+            GpuTimerRingConfig config{};
+            config.m_ring_depth = ring_depth;
+            CGpuTimerRing ring{backend, config};
+            std::vector<std::uint32_t> passes{};
+            for (const auto& simulated_pass : SIMULATED_PASSES)
+            {
+                passes.push_back(ring.RegisterPass(simulated_pass.m_p_name));
+            }
+            std::vector<std::uint64_t> submitted_counts(FRAME_COUNT + 1);
+            for (std::uint32_t frame = 1; frame <= FRAME_COUNT; ++frame)
+            {
+                if (frame % DISJOINT_FRAME_INTERVAL == 0)
+                {
+                    backend.MarkNextFrameDisjoint();
+                }
+                ring.BeginFrame();
+                for (std::size_t i = 0; i < SIMULATED_PASSES.size(); ++i)
+                {
+                    ring.BeginPass(passes[i]);
+                    spin_for(SIMULATED_PASSES[i].m_duration);
+                    ring.EndPass(passes[i]);
+                }
+                ring.EndFrame();
+                submitted_counts[frame] = backend.GetSubmittedCount();
+                if (frame > GPU_LATENCY_FRAMES)
+                {
+                    backend.Complete(submitted_counts[frame - GPU_LATENCY_FRAMES]);
+                }
+            }
+            const auto& statistics = ring.GetStatistics();
+            std::printf("gpu-timer depth %u: %llu/%u frames resolved, %llu skipped, %llu disjoint, latency avg %.2f max %llu frames\n",
+                        ring_depth,
+                        static_cast<unsigned long long>(statistics.m_resolved_frame_count),
+                        FRAME_COUNT,
+                        static_cast<unsigned long long>(statistics.m_skipped_frame_count),
+                        static_cast<unsigned long long>(statistics.m_disjoint_frame_count),
+                        statistics.m_resolved_frame_count == 0 ? 0.0 : static_cast<double>(statistics.m_total_latency_frames) / statistics.m_resolved_frame_count,
+                        static_cast<unsigned long long>(statistics.m_max_latency_frames));
+            for (std::size_t i = 0; i < SIMULATED_PASSES.size(); ++i)
+            {
+                const auto& timings = ring.GetPassTimings(passes[i]);
+                std::printf("gpu-timer depth %u %-14s: expected %.3f ms, last %.3f avg %.3f min %.3f max %.3f ms over %zu frames\n",
+                            ring_depth,
+                            ring.GetPassName(passes[i]).c_str(),
+                            SIMULATED_PASSES[i].m_duration.count() / 1000.0,
+                            timings.GetLast(),
+                            timings.GetAverage(),
+                            timings.GetMin(),
+                            timings.GetMax(),
+                            timings.GetCount());
+            }
+        }
+
+        // 不做任何工作时计时本身的开销
+        CCpuGpuTimerBackend backend{};
+        CGpuTimerRing ring{backend};
+        std::vector<std::uint32_t> passes{};
+        for (const auto& simulated_pass : SIMULATED_PASSES)
+        {
+            passes.push_back(ring.RegisterPass(simulated_pass.m_p_name));
+        }
+        auto timed_frame = [&]()
+        {
+            ring.BeginFrame();
+            for (const auto pass : passes)
+            {
+                ring.BeginPass(pass);
+                ring.EndPass(pass);
+            }
+            ring.EndFrame();
+            backend.Complete(backend.GetSubmittedCount() - (std::min)(backend.GetSubmittedCount(), GPU_LATENCY_FRAMES));
+        };
+        std::printf("gpu-timer overhead: %.3f us/frame for %zu passes\n", MeasureAverageMicroseconds(100000, timed_frame), passes.size());
+    }
+
+    void RunAlphaFixBenchmark()
+    {
+        constexpr std::array<std::array<std::uint32_t, 2>, 4> SURFACE_SIZES{{{64, 64}, {350, 100}, {1920, 1080}, {3840, 2160}}};
+        std::printf("alpha-fix: best kernel %s\n", GetAlphaFixKernelName(AlphaFix::GetBestKernel()));
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            // 行距多出一段，与GDI表面一样行距不等于宽度乘以像素大小
+            const auto row_pitch = width * CBgraImage::BYTES_PER_PIXEL + 64;
+            CBgraImage source{width, height, row_pitch};
+            std::mt19937 random_engine{42};
+            std::uniform_int_distribution<std::uint32_t> byte_distribution{0, 255};
+            std::generate(source.GetData(), source.GetData() + source.GetSizeInBytes(), [&]()
+                          { return static_cast<std::uint8_t>(byte_distribution(random_engine)); });
+            CBgraImage target{width, height, row_pitch};
+            const auto iterations = (std::max)(1u, 400'000'000u / (width * height));
+            const auto source_bytes = static_cast<double>(width) * height * CBgraImage::BYTES_PER_PIXEL;
+            for (std::size_t i = 0; i < ALPHA_FIX_KERNEL_COUNT; ++i)
+            {
+                const auto kernel = static_cast<AlphaFixKernel>(i);
+                if (!AlphaFix::IsKernelSupported(kernel))
+                {
+                    std::printf("alpha-fix %ux%u %-6s: unsupported\n", width, height, GetAlphaFixKernelName(kernel));
+                    continue;
+                }
+                auto increase_alpha = [&]()
+                {
+                    AlphaFix::IncreaseAlpha(kernel, source.GetData(), source.GetRowPitch(), target.GetData(), target.GetRowPitch(), width, height, 1);
+                };
+                const auto us = MeasureAverageMicroseconds(iterations, increase_alpha);
+                std::printf("alpha-fix %ux%u %-6s: %.2f us, %.2f GB/s\n",
+                            width,
+                            height,
+                            GetAlphaFixKernelName(kernel),
+                            us,
+                            source_bytes / us / 1000.0);
+            }
+        }
+    }
+
+    struct Benchmark
+    {
+        const char* m_p_name;
+        void (*m_p_function)();
+    };
+
+    constexpr std::array BENCHMARKS{
+        Benchmark{"draw-sort", &RunDrawSortBenchmark},
+        Benchmark{"render-graph", &RunRenderGraphBenchmark},
+        Benchmark{"upload", &RunUploadBenchmark},
+        Benchmark{"mapped-surface", &RunMappedSurfaceBenchmark},
+        Benchmark{"coverage", &RunCoverageBenchmark},
+        Benchmark{"compositor", &RunCompositorBenchmark},
+        Benchmark{"resolution-governor", &RunResolutionGovernorBenchmark},
+        Benchmark{"spsc-queue", &RunSpscQueueBenchmark},
+        Benchmark{"triple-buffer", &RunTripleBufferBenchmark},
+        Benchmark{"timing-wheel", &RunTimingWheelBenchmark},
+        Benchmark{"readback", &RunReadbackBenchmark},
+        Benchmark{"shared-frame", &RunSharedFrameBenchmark},
+        Benchmark{"gpu-budget", &RunGpuMemoryBudgetBenchmark},
+        Benchmark{"perf-lint", &RunPerfLintBenchmark},
+        Benchmark{"device-context", &RunDeviceContextBenchmark},
+        Benchmark{"mock-device", &RunMockDeviceBenchmark},
+        Benchmark{"recovery", &RunRecoveryBenchmark},
+        Benchmark{"frame-trace", &RunFrameTraceBenchmark},
+        Benchmark{"gpu-timer", &RunGpuTimerBenchmark},
+        Benchmark{"alpha-fix", &RunAlphaFixBenchmark}};
+}
+
+auto BenchmarkMode::ParseBenchmarkName(int argc, const char* const argv[])
+    -> std::optional<std::string>
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string{argv[i]} == "--benchmark")
+        {
+            return std::string{argv[i + 1]};
+        }
+    }
+    return std::nullopt;
+}
+
+int BenchmarkMode::Run(const std::string& name)
+{
+    bool is_found = false;
+    for (const auto& benchmark : BENCHMARKS)
+    {
+        if (name == "all" || name == benchmark.m_p_name)
+        {
+            is_found = true;
+            benchmark.m_p_function();
+        }
+    }
+    if (!is_found)
+    {
+        std::printf("Unknown benchmark: %s\n", name.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <optional>
+#include <string>
+
+/**
+ * @brief 不依赖窗口和D3D设备的基准测试，对应命令行 --benchmark 名称|all
+ */
+namespace BenchmarkMode
+{
+    /**
+     * @brief 解析命令行，没有--benchmark时返回std::nullopt
+     */
+    auto ParseBenchmarkName(int argc, const char* const argv[])
+        -> std::optional<std::string>;
+
+    /**
+     * @brief 运行指定名称的基准测试，名称为all时依次运行全部
+     *
+     * @return int 进程返回值，名称不存在时非0
+     */
+    int Run(const std::string& name);
+}
@@ -0,0 +1,96 @@
+#include "CBgraImage.h"
+#include <stdexcept>
+
+CBgraImage::CBgraImage(std::uint32_t width, std::uint32_t height, std::uint32_t row_pitch)
+{
+    Resize(width, height, row_pitch);
+}
+
+void CBgraImage::Resize(std::uint32_t width, std::uint32_t height, std::uint32_t row_pitch)
+{
+    const auto min_row_pitch = width * BYTES_PER_PIXEL;
+    if (row_pitch == 0)
+    {
+        row_pitch = min_row_pitch;
+    }
+    if (row_pitch < min_row_pitch)
+    {
+        throw std::invalid_argument{"Row pitch of image is smaller than its width."};
+    }
+    m_width = width;
+    m_height = height;
+    m_row_pitch = row_pitch;
+    m_data.assign(static_cast<std::size_t>(row_pitch) * height, 0);
+}
+
+void CBgraImage::Fill(std::uint8_t b, std::uint8_t g, std::uint8_t r, std::uint8_t a) noexcept
+{
+    for (std::uint32_t y = 0; y < m_height; ++y)
+    {
+        auto* p_pixel = GetRow(y);
+        for (std::uint32_t x = 0; x < m_width; ++x, p_pixel += BYTES_PER_PIXEL)
+        {
+            p_pixel[0] = b;
+            p_pixel[1] = g;
+            p_pixel[2] = r;
+            p_pixel[3] = a;
+        }
+    }
+}
+
+std::uint32_t CBgraImage::GetWidth() const noexcept
+{
+    return m_width;
+}
+
+std::uint32_t CBgraImage::GetHeight() const noexcept
+{
+    return m_height;
+}
+
+std::uint32_t CBgraImage::GetRowPitch() const noexcept
+{
+    return m_row_pitch;
+}
+
+auto CBgraImage::GetSizeInBytes() const noexcept
+    -> std::size_t
+{
+    return m_data.size();
+}
+
+auto CBgraImage::GetData() noexcept
+    -> std::uint8_t*
+{
+    return m_data.data();
+}
+
+auto CBgraImage::GetData() const noexcept
+    -> const std::uint8_t*
+{
+    return m_data.data();
+}
+
+auto CBgraImage::GetRow(std::uint32_t y) noexcept
+    -> std::uint8_t*
+{
+    return m_data.data() + static_cast<std::size_t>(y) * m_row_pitch;
+}
+
+auto CBgraImage::GetRow(std::uint32_t y) const noexcept
+    -> const std::uint8_t*
+{
+    return m_data.data() + static_cast<std::size_t>(y) * m_row_pitch;
+}
+
+auto CBgraImage::GetPixel(std::uint32_t x, std::uint32_t y) noexcept
+    -> std::uint8_t*
+{
+    return GetRow(y) + static_cast<std::size_t>(x) * BYTES_PER_PIXEL;
+}
+
+auto CBgraImage::GetPixel(std::uint32_t x, std::uint32_t y) const noexcept
+    -> const std::uint8_t*
+{
+    return GetRow(y) + static_cast<std::size_t>(x) * BYTES_PER_PIXEL;
+}
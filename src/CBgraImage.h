@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 位于内存中的BGRA8图像，与DXGI_FORMAT_B8G8R8A8_UNORM纹理的内存布局一致
+ */
+class CBgraImage
+{
+public:
+    constexpr static std::uint32_t BYTES_PER_PIXEL = 4;
+
+private:
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_row_pitch{};
+    std::vector<std::uint8_t> m_data{};
+
+public:
+    CBgraImage() = default;
+    /**
+     * @brief 构造一个图像，所有像素初始化为0
+     *
+     * @param width 宽度
+     * @param height 高度
+     * @param row_pitch 每行字节数，为0时使用紧密排列
+     */
+    CBgraImage(std::uint32_t width, std::uint32_t height, std::uint32_t row_pitch = 0);
+    ~CBgraImage() = default;
+
+    void Resize(std::uint32_t width, std::uint32_t height, std::uint32_t row_pitch = 0);
+    void Fill(std::uint8_t b, std::uint8_t g, std::uint8_t r, std::uint8_t a) noexcept;
+
+    std::uint32_t GetWidth() const noexcept;
+    std::uint32_t GetHeight() const noexcept;
+    std::uint32_t GetRowPitch() const noexcept;
+    auto GetSizeInBytes() const noexcept
+        -> std::size_t;
+
+    auto GetData() noexcept
+        -> std::uint8_t*;
+    auto GetData() const noexcept
+        -> const std::uint8_t*;
+    auto GetRow(std::uint32_t y) noexcept
+        -> std::uint8_t*;
+    auto GetRow(std::uint32_t y) const noexcept
+        -> const std::uint8_t*;
+    auto GetPixel(std::uint32_t x, std::uint32_t y) noexcept
+        -> std::uint8_t*;
+    auto GetPixel(std::uint32_t x, std::uint32_t y) const noexcept
+        -> const std::uint8_t*;
+};
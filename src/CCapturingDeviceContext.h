@@ -0,0 +1,314 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "FrameTrace.h"
+
+/**
+ * @brief 设备上下文的装饰器：提供与被包装的上下文同名的成员函数，捕获期间先把调用写入CFrameTraceWriter再转发 \n
+ * 不捕获时只多一次判断，可以常驻在上下文的调用路径上；与CInstrumentedDeviceContext一样可以互相嵌套 \n
+ * 经由Get得到的原始上下文的调用不会被捕获，需要时由调用者直接写入跟踪
+ *
+ * @tparam Context ID3D11DeviceContext、CMockD3D11DeviceContext或其它提供同名成员函数的类型
+ */
+template <class Context>
+class CCapturingDeviceContext
+{
+private:
+    Context* m_p_context{};
+    CFrameTraceWriter* m_p_writer{};
+
+public:
+    explicit CCapturingDeviceContext(Context* p_context) noexcept
+        : m_p_context{p_context}
+    {
+    }
+
+    void SetContext(Context* p_context) noexcept
+    {
+        m_p_context = p_context;
+    }
+    auto Get() const noexcept
+        -> Context*
+    {
+        return m_p_context;
+    }
+    /**
+     * @brief 开始把之后的调用写入writer，writer须在StopCapture之前一直有效
+     */
+    void StartCapture(CFrameTraceWriter& writer) noexcept
+    {
+        m_p_writer = &writer;
+    }
+    void StopCapture() noexcept
+    {
+        m_p_writer = nullptr;
+    }
+    bool IsCapturing() const noexcept
+    {
+        return m_p_writer != nullptr;
+    }
+
+    template <class Topology>
+    void IASetPrimitiveTopology(Topology topology)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->IASetPrimitiveTopology(static_cast<std::uint32_t>(topology));
+        }
+        m_p_context->IASetPrimitiveTopology(topology);
+    }
+
+    template <class InputLayout>
+    void IASetInputLayout(InputLayout p_input_layout)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->IASetInputLayout(p_input_layout);
+        }
+        m_p_context->IASetInputLayout(p_input_layout);
+    }
+
+    template <class Buffers>
+    void IASetVertexBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, Buffers p_buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->IASetVertexBuffers(start_slot, buffer_count, p_buffers, p_strides, p_offsets);
+        }
+        m_p_context->IASetVertexBuffers(start_slot, buffer_count, p_buffers, p_strides, p_offsets);
+    }
+
+    template <class Buffer, class Format>
+    void IASetIndexBuffer(Buffer p_index_buffer, Format format, std::uint32_t offset)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->IASetIndexBuffer(p_index_buffer, static_cast<std::uint32_t>(format), offset);
+        }
+        m_p_context->IASetIndexBuffer(p_index_buffer, format, offset);
+    }
+
+    template <class Shader, class ClassInstances>
+    void VSSetShader(Shader p_shader, ClassInstances p_class_instances, std::uint32_t class_instance_count)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->VSSetShader(p_shader, p_class_instances, class_instance_count);
+        }
+        m_p_context->VSSetShader(p_shader, p_class_instances, class_instance_count);
+    }
+
+    template <class Shader, class ClassInstances>
+    void GSSetShader(Shader p_shader, ClassInstances p_class_instances, std::uint32_t class_instance_count)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->GSSetShader(p_shader, p_class_instances, class_instance_count);
+        }
+        m_p_context->GSSetShader(p_shader, p_class_instances, class_instance_count);
+    }
+
+    template <class Shader, class ClassInstances>
+    void PSSetShader(Shader p_shader, ClassInstances p_class_instances, std::uint32_t class_instance_count)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->PSSetShader(p_shader, p_class_instances, class_instance_count);
+        }
+        m_p_context->PSSetShader(p_shader, p_class_instances, class_instance_count);
+    }
+
+    template <class Buffers>
+    void VSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, Buffers p_buffers)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->VSSetConstantBuffers(start_slot, buffer_count, p_buffers);
+        }
+        m_p_context->VSSetConstantBuffers(start_slot, buffer_count, p_buffers);
+    }
+
+    template <class Buffers>
+    void PSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, Buffers p_buffers)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->PSSetConstantBuffers(start_slot, buffer_count, p_buffers);
+        }
+        m_p_context->PSSetConstantBuffers(start_slot, buffer_count, p_buffers);
+    }
+
+    template <class Views>
+    void PSSetShaderResources(std::uint32_t start_slot, std::uint32_t view_count, Views p_views)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->PSSetShaderResources(start_slot, view_count, p_views);
+        }
+        m_p_context->PSSetShaderResources(start_slot, view_count, p_views);
+    }
+
+    template <class Samplers>
+    void PSSetSamplers(std::uint32_t start_slot, std::uint32_t sampler_count, Samplers p_samplers)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->PSSetSamplers(start_slot, sampler_count, p_samplers);
+        }
+        m_p_context->PSSetSamplers(start_slot, sampler_count, p_samplers);
+    }
+
+    template <class State>
+    void RSSetState(State p_rasterizer_state)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->RSSetState(p_rasterizer_state);
+        }
+        m_p_context->RSSetState(p_rasterizer_state);
+    }
+
+    template <class Viewport>
+    void RSSetViewports(std::uint32_t viewport_count, const Viewport* p_viewports)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->RSSetViewports(viewport_count, p_viewports);
+        }
+        m_p_context->RSSetViewports(viewport_count, p_viewports);
+    }
+
+    template <class State>
+    void OMSetBlendState(State p_blend_state, const float* p_blend_factor, std::uint32_t sample_mask)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->OMSetBlendState(p_blend_state, p_blend_factor, sample_mask);
+        }
+        m_p_context->OMSetBlendState(p_blend_state, p_blend_factor, sample_mask);
+    }
+
+    template <class State>
+    void OMSetDepthStencilState(State p_depth_stencil_state, std::uint32_t stencil_ref)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->OMSetDepthStencilState(p_depth_stencil_state, stencil_ref);
+        }
+        m_p_context->OMSetDepthStencilState(p_depth_stencil_state, stencil_ref);
+    }
+
+    template <class Views, class DepthStencilView>
+    void OMSetRenderTargets(std::uint32_t view_count, Views p_render_target_views, DepthStencilView p_depth_stencil_view)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->OMSetRenderTargets(view_count, p_render_target_views, p_depth_stencil_view);
+        }
+        m_p_context->OMSetRenderTargets(view_count, p_render_target_views, p_depth_stencil_view);
+    }
+
+    template <class Targets>
+    void SOSetTargets(std::uint32_t target_count, Targets p_targets, const std::uint32_t* p_offsets)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->SOSetTargets(target_count, p_targets, p_offsets);
+        }
+        m_p_context->SOSetTargets(target_count, p_targets, p_offsets);
+    }
+
+    void Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->Draw(vertex_count, start_vertex_location);
+        }
+        m_p_context->Draw(vertex_count, start_vertex_location);
+    }
+
+    void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->DrawIndexed(index_count, start_index_location, base_vertex_location);
+        }
+        m_p_context->DrawIndexed(index_count, start_index_location, base_vertex_location);
+    }
+
+    template <class Resource, class Box>
+    void UpdateSubresource(Resource p_resource, std::uint32_t subresource, Box p_box, const void* p_source, std::uint32_t row_pitch, std::uint32_t depth_pitch)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->UpdateSubresource(p_resource, subresource, p_box, p_source, row_pitch, depth_pitch);
+        }
+        m_p_context->UpdateSubresource(p_resource, subresource, p_box, p_source, row_pitch, depth_pitch);
+    }
+
+    /**
+     * @brief 映射成功后记下映射的内存，写入的内容在Unmap时复制到跟踪中
+     */
+    template <class Resource, class MapType, class MappedSubresource>
+    auto Map(Resource p_resource, std::uint32_t subresource, MapType map_type, std::uint32_t map_flags, MappedSubresource* p_mapped_resource)
+    {
+        using Result = decltype(m_p_context->Map(p_resource, subresource, map_type, map_flags, p_mapped_resource));
+        if constexpr (std::is_void_v<Result>)
+        {
+            m_p_context->Map(p_resource, subresource, map_type, map_flags, p_mapped_resource);
+            if (m_p_writer != nullptr)
+            {
+                m_p_writer->Map(p_resource, subresource, static_cast<std::uint32_t>(map_type), GetFrameTraceMappedData(*p_mapped_resource));
+            }
+        }
+        else
+        {
+            const auto result = m_p_context->Map(p_resource, subresource, map_type, map_flags, p_mapped_resource);
+            // HRESULT为负表示失败
+            if (m_p_writer != nullptr && result >= 0)
+            {
+                m_p_writer->Map(p_resource, subresource, static_cast<std::uint32_t>(map_type), GetFrameTraceMappedData(*p_mapped_resource));
+            }
+            return result;
+        }
+    }
+
+    template <class Resource>
+    void Unmap(Resource p_resource, std::uint32_t subresource)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->Unmap(p_resource, subresource);
+        }
+        m_p_context->Unmap(p_resource, subresource);
+    }
+
+    template <class Destination, class Source>
+    void CopyResource(Destination p_destination, Source p_source)
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->CopyResource(p_destination, p_source);
+        }
+        m_p_context->CopyResource(p_destination, p_source);
+    }
+
+    template <class View>
+    void ClearRenderTargetView(View p_render_target_view, const float color[4])
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->ClearRenderTargetView(p_render_target_view, color);
+        }
+        m_p_context->ClearRenderTargetView(p_render_target_view, color);
+    }
+
+    void Flush()
+    {
+        if (m_p_writer != nullptr)
+        {
+            m_p_writer->Flush();
+        }
+        m_p_context->Flush();
+    }
+};
@@ -0,0 +1,69 @@
+#include "CCoverageImage.h"
+#include <stdexcept>
+
+CCoverageImage::CCoverageImage(std::uint32_t width, std::uint32_t height, std::uint32_t row_pitch)
+{
+    Resize(width, height, row_pitch);
+}
+
+void CCoverageImage::Resize(std::uint32_t width, std::uint32_t height, std::uint32_t row_pitch)
+{
+    const auto min_row_pitch = width * BYTES_PER_PIXEL;
+    if (row_pitch == 0)
+    {
+        row_pitch = min_row_pitch;
+    }
+    if (row_pitch < min_row_pitch)
+    {
+        throw std::invalid_argument{"Row pitch of image is smaller than its width."};
+    }
+    m_width = width;
+    m_height = height;
+    m_row_pitch = row_pitch;
+    m_data.assign(static_cast<std::size_t>(row_pitch) * height, 0);
+}
+
+std::uint32_t CCoverageImage::GetWidth() const noexcept
+{
+    return m_width;
+}
+
+std::uint32_t CCoverageImage::GetHeight() const noexcept
+{
+    return m_height;
+}
+
+std::uint32_t CCoverageImage::GetRowPitch() const noexcept
+{
+    return m_row_pitch;
+}
+
+auto CCoverageImage::GetSizeInBytes() const noexcept
+    -> std::size_t
+{
+    return m_data.size();
+}
+
+auto CCoverageImage::GetData() noexcept
+    -> std::uint8_t*
+{
+    return m_data.data();
+}
+
+auto CCoverageImage::GetData() const noexcept
+    -> const std::uint8_t*
+{
+    return m_data.data();
+}
+
+auto CCoverageImage::GetRow(std::uint32_t y) noexcept
+    -> std::uint8_t*
+{
+    return m_data.data() + static_cast<std::size_t>(y) * m_row_pitch;
+}
+
+auto CCoverageImage::GetRow(std::uint32_t y) const noexcept
+    -> const std::uint8_t*
+{
+    return m_data.data() + static_cast<std::size_t>(y) * m_row_pitch;
+}
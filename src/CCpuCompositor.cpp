@@ -0,0 +1,77 @@
+#include "CCpuCompositor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+CCpuCompositor::CCpuCompositor(std::uint32_t width, std::uint32_t height, PresentFunction present)
+    : m_source{width, height}, m_target{width, height}, m_present{std::move(present)}
+{
+}
+
+auto CCpuCompositor::GetKind() const noexcept
+    -> CompositorKind
+{
+    return CompositorKind::Cpu;
+}
+
+void CCpuCompositor::Resize(std::uint32_t width, std::uint32_t height)
+{
+    m_source.Resize(width, height);
+    m_target.Resize(width, height);
+}
+
+void CCpuCompositor::Composite(const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects)
+{
+    // 只同步更新过的区域，未更新的像素保留上一次的内容
+    for (const auto& rect : updated_rects)
+    {
+        const auto row_size = static_cast<std::size_t>(rect.m_width) * CBgraImage::BYTES_PER_PIXEL;
+        for (std::uint32_t row = rect.m_y; row < rect.m_y + rect.m_height; ++row)
+        {
+            std::memcpy(m_source.GetPixel(rect.m_x, row),
+                        source.m_p_data + static_cast<std::size_t>(row) * source.m_row_pitch + static_cast<std::size_t>(rect.m_x) * CBgraImage::BYTES_PER_PIXEL,
+                        row_size);
+        }
+    }
+    m_renderer.RenderAlphaIncreasePass(m_source, m_target);
+    if (m_present)
+    {
+        m_present(m_target);
+    }
+}
+
+auto CCpuCompositor::MeasureMicroseconds(std::uint32_t width, std::uint32_t height, std::uint32_t draw_count, const PresentFunction& present)
+    -> double
+{
+    CAlignedSurfaceMemory memory{};
+    CMappedSurface surface{memory, width, height};
+    const auto& updated_rects = surface.Flush();
+    CCpuCompositor compositor{width, height, present};
+    const std::vector<SurfaceRect> no_updated_rects{};
+    compositor.Composite(surface.GetFrontBuffer(), updated_rects);
+
+    const auto iterations = (std::max)(3u, 2'000'000u / (width * height * draw_count + 1));
+    const auto begin = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < iterations; ++i)
+    {
+        for (std::uint32_t draw = 0; draw < draw_count; ++draw)
+        {
+            compositor.Composite(surface.GetFrontBuffer(), no_updated_rects);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - begin).count() / iterations;
+}
+
+auto CCpuCompositor::GetRenderer() noexcept
+    -> CSoftwareRenderer&
+{
+    return m_renderer;
+}
+
+auto CCpuCompositor::GetTarget() const noexcept
+    -> const CBgraImage&
+{
+    return m_target;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <functional>
+#include "CBgraImage.h"
+#include "CSoftwareRenderer.h"
+#include "Compositor.h"
+
+/**
+ * @brief 用CSoftwareRenderer在CPU上完成合成，结果交给present函数输出到窗口
+ */
+class CCpuCompositor final : public ICompositor
+{
+public:
+    using PresentFunction = std::function<void(const CBgraImage&)>;
+
+private:
+    CSoftwareRenderer m_renderer{};
+    CBgraImage m_source{};
+    CBgraImage m_target{};
+    PresentFunction m_present;
+
+public:
+    CCpuCompositor(std::uint32_t width, std::uint32_t height, PresentFunction present = {});
+    ~CCpuCompositor() override = default;
+
+    auto GetKind() const noexcept
+        -> CompositorKind override;
+    void Resize(std::uint32_t width, std::uint32_t height) override;
+    void Composite(const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects) override;
+
+    /**
+     * @brief 测量在width x height的表面上合成draw_count次的平均耗时，单位为微秒，用于CompositorCostModel::Calibrate \n
+     * present为输出结果的函数，例如写入交换链，其耗时也计入测量结果
+     */
+    static auto MeasureMicroseconds(std::uint32_t width, std::uint32_t height, std::uint32_t draw_count, const PresentFunction& present = {})
+        -> double;
+
+    auto GetRenderer() noexcept
+        -> CSoftwareRenderer&;
+    auto GetTarget() const noexcept
+        -> const CBgraImage&;
+};
@@ -0,0 +1,86 @@
+#include "CCpuGpuTimerBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace
+{
+    constexpr std::uint64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+}
+
+bool CCpuGpuTimerBackend::IsSlotReady(const FrameSlot& slot) const noexcept
+{
+    return slot.m_sequence != 0 && slot.m_sequence <= m_completed_count;
+}
+
+void CCpuGpuTimerBackend::Complete(std::uint64_t count)
+{
+    m_completed_count = (std::max)(m_completed_count, (std::min)(count, m_submitted_count));
+}
+
+void CCpuGpuTimerBackend::CompleteAll()
+{
+    Complete(m_submitted_count);
+}
+
+auto CCpuGpuTimerBackend::GetSubmittedCount() const noexcept
+    -> std::uint64_t
+{
+    return m_submitted_count;
+}
+
+void CCpuGpuTimerBackend::MarkNextFrameDisjoint() noexcept
+{
+    m_is_next_frame_disjoint = true;
+}
+
+auto CCpuGpuTimerBackend::CreateFrameSlot(std::uint32_t timestamp_count)
+    -> std::uint32_t
+{
+    FrameSlot slot{};
+    slot.m_timestamps.resize(timestamp_count);
+    m_slots.push_back(std::move(slot));
+    return static_cast<std::uint32_t>(m_slots.size() - 1);
+}
+
+void CCpuGpuTimerBackend::BeginDisjoint(std::uint32_t slot)
+{
+    m_slots.at(slot).m_sequence = 0;
+}
+
+void CCpuGpuTimerBackend::EndDisjoint(std::uint32_t slot)
+{
+    auto& frame_slot = m_slots.at(slot);
+    ++m_submitted_count;
+    frame_slot.m_sequence = m_submitted_count;
+    frame_slot.m_is_disjoint = m_is_next_frame_disjoint;
+    m_is_next_frame_disjoint = false;
+}
+
+void CCpuGpuTimerBackend::WriteTimestamp(std::uint32_t slot, std::uint32_t index)
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    m_slots.at(slot).m_timestamps.at(index) = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+auto CCpuGpuTimerBackend::TryGetDisjoint(std::uint32_t slot)
+    -> std::optional<GpuTimestampDisjoint>
+{
+    const auto& frame_slot = m_slots.at(slot);
+    if (!IsSlotReady(frame_slot))
+    {
+        return std::nullopt;
+    }
+    return GpuTimestampDisjoint{NANOSECONDS_PER_SECOND, frame_slot.m_is_disjoint};
+}
+
+auto CCpuGpuTimerBackend::TryGetTimestamp(std::uint32_t slot, std::uint32_t index)
+    -> std::optional<std::uint64_t>
+{
+    const auto& frame_slot = m_slots.at(slot);
+    if (!IsSlotReady(frame_slot))
+    {
+        return std::nullopt;
+    }
+    return frame_slot.m_timestamps.at(index);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CGpuTimerRing.h"
+
+/**
+ * @brief 以CPU时钟代替GPU时间戳的计时后端，用于没有GPU的基准测试 \n
+ * 时间戳在写入时立即取得，但要等调用者用Complete模拟GPU执行完该帧后才能读取
+ */
+class CCpuGpuTimerBackend final : public IGpuTimerBackend
+{
+private:
+    struct FrameSlot
+    {
+        std::vector<std::uint64_t> m_timestamps{};
+        /**
+         * @brief 该帧结束时的提交序号，为0表示还没有结束
+         */
+        std::uint64_t m_sequence{};
+        bool m_is_disjoint{};
+    };
+
+    std::vector<FrameSlot> m_slots{};
+    std::uint64_t m_submitted_count{};
+    std::uint64_t m_completed_count{};
+    bool m_is_next_frame_disjoint{};
+
+    bool IsSlotReady(const FrameSlot& slot) const noexcept;
+
+public:
+    CCpuGpuTimerBackend() = default;
+    ~CCpuGpuTimerBackend() override = default;
+
+    /**
+     * @brief 模拟GPU执行完前count帧，count不会超过已结束的帧数
+     */
+    void Complete(std::uint64_t count);
+    void CompleteAll();
+    auto GetSubmittedCount() const noexcept
+        -> std::uint64_t;
+    /**
+     * @brief 下一个结束的帧报告时间戳不可比较
+     */
+    void MarkNextFrameDisjoint() noexcept;
+
+    auto CreateFrameSlot(std::uint32_t timestamp_count)
+        -> std::uint32_t override;
+    void BeginDisjoint(std::uint32_t slot) override;
+    void EndDisjoint(std::uint32_t slot) override;
+    void WriteTimestamp(std::uint32_t slot, std::uint32_t index) override;
+    auto TryGetDisjoint(std::uint32_t slot)
+        -> std::optional<GpuTimestampDisjoint> override;
+    auto TryGetTimestamp(std::uint32_t slot, std::uint32_t index)
+        -> std::optional<std::uint64_t> override;
+};
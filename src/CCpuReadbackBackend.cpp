@@ -0,0 +1,67 @@
+#include "CCpuReadbackBackend.h"
+#include <algorithm>
+#include <cstring>
+
+auto CCpuReadbackBackend::RegisterSource(const CBgraImage& source)
+    -> std::uint32_t
+{
+    m_sources.push_back(&source);
+    return static_cast<std::uint32_t>(m_sources.size() - 1);
+}
+
+void CCpuReadbackBackend::Complete(std::uint64_t count)
+{
+    m_completed_count = (std::max)(m_completed_count, (std::min)(count, m_submitted_count));
+}
+
+void CCpuReadbackBackend::CompleteAll()
+{
+    Complete(m_submitted_count);
+}
+
+auto CCpuReadbackBackend::GetSubmittedCount() const noexcept
+    -> std::uint64_t
+{
+    return m_submitted_count;
+}
+
+auto CCpuReadbackBackend::CreateStagingSlot(std::uint32_t width, std::uint32_t height)
+    -> std::uint32_t
+{
+    const auto row_size = width * CBgraImage::BYTES_PER_PIXEL;
+    const auto row_pitch = (row_size + ROW_PITCH_ALIGNMENT - 1) / ROW_PITCH_ALIGNMENT * ROW_PITCH_ALIGNMENT;
+    m_staging_slots.emplace_back(width, height, row_pitch);
+    m_slot_sequences.push_back(0);
+    return static_cast<std::uint32_t>(m_staging_slots.size() - 1);
+}
+
+void CCpuReadbackBackend::CopyToSlot(std::uint32_t slot, std::uint32_t source)
+{
+    // 复制的内容是命令流中此刻的源图像，只是完成状态推迟到Complete
+    auto& staging_slot = m_staging_slots.at(slot);
+    const auto& source_image = *m_sources.at(source);
+    const auto width = (std::min)(staging_slot.GetWidth(), source_image.GetWidth());
+    const auto height = (std::min)(staging_slot.GetHeight(), source_image.GetHeight());
+    for (std::uint32_t y = 0; y < height; ++y)
+    {
+        std::memcpy(staging_slot.GetRow(y), source_image.GetRow(y), static_cast<std::size_t>(width) * CBgraImage::BYTES_PER_PIXEL);
+    }
+    ++m_submitted_count;
+    m_slot_sequences[slot] = m_submitted_count;
+}
+
+bool CCpuReadbackBackend::IsSlotReady(std::uint32_t slot)
+{
+    return m_slot_sequences.at(slot) <= m_completed_count;
+}
+
+auto CCpuReadbackBackend::MapSlot(std::uint32_t slot)
+    -> MappedStagingBlock
+{
+    auto& staging_slot = m_staging_slots.at(slot);
+    return {staging_slot.GetData(), staging_slot.GetRowPitch()};
+}
+
+void CCpuReadbackBackend::UnmapSlot(std::uint32_t)
+{
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CBgraImage.h"
+#include "CReadbackRing.h"
+
+/**
+ * @brief 以内存图像作为暂存槽的读回后端，用于没有GPU的基准测试 \n
+ * 复制立即执行，但要等调用者用Complete模拟GPU执行到该命令后才算完成；暂存槽的行距按256字节对齐，与常见驱动一致
+ */
+class CCpuReadbackBackend final : public IReadbackBackend
+{
+public:
+    constexpr static std::uint32_t ROW_PITCH_ALIGNMENT = 256;
+
+private:
+    std::vector<CBgraImage> m_staging_slots{};
+    std::vector<std::uint64_t> m_slot_sequences{};
+    std::vector<const CBgraImage*> m_sources{};
+    std::uint64_t m_submitted_count{};
+    std::uint64_t m_completed_count{};
+
+public:
+    CCpuReadbackBackend() = default;
+    ~CCpuReadbackBackend() override = default;
+
+    /**
+     * @brief 登记源图像，返回的编号用作CReadbackRing::Request的source
+     */
+    auto RegisterSource(const CBgraImage& source)
+        -> std::uint32_t;
+    /**
+     * @brief 模拟GPU执行完前count个复制命令，count不会超过已提交的数量
+     */
+    void Complete(std::uint64_t count);
+    void CompleteAll();
+    auto GetSubmittedCount() const noexcept
+        -> std::uint64_t;
+
+    auto CreateStagingSlot(std::uint32_t width, std::uint32_t height)
+        -> std::uint32_t override;
+    void CopyToSlot(std::uint32_t slot, std::uint32_t source) override;
+    bool IsSlotReady(std::uint32_t slot) override;
+    auto MapSlot(std::uint32_t slot)
+        -> MappedStagingBlock override;
+    void UnmapSlot(std::uint32_t slot) override;
+};
@@ -0,0 +1,44 @@
+#include "CCpuUploadBackend.h"
+#include <cstring>
+
+auto CCpuUploadBackend::RegisterDestination(CBgraImage& destination)
+    -> std::uint32_t
+{
+    m_destinations.push_back(&destination);
+    return static_cast<std::uint32_t>(m_destinations.size() - 1);
+}
+
+auto CCpuUploadBackend::CreateStagingBlock(std::uint32_t width, std::uint32_t height)
+    -> std::uint32_t
+{
+    m_staging_blocks.emplace_back(width, height);
+    return static_cast<std::uint32_t>(m_staging_blocks.size() - 1);
+}
+
+auto CCpuUploadBackend::MapStagingBlock(std::uint32_t block)
+    -> MappedStagingBlock
+{
+    auto& staging_block = m_staging_blocks.at(block);
+    return {staging_block.GetData(), staging_block.GetRowPitch()};
+}
+
+void CCpuUploadBackend::UnmapStagingBlock(std::uint32_t)
+{
+}
+
+void CCpuUploadBackend::CopyRegions(std::uint32_t block, const UploadCopyRegion* p_regions, std::size_t count)
+{
+    const auto& staging_block = m_staging_blocks.at(block);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& region = p_regions[i];
+        auto& destination = *m_destinations.at(region.m_destination);
+        const auto row_size = static_cast<std::size_t>(region.m_width) * CBgraImage::BYTES_PER_PIXEL;
+        for (std::uint32_t row = 0; row < region.m_height; ++row)
+        {
+            std::memcpy(destination.GetPixel(region.m_destination_x, region.m_destination_y + row),
+                        staging_block.GetPixel(region.m_source_x, region.m_source_y + row),
+                        row_size);
+        }
+    }
+}
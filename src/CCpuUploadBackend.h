@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+#include "CBgraImage.h"
+#include "CUploadEngine.h"
+
+/**
+ * @brief 以内存图像作为暂存块和目标纹理的上传后端，用于没有GPU的基准测试
+ */
+class CCpuUploadBackend final : public IUploadBackend
+{
+private:
+    std::vector<CBgraImage> m_staging_blocks{};
+    std::vector<CBgraImage*> m_destinations{};
+
+public:
+    CCpuUploadBackend() = default;
+    ~CCpuUploadBackend() override = default;
+
+    /**
+     * @brief 登记目标图像，返回的编号用作CUploadEngine::Upload的destination
+     */
+    auto RegisterDestination(CBgraImage& destination)
+        -> std::uint32_t;
+
+    auto CreateStagingBlock(std::uint32_t width, std::uint32_t height)
+        -> std::uint32_t override;
+    auto MapStagingBlock(std::uint32_t block)
+        -> MappedStagingBlock override;
+    void UnmapStagingBlock(std::uint32_t block) override;
+    void CopyRegions(std::uint32_t block, const UploadCopyRegion* p_regions, std::size_t count) override;
+};
@@ -0,0 +1,69 @@
+#include "CD3D11ConstantBufferManager.h"
+#include <cstring>
+#include "HResultException.h"
+
+CD3D11ConstantBufferManager::CD3D11ConstantBufferManager(CD3D11ResourceManifest& manifest, const CD3D11ResourceRegistry& registry)
+    : m_manifest{manifest}, m_registry{registry}
+{
+}
+
+auto CD3D11ConstantBufferManager::Register(CConstantBufferBase& source)
+    -> BufferHandle
+{
+    const GpuBufferDescription description{static_cast<std::uint32_t>(source.GetSize()), GpuUsage::DYNAMIC, GpuBindFlag::CONSTANT_BUFFER, GpuCpuAccessFlag::WRITE};
+    const GpuSubresourceData initial_data{source.GetData(), 0};
+    const auto buffer = m_manifest.CreateBuffer(description, &initial_data);
+    source.ClearDirty();
+    m_entries.push_back({&source, buffer});
+    return buffer;
+}
+
+auto CD3D11ConstantBufferManager::Commit(ID3D11DeviceContext* p_device_context)
+    -> std::uint32_t
+{
+    ++m_statistics.m_commit_count;
+    std::uint32_t update_count = 0;
+    for (auto& entry : m_entries)
+    {
+        if (!entry.m_p_source->IsDirty())
+        {
+            continue;
+        }
+        auto* p_buffer = m_registry.Get(entry.m_buffer);
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        ThrowIfFailed(p_device_context->Map(p_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped),
+                      "Map constant buffer failed.");
+        std::memcpy(mapped.pData, entry.m_p_source->GetData(), entry.m_p_source->GetSize());
+        p_device_context->Unmap(p_buffer, 0);
+        entry.m_p_source->ClearDirty();
+        ++update_count;
+        m_statistics.m_bytes_updated += entry.m_p_source->GetSize();
+    }
+    m_statistics.m_update_count += update_count;
+    return update_count;
+}
+
+void CD3D11ConstantBufferManager::MarkAllDirty() noexcept
+{
+    for (auto& entry : m_entries)
+    {
+        entry.m_p_source->MarkDirty();
+    }
+}
+
+void CD3D11ConstantBufferManager::RecordToTrace(CFrameTraceWriter& writer) const
+{
+    for (const auto& entry : m_entries)
+    {
+        const auto* p_buffer = m_registry.Get(entry.m_buffer);
+        const auto size = static_cast<std::uint32_t>(entry.m_p_source->GetSize());
+        writer.Map(p_buffer, 0, D3D11_MAP_WRITE_DISCARD, {entry.m_p_source->GetData(), size});
+        writer.Unmap(p_buffer, 0);
+    }
+}
+
+auto CD3D11ConstantBufferManager::GetStatistics() const noexcept
+    -> const ConstantBufferStatistics&
+{
+    return m_statistics;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <d3d11.h>
+#include "CD3D11ResourceManifest.h"
+#include "CD3D11ResourceRegistry.h"
+#include "ConstantBuffer.h"
+
+struct ConstantBufferStatistics
+{
+    std::uint64_t m_commit_count{};
+    std::uint64_t m_update_count{};
+    std::uint64_t m_bytes_updated{};
+};
+
+/**
+ * @brief 为类型化常量缓冲区创建DYNAMIC缓冲区，每帧在绘制前用一次WRITE_DISCARD写入所有脏缓冲区
+ */
+class CD3D11ConstantBufferManager
+{
+private:
+    struct Entry
+    {
+        CConstantBufferBase* m_p_source{};
+        BufferHandle m_buffer{};
+    };
+
+    CD3D11ResourceManifest& m_manifest;
+    const CD3D11ResourceRegistry& m_registry;
+    std::vector<Entry> m_entries{};
+    ConstantBufferStatistics m_statistics{};
+
+public:
+    CD3D11ConstantBufferManager(CD3D11ResourceManifest& manifest, const CD3D11ResourceRegistry& registry);
+    ~CD3D11ConstantBufferManager() = default;
+
+    /**
+     * @brief 为source创建GPU缓冲区，source的生命周期必须长于本对象
+     */
+    auto Register(CConstantBufferBase& source)
+        -> BufferHandle;
+    /**
+     * @brief 把所有脏的常量缓冲区写入GPU
+     *
+     * @return 本次写入的缓冲区数量
+     */
+    auto Commit(ID3D11DeviceContext* p_device_context)
+        -> std::uint32_t;
+    /**
+     * @brief 设备丢失重建后缓冲区内容回到创建时的值，需要全部重新写入
+     */
+    void MarkAllDirty() noexcept;
+    /**
+     * @brief 把每个缓冲区的当前内容作为一次WRITE_DISCARD映射写入帧跟踪；Commit经由原始上下文映射，不会被捕获
+     */
+    void RecordToTrace(CFrameTraceWriter& writer) const;
+
+    auto GetStatistics() const noexcept
+        -> const ConstantBufferStatistics&;
+};
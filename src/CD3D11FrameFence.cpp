@@ -0,0 +1,65 @@
+#include "CD3D11FrameFence.h"
+
+CD3D11FrameFence::CD3D11FrameFence(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context, UINT max_frames_in_flight)
+{
+    m_queries.resize(max_frames_in_flight == 0 ? 1 : max_frames_in_flight);
+    Recreate(p_device, p_device_context);
+}
+
+void CD3D11FrameFence::Recreate(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context)
+{
+    m_p_device_context = p_device_context;
+    m_completed_value = m_next_value - 1;
+    D3D11_QUERY_DESC query_desc{};
+    query_desc.Query = D3D11_QUERY_EVENT;
+    query_desc.MiscFlags = 0;
+    for (auto& p_query : m_queries)
+    {
+        ThrowIfFailed(p_device->CreateQuery(&query_desc, p_query.ReleaseAndGetAddressOf()));
+    }
+}
+
+bool CD3D11FrameFence::PollQuery(std::uint64_t value, UINT flags)
+{
+    BOOL is_done = FALSE;
+    auto* p_query = m_queries[value % m_queries.size()].Get();
+    if (m_p_device_context->GetData(p_query, &is_done, sizeof(is_done), flags) == S_OK && is_done)
+    {
+        m_completed_value = value;
+        return true;
+    }
+    return false;
+}
+
+auto CD3D11FrameFence::GetNextValue() const noexcept
+    -> std::uint64_t
+{
+    return m_next_value;
+}
+
+auto CD3D11FrameFence::Signal()
+    -> std::uint64_t
+{
+    // 环形队列已满时最早的查询还未完成，只能等待它
+    const auto oldest_value = m_next_value - m_queries.size();
+    while (m_next_value > m_queries.size() && m_completed_value < oldest_value)
+    {
+        if (!PollQuery(m_completed_value + 1, 0))
+        {
+            ::SwitchToThread();
+        }
+    }
+    const auto result = m_next_value++;
+    m_p_device_context->End(m_queries[result % m_queries.size()].Get());
+    return result;
+}
+
+auto CD3D11FrameFence::GetCompletedValue()
+    -> std::uint64_t
+{
+    // 查询按顺序完成，依次检查直到遇到未完成的
+    while (m_completed_value + 1 < m_next_value && PollQuery(m_completed_value + 1, D3D11_ASYNC_GETDATA_DONOTFLUSH))
+    {
+    }
+    return m_completed_value;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <wrl/client.h>
+#include <d3d11.h>
+#include "FrameFence.h"
+#include "HResultException.h"
+
+/**
+ * @brief 用D3D11_QUERY_EVENT环形队列实现的帧栅栏，D3D11设备没有原生的ID3D11Fence可用时使用
+ */
+class CD3D11FrameFence final : public IFrameFence
+{
+private:
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_p_device_context{};
+    std::vector<Microsoft::WRL::ComPtr<ID3D11Query>> m_queries{};
+    std::uint64_t m_next_value{1};
+    std::uint64_t m_completed_value{0};
+
+    bool PollQuery(std::uint64_t value, UINT flags);
+
+public:
+    /**
+     * @brief 构造帧栅栏
+     *
+     * @param max_frames_in_flight 最多同时在途的帧数，超过时Signal会等待最早的一帧完成
+     */
+    CD3D11FrameFence(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context, UINT max_frames_in_flight = 4);
+    ~CD3D11FrameFence() override = default;
+
+    /**
+     * @brief 设备丢失后在新设备上重建查询，旧设备上在途的栅栏全部视为已完成，栅栏值继续递增
+     */
+    void Recreate(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context);
+
+    auto GetNextValue() const noexcept
+        -> std::uint64_t override;
+    auto Signal()
+        -> std::uint64_t override;
+    auto GetCompletedValue()
+        -> std::uint64_t override;
+};
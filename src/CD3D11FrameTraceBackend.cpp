@@ -0,0 +1,315 @@
+#include "CD3D11FrameTraceBackend.h"
+#include <cstring>
+#include <stdexcept>
+#include "D3D11Description.h"
+
+using Microsoft::WRL::ComPtr;
+
+static_assert(sizeof(MockViewport) == sizeof(D3D11_VIEWPORT) && sizeof(MockBox) == sizeof(D3D11_BOX));
+
+CD3D11FrameTraceBackend::CD3D11FrameTraceBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context)
+    : m_p_device{p_device}, m_p_device_context{p_device_context}
+{
+    D3D11_QUERY_DESC query_desc{};
+    query_desc.Query = D3D11_QUERY_EVENT;
+    ThrowIfFailed(m_p_device->CreateQuery(&query_desc, &m_p_finish_query));
+}
+
+void CD3D11FrameTraceBackend::Reset(std::uint32_t object_count)
+{
+    m_p_device_context->ClearState();
+    m_p_objects.clear();
+    m_p_objects.resize(std::size_t{object_count} + 1);
+}
+
+void CD3D11FrameTraceBackend::CreateBuffer(std::uint32_t id, const GpuBufferDescription& description, const void* p_initial_data)
+{
+    const auto buffer_desc = D3D11Description::From(description);
+    D3D11_SUBRESOURCE_DATA initial_data{};
+    initial_data.pSysMem = p_initial_data;
+    ComPtr<ID3D11Buffer> p_buffer{};
+    ThrowIfFailed(m_p_device->CreateBuffer(&buffer_desc, p_initial_data != nullptr ? &initial_data : NULL, &p_buffer));
+    SetObject(id, p_buffer);
+}
+
+void CD3D11FrameTraceBackend::CreateTexture2D(std::uint32_t id, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data)
+{
+    const auto texture_desc = D3D11Description::From(description);
+    std::vector<D3D11_SUBRESOURCE_DATA> initial_data{};
+    if (p_initial_data != nullptr)
+    {
+        initial_data = D3D11Description::From(std::span{p_initial_data, std::size_t{description.m_mip_levels} * description.m_array_size});
+    }
+    ComPtr<ID3D11Texture2D> p_texture{};
+    ThrowIfFailed(m_p_device->CreateTexture2D(&texture_desc, initial_data.empty() ? NULL : initial_data.data(), &p_texture));
+    SetObject(id, p_texture);
+}
+
+void CD3D11FrameTraceBackend::CreateView(std::uint32_t id, MockObjectType type, std::uint32_t resource_id)
+{
+    auto* p_resource = GetObject<ID3D11Texture2D>(resource_id);
+    if (p_resource == nullptr)
+    {
+        // 视图所属的资源不在跟踪中（例如交换链的后备缓冲），视图同样回放为空
+        return;
+    }
+    if (type == MockObjectType::ShaderResourceView)
+    {
+        ComPtr<ID3D11ShaderResourceView> p_view{};
+        ThrowIfFailed(m_p_device->CreateShaderResourceView(p_resource, NULL, &p_view));
+        SetObject(id, p_view);
+    }
+    else if (type == MockObjectType::RenderTargetView)
+    {
+        ComPtr<ID3D11RenderTargetView> p_view{};
+        ThrowIfFailed(m_p_device->CreateRenderTargetView(p_resource, NULL, &p_view));
+        SetObject(id, p_view);
+    }
+    else
+    {
+        throw std::invalid_argument{"Frame trace view type is invalid."};
+    }
+}
+
+void CD3D11FrameTraceBackend::CreateShader(std::uint32_t id, MockObjectType type, std::span<const std::uint8_t> byte_code)
+{
+    switch (type)
+    {
+    case MockObjectType::VertexShader:
+    {
+        ComPtr<ID3D11VertexShader> p_shader{};
+        ThrowIfFailed(m_p_device->CreateVertexShader(byte_code.data(), byte_code.size(), NULL, &p_shader));
+        SetObject(id, p_shader);
+        break;
+    }
+    case MockObjectType::GeometryShader:
+    {
+        ComPtr<ID3D11GeometryShader> p_shader{};
+        ThrowIfFailed(m_p_device->CreateGeometryShader(byte_code.data(), byte_code.size(), NULL, &p_shader));
+        SetObject(id, p_shader);
+        break;
+    }
+    case MockObjectType::PixelShader:
+    {
+        ComPtr<ID3D11PixelShader> p_shader{};
+        ThrowIfFailed(m_p_device->CreatePixelShader(byte_code.data(), byte_code.size(), NULL, &p_shader));
+        SetObject(id, p_shader);
+        break;
+    }
+    default:
+        throw std::invalid_argument{"Frame trace shader type is invalid."};
+    }
+}
+
+void CD3D11FrameTraceBackend::CreateInputLayout(std::uint32_t id, std::span<const GpuInputElementDescription> elements, std::span<const std::uint8_t> byte_code)
+{
+    const auto input_elements = D3D11Description::From(elements);
+    ComPtr<ID3D11InputLayout> p_input_layout{};
+    ThrowIfFailed(m_p_device->CreateInputLayout(
+        input_elements.data(),
+        static_cast<UINT>(input_elements.size()),
+        byte_code.data(),
+        byte_code.size(),
+        &p_input_layout));
+    SetObject(id, p_input_layout);
+}
+
+void CD3D11FrameTraceBackend::CreateSamplerState(std::uint32_t id, const GpuSamplerDescription& description)
+{
+    const auto sampler_desc = D3D11Description::From(description);
+    ComPtr<ID3D11SamplerState> p_sampler_state{};
+    ThrowIfFailed(m_p_device->CreateSamplerState(&sampler_desc, &p_sampler_state));
+    SetObject(id, p_sampler_state);
+}
+
+void CD3D11FrameTraceBackend::CreateBlendState(std::uint32_t id, const GpuBlendDescription& description)
+{
+    const auto blend_desc = D3D11Description::From(description);
+    ComPtr<ID3D11BlendState> p_blend_state{};
+    ThrowIfFailed(m_p_device->CreateBlendState(&blend_desc, &p_blend_state));
+    SetObject(id, p_blend_state);
+}
+
+void CD3D11FrameTraceBackend::CreateRasterizerState(std::uint32_t id, const GpuRasterizerDescription& description)
+{
+    const auto rasterizer_desc = D3D11Description::From(description);
+    ComPtr<ID3D11RasterizerState> p_rasterizer_state{};
+    ThrowIfFailed(m_p_device->CreateRasterizerState(&rasterizer_desc, &p_rasterizer_state));
+    SetObject(id, p_rasterizer_state);
+}
+
+void CD3D11FrameTraceBackend::CreateDepthStencilState(std::uint32_t id, const GpuDepthStencilDescription& description)
+{
+    const auto depth_stencil_desc = D3D11Description::From(description);
+    ComPtr<ID3D11DepthStencilState> p_depth_stencil_state{};
+    ThrowIfFailed(m_p_device->CreateDepthStencilState(&depth_stencil_desc, &p_depth_stencil_state));
+    SetObject(id, p_depth_stencil_state);
+}
+
+void CD3D11FrameTraceBackend::IASetPrimitiveTopology(std::uint32_t topology)
+{
+    m_p_device_context->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(topology));
+}
+
+void CD3D11FrameTraceBackend::IASetInputLayout(std::uint32_t input_layout)
+{
+    m_p_device_context->IASetInputLayout(GetObject<ID3D11InputLayout>(input_layout));
+}
+
+void CD3D11FrameTraceBackend::IASetVertexBuffers(std::uint32_t start_slot, std::span<const std::uint32_t> buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets)
+{
+    m_p_device_context->IASetVertexBuffers(start_slot, static_cast<UINT>(buffers.size()), GetObjects<ID3D11Buffer>(buffers), p_strides, p_offsets);
+}
+
+void CD3D11FrameTraceBackend::IASetIndexBuffer(std::uint32_t index_buffer, std::uint32_t format, std::uint32_t offset)
+{
+    m_p_device_context->IASetIndexBuffer(GetObject<ID3D11Buffer>(index_buffer), static_cast<DXGI_FORMAT>(format), offset);
+}
+
+void CD3D11FrameTraceBackend::SetShader(MockObjectType stage, std::uint32_t shader)
+{
+    switch (stage)
+    {
+    case MockObjectType::VertexShader:
+        m_p_device_context->VSSetShader(GetObject<ID3D11VertexShader>(shader), NULL, 0);
+        break;
+    case MockObjectType::GeometryShader:
+        m_p_device_context->GSSetShader(GetObject<ID3D11GeometryShader>(shader), NULL, 0);
+        break;
+    case MockObjectType::PixelShader:
+        m_p_device_context->PSSetShader(GetObject<ID3D11PixelShader>(shader), NULL, 0);
+        break;
+    default:
+        throw std::invalid_argument{"Frame trace shader stage is invalid."};
+    }
+}
+
+void CD3D11FrameTraceBackend::SetObjects(FrameTraceOpcode opcode, std::uint32_t start_slot, std::span<const std::uint32_t> objects)
+{
+    const auto count = static_cast<UINT>(objects.size());
+    switch (opcode)
+    {
+    case FrameTraceOpcode::VSSetConstantBuffers:
+        m_p_device_context->VSSetConstantBuffers(start_slot, count, GetObjects<ID3D11Buffer>(objects));
+        break;
+    case FrameTraceOpcode::PSSetConstantBuffers:
+        m_p_device_context->PSSetConstantBuffers(start_slot, count, GetObjects<ID3D11Buffer>(objects));
+        break;
+    case FrameTraceOpcode::PSSetShaderResources:
+        m_p_device_context->PSSetShaderResources(start_slot, count, GetObjects<ID3D11ShaderResourceView>(objects));
+        break;
+    case FrameTraceOpcode::PSSetSamplers:
+        m_p_device_context->PSSetSamplers(start_slot, count, GetObjects<ID3D11SamplerState>(objects));
+        break;
+    default:
+        throw std::invalid_argument{"Frame trace binding opcode is invalid."};
+    }
+}
+
+void CD3D11FrameTraceBackend::RSSetState(std::uint32_t rasterizer_state)
+{
+    m_p_device_context->RSSetState(GetObject<ID3D11RasterizerState>(rasterizer_state));
+}
+
+void CD3D11FrameTraceBackend::RSSetViewports(std::span<const MockViewport> viewports)
+{
+    m_p_device_context->RSSetViewports(static_cast<UINT>(viewports.size()), reinterpret_cast<const D3D11_VIEWPORT*>(viewports.data()));
+}
+
+void CD3D11FrameTraceBackend::OMSetBlendState(std::uint32_t blend_state, const float* p_blend_factor, std::uint32_t sample_mask)
+{
+    m_p_device_context->OMSetBlendState(GetObject<ID3D11BlendState>(blend_state), p_blend_factor, sample_mask);
+}
+
+void CD3D11FrameTraceBackend::OMSetDepthStencilState(std::uint32_t depth_stencil_state, std::uint32_t stencil_ref)
+{
+    m_p_device_context->OMSetDepthStencilState(GetObject<ID3D11DepthStencilState>(depth_stencil_state), stencil_ref);
+}
+
+void CD3D11FrameTraceBackend::OMSetRenderTargets(std::span<const std::uint32_t> render_target_views, std::uint32_t depth_stencil_view)
+{
+    m_p_device_context->OMSetRenderTargets(
+        static_cast<UINT>(render_target_views.size()),
+        GetObjects<ID3D11RenderTargetView>(render_target_views),
+        GetObject<ID3D11DepthStencilView>(depth_stencil_view));
+}
+
+void CD3D11FrameTraceBackend::SOSetTargets(std::uint32_t target_count)
+{
+    m_p_device_context->SOSetTargets(target_count, NULL, NULL);
+}
+
+void CD3D11FrameTraceBackend::Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location)
+{
+    m_p_device_context->Draw(vertex_count, start_vertex_location);
+}
+
+void CD3D11FrameTraceBackend::DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location)
+{
+    m_p_device_context->DrawIndexed(index_count, start_index_location, base_vertex_location);
+}
+
+void CD3D11FrameTraceBackend::UpdateSubresource(std::uint32_t resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch)
+{
+    auto* p_resource = GetObject<ID3D11Resource>(resource);
+    if (p_resource != nullptr)
+    {
+        m_p_device_context->UpdateSubresource(p_resource, subresource, reinterpret_cast<const D3D11_BOX*>(p_box), p_source, row_pitch, 0);
+    }
+}
+
+void CD3D11FrameTraceBackend::MapAndUnmap(std::uint32_t resource, std::uint32_t subresource, std::uint32_t map_type, const void* p_written_data, std::uint32_t row_pitch, std::uint32_t size)
+{
+    auto* p_resource = GetObject<ID3D11Resource>(resource);
+    if (p_resource == nullptr)
+    {
+        return;
+    }
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    ThrowIfFailed(m_p_device_context->Map(p_resource, subresource, static_cast<D3D11_MAP>(map_type), 0, &mapped));
+    if (p_written_data != nullptr && row_pitch != 0)
+    {
+        const auto* p_source = static_cast<const std::uint8_t*>(p_written_data);
+        auto* p_destination = static_cast<std::uint8_t*>(mapped.pData);
+        for (std::uint32_t offset = 0; offset + row_pitch <= size; offset += row_pitch)
+        {
+            std::memcpy(p_destination, p_source + offset, row_pitch);
+            p_destination += mapped.RowPitch;
+        }
+    }
+    m_p_device_context->Unmap(p_resource, subresource);
+}
+
+void CD3D11FrameTraceBackend::CopyResource(std::uint32_t destination, std::uint32_t source)
+{
+    auto* p_destination = GetObject<ID3D11Resource>(destination);
+    auto* p_source = GetObject<ID3D11Resource>(source);
+    if (p_destination != nullptr && p_source != nullptr)
+    {
+        m_p_device_context->CopyResource(p_destination, p_source);
+    }
+}
+
+void CD3D11FrameTraceBackend::ClearRenderTargetView(std::uint32_t render_target_view, const float color[4])
+{
+    auto* p_render_target_view = GetObject<ID3D11RenderTargetView>(render_target_view);
+    if (p_render_target_view != nullptr)
+    {
+        m_p_device_context->ClearRenderTargetView(p_render_target_view, color);
+    }
+}
+
+void CD3D11FrameTraceBackend::Flush()
+{
+    m_p_device_context->Flush();
+}
+
+void CD3D11FrameTraceBackend::Finish()
+{
+    m_p_device_context->End(m_p_finish_query.Get());
+    BOOL is_done = FALSE;
+    while (m_p_device_context->GetData(m_p_finish_query.Get(), &is_done, sizeof(is_done), 0) != S_OK || !is_done)
+    {
+        ::SwitchToThread();
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <wrl/client.h>
+#include <d3d11.h>
+#include "FrameTrace.h"
+#include "HResultException.h"
+
+/**
+ * @brief 在真实的D3D11设备上回放帧跟踪，描述中没有记录的字段取D3D11的默认值 \n
+ * Finish插入事件查询并等待GPU执行完毕，回放的每帧耗时包含GPU时间
+ */
+class CD3D11FrameTraceBackend final : public IFrameTraceBackend
+{
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device> m_p_device{};
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_p_device_context{};
+    Microsoft::WRL::ComPtr<ID3D11Query> m_p_finish_query{};
+    /**
+     * @brief 下标为跟踪中的对象编号，0始终为空；各种接口都以单继承派生自ID3D11DeviceChild
+     */
+    std::vector<Microsoft::WRL::ComPtr<ID3D11DeviceChild>> m_p_objects{};
+    std::vector<ID3D11DeviceChild*> m_p_scratch_objects{};
+
+    template <class T>
+    auto GetObject(std::uint32_t id) const
+        -> T*
+    {
+        if (id >= m_p_objects.size())
+        {
+            throw std::out_of_range{"Frame trace object id is out of range."};
+        }
+        return static_cast<T*>(m_p_objects[id].Get());
+    }
+    template <class T>
+    auto GetObjects(std::span<const std::uint32_t> ids)
+        -> T* const*
+    {
+        m_p_scratch_objects.resize(ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            m_p_scratch_objects[i] = GetObject<ID3D11DeviceChild>(ids[i]);
+        }
+        return ids.empty() ? nullptr : reinterpret_cast<T* const*>(m_p_scratch_objects.data());
+    }
+    template <class T>
+    void SetObject(std::uint32_t id, const Microsoft::WRL::ComPtr<T>& p_object)
+    {
+        if (id == 0 || id >= m_p_objects.size())
+        {
+            throw std::out_of_range{"Frame trace object id is out of range."};
+        }
+        m_p_objects[id] = p_object;
+    }
+
+public:
+    CD3D11FrameTraceBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context);
+    ~CD3D11FrameTraceBackend() override = default;
+
+    void Reset(std::uint32_t object_count) override;
+    void CreateBuffer(std::uint32_t id, const GpuBufferDescription& description, const void* p_initial_data) override;
+    void CreateTexture2D(std::uint32_t id, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data) override;
+    void CreateView(std::uint32_t id, MockObjectType type, std::uint32_t resource_id) override;
+    void CreateShader(std::uint32_t id, MockObjectType type, std::span<const std::uint8_t> byte_code) override;
+    void CreateInputLayout(std::uint32_t id, std::span<const GpuInputElementDescription> elements, std::span<const std::uint8_t> byte_code) override;
+    void CreateSamplerState(std::uint32_t id, const GpuSamplerDescription& description) override;
+    void CreateBlendState(std::uint32_t id, const GpuBlendDescription& description) override;
+    void CreateRasterizerState(std::uint32_t id, const GpuRasterizerDescription& description) override;
+    void CreateDepthStencilState(std::uint32_t id, const GpuDepthStencilDescription& description) override;
+
+    void IASetPrimitiveTopology(std::uint32_t topology) override;
+    void IASetInputLayout(std::uint32_t input_layout) override;
+    void IASetVertexBuffers(std::uint32_t start_slot, std::span<const std::uint32_t> buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets) override;
+    void IASetIndexBuffer(std::uint32_t index_buffer, std::uint32_t format, std::uint32_t offset) override;
+    void SetShader(MockObjectType stage, std::uint32_t shader) override;
+    void SetObjects(FrameTraceOpcode opcode, std::uint32_t start_slot, std::span<const std::uint32_t> objects) override;
+    void RSSetState(std::uint32_t rasterizer_state) override;
+    void RSSetViewports(std::span<const MockViewport> viewports) override;
+    void OMSetBlendState(std::uint32_t blend_state, const float* p_blend_factor, std::uint32_t sample_mask) override;
+    void OMSetDepthStencilState(std::uint32_t depth_stencil_state, std::uint32_t stencil_ref) override;
+    void OMSetRenderTargets(std::span<const std::uint32_t> render_target_views, std::uint32_t depth_stencil_view) override;
+    void SOSetTargets(std::uint32_t target_count) override;
+    void Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location) override;
+    void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location) override;
+    void UpdateSubresource(std::uint32_t resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch) override;
+    void MapAndUnmap(std::uint32_t resource, std::uint32_t subresource, std::uint32_t map_type, const void* p_written_data, std::uint32_t row_pitch, std::uint32_t size) override;
+    void CopyResource(std::uint32_t destination, std::uint32_t source) override;
+    void ClearRenderTargetView(std::uint32_t render_target_view, const float color[4]) override;
+    void Flush() override;
+    void Finish() override;
+};
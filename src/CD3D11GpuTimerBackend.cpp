@@ -0,0 +1,76 @@
+#include "CD3D11GpuTimerBackend.h"
+
+CD3D11GpuTimerBackend::CD3D11GpuTimerBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context)
+    : m_p_device{p_device}, m_p_device_context{p_device_context}
+{
+}
+
+void CD3D11GpuTimerBackend::CreateQueries(FrameSlot& slot)
+{
+    D3D11_QUERY_DESC query_description{};
+    query_description.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    ThrowIfFailed(m_p_device->CreateQuery(&query_description, slot.m_p_disjoint_query.ReleaseAndGetAddressOf()));
+    query_description.Query = D3D11_QUERY_TIMESTAMP;
+    for (auto& p_query : slot.m_timestamp_queries)
+    {
+        ThrowIfFailed(m_p_device->CreateQuery(&query_description, p_query.ReleaseAndGetAddressOf()));
+    }
+}
+
+void CD3D11GpuTimerBackend::Recreate(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context)
+{
+    m_p_device = p_device;
+    m_p_device_context = p_device_context;
+    for (auto& slot : m_slots)
+    {
+        CreateQueries(slot);
+    }
+}
+
+auto CD3D11GpuTimerBackend::CreateFrameSlot(std::uint32_t timestamp_count)
+    -> std::uint32_t
+{
+    FrameSlot slot{};
+    slot.m_timestamp_queries.resize(timestamp_count);
+    CreateQueries(slot);
+    m_slots.push_back(std::move(slot));
+    return static_cast<std::uint32_t>(m_slots.size() - 1);
+}
+
+void CD3D11GpuTimerBackend::BeginDisjoint(std::uint32_t slot)
+{
+    m_p_device_context->Begin(m_slots.at(slot).m_p_disjoint_query.Get());
+}
+
+void CD3D11GpuTimerBackend::EndDisjoint(std::uint32_t slot)
+{
+    m_p_device_context->End(m_slots.at(slot).m_p_disjoint_query.Get());
+}
+
+void CD3D11GpuTimerBackend::WriteTimestamp(std::uint32_t slot, std::uint32_t index)
+{
+    // 时间戳查询没有Begin，End即写入
+    m_p_device_context->End(m_slots.at(slot).m_timestamp_queries.at(index).Get());
+}
+
+auto CD3D11GpuTimerBackend::TryGetDisjoint(std::uint32_t slot)
+    -> std::optional<GpuTimestampDisjoint>
+{
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT data{};
+    if (m_p_device_context->GetData(m_slots.at(slot).m_p_disjoint_query.Get(), &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+    {
+        return std::nullopt;
+    }
+    return GpuTimestampDisjoint{data.Frequency, data.Disjoint != FALSE};
+}
+
+auto CD3D11GpuTimerBackend::TryGetTimestamp(std::uint32_t slot, std::uint32_t index)
+    -> std::optional<std::uint64_t>
+{
+    UINT64 timestamp{};
+    if (m_p_device_context->GetData(m_slots.at(slot).m_timestamp_queries.at(index).Get(), &timestamp, sizeof(timestamp), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+    {
+        return std::nullopt;
+    }
+    return timestamp;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <wrl/client.h>
+#include <d3d11.h>
+#include "CGpuTimerRing.h"
+#include "HResultException.h"
+
+/**
+ * @brief 用D3D11_QUERY_TIMESTAMP_DISJOINT和D3D11_QUERY_TIMESTAMP实现的计时后端 \n
+ * 查询发到构造时传入的上下文上，不经过被装饰的渲染上下文，所以不会计入调用统计或帧跟踪
+ */
+class CD3D11GpuTimerBackend final : public IGpuTimerBackend
+{
+private:
+    struct FrameSlot
+    {
+        Microsoft::WRL::ComPtr<ID3D11Query> m_p_disjoint_query{};
+        std::vector<Microsoft::WRL::ComPtr<ID3D11Query>> m_timestamp_queries{};
+    };
+
+    Microsoft::WRL::ComPtr<ID3D11Device> m_p_device{};
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_p_device_context{};
+    std::vector<FrameSlot> m_slots{};
+
+    void CreateQueries(FrameSlot& slot);
+
+public:
+    CD3D11GpuTimerBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context);
+    ~CD3D11GpuTimerBackend() override = default;
+
+    /**
+     * @brief 设备丢失后在新设备上重建全部查询，之后应调用CGpuTimerRing::DiscardPending
+     */
+    void Recreate(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context);
+
+    auto CreateFrameSlot(std::uint32_t timestamp_count)
+        -> std::uint32_t override;
+    void BeginDisjoint(std::uint32_t slot) override;
+    void EndDisjoint(std::uint32_t slot) override;
+    void WriteTimestamp(std::uint32_t slot, std::uint32_t index) override;
+    auto TryGetDisjoint(std::uint32_t slot)
+        -> std::optional<GpuTimestampDisjoint> override;
+    auto TryGetTimestamp(std::uint32_t slot, std::uint32_t index)
+        -> std::optional<std::uint64_t> override;
+};
@@ -0,0 +1,78 @@
+#include "CD3D11ReadbackBackend.h"
+#include <stdexcept>
+
+CD3D11ReadbackBackend::CD3D11ReadbackBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context, const CD3D11ResourceRegistry& registry, DXGI_FORMAT format, CGpuMemoryBudget* p_memory_budget)
+    : m_p_device{p_device}, m_p_device_context{p_device_context}, m_registry{registry}, m_format{format}, m_p_memory_budget{p_memory_budget}
+{
+}
+
+auto CD3D11ReadbackBackend::CreateStagingSlot(std::uint32_t width, std::uint32_t height)
+    -> std::uint32_t
+{
+    D3D11_TEXTURE2D_DESC description{};
+    description.Width = width;
+    description.Height = height;
+    description.MipLevels = 1;
+    description.ArraySize = 1;
+    description.Format = m_format;
+    description.SampleDesc.Count = 1;
+    description.Usage = D3D11_USAGE_STAGING;
+    description.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    CGpuMemoryReservation reservation{m_p_memory_budget, GpuMemoryCategory::Staging, EstimateTexture2DBytes(width, height, m_format, 1, 1)};
+    StagingSlot staging_slot{};
+    ThrowIfFailed(m_p_device->CreateTexture2D(&description, NULL, &staging_slot.m_p_texture));
+    D3D11_QUERY_DESC query_description{};
+    query_description.Query = D3D11_QUERY_EVENT;
+    ThrowIfFailed(m_p_device->CreateQuery(&query_description, &staging_slot.m_p_copy_done_query));
+    staging_slot.m_width = width;
+    staging_slot.m_height = height;
+    m_staging_slots.push_back(std::move(staging_slot));
+    m_reservations.push_back(std::move(reservation));
+    return static_cast<std::uint32_t>(m_staging_slots.size() - 1);
+}
+
+void CD3D11ReadbackBackend::CopyToSlot(std::uint32_t slot, std::uint32_t source)
+{
+    auto& staging_slot = m_staging_slots.at(slot);
+    auto* p_source = m_registry.Get(TextureHandle{source});
+    if (p_source == nullptr)
+    {
+        throw std::invalid_argument{"Source texture of readback does not exist."};
+    }
+    D3D11_BOX source_box{};
+    source_box.right = staging_slot.m_width;
+    source_box.bottom = staging_slot.m_height;
+    source_box.back = 1;
+    m_p_device_context->CopySubresourceRegion(staging_slot.m_p_texture.Get(), 0, 0, 0, 0, p_source, 0, &source_box);
+    m_p_device_context->End(staging_slot.m_p_copy_done_query.Get());
+}
+
+bool CD3D11ReadbackBackend::IsSlotReady(std::uint32_t slot)
+{
+    // 不刷新命令缓冲区，复制命令随本帧的Present一起提交
+    return m_p_device_context->GetData(
+               m_staging_slots.at(slot).m_p_copy_done_query.Get(),
+               NULL,
+               0,
+               D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK;
+}
+
+auto CD3D11ReadbackBackend::MapSlot(std::uint32_t slot)
+    -> MappedStagingBlock
+{
+    // 事件查询已完成，DO_NOT_WAIT用于发现违反这一约定的情况
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    ThrowIfFailed(m_p_device_context->Map(
+                      m_staging_slots.at(slot).m_p_texture.Get(),
+                      0,
+                      D3D11_MAP_READ,
+                      D3D11_MAP_FLAG_DO_NOT_WAIT,
+                      &mapped),
+                  "Map staging texture of readback ring failed.");
+    return {static_cast<std::uint8_t*>(mapped.pData), mapped.RowPitch};
+}
+
+void CD3D11ReadbackBackend::UnmapSlot(std::uint32_t slot)
+{
+    m_p_device_context->Unmap(m_staging_slots.at(slot).m_p_texture.Get(), 0);
+}
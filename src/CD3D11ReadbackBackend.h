@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <wrl/client.h>
+#include <d3d11.h>
+#include "CD3D11ResourceRegistry.h"
+#include "CGpuMemoryBudget.h"
+#include "CReadbackRing.h"
+#include "HResultException.h"
+
+/**
+ * @brief 以STAGING纹理作为暂存槽、以事件查询判断复制是否完成的读回后端 \n
+ * 源编号即CD3D11ResourceRegistry中纹理句柄的值
+ */
+class CD3D11ReadbackBackend final : public IReadbackBackend
+{
+private:
+    struct StagingSlot
+    {
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> m_p_texture{};
+        Microsoft::WRL::ComPtr<ID3D11Query> m_p_copy_done_query{};
+        std::uint32_t m_width{};
+        std::uint32_t m_height{};
+    };
+
+    Microsoft::WRL::ComPtr<ID3D11Device> m_p_device{};
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_p_device_context{};
+    const CD3D11ResourceRegistry& m_registry;
+    DXGI_FORMAT m_format{};
+    CGpuMemoryBudget* m_p_memory_budget{};
+    std::vector<CGpuMemoryReservation> m_reservations{};
+    std::vector<StagingSlot> m_staging_slots{};
+
+public:
+    /**
+     * @param p_memory_budget 不为空时暂存纹理在其中按STAGING类别记账
+     */
+    CD3D11ReadbackBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context, const CD3D11ResourceRegistry& registry, DXGI_FORMAT format, CGpuMemoryBudget* p_memory_budget = nullptr);
+    ~CD3D11ReadbackBackend() override = default;
+
+    auto CreateStagingSlot(std::uint32_t width, std::uint32_t height)
+        -> std::uint32_t override;
+    void CopyToSlot(std::uint32_t slot, std::uint32_t source) override;
+    bool IsSlotReady(std::uint32_t slot) override;
+    auto MapSlot(std::uint32_t slot)
+        -> MappedStagingBlock override;
+    void UnmapSlot(std::uint32_t slot) override;
+};
@@ -0,0 +1,187 @@
+#include "CD3D11ResourceManifest.h"
+#include <stdexcept>
+#include <type_traits>
+#include "D3D11Description.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+    template <class T>
+    auto AsUnknown(ComPtr<T>& p_object)
+        -> ComPtr<IUnknown>
+    {
+        ComPtr<IUnknown> result{};
+        ThrowIfFailed(p_object.As(&result));
+        return result;
+    }
+
+    /**
+     * @brief 以条目的种类选择登记表中的对象类型，对该类型调用function
+     */
+    template <class Function>
+    decltype(auto) VisitKind(ManifestResourceKind kind, Function&& function)
+    {
+        switch (kind)
+        {
+        case ManifestResourceKind::Buffer:
+            return function(static_cast<ID3D11Buffer*>(nullptr));
+        case ManifestResourceKind::Texture2D:
+            return function(static_cast<ID3D11Texture2D*>(nullptr));
+        case ManifestResourceKind::VertexShader:
+            return function(static_cast<ID3D11VertexShader*>(nullptr));
+        case ManifestResourceKind::PixelShader:
+            return function(static_cast<ID3D11PixelShader*>(nullptr));
+        case ManifestResourceKind::InputLayout:
+            return function(static_cast<ID3D11InputLayout*>(nullptr));
+        case ManifestResourceKind::SamplerState:
+            return function(static_cast<ID3D11SamplerState*>(nullptr));
+        case ManifestResourceKind::RasterizerState:
+            return function(static_cast<ID3D11RasterizerState*>(nullptr));
+        case ManifestResourceKind::BlendState:
+            return function(static_cast<ID3D11BlendState*>(nullptr));
+        case ManifestResourceKind::DepthStencilState:
+            return function(static_cast<ID3D11DepthStencilState*>(nullptr));
+        case ManifestResourceKind::ShaderResourceView:
+            return function(static_cast<ID3D11ShaderResourceView*>(nullptr));
+        case ManifestResourceKind::RenderTargetView:
+            return function(static_cast<ID3D11RenderTargetView*>(nullptr));
+        default:
+            throw std::logic_error{"Unknown manifest resource kind."};
+        }
+    }
+}
+
+CD3D11ManifestBackend::CD3D11ManifestBackend(ID3D11Device* p_device, CD3D11ResourceRegistry& registry)
+    : m_p_device{p_device}, m_registry{registry}
+{
+}
+
+void CD3D11ManifestBackend::Reset(ID3D11Device* p_device)
+{
+    m_p_device = p_device;
+}
+
+auto CD3D11ManifestBackend::Create(const ManifestEntry& entry) const
+    -> ComPtr<IUnknown>
+{
+    const auto subresources = entry.GetInitialData();
+    const auto initial_data = D3D11Description::From(subresources);
+    const auto* p_initial_data = initial_data.empty() ? NULL : initial_data.data();
+
+    switch (entry.m_kind)
+    {
+    case ManifestResourceKind::Buffer:
+    {
+        const auto description = D3D11Description::From(std::get<GpuBufferDescription>(entry.m_description));
+        ComPtr<ID3D11Buffer> p_result{};
+        ThrowIfFailed(m_p_device->CreateBuffer(&description, p_initial_data, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::Texture2D:
+    {
+        const auto description = D3D11Description::From(std::get<GpuTexture2DDescription>(entry.m_description));
+        ComPtr<ID3D11Texture2D> p_result{};
+        ThrowIfFailed(m_p_device->CreateTexture2D(&description, p_initial_data, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::VertexShader:
+    {
+        ComPtr<ID3D11VertexShader> p_result{};
+        ThrowIfFailed(m_p_device->CreateVertexShader(entry.m_data.data(), entry.m_data.size(), NULL, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::PixelShader:
+    {
+        ComPtr<ID3D11PixelShader> p_result{};
+        ThrowIfFailed(m_p_device->CreatePixelShader(entry.m_data.data(), entry.m_data.size(), NULL, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::InputLayout:
+    {
+        // 语义名指向entry自己保存的字符串
+        const auto elements = entry.GetInputElements();
+        const auto input_elements = D3D11Description::From(elements);
+        ComPtr<ID3D11InputLayout> p_result{};
+        ThrowIfFailed(m_p_device->CreateInputLayout(
+            input_elements.data(),
+            static_cast<UINT>(input_elements.size()),
+            entry.m_data.data(),
+            entry.m_data.size(),
+            &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::SamplerState:
+    {
+        const auto description = D3D11Description::From(std::get<GpuSamplerDescription>(entry.m_description));
+        ComPtr<ID3D11SamplerState> p_result{};
+        ThrowIfFailed(m_p_device->CreateSamplerState(&description, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::RasterizerState:
+    {
+        const auto description = D3D11Description::From(std::get<GpuRasterizerDescription>(entry.m_description));
+        ComPtr<ID3D11RasterizerState> p_result{};
+        ThrowIfFailed(m_p_device->CreateRasterizerState(&description, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::BlendState:
+    {
+        const auto description = D3D11Description::From(std::get<GpuBlendDescription>(entry.m_description));
+        ComPtr<ID3D11BlendState> p_result{};
+        ThrowIfFailed(m_p_device->CreateBlendState(&description, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::DepthStencilState:
+    {
+        const auto description = D3D11Description::From(std::get<GpuDepthStencilDescription>(entry.m_description));
+        ComPtr<ID3D11DepthStencilState> p_result{};
+        ThrowIfFailed(m_p_device->CreateDepthStencilState(&description, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::ShaderResourceView:
+    {
+        ComPtr<ID3D11ShaderResourceView> p_result{};
+        ThrowIfFailed(m_p_device->CreateShaderResourceView(m_registry.Get(TextureHandle{entry.m_parent_handle_value}), NULL, &p_result));
+        return AsUnknown(p_result);
+    }
+    case ManifestResourceKind::RenderTargetView:
+    {
+        ComPtr<ID3D11RenderTargetView> p_result{};
+        ThrowIfFailed(m_p_device->CreateRenderTargetView(m_registry.Get(TextureHandle{entry.m_parent_handle_value}), NULL, &p_result));
+        return AsUnknown(p_result);
+    }
+    default:
+        throw std::logic_error{"Unknown manifest resource kind."};
+    }
+}
+
+auto CD3D11ManifestBackend::Register(const ManifestEntry& entry, ComPtr<IUnknown>& p_object)
+    -> std::uint32_t
+{
+    return VisitKind(entry.m_kind, [this, &p_object](auto* p_type_tag)
+                     {
+                         using T = std::remove_pointer_t<decltype(p_type_tag)>;
+                         ComPtr<T> p_typed_object{};
+                         ThrowIfFailed(p_object.As(&p_typed_object));
+                         return m_registry.Register(p_typed_object).m_value; });
+}
+
+void CD3D11ManifestBackend::Replace(const ManifestEntry& entry, ComPtr<IUnknown>& p_object)
+{
+    VisitKind(entry.m_kind, [this, &entry, &p_object](auto* p_type_tag)
+              {
+                  using T = std::remove_pointer_t<decltype(p_type_tag)>;
+                  ComPtr<T> p_typed_object{};
+                  ThrowIfFailed(p_object.As(&p_typed_object));
+                  m_registry.Replace(ComHandle<T>{entry.m_handle_value}, p_typed_object); });
+}
+
+auto CD3D11ManifestBackend::GetTraceObject(ManifestResourceKind kind, std::uint32_t handle_value) const
+    -> const void*
+{
+    return VisitKind(kind, [this, handle_value](auto* p_type_tag)
+                     {
+                         using T = std::remove_pointer_t<decltype(p_type_tag)>;
+                         return static_cast<const void*>(m_registry.Get(ComHandle<T>{handle_value})); });
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <wrl/client.h>
+#include <d3d11.h>
+#include "CD3D11ResourceRegistry.h"
+#include "CResourceManifest.h"
+#include "HResultException.h"
+
+/**
+ * @brief 资源清单在D3D11设备上的后端：对象登记在CD3D11ResourceRegistry中，设备丢失重建后句柄不变 \n
+ * D3D11设备的创建函数是线程安全的，Create可以在多个线程中同时调用
+ */
+class CD3D11ManifestBackend
+{
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device> m_p_device{};
+    CD3D11ResourceRegistry& m_registry;
+
+public:
+    using Object = Microsoft::WRL::ComPtr<IUnknown>;
+    using Buffer = BufferHandle;
+    using Texture = TextureHandle;
+    using ShaderResourceView = ShaderResourceViewHandle;
+    using RenderTargetView = RenderTargetViewHandle;
+    using VertexShader = ComHandle<ID3D11VertexShader>;
+    using PixelShader = ComHandle<ID3D11PixelShader>;
+    using InputLayout = ComHandle<ID3D11InputLayout>;
+    using SamplerState = ComHandle<ID3D11SamplerState>;
+    using RasterizerState = ComHandle<ID3D11RasterizerState>;
+    using BlendState = ComHandle<ID3D11BlendState>;
+    using DepthStencilState = ComHandle<ID3D11DepthStencilState>;
+    using Viewport = D3D11_VIEWPORT;
+    using PrimitiveTopology = D3D11_PRIMITIVE_TOPOLOGY;
+    using Format = DXGI_FORMAT;
+    constexpr static unsigned MAX_RECOVERY_WORKER_COUNT = (std::numeric_limits<unsigned>::max)();
+
+    CD3D11ManifestBackend(ID3D11Device* p_device, CD3D11ResourceRegistry& registry);
+
+    /**
+     * @brief 之后的对象在p_device上创建，用于设备丢失后重建
+     */
+    void Reset(ID3D11Device* p_device);
+    auto Create(const ManifestEntry& entry) const
+        -> Microsoft::WRL::ComPtr<IUnknown>;
+    auto Register(const ManifestEntry& entry, Microsoft::WRL::ComPtr<IUnknown>& p_object)
+        -> std::uint32_t;
+    void Replace(const ManifestEntry& entry, Microsoft::WRL::ComPtr<IUnknown>& p_object);
+    auto GetTraceObject(ManifestResourceKind kind, std::uint32_t handle_value) const
+        -> const void*;
+    template <class T>
+    auto Get(ComHandle<T> handle) const noexcept
+        -> T*
+    {
+        return m_registry.Get(handle);
+    }
+};
+
+using CD3D11ResourceManifest = CResourceManifest<CD3D11ManifestBackend>;
@@ -0,0 +1,152 @@
+#pragma once
+#include <tuple>
+#include <wrl/client.h>
+#include <d3d11_2.h>
+#include "CHandleTable.h"
+#include "CDeferredReleaseQueue.h"
+
+template <class T>
+using ComHandle = Handle<T*>;
+
+using TextureHandle = ComHandle<ID3D11Texture2D>;
+using BufferHandle = ComHandle<ID3D11Buffer>;
+using ShaderResourceViewHandle = ComHandle<ID3D11ShaderResourceView>;
+using RenderTargetViewHandle = ComHandle<ID3D11RenderTargetView>;
+
+/**
+ * @brief D3D11资源登记表：每个对象只在登记时持有一次引用，之后以32位句柄传递和查找， \n
+ * 每帧的代码只传递整数和裸指针，没有AddRef/Release的原子操作
+ */
+class CD3D11ResourceRegistry
+{
+private:
+    std::tuple<
+        CHandleTable<ID3D11Texture2D*>,
+        CHandleTable<ID3D11Buffer*>,
+        CHandleTable<ID3D11ShaderResourceView*>,
+        CHandleTable<ID3D11RenderTargetView*>,
+        CHandleTable<ID3D11VertexShader*>,
+        CHandleTable<ID3D11PixelShader*>,
+        CHandleTable<ID3D11InputLayout*>,
+        CHandleTable<ID3D11SamplerState*>,
+        CHandleTable<ID3D11RasterizerState*>,
+        CHandleTable<ID3D11BlendState*>,
+        CHandleTable<ID3D11DepthStencilState*>>
+        m_tables{};
+    CDeferredReleaseQueue* m_p_release_queue{};
+
+    template <class T>
+    auto GetTable() noexcept
+        -> CHandleTable<T*>&
+    {
+        return std::get<CHandleTable<T*>>(m_tables);
+    }
+    template <class T>
+    auto GetTable() const noexcept
+        -> const CHandleTable<T*>&
+    {
+        return std::get<CHandleTable<T*>>(m_tables);
+    }
+
+public:
+    /**
+     * @brief 构造登记表
+     *
+     * @param p_release_queue 不为空时，销毁的对象交给该队列在栅栏完成后释放
+     */
+    explicit CD3D11ResourceRegistry(CDeferredReleaseQueue* p_release_queue = nullptr) noexcept
+        : m_p_release_queue{p_release_queue}
+    {
+    }
+    ~CD3D11ResourceRegistry()
+    {
+        std::apply([](auto&... tables)
+                   { (ReleaseAll(tables), ...); },
+                   m_tables);
+    }
+    CD3D11ResourceRegistry(const CD3D11ResourceRegistry&) = delete;
+    CD3D11ResourceRegistry& operator=(const CD3D11ResourceRegistry&) = delete;
+
+    /**
+     * @brief 登记对象，接管p_object持有的引用，调用后p_object为空
+     */
+    template <class T>
+    auto Register(Microsoft::WRL::ComPtr<T>& p_object)
+        -> ComHandle<T>
+    {
+        return GetTable<T>().Insert(p_object.Detach());
+    }
+
+    /**
+     * @brief 以句柄查找对象，不增加引用计数；句柄失效时返回nullptr
+     */
+    template <class T>
+    auto Get(ComHandle<T> handle) const noexcept
+        -> T*
+    {
+        auto* p_result = GetTable<T>().Get(handle);
+        return p_result == nullptr ? nullptr : *p_result;
+    }
+
+    template <class T>
+    bool IsValid(ComHandle<T> handle) const noexcept
+    {
+        return GetTable<T>().IsValid(handle);
+    }
+
+    /**
+     * @brief 注销对象并释放登记时持有的引用，之后该句柄失效
+     */
+    template <class T>
+    bool Destroy(ComHandle<T> handle)
+    {
+        T* p_object = nullptr;
+        if (!GetTable<T>().Remove(handle, &p_object))
+        {
+            return false;
+        }
+        if (m_p_release_queue != nullptr)
+        {
+            m_p_release_queue->DeferRelease(p_object);
+        }
+        else
+        {
+            p_object->Release();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 用新对象替换句柄指向的对象，句柄保持有效；旧对象立即释放，用于设备丢失后重建
+     */
+    template <class T>
+    bool Replace(ComHandle<T> handle, Microsoft::WRL::ComPtr<T>& p_object)
+    {
+        auto* p_slot = GetTable<T>().Get(handle);
+        if (p_slot == nullptr)
+        {
+            return false;
+        }
+        (*p_slot)->Release();
+        *p_slot = p_object.Detach();
+        return true;
+    }
+
+    template <class T>
+    auto GetCount() const noexcept
+        -> std::size_t
+    {
+        return GetTable<T>().GetSize();
+    }
+
+private:
+    template <class T>
+    static void ReleaseAll(CHandleTable<T*>& table) noexcept
+    {
+        for (auto* p_object : table.GetObjects())
+        {
+            p_object->Release();
+        }
+        table.GetObjects().clear();
+    }
+};
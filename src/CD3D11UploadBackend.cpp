@@ -0,0 +1,76 @@
+#include "CD3D11UploadBackend.h"
+
+CD3D11UploadBackend::CD3D11UploadBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context, const CD3D11ResourceRegistry& registry, DXGI_FORMAT format, CGpuMemoryBudget* p_memory_budget)
+    : m_p_device{p_device}, m_p_device_context{p_device_context}, m_registry{registry}, m_format{format}, m_p_memory_budget{p_memory_budget}
+{
+}
+
+auto CD3D11UploadBackend::CreateStagingBlock(std::uint32_t width, std::uint32_t height)
+    -> std::uint32_t
+{
+    D3D11_TEXTURE2D_DESC description{};
+    description.Width = width;
+    description.Height = height;
+    description.MipLevels = 1;
+    description.ArraySize = 1;
+    description.Format = m_format;
+    description.SampleDesc.Count = 1;
+    description.Usage = D3D11_USAGE_STAGING;
+    description.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    CGpuMemoryReservation reservation{m_p_memory_budget, GpuMemoryCategory::Staging, EstimateTexture2DBytes(width, height, m_format, 1, 1)};
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> p_staging_texture{};
+    ThrowIfFailed(m_p_device->CreateTexture2D(&description, NULL, &p_staging_texture));
+    m_staging_textures.push_back(std::move(p_staging_texture));
+    m_reservations.push_back(std::move(reservation));
+    return static_cast<std::uint32_t>(m_staging_textures.size() - 1);
+}
+
+auto CD3D11UploadBackend::MapStagingBlock(std::uint32_t block)
+    -> MappedStagingBlock
+{
+    // 上传引擎保证该暂存块的栅栏已完成，DO_NOT_WAIT用于发现违反这一约定的情况
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    ThrowIfFailed(m_p_device_context->Map(
+                      m_staging_textures.at(block).Get(),
+                      0,
+                      D3D11_MAP_WRITE,
+                      D3D11_MAP_FLAG_DO_NOT_WAIT,
+                      &mapped),
+                  "Map staging texture of upload engine failed.");
+    return {static_cast<std::uint8_t*>(mapped.pData), mapped.RowPitch};
+}
+
+void CD3D11UploadBackend::UnmapStagingBlock(std::uint32_t block)
+{
+    m_p_device_context->Unmap(m_staging_textures.at(block).Get(), 0);
+}
+
+void CD3D11UploadBackend::CopyRegions(std::uint32_t block, const UploadCopyRegion* p_regions, std::size_t count)
+{
+    auto* p_staging_texture = m_staging_textures.at(block).Get();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& region = p_regions[i];
+        auto* p_destination = m_registry.Get(TextureHandle{region.m_destination});
+        if (p_destination == nullptr)
+        {
+            continue;
+        }
+        D3D11_BOX source_box{};
+        source_box.left = region.m_source_x;
+        source_box.top = region.m_source_y;
+        source_box.front = 0;
+        source_box.right = region.m_source_x + region.m_width;
+        source_box.bottom = region.m_source_y + region.m_height;
+        source_box.back = 1;
+        m_p_device_context->CopySubresourceRegion(
+            p_destination,
+            0,
+            region.m_destination_x,
+            region.m_destination_y,
+            0,
+            p_staging_texture,
+            0,
+            &source_box);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <wrl/client.h>
+#include <d3d11.h>
+#include "CD3D11ResourceRegistry.h"
+#include "CGpuMemoryBudget.h"
+#include "CUploadEngine.h"
+#include "HResultException.h"
+
+/**
+ * @brief 以STAGING纹理作为暂存块、用CopySubresourceRegion复制到目标纹理的上传后端 \n
+ * 目标编号即CD3D11ResourceRegistry中纹理句柄的值
+ */
+class CD3D11UploadBackend final : public IUploadBackend
+{
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device> m_p_device{};
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_p_device_context{};
+    const CD3D11ResourceRegistry& m_registry;
+    DXGI_FORMAT m_format{};
+    CGpuMemoryBudget* m_p_memory_budget{};
+    std::vector<CGpuMemoryReservation> m_reservations{};
+    std::vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>> m_staging_textures{};
+
+public:
+    /**
+     * @param p_memory_budget 不为空时暂存纹理在其中按STAGING类别记账
+     */
+    CD3D11UploadBackend(ID3D11Device* p_device, ID3D11DeviceContext* p_device_context, const CD3D11ResourceRegistry& registry, DXGI_FORMAT format, CGpuMemoryBudget* p_memory_budget = nullptr);
+    ~CD3D11UploadBackend() override = default;
+
+    auto CreateStagingBlock(std::uint32_t width, std::uint32_t height)
+        -> std::uint32_t override;
+    auto MapStagingBlock(std::uint32_t block)
+        -> MappedStagingBlock override;
+    void UnmapStagingBlock(std::uint32_t block) override;
+    void CopyRegions(std::uint32_t block, const UploadCopyRegion* p_regions, std::size_t count) override;
+};
@@ -0,0 +1,63 @@
+#include "CDeferredReleaseQueue.h"
+
+CDeferredReleaseQueue::CDeferredReleaseQueue(IFrameFence& fence) noexcept
+    : m_fence{fence}
+{
+}
+
+CDeferredReleaseQueue::~CDeferredReleaseQueue()
+{
+    ReleaseAll();
+}
+
+void CDeferredReleaseQueue::Defer(void* p_object, ReleaseFunction p_release)
+{
+    if (p_object == nullptr)
+    {
+        return;
+    }
+    m_entries.push_back({m_fence.GetNextValue(), p_object, p_release});
+}
+
+auto CDeferredReleaseQueue::Collect()
+    -> std::size_t
+{
+    if (m_entries.empty())
+    {
+        return 0;
+    }
+    // 栅栏值随入队顺序单调不减，遇到第一个未完成的即可停止
+    const auto completed_value = m_fence.GetCompletedValue();
+    std::size_t result = 0;
+    while (!m_entries.empty() && m_entries.front().m_fence_value <= completed_value)
+    {
+        const auto entry = m_entries.front();
+        m_entries.pop_front();
+        entry.m_p_release(entry.m_p_object);
+        ++result;
+    }
+    m_released_count += result;
+    return result;
+}
+
+void CDeferredReleaseQueue::ReleaseAll() noexcept
+{
+    for (const auto& entry : m_entries)
+    {
+        entry.m_p_release(entry.m_p_object);
+    }
+    m_released_count += m_entries.size();
+    m_entries.clear();
+}
+
+auto CDeferredReleaseQueue::GetPendingCount() const noexcept
+    -> std::size_t
+{
+    return m_entries.size();
+}
+
+auto CDeferredReleaseQueue::GetReleasedCount() const noexcept
+    -> std::uint64_t
+{
+    return m_released_count;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include "FrameFence.h"
+
+/**
+ * @brief 延迟释放队列：被释放的对象带上当前帧的栅栏值，等GPU越过该栅栏后再批量释放， \n
+ * 避免释放仍被在途命令引用的资源，也避免为了释放而等待GPU
+ */
+class CDeferredReleaseQueue
+{
+public:
+    using ReleaseFunction = void (*)(void*) noexcept;
+
+private:
+    struct Entry
+    {
+        std::uint64_t m_fence_value;
+        void* m_p_object;
+        ReleaseFunction m_p_release;
+    };
+
+    IFrameFence& m_fence;
+    std::deque<Entry> m_entries{};
+    std::uint64_t m_released_count{};
+
+public:
+    explicit CDeferredReleaseQueue(IFrameFence& fence) noexcept;
+    /**
+     * @brief 析构时不再等待GPU，直接释放所有对象；调用者应保证此时设备已经空闲
+     */
+    ~CDeferredReleaseQueue();
+    CDeferredReleaseQueue(const CDeferredReleaseQueue&) = delete;
+    CDeferredReleaseQueue& operator=(const CDeferredReleaseQueue&) = delete;
+
+    /**
+     * @brief 推迟释放任意对象，p_release在栅栏完成后以p_object为参数调用
+     */
+    void Defer(void* p_object, ReleaseFunction p_release);
+    /**
+     * @brief 推迟释放COM对象，接管调用者持有的一个引用
+     */
+    template <class T>
+    void DeferRelease(T* p_object)
+    {
+        if (p_object == nullptr)
+        {
+            return;
+        }
+        Defer(p_object, [](void* p) noexcept
+              { static_cast<T*>(p)->Release(); });
+    }
+    /**
+     * @brief 推迟释放智能指针(如ComPtr)持有的引用，调用后p_com_ptr为空
+     */
+    template <class ComPtrType>
+    auto DeferReleaseComPtr(ComPtrType& p_com_ptr)
+        -> decltype(p_com_ptr.Detach(), void())
+    {
+        DeferRelease(p_com_ptr.Detach());
+    }
+
+    /**
+     * @brief 释放所有栅栏已完成的对象
+     *
+     * @return std::size_t 本次释放的对象数量
+     */
+    auto Collect()
+        -> std::size_t;
+    /**
+     * @brief 不检查栅栏，立即释放所有对象
+     */
+    void ReleaseAll() noexcept;
+
+    auto GetPendingCount() const noexcept
+        -> std::size_t;
+    auto GetReleasedCount() const noexcept
+        -> std::uint64_t;
+};
@@ -0,0 +1,141 @@
+#include "CDrawQueue.h"
+#include <array>
+#include <utility>
+
+void RadixSort::SortByKey(std::vector<DrawSortItem>& items, std::vector<DrawSortItem>& scratch)
+{
+    constexpr std::size_t RADIX_BITS = 8;
+    constexpr std::size_t BUCKET_COUNT = std::size_t{1} << RADIX_BITS;
+    constexpr std::size_t PASS_COUNT = 64 / RADIX_BITS;
+
+    const auto count = items.size();
+    if (count < 2)
+    {
+        return;
+    }
+    scratch.resize(count);
+
+    // 一次遍历计算所有趟的直方图
+    std::array<std::array<std::uint32_t, BUCKET_COUNT>, PASS_COUNT> histograms{};
+    for (const auto& item : items)
+    {
+        auto key = item.m_key;
+        for (std::size_t pass = 0; pass < PASS_COUNT; ++pass, key >>= RADIX_BITS)
+        {
+            ++histograms[pass][key & (BUCKET_COUNT - 1)];
+        }
+    }
+
+    auto* p_source = &items;
+    auto* p_destination = &scratch;
+    for (std::size_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        auto& histogram = histograms[pass];
+        const auto shift = pass * RADIX_BITS;
+        // 所有键在这一字节上相同，本趟不会改变顺序
+        if (histogram[((*p_source)[0].m_key >> shift) & (BUCKET_COUNT - 1)] == count)
+        {
+            continue;
+        }
+        std::uint32_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            const auto bucket_count = bucket;
+            bucket = offset;
+            offset += bucket_count;
+        }
+        for (const auto& item : *p_source)
+        {
+            (*p_destination)[histogram[(item.m_key >> shift) & (BUCKET_COUNT - 1)]++] = item;
+        }
+        std::swap(p_source, p_destination);
+    }
+    if (p_source != &items)
+    {
+        items.swap(scratch);
+    }
+}
+
+void CDrawQueue::Reserve(std::size_t count)
+{
+    m_commands.reserve(count);
+    m_sort_items.reserve(count);
+    m_scratch.reserve(count);
+}
+
+void CDrawQueue::Clear() noexcept
+{
+    m_commands.clear();
+    m_sort_items.clear();
+    m_translucent_sequence = 0;
+    m_is_sorted = true;
+}
+
+void CDrawQueue::Submit(const DrawCommand& command, std::uint32_t layer, bool is_translucent)
+{
+    DrawSortKey::Fields fields{};
+    fields.m_layer = layer;
+    fields.m_is_translucent = is_translucent;
+    fields.m_shader = command.m_shader;
+    fields.m_texture = command.m_texture;
+    fields.m_state = command.m_state;
+    if (is_translucent)
+    {
+        if (m_translucent_sequence >= DrawSortKey::MAX_SEQUENCE)
+        {
+            // 序号用尽后其余字段置0，依靠排序的稳定性保持提交顺序
+            fields.m_shader = 0;
+            fields.m_texture = 0;
+            fields.m_state = 0;
+        }
+        fields.m_sequence = m_translucent_sequence < DrawSortKey::MAX_SEQUENCE ? m_translucent_sequence++ : DrawSortKey::MAX_SEQUENCE;
+    }
+    m_sort_items.push_back({DrawSortKey::Pack(fields), static_cast<std::uint32_t>(m_commands.size())});
+    m_commands.push_back(command);
+    m_is_sorted = false;
+}
+
+void CDrawQueue::Sort()
+{
+    if (m_is_sorted)
+    {
+        return;
+    }
+    RadixSort::SortByKey(m_sort_items, m_scratch);
+    m_is_sorted = true;
+}
+
+auto CDrawQueue::GetCommands() const noexcept
+    -> const std::vector<DrawCommand>&
+{
+    return m_commands;
+}
+
+auto CDrawQueue::GetSortedItems() const noexcept
+    -> const std::vector<DrawSortItem>&
+{
+    return m_sort_items;
+}
+
+auto CDrawQueue::CountStateChanges(bool use_sorted_order) const noexcept
+    -> std::uint32_t
+{
+    std::uint32_t result = 0;
+    const DrawCommand* p_previous = nullptr;
+    for (std::size_t i = 0; i < m_commands.size(); ++i)
+    {
+        const auto& current = m_commands[use_sorted_order ? m_sort_items[i].m_index : i];
+        if (p_previous == nullptr)
+        {
+            result += 3;
+        }
+        else
+        {
+            result += p_previous->m_shader != current.m_shader;
+            result += p_previous->m_texture != current.m_texture;
+            result += p_previous->m_state != current.m_state;
+        }
+        p_previous = &current;
+    }
+    return result;
+}
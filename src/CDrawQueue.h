@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "DrawSortKey.h"
+
+/**
+ * @brief 一次DrawIndexed调用及其所需的管线状态编号
+ */
+struct DrawCommand
+{
+    std::uint32_t m_shader{};
+    std::uint32_t m_texture{};
+    std::uint32_t m_state{};
+    std::uint32_t m_index_count{};
+    std::uint32_t m_start_index_location{};
+    std::int32_t m_base_vertex_location{};
+};
+
+struct DrawSortItem
+{
+    std::uint64_t m_key{};
+    std::uint32_t m_index{};
+};
+
+namespace RadixSort
+{
+    /**
+     * @brief 按8位一趟的LSD基数排序，稳定；所有键在某一字节上都相同时跳过该趟
+     *
+     * @param items 要排序的数据，排序结果也存放于此
+     * @param scratch 与items等长的临时空间，会被自动扩容
+     */
+    void SortByKey(std::vector<DrawSortItem>& items, std::vector<DrawSortItem>& scratch);
+}
+
+/**
+ * @brief 收集一帧内的绘制，按排序键重排后再提交，以减少状态切换
+ */
+class CDrawQueue
+{
+private:
+    std::vector<DrawCommand> m_commands{};
+    std::vector<DrawSortItem> m_sort_items{};
+    std::vector<DrawSortItem> m_scratch{};
+    std::uint32_t m_translucent_sequence{};
+    bool m_is_sorted{true};
+
+public:
+    CDrawQueue() = default;
+    ~CDrawQueue() = default;
+
+    void Reserve(std::size_t count);
+    void Clear() noexcept;
+    /**
+     * @brief 提交一个绘制，半透明绘制在同一层内按提交顺序执行
+     */
+    void Submit(const DrawCommand& command, std::uint32_t layer, bool is_translucent);
+    void Sort();
+
+    auto GetCommands() const noexcept
+        -> const std::vector<DrawCommand>&;
+    auto GetSortedItems() const noexcept
+        -> const std::vector<DrawSortItem>&;
+
+    /**
+     * @brief 按排序后的顺序遍历绘制，未排序时先排序
+     */
+    template <class Function>
+    void ForEachSorted(Function function)
+    {
+        Sort();
+        for (const auto& item : m_sort_items)
+        {
+            function(m_commands[item.m_index]);
+        }
+    }
+
+    /**
+     * @brief 统计按当前顺序提交时着色器、纹理和其它状态的切换次数
+     *
+     * @param use_sorted_order 为false时按提交顺序统计
+     */
+    auto CountStateChanges(bool use_sorted_order) const noexcept
+        -> std::uint32_t;
+};
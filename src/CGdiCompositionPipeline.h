@@ -0,0 +1,313 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "CRenderGraph.h"
+#include "GpuResourceDescription.h"
+
+struct GdiCompositionVertex
+{
+    std::array<float, 3> m_position{};
+    std::array<float, 2> m_texcoord{};
+};
+
+struct GdiCompositionPipelineConfig
+{
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    /**
+     * @brief GDI表面上传到的纹理的格式，使用覆盖率纹理时为单通道格式
+     */
+    std::uint32_t m_gdi_initial_format{GpuFormat::B8G8R8A8_UNORM};
+    /**
+     * @brief alpha修正的输出格式，与后台缓冲区相同才能直接复制
+     */
+    std::uint32_t m_gdi_final_format{GpuFormat::B8G8R8A8_UNORM};
+    std::span<const std::uint8_t> m_vertex_shader{};
+    std::span<const std::uint8_t> m_alpha_increase_shader{};
+    std::span<const std::uint8_t> m_scaled_blit_shader{};
+};
+
+/**
+ * @brief 合成管线渲染图中的pass，数值即pass在图中的序号
+ */
+enum class GdiCompositionPass : std::uint32_t
+{
+    Upload,
+    AlphaIncrease,
+    Blit,
+};
+
+/**
+ * @brief GDI表面的合成管线：alpha修正把gdi_initial绘制到gdi_final，再复制或拉伸到后台缓冲区 \n
+ * 资源经资源清单创建，状态设置对上下文模板化，窗口程序在D3D11上、基准测试在模拟设备上运行同一份代码 \n
+ * 上传、alpha修正和输出三个pass由渲染图排序；alpha修正与上一帧的gdi_final混合，而且帧结束后还要回读，所以gdi_final是导入的持久纹理
+ *
+ * @tparam Manifest CResourceManifest的实例，决定句柄、视口、图元拓扑和格式的类型
+ */
+template <class Manifest>
+class CGdiCompositionPipeline
+{
+public:
+    constexpr static std::uint32_t SLOT = 0;
+    /**
+     * @brief 左上、右上、右下、左下，两个三角形都是顺时针
+     */
+    constexpr static std::array<GdiCompositionVertex, 4> VERTICES{{
+        {{-1.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{1.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{1.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-1.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
+    }};
+    constexpr static std::array<std::uint16_t, 6> INDICES{0, 1, 2, 2, 3, 0};
+
+private:
+    Manifest& m_manifest;
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    typename Manifest::Buffer m_alpha_increase_constants{};
+    typename Manifest::Buffer m_blit_constants{};
+    typename Manifest::VertexShader m_vertex_shader{};
+    typename Manifest::InputLayout m_input_layout{};
+    typename Manifest::Buffer m_vertex_buffer{};
+    typename Manifest::Buffer m_index_buffer{};
+    typename Manifest::RasterizerState m_rasterizer_state{};
+    typename Manifest::SamplerState m_point_sampler{};
+    typename Manifest::SamplerState m_linear_sampler{};
+    typename Manifest::BlendState m_blend_state{};
+    typename Manifest::DepthStencilState m_depth_stencil_state{};
+    typename Manifest::Texture m_gdi_initial_texture{};
+    typename Manifest::Texture m_gdi_final_texture{};
+    typename Manifest::ShaderResourceView m_gdi_initial_srv{};
+    typename Manifest::RenderTargetView m_gdi_final_rtv{};
+    typename Manifest::ShaderResourceView m_gdi_final_srv{};
+    typename Manifest::PixelShader m_alpha_increase_shader{};
+    typename Manifest::PixelShader m_scaled_blit_shader{};
+
+    CRenderGraph m_graph{};
+
+    /**
+     * @brief 声明三个pass并编译，导入纹理的外部编号不使用：gdi_initial和gdi_final是成员，后台缓冲区每帧由调用者给出
+     */
+    void BuildGraph(const TextureDescription& gdi_initial_description, const TextureDescription& gdi_final_description)
+    {
+        const auto gdi_initial = m_graph.ImportTexture("GdiInitial", gdi_initial_description, 0);
+        const auto gdi_final = m_graph.ImportTexture("GdiFinal", gdi_final_description, 1);
+        const auto back_buffer = m_graph.ImportTexture("BackBuffer", gdi_final_description, 2);
+        m_graph.MarkOutput(back_buffer);
+        m_graph.AddPass(
+            "Upload", [&](CRenderGraph::CPassBuilder& builder)
+            { builder.Write(gdi_initial); },
+            {});
+        m_graph.AddPass(
+            "AlphaIncrease", [&](CRenderGraph::CPassBuilder& builder)
+            { builder.Read(gdi_initial).Write(gdi_final); },
+            {});
+        m_graph.AddPass(
+            "Blit", [&](CRenderGraph::CPassBuilder& builder)
+            { builder.Read(gdi_final).Write(back_buffer); },
+            {});
+        m_graph.Compile();
+    }
+
+    /**
+     * @brief alpha修正：以render_scale缩放的视口把gdi_initial绘制到gdi_final的左上角 \n
+     * 像素着色器只写入SV_Target0，只绑定gdi_final一个渲染目标
+     *
+     * @param draw 提交绘制调用，例如执行绘制队列
+     */
+    template <class Context, class Draw>
+    void DrawAlphaIncrease(Context& context, float render_scale, Draw&& draw) const
+    {
+        auto* p_sampler_state = m_manifest.Get(render_scale == 1.0f ? m_point_sampler : m_linear_sampler);
+        context.PSSetSamplers(SLOT, 1u, &p_sampler_state);
+        auto* p_render_target_view = m_manifest.Get(m_gdi_final_rtv);
+        context.OMSetRenderTargets(1u, &p_render_target_view, nullptr);
+        SetViewport(context, render_scale);
+        draw();
+    }
+
+    /**
+     * @brief 把gdi_final输出到后台缓冲区：render_scale为1时尺寸和格式相同，直接复制而不再绘制一次； \n
+     * 否则拉伸gdi_final的左上角，之后恢复alpha修正的状态，gdi_final下一帧要作为渲染目标，不能继续绑定为着色器资源
+     */
+    template <class Context, class Resource, class RenderTargetView, class Draw>
+    void Blit(Context& context, float render_scale, Resource* p_back_buffer, RenderTargetView* p_back_buffer_rtv, Draw&& draw) const
+    {
+        if (render_scale == 1.0f)
+        {
+            context.CopyResource(p_back_buffer, m_manifest.Get(m_gdi_final_texture));
+            return;
+        }
+        context.OMSetRenderTargets(1u, &p_back_buffer_rtv, nullptr);
+        SetViewport(context, 1.0f);
+        auto* p_shader_resource_view = m_manifest.Get(m_gdi_final_srv);
+        context.PSSetShaderResources(SLOT, 1u, &p_shader_resource_view);
+        context.PSSetShader(m_manifest.Get(m_scaled_blit_shader), nullptr, 0u);
+        context.OMSetBlendState(nullptr, nullptr, 0xFFFFFFFFu);
+        draw();
+
+        p_shader_resource_view = m_manifest.Get(m_gdi_initial_srv);
+        context.PSSetShaderResources(SLOT, 1u, &p_shader_resource_view);
+        context.PSSetShader(m_manifest.Get(m_alpha_increase_shader), nullptr, 0u);
+        context.OMSetBlendState(m_manifest.Get(m_blend_state), nullptr, 0u);
+    }
+
+    template <class Context>
+    void SetViewport(Context& context, float scale) const
+    {
+        const typename Manifest::Viewport viewport{0.0f, 0.0f, m_width * scale, m_height * scale, 0.0f, 1.0f};
+        context.RSSetViewports(1u, &viewport);
+    }
+
+public:
+    /**
+     * @brief 经manifest创建全部资源和状态
+     *
+     * @param alpha_increase_constants alpha修正的常量缓冲区，绑定到b0
+     * @param blit_constants 拉伸的常量缓冲区，绑定到b1
+     */
+    CGdiCompositionPipeline(Manifest& manifest,
+                            const GdiCompositionPipelineConfig& config,
+                            typename Manifest::Buffer alpha_increase_constants,
+                            typename Manifest::Buffer blit_constants)
+        : m_manifest{manifest},
+          m_width{config.m_width},
+          m_height{config.m_height},
+          m_alpha_increase_constants{alpha_increase_constants},
+          m_blit_constants{blit_constants}
+    {
+        m_vertex_shader = manifest.CreateVertexShader(config.m_vertex_shader.data(), config.m_vertex_shader.size());
+        constexpr std::array<GpuInputElementDescription, 2> input_elements{{
+            {"POSITION", 0, GpuFormat::R32G32B32_FLOAT, SLOT, offsetof(GdiCompositionVertex, m_position)},
+            {"TEXCOORD", 0, GpuFormat::R32G32_FLOAT, SLOT, offsetof(GdiCompositionVertex, m_texcoord)},
+        }};
+        m_input_layout = manifest.CreateInputLayout(input_elements.data(),
+                                                    static_cast<std::uint32_t>(input_elements.size()),
+                                                    config.m_vertex_shader.data(),
+                                                    config.m_vertex_shader.size());
+        const GpuSubresourceData vertex_data{VERTICES.data(), 0};
+        m_vertex_buffer = manifest.CreateBuffer({static_cast<std::uint32_t>(sizeof(VERTICES)), GpuUsage::IMMUTABLE, GpuBindFlag::VERTEX_BUFFER, 0}, &vertex_data);
+        const GpuSubresourceData index_data{INDICES.data(), 0};
+        m_index_buffer = manifest.CreateBuffer({static_cast<std::uint32_t>(sizeof(INDICES)), GpuUsage::IMMUTABLE, GpuBindFlag::INDEX_BUFFER, 0}, &index_data);
+        m_rasterizer_state = manifest.CreateRasterizerState({false, false});
+        // 1:1绘制时点采样与线性过滤结果相同；内部渲染比例不为1时缩放需要线性过滤
+        m_point_sampler = manifest.CreateSamplerState({GpuFilter::MIN_MAG_MIP_POINT, 1}, 1.0f);
+        m_linear_sampler = manifest.CreateSamplerState({GpuFilter::MIN_MAG_MIP_LINEAR, 1});
+        m_blend_state = manifest.CreateBlendState({true, GpuBlend::SRC_ALPHA, GpuBlend::INV_DEST_ALPHA, GpuBlend::OP_ADD, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD, 0xF});
+        m_depth_stencil_state = manifest.CreateDepthStencilState({false, false});
+
+        GpuTexture2DDescription texture_description{};
+        texture_description.m_width = config.m_width;
+        texture_description.m_height = config.m_height;
+        // GDI绘制到持久映射的DIB section中，再经上传引擎复制脏矩形，初始纹理不需要GDI兼容
+        texture_description.m_format = config.m_gdi_initial_format;
+        texture_description.m_bind_flags = GpuBindFlag::SHADER_RESOURCE;
+        m_gdi_initial_texture = manifest.CreateTexture2D(texture_description, nullptr);
+        texture_description.m_format = config.m_gdi_final_format;
+        texture_description.m_bind_flags = GpuBindFlag::RENDER_TARGET | GpuBindFlag::SHADER_RESOURCE;
+        m_gdi_final_texture = manifest.CreateTexture2D(texture_description, nullptr);
+        m_gdi_initial_srv = manifest.CreateShaderResourceView(m_gdi_initial_texture);
+        m_gdi_final_rtv = manifest.CreateRenderTargetView(m_gdi_final_texture);
+        m_gdi_final_srv = manifest.CreateShaderResourceView(m_gdi_final_texture);
+        BuildGraph({config.m_width, config.m_height, config.m_gdi_initial_format}, {config.m_width, config.m_height, config.m_gdi_final_format});
+        m_alpha_increase_shader = manifest.CreatePixelShader(config.m_alpha_increase_shader.data(), config.m_alpha_increase_shader.size());
+        m_scaled_blit_shader = manifest.CreatePixelShader(config.m_scaled_blit_shader.data(), config.m_scaled_blit_shader.size());
+    }
+
+    /**
+     * @brief 设置alpha修正的全部管线状态，设备丢失重建或上下文被清空后需要重新调用
+     */
+    template <class Context>
+    void Bind(Context& context) const
+    {
+        context.IASetPrimitiveTopology(static_cast<typename Manifest::PrimitiveTopology>(GpuPrimitiveTopology::TRIANGLE_LIST));
+        context.IASetInputLayout(m_manifest.Get(m_input_layout));
+        context.IASetIndexBuffer(m_manifest.Get(m_index_buffer), static_cast<typename Manifest::Format>(GpuFormat::R16_UINT), 0u);
+        auto* p_vertex_buffer = m_manifest.Get(m_vertex_buffer);
+        constexpr std::array<std::uint32_t, 1> strides{static_cast<std::uint32_t>(sizeof(GdiCompositionVertex))};
+        constexpr std::array<std::uint32_t, 1> offsets{0};
+        context.IASetVertexBuffers(SLOT, 1u, &p_vertex_buffer, strides.data(), offsets.data());
+        context.VSSetShader(m_manifest.Get(m_vertex_shader), nullptr, 0u);
+        context.GSSetShader(nullptr, nullptr, 0u);
+        context.SOSetTargets(0u, nullptr, nullptr);
+
+        SetViewport(context, 1.0f);
+        context.RSSetState(m_manifest.Get(m_rasterizer_state));
+
+        auto* p_sampler_state = m_manifest.Get(m_point_sampler);
+        context.PSSetSamplers(SLOT, 1u, &p_sampler_state);
+        auto* p_shader_resource_view = m_manifest.Get(m_gdi_initial_srv);
+        context.PSSetShaderResources(SLOT, 1u, &p_shader_resource_view);
+        context.PSSetShader(m_manifest.Get(m_alpha_increase_shader), nullptr, 0u);
+        const std::array<decltype(m_manifest.Get(m_alpha_increase_constants)), 2> constant_buffers{
+            m_manifest.Get(m_alpha_increase_constants),
+            m_manifest.Get(m_blit_constants)};
+        context.PSSetConstantBuffers(SLOT, static_cast<std::uint32_t>(constant_buffers.size()), constant_buffers.data());
+
+        context.OMSetBlendState(m_manifest.Get(m_blend_state), nullptr, 0u);
+        context.OMSetDepthStencilState(m_manifest.Get(m_depth_stencil_state), 0u);
+    }
+
+    /**
+     * @brief 按渲染图的顺序执行一帧：上传、alpha修正、输出到后台缓冲区
+     *
+     * @param upload 把GDI表面的脏矩形写入gdi_initial
+     * @param draw 提交绘制调用，例如执行绘制队列
+     * @param pass_scope 以(GdiCompositionPass, run)调用，在run前后可以插入计时等操作
+     */
+    template <class Context, class Resource, class RenderTargetView, class Upload, class Draw, class PassScope>
+    void Execute(Context& context,
+                 float render_scale,
+                 Resource* p_back_buffer,
+                 RenderTargetView* p_back_buffer_rtv,
+                 Upload&& upload,
+                 Draw&& draw,
+                 PassScope&& pass_scope) const
+    {
+        m_graph.Execute([&](std::uint32_t pass_index)
+                        {
+                            const auto pass = static_cast<GdiCompositionPass>(pass_index);
+                            pass_scope(pass, [&]()
+                                       {
+                                           switch (pass)
+                                           {
+                                           case GdiCompositionPass::Upload:
+                                               upload();
+                                               break;
+                                           case GdiCompositionPass::AlphaIncrease:
+                                               DrawAlphaIncrease(context, render_scale, draw);
+                                               break;
+                                           case GdiCompositionPass::Blit:
+                                               Blit(context, render_scale, p_back_buffer, p_back_buffer_rtv, draw);
+                                               break;
+                                           } }); });
+    }
+
+    auto GetGdiInitialTexture() const noexcept
+        -> typename Manifest::Texture
+    {
+        return m_gdi_initial_texture;
+    }
+    auto GetGdiFinalTexture() const noexcept
+        -> typename Manifest::Texture
+    {
+        return m_gdi_final_texture;
+    }
+    auto GetGdiFinalRenderTargetView() const noexcept
+        -> typename Manifest::RenderTargetView
+    {
+        return m_gdi_final_rtv;
+    }
+    auto GetRenderGraphStatistics() const noexcept
+        -> const RenderGraphStatistics&
+    {
+        return m_graph.GetStatistics();
+    }
+    constexpr static auto GetIndexCount() noexcept
+        -> std::uint32_t
+    {
+        return static_cast<std::uint32_t>(INDICES.size());
+    }
+};
@@ -0,0 +1,56 @@
+#include "CGdiSurfaceMemory.h"
+#include <algorithm>
+#include <stdexcept>
+
+auto CGdiSurfaceMemory::AllocateBuffer(std::uint32_t width, std::uint32_t height)
+    -> MappedSurfaceBuffer
+{
+    BITMAPINFO bitmap_info{};
+    bitmap_info.bmiHeader.biSize = sizeof(bitmap_info.bmiHeader);
+    bitmap_info.bmiHeader.biWidth = static_cast<LONG>(width);
+    // 高度为负数时DIB自上而下排列，与纹理的内存布局一致
+    bitmap_info.bmiHeader.biHeight = -static_cast<LONG>(height);
+    bitmap_info.bmiHeader.biPlanes = 1;
+    bitmap_info.bmiHeader.biBitCount = 32;
+    bitmap_info.bmiHeader.biCompression = BI_RGB;
+
+    DibSection dib_section{};
+    dib_section.m_hdc = ::CreateCompatibleDC(NULL);
+    if (dib_section.m_hdc == NULL)
+    {
+        throw std::runtime_error{"CreateCompatibleDC failed."};
+    }
+    void* p_bits = nullptr;
+    dib_section.m_bitmap = ::CreateDIBSection(dib_section.m_hdc, &bitmap_info, DIB_RGB_COLORS, &p_bits, NULL, 0);
+    if (dib_section.m_bitmap == NULL)
+    {
+        ::DeleteDC(dib_section.m_hdc);
+        throw std::runtime_error{"CreateDIBSection failed."};
+    }
+    dib_section.m_old_bitmap = ::SelectObject(dib_section.m_hdc, dib_section.m_bitmap);
+    m_dib_sections.push_back(dib_section);
+    // 32位DIB的每行天然按DWORD对齐
+    return {static_cast<std::uint8_t*>(p_bits), width * MappedSurfaceBuffer::BYTES_PER_PIXEL, dib_section.m_hdc};
+}
+
+void CGdiSurfaceMemory::FreeBuffer(MappedSurfaceBuffer& buffer) noexcept
+{
+    auto it = std::find_if(
+        m_dib_sections.begin(),
+        m_dib_sections.end(),
+        [&buffer](const DibSection& dib_section)
+        { return dib_section.m_hdc == buffer.m_p_native_handle; });
+    if (it != m_dib_sections.end())
+    {
+        ::SelectObject(it->m_hdc, it->m_old_bitmap);
+        ::DeleteObject(it->m_bitmap);
+        ::DeleteDC(it->m_hdc);
+        m_dib_sections.erase(it);
+    }
+    buffer = {};
+}
+
+void CGdiSurfaceMemory::Synchronize() noexcept
+{
+    ::GdiFlush();
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <vector>
+#include <Windows.h>
+#include "CMappedSurface.h"
+
+/**
+ * @brief 以DIB section作为像素内存，GDI通过m_p_native_handle中的HDC直接绘制到映射内存， \n
+ * 不再需要GDI兼容纹理和额外的复制
+ */
+class CGdiSurfaceMemory final : public IMappedSurfaceMemory
+{
+private:
+    struct DibSection
+    {
+        HDC m_hdc{};
+        HBITMAP m_bitmap{};
+        HGDIOBJ m_old_bitmap{};
+    };
+
+    std::vector<DibSection> m_dib_sections{};
+
+public:
+    CGdiSurfaceMemory() = default;
+    ~CGdiSurfaceMemory() override = default;
+
+    auto AllocateBuffer(std::uint32_t width, std::uint32_t height)
+        -> MappedSurfaceBuffer override;
+    void FreeBuffer(MappedSurfaceBuffer& buffer) noexcept override;
+    void Synchronize() noexcept override;
+};
@@ -0,0 +1,291 @@
+#include "CGpuMemoryBudget.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "GpuResourceDescription.h"
+
+auto GetGpuMemoryCategoryName(GpuMemoryCategory category) noexcept
+    -> const char*
+{
+    switch (category)
+    {
+    case GpuMemoryCategory::Atlas:
+        return "atlas";
+    case GpuMemoryCategory::Intermediate:
+        return "intermediate";
+    case GpuMemoryCategory::Staging:
+        return "staging";
+    case GpuMemoryCategory::SwapChain:
+        return "swap chain";
+    case GpuMemoryCategory::Buffer:
+        return "buffer";
+    }
+    return "unknown";
+}
+
+auto EstimateTexture2DBytes(std::uint32_t width, std::uint32_t height, std::uint32_t format, std::uint32_t mip_levels, std::uint32_t array_size) noexcept
+    -> std::uint64_t
+{
+    const auto bytes_per_pixel = GpuFormat::GetBytesPerPixel(format);
+    const std::uint64_t pixel_size = bytes_per_pixel == 0 ? 4 : bytes_per_pixel;
+    // MipLevels为0表示完整的mip链
+    const auto level_count = mip_levels == 0 ? 32u : mip_levels;
+    std::uint64_t bytes = 0;
+    for (std::uint32_t level = 0; level < level_count; ++level)
+    {
+        const auto level_width = (std::max)(1u, width >> level);
+        const auto level_height = (std::max)(1u, height >> level);
+        bytes += std::uint64_t{level_width} * level_height * pixel_size;
+        if (level_width == 1 && level_height == 1)
+        {
+            break;
+        }
+    }
+    return bytes * (std::max)(1u, array_size);
+}
+
+CGpuMemoryBudget::CGpuMemoryBudget(const GpuMemoryBudgetConfig& config)
+    : m_config{config}
+{
+    if (m_config.m_hard_limit_bytes < m_config.m_budget_bytes)
+    {
+        throw std::invalid_argument{"Hard limit of GPU memory budget must not be less than the budget."};
+    }
+}
+
+bool CGpuMemoryBudget::IsValid(GpuAllocationHandle handle) const noexcept
+{
+    const auto index = handle.GetIndex();
+    return !handle.IsNull() &&
+           index < m_allocations.size() &&
+           m_allocations[index].m_is_active &&
+           m_allocations[index].m_generation == handle.GetGeneration();
+}
+
+void CGpuMemoryBudget::LinkTail(std::uint32_t index) noexcept
+{
+    auto& allocation = m_allocations[index];
+    allocation.m_previous = m_lru_tail;
+    allocation.m_next = INVALID_ALLOCATION;
+    if (m_lru_tail != INVALID_ALLOCATION)
+    {
+        m_allocations[m_lru_tail].m_next = index;
+    }
+    else
+    {
+        m_lru_head = index;
+    }
+    m_lru_tail = index;
+}
+
+void CGpuMemoryBudget::Unlink(std::uint32_t index) noexcept
+{
+    auto& allocation = m_allocations[index];
+    if (allocation.m_previous != INVALID_ALLOCATION)
+    {
+        m_allocations[allocation.m_previous].m_next = allocation.m_next;
+    }
+    else
+    {
+        m_lru_head = allocation.m_next;
+    }
+    if (allocation.m_next != INVALID_ALLOCATION)
+    {
+        m_allocations[allocation.m_next].m_previous = allocation.m_previous;
+    }
+    else
+    {
+        m_lru_tail = allocation.m_previous;
+    }
+    allocation.m_previous = INVALID_ALLOCATION;
+    allocation.m_next = INVALID_ALLOCATION;
+}
+
+void CGpuMemoryBudget::Free(std::uint32_t index) noexcept
+{
+    auto& allocation = m_allocations[index];
+    if (allocation.m_p_evictor != nullptr)
+    {
+        Unlink(index);
+        m_evictable_bytes -= allocation.m_bytes;
+    }
+    auto& usage = m_statistics.m_categories[static_cast<std::size_t>(allocation.m_category)];
+    usage.m_current_bytes -= allocation.m_bytes;
+    --usage.m_allocation_count;
+    m_statistics.m_current_bytes -= allocation.m_bytes;
+
+    allocation.m_is_active = false;
+    allocation.m_p_evictor = nullptr;
+    // 代数为0会使句柄可能为0，跳过
+    const auto next_generation = static_cast<std::uint16_t>((allocation.m_generation + 1) & GpuAllocationHandle::GENERATION_MASK);
+    allocation.m_generation = next_generation == 0 ? 1 : next_generation;
+    m_free_allocations.push_back(index);
+}
+
+void CGpuMemoryBudget::EvictUntil(std::uint64_t target_bytes, std::uint64_t incoming_bytes)
+{
+    while (m_lru_head != INVALID_ALLOCATION && m_statistics.m_current_bytes + incoming_bytes > target_bytes)
+    {
+        const auto index = m_lru_head;
+        const auto& allocation = m_allocations[index];
+        const auto handle = GpuAllocationHandle::Make(index, allocation.m_generation);
+        auto* const p_evictor = allocation.m_p_evictor;
+        const auto user_data = allocation.m_user_data;
+        ++m_statistics.m_evicted_count;
+        m_statistics.m_evicted_bytes += allocation.m_bytes;
+        // 先回收再通知，所有者在Evict中调用Release也是安全的
+        Free(index);
+        p_evictor->Evict(handle, user_data);
+    }
+}
+
+auto CGpuMemoryBudget::TryReserve(GpuMemoryCategory category, std::uint64_t bytes, IGpuMemoryEvictor* p_evictor, std::uint64_t user_data)
+    -> GpuAllocationHandle
+{
+    // 即使逐出全部可逐出的分配也放不下时直接拒绝，不白白丢弃缓存
+    if (m_statistics.m_current_bytes - m_evictable_bytes + bytes > m_config.m_hard_limit_bytes)
+    {
+        ++m_statistics.m_rejected_count;
+        return {};
+    }
+    EvictUntil(m_config.m_budget_bytes, bytes);
+    if (m_statistics.m_current_bytes + bytes > m_config.m_budget_bytes)
+    {
+        ++m_statistics.m_over_budget_count;
+    }
+
+    std::uint32_t index{};
+    if (!m_free_allocations.empty())
+    {
+        index = m_free_allocations.back();
+        m_free_allocations.pop_back();
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(m_allocations.size());
+        if (index > GpuAllocationHandle::INDEX_MASK)
+        {
+            throw std::length_error{"Too many GPU memory allocations."};
+        }
+        m_allocations.emplace_back();
+    }
+    auto& allocation = m_allocations[index];
+    allocation.m_bytes = bytes;
+    allocation.m_user_data = user_data;
+    allocation.m_p_evictor = p_evictor;
+    allocation.m_category = category;
+    allocation.m_is_active = true;
+    if (p_evictor != nullptr)
+    {
+        LinkTail(index);
+        m_evictable_bytes += bytes;
+    }
+
+    auto& usage = m_statistics.m_categories[static_cast<std::size_t>(category)];
+    usage.m_current_bytes += bytes;
+    usage.m_peak_bytes = (std::max)(usage.m_peak_bytes, usage.m_current_bytes);
+    ++usage.m_allocation_count;
+    m_statistics.m_current_bytes += bytes;
+    m_statistics.m_peak_bytes = (std::max)(m_statistics.m_peak_bytes, m_statistics.m_current_bytes);
+    ++m_statistics.m_reserved_count;
+    return GpuAllocationHandle::Make(index, allocation.m_generation);
+}
+
+auto CGpuMemoryBudget::Reserve(GpuMemoryCategory category, std::uint64_t bytes, IGpuMemoryEvictor* p_evictor, std::uint64_t user_data)
+    -> GpuAllocationHandle
+{
+    const auto handle = TryReserve(category, bytes, p_evictor, user_data);
+    if (handle.IsNull())
+    {
+        throw std::runtime_error{"GPU memory hard limit exceeded."};
+    }
+    return handle;
+}
+
+bool CGpuMemoryBudget::Release(GpuAllocationHandle handle) noexcept
+{
+    if (!IsValid(handle))
+    {
+        return false;
+    }
+    Free(handle.GetIndex());
+    ++m_statistics.m_released_count;
+    return true;
+}
+
+void CGpuMemoryBudget::Touch(GpuAllocationHandle handle) noexcept
+{
+    if (!IsValid(handle) || m_allocations[handle.GetIndex()].m_p_evictor == nullptr)
+    {
+        return;
+    }
+    Unlink(handle.GetIndex());
+    LinkTail(handle.GetIndex());
+}
+
+bool CGpuMemoryBudget::IsActive(GpuAllocationHandle handle) const noexcept
+{
+    return IsValid(handle);
+}
+
+void CGpuMemoryBudget::SetConfig(const GpuMemoryBudgetConfig& config)
+{
+    if (config.m_hard_limit_bytes < config.m_budget_bytes)
+    {
+        throw std::invalid_argument{"Hard limit of GPU memory budget must not be less than the budget."};
+    }
+    m_config = config;
+    EvictUntil(m_config.m_budget_bytes, 0);
+}
+
+auto CGpuMemoryBudget::GetConfig() const noexcept
+    -> const GpuMemoryBudgetConfig&
+{
+    return m_config;
+}
+
+auto CGpuMemoryBudget::GetStatistics() const noexcept
+    -> const GpuMemoryBudgetStatistics&
+{
+    return m_statistics;
+}
+
+CGpuMemoryReservation::CGpuMemoryReservation(CGpuMemoryBudget* p_budget, GpuMemoryCategory category, std::uint64_t bytes)
+    : m_p_budget{p_budget}
+{
+    if (m_p_budget != nullptr)
+    {
+        m_handle = m_p_budget->Reserve(category, bytes);
+    }
+}
+
+CGpuMemoryReservation::~CGpuMemoryReservation()
+{
+    Reset();
+}
+
+CGpuMemoryReservation::CGpuMemoryReservation(CGpuMemoryReservation&& other) noexcept
+    : m_p_budget{std::exchange(other.m_p_budget, nullptr)}, m_handle{std::exchange(other.m_handle, {})}
+{
+}
+
+CGpuMemoryReservation& CGpuMemoryReservation::operator=(CGpuMemoryReservation&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        m_p_budget = std::exchange(other.m_p_budget, nullptr);
+        m_handle = std::exchange(other.m_handle, {});
+    }
+    return *this;
+}
+
+void CGpuMemoryReservation::Reset() noexcept
+{
+    if (m_p_budget != nullptr)
+    {
+        m_p_budget->Release(m_handle);
+    }
+    m_p_budget = nullptr;
+    m_handle = {};
+}
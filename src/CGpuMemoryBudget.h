@@ -0,0 +1,198 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CHandleTable.h"
+
+enum class GpuMemoryCategory : std::uint8_t
+{
+    /**
+     * @brief 图集等可以随时丢弃并重新生成的缓存
+     */
+    Atlas,
+    /**
+     * @brief 渲染目标和中间纹理
+     */
+    Intermediate,
+    /**
+     * @brief 上传和读回使用的STAGING资源
+     */
+    Staging,
+    SwapChain,
+    /**
+     * @brief 顶点、索引和常量缓冲
+     */
+    Buffer,
+};
+
+constexpr std::size_t GPU_MEMORY_CATEGORY_COUNT = 5;
+
+auto GetGpuMemoryCategoryName(GpuMemoryCategory category) noexcept
+    -> const char*;
+
+/**
+ * @brief 估算二维纹理占用的显存：各级mip之和乘以数组大小，未知格式按每像素4字节计算
+ */
+auto EstimateTexture2DBytes(std::uint32_t width, std::uint32_t height, std::uint32_t format, std::uint32_t mip_levels, std::uint32_t array_size) noexcept
+    -> std::uint64_t;
+
+struct GpuAllocation;
+using GpuAllocationHandle = Handle<GpuAllocation>;
+
+/**
+ * @brief 可逐出分配的所有者，例如图集或资源池
+ */
+class IGpuMemoryEvictor
+{
+public:
+    virtual ~IGpuMemoryEvictor() = default;
+
+    /**
+     * @brief 预算不足时调用，实现应释放该分配对应的资源；调用时句柄已被回收，不需要再Release \n
+     * 不得在其中调用CGpuMemoryBudget的Reserve
+     */
+    virtual void Evict(GpuAllocationHandle allocation, std::uint64_t user_data) = 0;
+};
+
+struct GpuMemoryBudgetConfig
+{
+    /**
+     * @brief 软预算：新的分配使总量超过它时，先按最久未使用的顺序逐出可逐出的分配
+     */
+    std::uint64_t m_budget_bytes{256ull << 20};
+    /**
+     * @brief 硬上限：逐出全部可逐出的分配后仍会超过它时拒绝分配
+     */
+    std::uint64_t m_hard_limit_bytes{384ull << 20};
+};
+
+struct GpuMemoryCategoryUsage
+{
+    std::uint64_t m_current_bytes{};
+    std::uint64_t m_peak_bytes{};
+    std::uint64_t m_allocation_count{};
+};
+
+struct GpuMemoryBudgetStatistics
+{
+    std::array<GpuMemoryCategoryUsage, GPU_MEMORY_CATEGORY_COUNT> m_categories{};
+    std::uint64_t m_current_bytes{};
+    std::uint64_t m_peak_bytes{};
+    std::uint64_t m_reserved_count{};
+    std::uint64_t m_released_count{};
+    std::uint64_t m_evicted_count{};
+    std::uint64_t m_evicted_bytes{};
+    /**
+     * @brief 因超过硬上限被拒绝的分配数
+     */
+    std::uint64_t m_rejected_count{};
+    /**
+     * @brief 逐出后仍超过软预算、但没有超过硬上限而被允许的分配数
+     */
+    std::uint64_t m_over_budget_count{};
+};
+
+/**
+ * @brief 显存预算：按类别记录每一次纹理和缓冲分配的字节数 \n
+ * 可逐出的分配按使用顺序挂在侵入式链表上，超出软预算时从最久未使用的一端逐出，超过硬上限的分配被拒绝 \n
+ * 只记账，不创建资源；调用者在创建资源之前预留，销毁资源之后释放
+ */
+class CGpuMemoryBudget
+{
+private:
+    constexpr static std::uint32_t INVALID_ALLOCATION = 0xFFFFFFFFu;
+
+    struct Allocation
+    {
+        std::uint64_t m_bytes{};
+        std::uint64_t m_user_data{};
+        IGpuMemoryEvictor* m_p_evictor{};
+        std::uint32_t m_previous{INVALID_ALLOCATION};
+        std::uint32_t m_next{INVALID_ALLOCATION};
+        std::uint16_t m_generation{1};
+        GpuMemoryCategory m_category{};
+        bool m_is_active{};
+    };
+
+    GpuMemoryBudgetConfig m_config{};
+    std::vector<Allocation> m_allocations{};
+    std::vector<std::uint32_t> m_free_allocations{};
+    // 可逐出分配的链表，表头最久未使用
+    std::uint32_t m_lru_head{INVALID_ALLOCATION};
+    std::uint32_t m_lru_tail{INVALID_ALLOCATION};
+    std::uint64_t m_evictable_bytes{};
+    GpuMemoryBudgetStatistics m_statistics{};
+
+    bool IsValid(GpuAllocationHandle handle) const noexcept;
+    void LinkTail(std::uint32_t index) noexcept;
+    void Unlink(std::uint32_t index) noexcept;
+    void Free(std::uint32_t index) noexcept;
+    /**
+     * @brief 逐出可逐出的分配，直到总量加上incoming_bytes不超过target_bytes或没有可逐出的分配
+     */
+    void EvictUntil(std::uint64_t target_bytes, std::uint64_t incoming_bytes);
+
+public:
+    explicit CGpuMemoryBudget(const GpuMemoryBudgetConfig& config = {});
+    ~CGpuMemoryBudget() = default;
+    CGpuMemoryBudget(const CGpuMemoryBudget&) = delete;
+    CGpuMemoryBudget& operator=(const CGpuMemoryBudget&) = delete;
+
+    /**
+     * @brief 预留bytes字节，必要时先逐出其它分配
+     *
+     * @param p_evictor 不为空时该分配可以被逐出
+     * @param user_data 逐出时原样传给p_evictor
+     * @return 超过硬上限时返回空句柄
+     */
+    auto TryReserve(GpuMemoryCategory category, std::uint64_t bytes, IGpuMemoryEvictor* p_evictor = nullptr, std::uint64_t user_data = 0)
+        -> GpuAllocationHandle;
+    /**
+     * @brief 与TryReserve相同，超过硬上限时抛出std::runtime_error
+     */
+    auto Reserve(GpuMemoryCategory category, std::uint64_t bytes, IGpuMemoryEvictor* p_evictor = nullptr, std::uint64_t user_data = 0)
+        -> GpuAllocationHandle;
+    /**
+     * @brief 释放预留，句柄已失效（已释放或已被逐出）时返回false
+     */
+    bool Release(GpuAllocationHandle handle) noexcept;
+    /**
+     * @brief 标记可逐出的分配刚被使用，使其最后被逐出
+     */
+    void Touch(GpuAllocationHandle handle) noexcept;
+    bool IsActive(GpuAllocationHandle handle) const noexcept;
+
+    /**
+     * @brief 修改预算，总量超出新的软预算时立即逐出
+     */
+    void SetConfig(const GpuMemoryBudgetConfig& config);
+    auto GetConfig() const noexcept
+        -> const GpuMemoryBudgetConfig&;
+    auto GetStatistics() const noexcept
+        -> const GpuMemoryBudgetStatistics&;
+};
+
+/**
+ * @brief 在析构时释放的预留，用于生命周期与某个对象绑定的资源
+ */
+class CGpuMemoryReservation
+{
+private:
+    CGpuMemoryBudget* m_p_budget{};
+    GpuAllocationHandle m_handle{};
+
+public:
+    CGpuMemoryReservation() = default;
+    /**
+     * @brief p_budget为空时不记账，超过硬上限时抛出std::runtime_error
+     */
+    CGpuMemoryReservation(CGpuMemoryBudget* p_budget, GpuMemoryCategory category, std::uint64_t bytes);
+    ~CGpuMemoryReservation();
+    CGpuMemoryReservation(const CGpuMemoryReservation&) = delete;
+    CGpuMemoryReservation& operator=(const CGpuMemoryReservation&) = delete;
+    CGpuMemoryReservation(CGpuMemoryReservation&& other) noexcept;
+    CGpuMemoryReservation& operator=(CGpuMemoryReservation&& other) noexcept;
+
+    void Reset() noexcept;
+};
@@ -0,0 +1,267 @@
+#include "CGpuTimerRing.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+CRollingTimings::CRollingTimings(std::size_t window_size)
+    : m_samples(window_size == 0 ? 1 : window_size)
+{
+}
+
+void CRollingTimings::Push(double sample_ms) noexcept
+{
+    if (m_count == m_samples.size())
+    {
+        m_sum -= m_samples[m_next];
+    }
+    else
+    {
+        ++m_count;
+    }
+    m_samples[m_next] = sample_ms;
+    m_sum += sample_ms;
+    m_next = (m_next + 1) % m_samples.size();
+    ++m_total_count;
+}
+
+auto CRollingTimings::GetCount() const noexcept
+    -> std::size_t
+{
+    return m_count;
+}
+
+auto CRollingTimings::GetTotalCount() const noexcept
+    -> std::uint64_t
+{
+    return m_total_count;
+}
+
+auto CRollingTimings::GetLast() const noexcept
+    -> double
+{
+    return m_count == 0 ? 0.0 : m_samples[(m_next + m_samples.size() - 1) % m_samples.size()];
+}
+
+auto CRollingTimings::GetAverage() const noexcept
+    -> double
+{
+    return m_count == 0 ? 0.0 : m_sum / m_count;
+}
+
+auto CRollingTimings::GetMin() const noexcept
+    -> double
+{
+    return m_count == 0 ? 0.0 : *std::min_element(m_samples.begin(), m_samples.begin() + m_count);
+}
+
+auto CRollingTimings::GetMax() const noexcept
+    -> double
+{
+    return m_count == 0 ? 0.0 : *std::max_element(m_samples.begin(), m_samples.begin() + m_count);
+}
+
+CGpuTimerRing::CGpuTimerRing(IGpuTimerBackend& backend, const GpuTimerRingConfig& config)
+    : m_backend{backend}, m_config{config}
+{
+    if (m_config.m_ring_depth == 0 || m_config.m_max_pass_count == 0)
+    {
+        throw std::invalid_argument{"Depth and pass count of GPU timer ring must not be zero."};
+    }
+    m_slots.resize(m_config.m_ring_depth);
+    for (auto& slot : m_slots)
+    {
+        // 每个阶段占用一对时间戳
+        slot.m_backend_index = m_backend.CreateFrameSlot(m_config.m_max_pass_count * 2);
+        slot.m_pass_states.resize(m_config.m_max_pass_count, PassState::Idle);
+    }
+    m_pass_names.reserve(m_config.m_max_pass_count);
+    m_pass_timings.reserve(m_config.m_max_pass_count);
+}
+
+auto CGpuTimerRing::RegisterPass(std::string name)
+    -> std::uint32_t
+{
+    if (m_pass_names.size() >= m_config.m_max_pass_count)
+    {
+        throw std::logic_error{"Too many passes registered in GPU timer ring."};
+    }
+    m_pass_names.push_back(std::move(name));
+    m_pass_timings.emplace_back(m_config.m_window_size);
+    return static_cast<std::uint32_t>(m_pass_names.size() - 1);
+}
+
+bool CGpuTimerRing::BeginFrame()
+{
+    if (m_is_in_frame)
+    {
+        throw std::logic_error{"GPU timer frame has already begun."};
+    }
+    Resolve();
+    m_is_in_frame = true;
+    ++m_frame_index;
+    ++m_statistics.m_frame_count;
+    // 帧按顺序读取，下一个槽仍在途就说明全部在途，跳过本帧而不是等待
+    if (m_pending_count == m_slots.size())
+    {
+        ++m_statistics.m_skipped_frame_count;
+        return false;
+    }
+    auto& slot = m_slots[m_next_slot];
+    std::fill(slot.m_pass_states.begin(), slot.m_pass_states.end(), PassState::Idle);
+    slot.m_frame_index = m_frame_index;
+    m_backend.BeginDisjoint(slot.m_backend_index);
+    m_p_active_slot = &slot;
+    return true;
+}
+
+void CGpuTimerRing::BeginPass(std::uint32_t pass)
+{
+    if (!m_is_in_frame || pass >= m_pass_names.size())
+    {
+        throw std::logic_error{"GPU timer pass begins outside a frame or is not registered."};
+    }
+    if (m_p_active_slot == nullptr)
+    {
+        return;
+    }
+    auto& state = m_p_active_slot->m_pass_states[pass];
+    if (state != PassState::Idle)
+    {
+        throw std::logic_error{"GPU timer pass has already been timed in this frame."};
+    }
+    m_backend.WriteTimestamp(m_p_active_slot->m_backend_index, pass * 2);
+    state = PassState::Begun;
+}
+
+void CGpuTimerRing::EndPass(std::uint32_t pass)
+{
+    if (!m_is_in_frame || pass >= m_pass_names.size())
+    {
+        throw std::logic_error{"GPU timer pass ends outside a frame or is not registered."};
+    }
+    if (m_p_active_slot == nullptr)
+    {
+        return;
+    }
+    auto& state = m_p_active_slot->m_pass_states[pass];
+    if (state != PassState::Begun)
+    {
+        throw std::logic_error{"GPU timer pass ends without beginning."};
+    }
+    m_backend.WriteTimestamp(m_p_active_slot->m_backend_index, pass * 2 + 1);
+    state = PassState::Ended;
+}
+
+void CGpuTimerRing::EndFrame()
+{
+    if (!m_is_in_frame)
+    {
+        throw std::logic_error{"GPU timer frame ends without beginning."};
+    }
+    m_is_in_frame = false;
+    if (m_p_active_slot == nullptr)
+    {
+        return;
+    }
+    if (std::find(m_p_active_slot->m_pass_states.begin(), m_p_active_slot->m_pass_states.end(), PassState::Begun) != m_p_active_slot->m_pass_states.end())
+    {
+        throw std::logic_error{"GPU timer pass has not ended before the end of frame."};
+    }
+    m_backend.EndDisjoint(m_p_active_slot->m_backend_index);
+    m_p_active_slot = nullptr;
+    m_next_slot = (m_next_slot + 1) % static_cast<std::uint32_t>(m_slots.size());
+    ++m_pending_count;
+}
+
+auto CGpuTimerRing::TryResolve(FrameSlot& slot)
+    -> bool
+{
+    const auto disjoint = m_backend.TryGetDisjoint(slot.m_backend_index);
+    if (!disjoint)
+    {
+        return false;
+    }
+    // 先读出全部时间戳，任何一个未完成都留到下次，避免只记录了一部分阶段
+    m_timestamps.assign(slot.m_pass_states.size() * 2, 0);
+    for (std::uint32_t pass = 0; pass < slot.m_pass_states.size(); ++pass)
+    {
+        if (slot.m_pass_states[pass] != PassState::Ended)
+        {
+            continue;
+        }
+        const auto begin_timestamp = m_backend.TryGetTimestamp(slot.m_backend_index, pass * 2);
+        const auto end_timestamp = m_backend.TryGetTimestamp(slot.m_backend_index, pass * 2 + 1);
+        if (!begin_timestamp || !end_timestamp)
+        {
+            return false;
+        }
+        m_timestamps[pass * 2] = *begin_timestamp;
+        m_timestamps[pass * 2 + 1] = *end_timestamp;
+    }
+
+    const auto latency_frames = m_frame_index - slot.m_frame_index;
+    if (disjoint->m_is_disjoint || disjoint->m_frequency == 0)
+    {
+        ++m_statistics.m_disjoint_frame_count;
+        return true;
+    }
+    for (std::uint32_t pass = 0; pass < slot.m_pass_states.size(); ++pass)
+    {
+        if (slot.m_pass_states[pass] != PassState::Ended)
+        {
+            continue;
+        }
+        const auto begin_timestamp = m_timestamps[pass * 2];
+        const auto end_timestamp = m_timestamps[pass * 2 + 1];
+        const auto ticks = end_timestamp > begin_timestamp ? end_timestamp - begin_timestamp : 0;
+        m_pass_timings[pass].Push(static_cast<double>(ticks) * 1000.0 / static_cast<double>(disjoint->m_frequency));
+    }
+    ++m_statistics.m_resolved_frame_count;
+    m_statistics.m_total_latency_frames += latency_frames;
+    m_statistics.m_max_latency_frames = (std::max)(m_statistics.m_max_latency_frames, latency_frames);
+    return true;
+}
+
+void CGpuTimerRing::Resolve()
+{
+    while (m_pending_count != 0)
+    {
+        const auto oldest_slot = (m_next_slot + m_slots.size() - m_pending_count) % m_slots.size();
+        if (!TryResolve(m_slots[oldest_slot]))
+        {
+            return;
+        }
+        --m_pending_count;
+    }
+}
+
+void CGpuTimerRing::DiscardPending() noexcept
+{
+    m_pending_count = 0;
+    m_is_in_frame = false;
+    m_p_active_slot = nullptr;
+}
+
+auto CGpuTimerRing::GetPassCount() const noexcept
+    -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(m_pass_names.size());
+}
+
+auto CGpuTimerRing::GetPassName(std::uint32_t pass) const
+    -> const std::string&
+{
+    return m_pass_names.at(pass);
+}
+
+auto CGpuTimerRing::GetPassTimings(std::uint32_t pass) const
+    -> const CRollingTimings&
+{
+    return m_pass_timings.at(pass);
+}
+
+auto CGpuTimerRing::GetStatistics() const noexcept
+    -> const GpuTimerStatistics&
+{
+    return m_statistics;
+}
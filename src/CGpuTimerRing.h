@@ -0,0 +1,200 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct GpuTimestampDisjoint
+{
+    /**
+     * @brief 时间戳每秒递增的次数
+     */
+    std::uint64_t m_frequency{};
+    /**
+     * @brief 为true时区间内的时间戳不可比较（降频、切换电源状态等），该帧的结果应丢弃
+     */
+    bool m_is_disjoint{};
+};
+
+/**
+ * @brief GPU计时环的后端，每个帧槽包含一对DISJOINT查询的区间和若干个时间戳查询
+ */
+class IGpuTimerBackend
+{
+public:
+    virtual ~IGpuTimerBackend() = default;
+
+    /**
+     * @brief 创建一个帧槽，返回从0开始连续的编号
+     */
+    virtual auto CreateFrameSlot(std::uint32_t timestamp_count)
+        -> std::uint32_t = 0;
+    virtual void BeginDisjoint(std::uint32_t slot) = 0;
+    virtual void EndDisjoint(std::uint32_t slot) = 0;
+    /**
+     * @brief 在命令流中插入时间戳，只能在BeginDisjoint与EndDisjoint之间调用
+     */
+    virtual void WriteTimestamp(std::uint32_t slot, std::uint32_t index) = 0;
+    /**
+     * @brief 读取DISJOINT查询的结果，未完成时返回std::nullopt，不得等待
+     */
+    virtual auto TryGetDisjoint(std::uint32_t slot)
+        -> std::optional<GpuTimestampDisjoint> = 0;
+    /**
+     * @brief 读取时间戳，未完成时返回std::nullopt，不得等待
+     */
+    virtual auto TryGetTimestamp(std::uint32_t slot, std::uint32_t index)
+        -> std::optional<std::uint64_t> = 0;
+};
+
+struct GpuTimerRingConfig
+{
+    /**
+     * @brief 帧槽数量；为N时通常在N-1帧之后读到结果，全部在途时跳过该帧的计时
+     */
+    std::uint32_t m_ring_depth{4};
+    /**
+     * @brief 最多可以登记的阶段数量
+     */
+    std::uint32_t m_max_pass_count{8};
+    /**
+     * @brief 滚动统计保留的最近帧数
+     */
+    std::uint32_t m_window_size{120};
+};
+
+/**
+ * @brief 最近若干个样本的滚动统计，写满后覆盖最早的样本
+ */
+class CRollingTimings
+{
+private:
+    std::vector<double> m_samples{};
+    std::size_t m_next{};
+    std::size_t m_count{};
+    double m_sum{};
+    std::uint64_t m_total_count{};
+
+public:
+    explicit CRollingTimings(std::size_t window_size);
+
+    void Push(double sample_ms) noexcept;
+    /**
+     * @brief 窗口内的样本数
+     */
+    auto GetCount() const noexcept
+        -> std::size_t;
+    /**
+     * @brief 包括已经移出窗口的样本在内的总样本数
+     */
+    auto GetTotalCount() const noexcept
+        -> std::uint64_t;
+    /**
+     * @brief 以下均在窗口为空时返回0
+     */
+    auto GetLast() const noexcept
+        -> double;
+    auto GetAverage() const noexcept
+        -> double;
+    auto GetMin() const noexcept
+        -> double;
+    auto GetMax() const noexcept
+        -> double;
+};
+
+struct GpuTimerStatistics
+{
+    std::uint64_t m_frame_count{};
+    std::uint64_t m_resolved_frame_count{};
+    /**
+     * @brief 没有空闲帧槽、没有计时的帧数
+     */
+    std::uint64_t m_skipped_frame_count{};
+    /**
+     * @brief 时间戳不可比较、结果被丢弃的帧数
+     */
+    std::uint64_t m_disjoint_frame_count{};
+    /**
+     * @brief 读到结果时与最新一帧相差的帧数之和，除以m_resolved_frame_count即平均延迟
+     */
+    std::uint64_t m_total_latency_frames{};
+    std::uint64_t m_max_latency_frames{};
+};
+
+/**
+ * @brief 按阶段统计GPU耗时的时间戳环：每帧在DISJOINT区间内为每个阶段写入起止时间戳， \n
+ * 几帧之后查询完成时再读取，从不等待GPU；阶段可以嵌套或交错，每帧每个阶段最多计时一次
+ */
+class CGpuTimerRing
+{
+private:
+    enum class PassState : std::uint8_t
+    {
+        Idle,
+        Begun,
+        Ended,
+    };
+    struct FrameSlot
+    {
+        std::uint32_t m_backend_index{};
+        std::uint64_t m_frame_index{};
+        std::vector<PassState> m_pass_states{};
+    };
+
+    IGpuTimerBackend& m_backend;
+    GpuTimerRingConfig m_config{};
+    std::vector<FrameSlot> m_slots{};
+    std::uint32_t m_next_slot{};
+    std::uint32_t m_pending_count{};
+    std::vector<std::string> m_pass_names{};
+    std::vector<CRollingTimings> m_pass_timings{};
+    std::uint64_t m_frame_index{};
+    bool m_is_in_frame{};
+    FrameSlot* m_p_active_slot{};
+    std::vector<std::uint64_t> m_timestamps{};
+    GpuTimerStatistics m_statistics{};
+
+    auto TryResolve(FrameSlot& slot)
+        -> bool;
+
+public:
+    CGpuTimerRing(IGpuTimerBackend& backend, const GpuTimerRingConfig& config = {});
+    ~CGpuTimerRing() = default;
+    CGpuTimerRing(const CGpuTimerRing&) = delete;
+    CGpuTimerRing& operator=(const CGpuTimerRing&) = delete;
+
+    /**
+     * @brief 登记一个阶段，返回的编号用于BeginPass和EndPass
+     */
+    auto RegisterPass(std::string name)
+        -> std::uint32_t;
+    /**
+     * @brief 先读取已经完成的帧，再开始新一帧的计时；没有空闲帧槽时跳过本帧并返回false， \n
+     * 此时本帧的BeginPass和EndPass不做任何事
+     */
+    bool BeginFrame();
+    void BeginPass(std::uint32_t pass);
+    void EndPass(std::uint32_t pass);
+    /**
+     * @brief 结束本帧，本帧开始的阶段都必须已经结束
+     */
+    void EndFrame();
+    /**
+     * @brief 按提交顺序读取已经完成的帧，遇到未完成的帧即停止，不等待GPU
+     */
+    void Resolve();
+    /**
+     * @brief 丢弃全部在途的帧，设备丢失后在重建后端的查询之后调用
+     */
+    void DiscardPending() noexcept;
+
+    auto GetPassCount() const noexcept
+        -> std::uint32_t;
+    auto GetPassName(std::uint32_t pass) const
+        -> const std::string&;
+    auto GetPassTimings(std::uint32_t pass) const
+        -> const CRollingTimings&;
+    auto GetStatistics() const noexcept
+        -> const GpuTimerStatistics&;
+};
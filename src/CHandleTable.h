@@ -0,0 +1,181 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief 32位代际句柄：低20位为槽位序号，高12位为代数；值为0表示无效句柄
+ *
+ * @tparam T 句柄指向的对象类型，仅用于区分不同表的句柄
+ */
+template <class T>
+struct Handle
+{
+    constexpr static std::uint32_t INDEX_BITS = 20;
+    constexpr static std::uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+    constexpr static std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    constexpr static std::uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+    std::uint32_t m_value{};
+
+    constexpr std::uint32_t GetIndex() const noexcept
+    {
+        return m_value & INDEX_MASK;
+    }
+    constexpr std::uint32_t GetGeneration() const noexcept
+    {
+        return m_value >> INDEX_BITS;
+    }
+    constexpr bool IsNull() const noexcept
+    {
+        return m_value == 0;
+    }
+    constexpr static auto Make(std::uint32_t index, std::uint32_t generation) noexcept
+        -> Handle
+    {
+        return {((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK)};
+    }
+
+    constexpr bool operator==(const Handle&) const noexcept = default;
+};
+
+/**
+ * @brief 以结构数组方式存放对象的句柄表：对象紧密排列便于遍历，句柄校验为O(1) \n
+ * 删除对象时用末尾对象填补空位，因此遍历顺序不固定
+ *
+ * @tparam T 存放的对象类型
+ */
+template <class T>
+class CHandleTable
+{
+private:
+    constexpr static std::uint32_t INVALID_DENSE_INDEX = 0xFFFFFFFFu;
+
+    // 稀疏部分，以槽位序号为下标
+    std::vector<std::uint16_t> m_slot_generations{};
+    std::vector<std::uint32_t> m_slot_to_dense{};
+    std::vector<std::uint32_t> m_free_slots{};
+    // 紧密部分，以紧密序号为下标
+    std::vector<T> m_objects{};
+    std::vector<std::uint32_t> m_dense_to_slot{};
+
+public:
+    CHandleTable() = default;
+    ~CHandleTable() = default;
+
+    void Reserve(std::size_t count)
+    {
+        m_slot_generations.reserve(count);
+        m_slot_to_dense.reserve(count);
+        m_objects.reserve(count);
+        m_dense_to_slot.reserve(count);
+    }
+
+    auto Insert(T object)
+        -> Handle<T>
+    {
+        std::uint32_t slot{};
+        if (!m_free_slots.empty())
+        {
+            slot = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<std::uint32_t>(m_slot_generations.size());
+            if (slot > Handle<T>::INDEX_MASK)
+            {
+                throw std::length_error{"Handle table is full."};
+            }
+            m_slot_generations.push_back(1);
+            m_slot_to_dense.push_back(INVALID_DENSE_INDEX);
+        }
+        m_slot_to_dense[slot] = static_cast<std::uint32_t>(m_objects.size());
+        m_objects.push_back(std::move(object));
+        m_dense_to_slot.push_back(slot);
+        return Handle<T>::Make(slot, m_slot_generations[slot]);
+    }
+
+    bool IsValid(Handle<T> handle) const noexcept
+    {
+        const auto slot = handle.GetIndex();
+        return !handle.IsNull() &&
+               slot < m_slot_generations.size() &&
+               m_slot_generations[slot] == handle.GetGeneration() &&
+               m_slot_to_dense[slot] != INVALID_DENSE_INDEX;
+    }
+
+    /**
+     * @brief 获取句柄对应的对象，句柄失效时返回nullptr
+     */
+    auto Get(Handle<T> handle) noexcept
+        -> T*
+    {
+        return IsValid(handle) ? &m_objects[m_slot_to_dense[handle.GetIndex()]] : nullptr;
+    }
+    auto Get(Handle<T> handle) const noexcept
+        -> const T*
+    {
+        return IsValid(handle) ? &m_objects[m_slot_to_dense[handle.GetIndex()]] : nullptr;
+    }
+
+    /**
+     * @brief 删除句柄对应的对象并将其移出，句柄失效时返回false
+     */
+    bool Remove(Handle<T> handle, T* p_removed_object = nullptr)
+    {
+        if (!IsValid(handle))
+        {
+            return false;
+        }
+        const auto slot = handle.GetIndex();
+        const auto dense_index = m_slot_to_dense[slot];
+        const auto last_dense_index = static_cast<std::uint32_t>(m_objects.size() - 1);
+        if (p_removed_object != nullptr)
+        {
+            *p_removed_object = std::move(m_objects[dense_index]);
+        }
+        if (dense_index != last_dense_index)
+        {
+            m_objects[dense_index] = std::move(m_objects[last_dense_index]);
+            m_dense_to_slot[dense_index] = m_dense_to_slot[last_dense_index];
+            m_slot_to_dense[m_dense_to_slot[dense_index]] = dense_index;
+        }
+        m_objects.pop_back();
+        m_dense_to_slot.pop_back();
+        m_slot_to_dense[slot] = INVALID_DENSE_INDEX;
+        // 代数为0会使句柄可能为0，跳过
+        auto next_generation = static_cast<std::uint16_t>((m_slot_generations[slot] + 1) & Handle<T>::GENERATION_MASK);
+        m_slot_generations[slot] = next_generation == 0 ? 1 : next_generation;
+        m_free_slots.push_back(slot);
+        return true;
+    }
+
+    auto GetSize() const noexcept
+        -> std::size_t
+    {
+        return m_objects.size();
+    }
+    /**
+     * @brief 紧密排列的全部对象，可直接遍历
+     */
+    auto GetObjects() noexcept
+        -> std::vector<T>&
+    {
+        return m_objects;
+    }
+    auto GetObjects() const noexcept
+        -> const std::vector<T>&
+    {
+        return m_objects;
+    }
+    /**
+     * @brief 第dense_index个对象的句柄，与GetObjects配合使用
+     */
+    auto GetHandleAt(std::size_t dense_index) const noexcept
+        -> Handle<T>
+    {
+        const auto slot = m_dense_to_slot[dense_index];
+        return Handle<T>::Make(slot, m_slot_generations[slot]);
+    }
+};
@@ -0,0 +1,387 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "DeviceContextCounters.h"
+
+#ifndef INSTRUMENT_DEVICE_CONTEXT
+#define INSTRUMENT_DEVICE_CONTEXT 1
+#endif
+
+/**
+ * @brief 设备上下文的装饰器：提供与被包装的上下文同名的成员函数，转发调用的同时按类别计数并计时 \n
+ * 每帧结束时调用EndFrame，把本帧的计数放入固定大小的环 \n
+ * IS_ENABLED为false时只转发调用，计数和计时在编译期去除；默认由INSTRUMENT_DEVICE_CONTEXT宏决定 \n
+ * 参数原样转发，空指针应写作nullptr而不是NULL，否则会被推导为整数
+ *
+ * @tparam Context ID3D11DeviceContext或其它提供同名成员函数的类型
+ */
+template <class Context, bool IS_ENABLED = INSTRUMENT_DEVICE_CONTEXT != 0>
+class CInstrumentedDeviceContext
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum ShaderStage : std::size_t
+    {
+        VERTEX_SHADER_STAGE,
+        PIXEL_SHADER_STAGE,
+        GEOMETRY_SHADER_STAGE,
+        SHADER_STAGE_COUNT
+    };
+
+    Context* m_p_context{};
+    ContextFrameCounters m_current_frame{};
+    CContextFrameRing m_frames{};
+    std::array<const void*, SHADER_STAGE_COUNT> m_p_bound_shaders{};
+
+    template <class Function>
+    decltype(auto) Invoke(ContextCallCategory category, Function&& function)
+    {
+        if constexpr (IS_ENABLED)
+        {
+            // 析构时记录，返回值和异常都不影响计时
+            struct CallScope
+            {
+                ContextCategoryCounters& m_counters;
+                Clock::time_point m_begin;
+
+                ~CallScope()
+                {
+                    ++m_counters.m_call_count;
+                    m_counters.m_cpu_ns += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_begin).count());
+                }
+            };
+            const CallScope scope{m_current_frame.m_categories[static_cast<std::size_t>(category)], Clock::now()};
+            return function();
+        }
+        else
+        {
+            return function();
+        }
+    }
+
+    template <class Shader>
+    void RecordShaderBind(ShaderStage stage, const Shader& p_shader) noexcept
+    {
+        if constexpr (IS_ENABLED)
+        {
+            const void* const p_bound_shader = p_shader;
+            if (p_bound_shader == m_p_bound_shaders[stage])
+            {
+                ++m_current_frame.m_redundant_shader_bind_count;
+                return;
+            }
+            m_p_bound_shaders[stage] = p_bound_shader;
+            ++m_current_frame.m_shader_switch_count;
+        }
+    }
+
+public:
+    explicit CInstrumentedDeviceContext(Context* p_context) noexcept
+        : m_p_context{p_context}
+    {
+    }
+
+    /**
+     * @brief 设备重建后换成新的上下文，已绑定着色器的记录随之清空
+     */
+    void SetContext(Context* p_context) noexcept
+    {
+        m_p_context = p_context;
+        m_p_bound_shaders.fill(nullptr);
+    }
+    /**
+     * @brief 被包装的上下文，用于需要原始接口的代码；经由它的调用不计数
+     */
+    auto Get() const noexcept
+        -> Context*
+    {
+        return m_p_context;
+    }
+
+    void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location)
+    {
+        if constexpr (IS_ENABLED)
+        {
+            m_current_frame.m_index_count += index_count;
+        }
+        Invoke(ContextCallCategory::Draw, [&]()
+               { m_p_context->DrawIndexed(index_count, start_index_location, base_vertex_location); });
+    }
+
+    void DrawIndexedInstanced(std::uint32_t index_count_per_instance, std::uint32_t instance_count, std::uint32_t start_index_location, std::int32_t base_vertex_location, std::uint32_t start_instance_location)
+    {
+        if constexpr (IS_ENABLED)
+        {
+            m_current_frame.m_index_count += std::uint64_t{index_count_per_instance} * instance_count;
+        }
+        Invoke(ContextCallCategory::Draw, [&]()
+               { m_p_context->DrawIndexedInstanced(index_count_per_instance, instance_count, start_index_location, base_vertex_location, start_instance_location); });
+    }
+
+    template <class... Args>
+    void Draw(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Draw, [&]()
+               { m_p_context->Draw(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void DrawInstanced(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Draw, [&]()
+               { m_p_context->DrawInstanced(std::forward<Args>(args)...); });
+    }
+
+    template <class Shader, class... Args>
+    void VSSetShader(Shader&& p_shader, Args&&... args)
+    {
+        RecordShaderBind(VERTEX_SHADER_STAGE, p_shader);
+        Invoke(ContextCallCategory::ShaderBind, [&]()
+               { m_p_context->VSSetShader(std::forward<Shader>(p_shader), std::forward<Args>(args)...); });
+    }
+
+    template <class Shader, class... Args>
+    void PSSetShader(Shader&& p_shader, Args&&... args)
+    {
+        RecordShaderBind(PIXEL_SHADER_STAGE, p_shader);
+        Invoke(ContextCallCategory::ShaderBind, [&]()
+               { m_p_context->PSSetShader(std::forward<Shader>(p_shader), std::forward<Args>(args)...); });
+    }
+
+    template <class Shader, class... Args>
+    void GSSetShader(Shader&& p_shader, Args&&... args)
+    {
+        RecordShaderBind(GEOMETRY_SHADER_STAGE, p_shader);
+        Invoke(ContextCallCategory::ShaderBind, [&]()
+               { m_p_context->GSSetShader(std::forward<Shader>(p_shader), std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void IASetPrimitiveTopology(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->IASetPrimitiveTopology(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void IASetInputLayout(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->IASetInputLayout(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void RSSetState(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->RSSetState(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void RSSetViewports(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->RSSetViewports(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void RSSetScissorRects(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->RSSetScissorRects(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void OMSetBlendState(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->OMSetBlendState(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void OMSetDepthStencilState(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->OMSetDepthStencilState(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void PSSetSamplers(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->PSSetSamplers(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void SOSetTargets(Args&&... args)
+    {
+        Invoke(ContextCallCategory::StateBind, [&]()
+               { m_p_context->SOSetTargets(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void IASetVertexBuffers(Args&&... args)
+    {
+        Invoke(ContextCallCategory::ResourceBind, [&]()
+               { m_p_context->IASetVertexBuffers(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void IASetIndexBuffer(Args&&... args)
+    {
+        Invoke(ContextCallCategory::ResourceBind, [&]()
+               { m_p_context->IASetIndexBuffer(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void VSSetConstantBuffers(Args&&... args)
+    {
+        Invoke(ContextCallCategory::ResourceBind, [&]()
+               { m_p_context->VSSetConstantBuffers(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void PSSetConstantBuffers(Args&&... args)
+    {
+        Invoke(ContextCallCategory::ResourceBind, [&]()
+               { m_p_context->PSSetConstantBuffers(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void PSSetShaderResources(Args&&... args)
+    {
+        Invoke(ContextCallCategory::ResourceBind, [&]()
+               { m_p_context->PSSetShaderResources(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void OMSetRenderTargets(Args&&... args)
+    {
+        Invoke(ContextCallCategory::ResourceBind, [&]()
+               { m_p_context->OMSetRenderTargets(std::forward<Args>(args)...); });
+    }
+
+    /**
+     * @brief 有目标区域时按区域的行数和层数乘以行距计入上传字节数；没有时无法得知大小，由调用者用RecordUploadedBytes补充
+     */
+    template <class Resource, class Box>
+    void UpdateSubresource(Resource&& p_resource, std::uint32_t subresource, const Box& p_box, const void* p_source, std::uint32_t row_pitch, std::uint32_t depth_pitch)
+    {
+        if constexpr (IS_ENABLED && !std::is_same_v<Box, std::nullptr_t>)
+        {
+            if (p_box != nullptr)
+            {
+                const std::uint64_t depth = p_box->back - p_box->front;
+                m_current_frame.m_uploaded_bytes += std::uint64_t{p_box->bottom - p_box->top} * row_pitch * (std::max)(depth, std::uint64_t{1});
+            }
+        }
+        Invoke(ContextCallCategory::Upload, [&]()
+               { m_p_context->UpdateSubresource(std::forward<Resource>(p_resource), subresource, p_box, p_source, row_pitch, depth_pitch); });
+    }
+
+    template <class... Args>
+    auto Map(Args&&... args)
+    {
+        return Invoke(ContextCallCategory::Upload, [&]()
+                      { return m_p_context->Map(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void Unmap(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Upload, [&]()
+               { m_p_context->Unmap(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void CopyResource(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Upload, [&]()
+               { m_p_context->CopyResource(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void CopySubresourceRegion(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Upload, [&]()
+               { m_p_context->CopySubresourceRegion(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void Flush(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Other, [&]()
+               { m_p_context->Flush(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void ClearRenderTargetView(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Other, [&]()
+               { m_p_context->ClearRenderTargetView(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void Begin(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Other, [&]()
+               { m_p_context->Begin(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    void End(Args&&... args)
+    {
+        Invoke(ContextCallCategory::Other, [&]()
+               { m_p_context->End(std::forward<Args>(args)...); });
+    }
+
+    template <class... Args>
+    auto GetData(Args&&... args)
+    {
+        return Invoke(ContextCallCategory::Other, [&]()
+                      { return m_p_context->GetData(std::forward<Args>(args)...); });
+    }
+
+    /**
+     * @brief 计入不经过本对象的上传，例如上传引擎的暂存纹理和常量缓冲的Map
+     */
+    void RecordUploadedBytes(std::uint64_t bytes) noexcept
+    {
+        if constexpr (IS_ENABLED)
+        {
+            m_current_frame.m_uploaded_bytes += bytes;
+        }
+    }
+    /**
+     * @brief 结束一帧：把本帧的计数放入环并清零
+     */
+    void EndFrame() noexcept
+    {
+        if constexpr (IS_ENABLED)
+        {
+            m_frames.Push(m_current_frame);
+            const auto next_frame_index = m_current_frame.m_frame_index + 1;
+            m_current_frame = {};
+            m_current_frame.m_frame_index = next_frame_index;
+        }
+    }
+
+    constexpr static bool IsEnabled() noexcept
+    {
+        return IS_ENABLED;
+    }
+    /**
+     * @brief 最近各帧的计数；未启用时为空
+     */
+    auto GetFrames() const noexcept
+        -> const CContextFrameRing&
+    {
+        return m_frames;
+    }
+};
@@ -0,0 +1,133 @@
+#include "CMappedFile.h"
+#include <stdexcept>
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+auto CMappedFile::Open(const std::string& path)
+    -> CMappedFile
+{
+    CMappedFile file{};
+#ifdef _WIN32
+    const auto file_handle = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error{"CreateFile failed."};
+    }
+    file.m_file_handle = file_handle;
+    LARGE_INTEGER file_size{};
+    if (!::GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart <= 0)
+    {
+        throw std::runtime_error{"File is empty or its size cannot be queried."};
+    }
+    file.m_size = static_cast<std::size_t>(file_size.QuadPart);
+    file.m_mapping_handle = ::CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (file.m_mapping_handle == NULL)
+    {
+        throw std::runtime_error{"CreateFileMapping failed."};
+    }
+    file.m_p_data = static_cast<const std::uint8_t*>(::MapViewOfFile(file.m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (file.m_p_data == nullptr)
+    {
+        throw std::runtime_error{"MapViewOfFile failed."};
+    }
+#else
+    const int file_descriptor = ::open(path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        throw std::runtime_error{"open failed."};
+    }
+    struct stat file_status{};
+    if (::fstat(file_descriptor, &file_status) != 0 || file_status.st_size <= 0)
+    {
+        ::close(file_descriptor);
+        throw std::runtime_error{"File is empty or its size cannot be queried."};
+    }
+    file.m_size = static_cast<std::size_t>(file_status.st_size);
+    void* p_data = ::mmap(nullptr, file.m_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    ::close(file_descriptor);
+    if (p_data == MAP_FAILED)
+    {
+        file.m_size = 0;
+        throw std::runtime_error{"mmap failed."};
+    }
+    file.m_p_data = static_cast<const std::uint8_t*>(p_data);
+#endif
+    return file;
+}
+
+CMappedFile::~CMappedFile()
+{
+    Close();
+}
+
+CMappedFile::CMappedFile(CMappedFile&& other) noexcept
+    : m_p_data{std::exchange(other.m_p_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)}
+#ifdef _WIN32
+      ,
+      m_file_handle{std::exchange(other.m_file_handle, nullptr)},
+      m_mapping_handle{std::exchange(other.m_mapping_handle, nullptr)}
+#endif
+{
+}
+
+CMappedFile& CMappedFile::operator=(CMappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_p_data = std::exchange(other.m_p_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+        m_file_handle = std::exchange(other.m_file_handle, nullptr);
+        m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void CMappedFile::Close() noexcept
+{
+#ifdef _WIN32
+    if (m_p_data != nullptr)
+    {
+        ::UnmapViewOfFile(m_p_data);
+    }
+    if (m_mapping_handle != nullptr)
+    {
+        ::CloseHandle(m_mapping_handle);
+    }
+    if (m_file_handle != nullptr)
+    {
+        ::CloseHandle(m_file_handle);
+    }
+    m_mapping_handle = nullptr;
+    m_file_handle = nullptr;
+#else
+    if (m_p_data != nullptr)
+    {
+        ::munmap(const_cast<std::uint8_t*>(m_p_data), m_size);
+    }
+#endif
+    m_p_data = nullptr;
+    m_size = 0;
+}
+
+auto CMappedFile::GetData() const noexcept
+    -> const std::uint8_t*
+{
+    return m_p_data;
+}
+
+auto CMappedFile::GetSize() const noexcept
+    -> std::size_t
+{
+    return m_size;
+}
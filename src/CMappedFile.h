@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 只读映射整个文件，内容按需由系统分页读入，大文件不需要一次性复制到内存
+ */
+class CMappedFile
+{
+private:
+    const std::uint8_t* m_p_data{};
+    std::size_t m_size{};
+#ifdef _WIN32
+    void* m_file_handle{};
+    void* m_mapping_handle{};
+#endif
+
+    void Close() noexcept;
+
+public:
+    /**
+     * @brief 映射文件，文件不存在、为空或无法映射时抛出std::runtime_error
+     */
+    static auto Open(const std::string& path)
+        -> CMappedFile;
+
+    CMappedFile() = default;
+    ~CMappedFile();
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+    CMappedFile(CMappedFile&& other) noexcept;
+    CMappedFile& operator=(CMappedFile&& other) noexcept;
+
+    auto GetData() const noexcept
+        -> const std::uint8_t*;
+    auto GetSize() const noexcept
+        -> std::size_t;
+};
@@ -0,0 +1,177 @@
+#include "CMappedSurface.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+auto CAlignedSurfaceMemory::AllocateBuffer(std::uint32_t width, std::uint32_t height)
+    -> MappedSurfaceBuffer
+{
+    const auto row_pitch = (static_cast<std::size_t>(width) * MappedSurfaceBuffer::BYTES_PER_PIXEL + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    const auto size = (std::max)(row_pitch * height, ALIGNMENT);
+    auto* p_data = static_cast<std::uint8_t*>(::operator new(size, std::align_val_t{ALIGNMENT}));
+    std::memset(p_data, 0, size);
+    return {p_data, static_cast<std::uint32_t>(row_pitch), nullptr};
+}
+
+void CAlignedSurfaceMemory::FreeBuffer(MappedSurfaceBuffer& buffer) noexcept
+{
+    ::operator delete(buffer.m_p_data, std::align_val_t{ALIGNMENT});
+    buffer = {};
+}
+
+CMappedSurface::CMappedSurface(IMappedSurfaceMemory& memory, std::uint32_t width, std::uint32_t height)
+    : m_memory{memory}
+{
+    Resize(width, height);
+}
+
+CMappedSurface::~CMappedSurface()
+{
+    FreeBuffers();
+}
+
+void CMappedSurface::FreeBuffers() noexcept
+{
+    for (auto& buffer : m_buffers)
+    {
+        if (buffer.m_p_data != nullptr)
+        {
+            m_memory.FreeBuffer(buffer);
+        }
+    }
+}
+
+void CMappedSurface::Resize(std::uint32_t width, std::uint32_t height)
+{
+    FreeBuffers();
+    m_width = width;
+    m_height = height;
+    for (auto& buffer : m_buffers)
+    {
+        buffer = m_memory.AllocateBuffer(width, height);
+    }
+    m_back_buffer_index = 0;
+    m_flushed_rects.clear();
+    MarkAllDirty();
+}
+
+auto CMappedSurface::GetBackBuffer() const noexcept
+    -> const MappedSurfaceBuffer&
+{
+    return m_buffers[m_back_buffer_index];
+}
+
+auto CMappedSurface::GetFrontBuffer() const noexcept
+    -> const MappedSurfaceBuffer&
+{
+    return m_buffers[m_back_buffer_index ^ 1];
+}
+
+void CMappedSurface::MarkDirty(const SurfaceRect& rect)
+{
+    if (rect.m_x >= m_width || rect.m_y >= m_height)
+    {
+        return;
+    }
+    SurfaceRect clipped_rect = rect;
+    clipped_rect.m_width = (std::min)(rect.m_width, m_width - rect.m_x);
+    clipped_rect.m_height = (std::min)(rect.m_height, m_height - rect.m_y);
+    if (clipped_rect.m_width == 0 || clipped_rect.m_height == 0)
+    {
+        return;
+    }
+    if (m_dirty_rects.size() < MAX_DIRTY_RECT_COUNT)
+    {
+        m_dirty_rects.push_back(clipped_rect);
+        return;
+    }
+    // 矩形过多时逐个上传的开销超过多复制的像素，合并为一个包围盒
+    auto left = clipped_rect.m_x;
+    auto top = clipped_rect.m_y;
+    auto right = clipped_rect.m_x + clipped_rect.m_width;
+    auto bottom = clipped_rect.m_y + clipped_rect.m_height;
+    for (const auto& dirty_rect : m_dirty_rects)
+    {
+        left = (std::min)(left, dirty_rect.m_x);
+        top = (std::min)(top, dirty_rect.m_y);
+        right = (std::max)(right, dirty_rect.m_x + dirty_rect.m_width);
+        bottom = (std::max)(bottom, dirty_rect.m_y + dirty_rect.m_height);
+    }
+    m_dirty_rects.assign(1, SurfaceRect{left, top, right - left, bottom - top});
+}
+
+void CMappedSurface::MarkAllDirty()
+{
+    m_dirty_rects.assign(1, SurfaceRect{0, 0, m_width, m_height});
+    if (m_width == 0 || m_height == 0)
+    {
+        m_dirty_rects.clear();
+    }
+}
+
+bool CMappedSurface::IsDirty() const noexcept
+{
+    return !m_dirty_rects.empty();
+}
+
+void CMappedSurface::CopyRect(const MappedSurfaceBuffer& source, MappedSurfaceBuffer& target, const SurfaceRect& rect) const noexcept
+{
+    const auto row_size = static_cast<std::size_t>(rect.m_width) * MappedSurfaceBuffer::BYTES_PER_PIXEL;
+    for (std::uint32_t row = rect.m_y; row < rect.m_y + rect.m_height; ++row)
+    {
+        const auto offset = static_cast<std::size_t>(row) * source.m_row_pitch + static_cast<std::size_t>(rect.m_x) * MappedSurfaceBuffer::BYTES_PER_PIXEL;
+        std::memcpy(target.m_p_data + offset, source.m_p_data + offset, row_size);
+    }
+}
+
+auto CMappedSurface::Flush()
+    -> const std::vector<SurfaceRect>&
+{
+    m_memory.Synchronize();
+    m_flushed_rects.swap(m_dirty_rects);
+    m_dirty_rects.clear();
+    m_back_buffer_index ^= 1;
+    // 两个缓冲区由同一后端以相同尺寸分配，行距一致
+    const auto& front_buffer = m_buffers[m_back_buffer_index ^ 1];
+    auto& back_buffer = m_buffers[m_back_buffer_index];
+    for (const auto& rect : m_flushed_rects)
+    {
+        CopyRect(front_buffer, back_buffer, rect);
+    }
+    return m_flushed_rects;
+}
+
+auto CMappedSurface::UploadFlushedRects(CUploadEngine& engine, std::uint32_t destination)
+    -> std::uint32_t
+{
+    const auto& front_buffer = GetFrontBuffer();
+    std::uint32_t rejected_count = 0;
+    for (const auto& rect : m_flushed_rects)
+    {
+        const auto is_uploaded = engine.Upload(
+            destination,
+            rect.m_x,
+            rect.m_y,
+            rect.m_width,
+            rect.m_height,
+            front_buffer.m_p_data + static_cast<std::size_t>(rect.m_y) * front_buffer.m_row_pitch + static_cast<std::size_t>(rect.m_x) * MappedSurfaceBuffer::BYTES_PER_PIXEL,
+            front_buffer.m_row_pitch);
+        if (!is_uploaded)
+        {
+            // Flush已把该区域同步到后台缓冲区，重新登记即可在下一帧发布
+            MarkDirty(rect);
+            ++rejected_count;
+        }
+    }
+    return rejected_count;
+}
+
+std::uint32_t CMappedSurface::GetWidth() const noexcept
+{
+    return m_width;
+}
+
+std::uint32_t CMappedSurface::GetHeight() const noexcept
+{
+    return m_height;
+}
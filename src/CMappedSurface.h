@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "CUploadEngine.h"
+
+struct SurfaceRect
+{
+    std::uint32_t m_x{};
+    std::uint32_t m_y{};
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+};
+
+/**
+ * @brief 一块CPU可见、在整个生命周期内保持映射的BGRA8像素内存
+ */
+struct MappedSurfaceBuffer
+{
+    constexpr static std::uint32_t BYTES_PER_PIXEL = 4;
+
+    std::uint8_t* m_p_data{};
+    std::uint32_t m_row_pitch{};
+    /**
+     * @brief 后端相关的句柄，例如GDI后端中选入了该内存的HDC
+     */
+    void* m_p_native_handle{};
+};
+
+/**
+ * @brief 为CMappedSurface分配像素内存的后端
+ */
+class IMappedSurfaceMemory
+{
+public:
+    virtual ~IMappedSurfaceMemory() = default;
+
+    virtual auto AllocateBuffer(std::uint32_t width, std::uint32_t height)
+        -> MappedSurfaceBuffer = 0;
+    virtual void FreeBuffer(MappedSurfaceBuffer& buffer) noexcept = 0;
+    /**
+     * @brief 在CPU读取像素之前调用，确保其他写入者（例如GDI的批处理）已经写完
+     */
+    virtual void Synchronize() noexcept {}
+};
+
+/**
+ * @brief 以对齐的普通内存作为像素内存，行距按ALIGNMENT对齐，用于测试和基准测试
+ */
+class CAlignedSurfaceMemory final : public IMappedSurfaceMemory
+{
+public:
+    constexpr static std::size_t ALIGNMENT = 64;
+
+    CAlignedSurfaceMemory() = default;
+    ~CAlignedSurfaceMemory() override = default;
+
+    auto AllocateBuffer(std::uint32_t width, std::uint32_t height)
+        -> MappedSurfaceBuffer override;
+    void FreeBuffer(MappedSurfaceBuffer& buffer) noexcept override;
+};
+
+/**
+ * @brief 双缓冲、持久映射的CPU可写表面 \n
+ * 写入者直接写后台缓冲区并用MarkDirty登记修改范围；Flush交换前后台缓冲区， \n
+ * 只有被登记的区域会被上传，并被复制回新的后台缓冲区以保持两者一致
+ */
+class CMappedSurface
+{
+public:
+    /**
+     * @brief 脏矩形超过该数量时合并为包围盒
+     */
+    constexpr static std::size_t MAX_DIRTY_RECT_COUNT = 16;
+
+private:
+    IMappedSurfaceMemory& m_memory;
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::array<MappedSurfaceBuffer, 2> m_buffers{};
+    std::uint32_t m_back_buffer_index{};
+    std::vector<SurfaceRect> m_dirty_rects{};
+    std::vector<SurfaceRect> m_flushed_rects{};
+
+    void FreeBuffers() noexcept;
+    void CopyRect(const MappedSurfaceBuffer& source, MappedSurfaceBuffer& target, const SurfaceRect& rect) const noexcept;
+
+public:
+    CMappedSurface(IMappedSurfaceMemory& memory, std::uint32_t width, std::uint32_t height);
+    ~CMappedSurface();
+    CMappedSurface(const CMappedSurface&) = delete;
+    CMappedSurface& operator=(const CMappedSurface&) = delete;
+
+    /**
+     * @brief 重新分配两个缓冲区，内容清零并整体标记为脏
+     */
+    void Resize(std::uint32_t width, std::uint32_t height);
+
+    /**
+     * @brief 写入者使用的缓冲区，指针在下一次Flush或Resize之前有效
+     */
+    auto GetBackBuffer() const noexcept
+        -> const MappedSurfaceBuffer&;
+    /**
+     * @brief 最近一次Flush发布的缓冲区，在下一次Flush之前内容不变
+     */
+    auto GetFrontBuffer() const noexcept
+        -> const MappedSurfaceBuffer&;
+
+    /**
+     * @brief 登记后台缓冲区中被修改的区域，超出表面的部分会被裁掉
+     */
+    void MarkDirty(const SurfaceRect& rect);
+    void MarkAllDirty();
+    bool IsDirty() const noexcept;
+
+    /**
+     * @brief 发布后台缓冲区并交换前后台
+     *
+     * @return 本次发布的脏矩形，在下一次Flush之前有效
+     */
+    auto Flush()
+        -> const std::vector<SurfaceRect>&;
+    /**
+     * @brief 把最近一次Flush发布的脏矩形直接从前台缓冲区上传到destination \n
+     * 上传引擎拒绝的矩形重新登记为脏区域，在下一次Flush时再发布
+     *
+     * @return 被拒绝的矩形数量
+     */
+    auto UploadFlushedRects(CUploadEngine& engine, std::uint32_t destination)
+        -> std::uint32_t;
+
+    std::uint32_t GetWidth() const noexcept;
+    std::uint32_t GetHeight() const noexcept;
+};
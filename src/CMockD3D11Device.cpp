@@ -0,0 +1,920 @@
+#include "CMockD3D11Device.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::uint32_t MAX_TEXTURE_DIMENSION = 16384;
+    constexpr std::uint32_t MAX_CONSTANT_BUFFER_SIZE = 4096 * 16;
+    constexpr std::uint32_t MAX_INPUT_ELEMENT_COUNT = 32;
+
+    bool IsObjectOfType(const MockObject* p_object, MockObjectType type) noexcept
+    {
+        return p_object == nullptr || p_object->m_type == type;
+    }
+
+    void RequireObjectOfType(const MockObject* p_object, MockObjectType type, const char* p_message)
+    {
+        if (!IsObjectOfType(p_object, type))
+        {
+            throw std::invalid_argument{p_message};
+        }
+    }
+
+    void RequireSlotRange(std::uint32_t start_slot, std::uint32_t count, std::uint32_t slot_count, const char* p_message)
+    {
+        if (start_slot > slot_count || count > slot_count - start_slot)
+        {
+            throw std::out_of_range{p_message};
+        }
+    }
+
+    template <std::size_t N>
+    void BindObjects(std::array<MockObject*, N>& slots, std::uint32_t start_slot, std::uint32_t count, MockObject* const* p_objects, MockObjectType type, const char* p_message)
+    {
+        RequireSlotRange(start_slot, count, static_cast<std::uint32_t>(N), p_message);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            MockObject* const p_object = p_objects == nullptr ? nullptr : p_objects[i];
+            RequireObjectOfType(p_object, type, p_message);
+            slots[start_slot + i] = p_object;
+        }
+    }
+
+    template <std::size_t N>
+    void UnbindObject(std::array<MockObject*, N>& slots, const MockObject* p_object) noexcept
+    {
+        std::replace(slots.begin(), slots.end(), const_cast<MockObject*>(p_object), static_cast<MockObject*>(nullptr));
+    }
+
+    auto GetIndexSize(std::uint32_t format) noexcept
+        -> std::uint32_t
+    {
+        switch (format)
+        {
+        case GpuFormat::R16_UINT:
+            return 2;
+        case GpuFormat::R32_UINT:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    auto GetFullMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept
+        -> std::uint32_t
+    {
+        return static_cast<std::uint32_t>(std::bit_width((std::max)(width, height)));
+    }
+
+    auto GetResourceUsage(const MockObject& resource) noexcept
+        -> std::uint32_t
+    {
+        if (const auto* p_buffer = std::get_if<GpuBufferDescription>(&resource.m_description))
+        {
+            return p_buffer->m_usage;
+        }
+        return std::get<GpuTexture2DDescription>(resource.m_description).m_usage;
+    }
+
+    auto GetResourceCpuAccessFlags(const MockObject& resource) noexcept
+        -> std::uint32_t
+    {
+        if (const auto* p_buffer = std::get_if<GpuBufferDescription>(&resource.m_description))
+        {
+            return p_buffer->m_cpu_access_flags;
+        }
+        return std::get<GpuTexture2DDescription>(resource.m_description).m_cpu_access_flags;
+    }
+
+    bool IsResource(const MockObject* p_object) noexcept
+    {
+        return p_object != nullptr &&
+               (p_object->m_type == MockObjectType::Buffer || p_object->m_type == MockObjectType::Texture2D);
+    }
+
+    /**
+     * @brief 子资源的起始地址、行距和行数；缓冲只有一个子资源，行距为其大小
+     */
+    struct SubresourceLayout
+    {
+        std::uint8_t* m_p_data{};
+        std::uint32_t m_row_pitch{};
+        std::uint32_t m_row_count{};
+        std::uint32_t m_bytes_per_element{1};
+    };
+
+    auto GetSubresourceLayout(MockObject& resource, std::uint32_t subresource)
+        -> SubresourceLayout
+    {
+        if (resource.m_type == MockObjectType::Buffer)
+        {
+            if (subresource != 0)
+            {
+                throw std::out_of_range{"Buffer has only one subresource."};
+            }
+            return {resource.m_data.data(), static_cast<std::uint32_t>(resource.m_data.size()), 1, 1};
+        }
+        if (subresource >= resource.m_subresource_offsets.size())
+        {
+            throw std::out_of_range{"Subresource index is out of range."};
+        }
+        const auto& description = std::get<GpuTexture2DDescription>(resource.m_description);
+        const auto mip = subresource % description.m_mip_levels;
+        return {resource.m_data.data() + resource.m_subresource_offsets[subresource],
+                resource.m_subresource_row_pitches[subresource],
+                (std::max)(description.m_height >> mip, 1u),
+                GpuFormat::GetBytesPerPixel(description.m_format)};
+    }
+
+    auto QuantizeUnorm(float value) noexcept
+        -> std::uint8_t
+    {
+        return static_cast<std::uint8_t>(std::lround((std::clamp)(value, 0.0f, 1.0f) * 255.0f));
+    }
+}
+
+auto GetMockCallTypeName(MockCallType type) noexcept
+    -> const char*
+{
+    switch (type)
+    {
+    case MockCallType::IASetPrimitiveTopology:
+        return "IASetPrimitiveTopology";
+    case MockCallType::IASetInputLayout:
+        return "IASetInputLayout";
+    case MockCallType::IASetVertexBuffers:
+        return "IASetVertexBuffers";
+    case MockCallType::IASetIndexBuffer:
+        return "IASetIndexBuffer";
+    case MockCallType::VSSetShader:
+        return "VSSetShader";
+    case MockCallType::GSSetShader:
+        return "GSSetShader";
+    case MockCallType::PSSetShader:
+        return "PSSetShader";
+    case MockCallType::VSSetConstantBuffers:
+        return "VSSetConstantBuffers";
+    case MockCallType::PSSetConstantBuffers:
+        return "PSSetConstantBuffers";
+    case MockCallType::PSSetShaderResources:
+        return "PSSetShaderResources";
+    case MockCallType::PSSetSamplers:
+        return "PSSetSamplers";
+    case MockCallType::RSSetState:
+        return "RSSetState";
+    case MockCallType::RSSetViewports:
+        return "RSSetViewports";
+    case MockCallType::OMSetBlendState:
+        return "OMSetBlendState";
+    case MockCallType::OMSetDepthStencilState:
+        return "OMSetDepthStencilState";
+    case MockCallType::OMSetRenderTargets:
+        return "OMSetRenderTargets";
+    case MockCallType::SOSetTargets:
+        return "SOSetTargets";
+    case MockCallType::Draw:
+        return "Draw";
+    case MockCallType::DrawIndexed:
+        return "DrawIndexed";
+    case MockCallType::UpdateSubresource:
+        return "UpdateSubresource";
+    case MockCallType::Map:
+        return "Map";
+    case MockCallType::Unmap:
+        return "Unmap";
+    case MockCallType::CopyResource:
+        return "CopyResource";
+    case MockCallType::ClearRenderTargetView:
+        return "ClearRenderTargetView";
+    case MockCallType::Flush:
+        return "Flush";
+    }
+    return "Unknown";
+}
+
+void CMockD3D11DeviceContext::Record(MockCallType type, const MockObject* p_object, std::uint64_t value)
+{
+    ++m_statistics.m_call_counts[static_cast<std::size_t>(type)];
+    if (m_is_recording)
+    {
+        m_calls.push_back({type, p_object, value});
+    }
+}
+
+bool CMockD3D11DeviceContext::ValidateDraw(bool is_indexed, std::uint64_t first_index, std::uint64_t index_count) noexcept
+{
+    bool is_valid = m_state.m_p_vertex_shader != nullptr &&
+                    m_state.m_p_pixel_shader != nullptr &&
+                    m_state.m_viewport_count != 0 &&
+                    std::any_of(m_state.m_p_render_targets.begin(), m_state.m_p_render_targets.end(), [](const MockObject* p_view)
+                                { return p_view != nullptr; });
+    if (is_valid && is_indexed)
+    {
+        const auto* p_index_buffer = m_state.m_p_index_buffer;
+        const auto index_size = GetIndexSize(m_state.m_index_format);
+        is_valid = p_index_buffer != nullptr &&
+                   m_state.m_index_offset + (first_index + index_count) * index_size <= p_index_buffer->m_data.size();
+    }
+    if (!is_valid)
+    {
+        ++m_statistics.m_invalid_draw_count;
+    }
+    return is_valid;
+}
+
+void CMockD3D11DeviceContext::IASetPrimitiveTopology(std::uint32_t topology)
+{
+    m_state.m_primitive_topology = topology;
+    Record(MockCallType::IASetPrimitiveTopology, nullptr, topology);
+}
+
+void CMockD3D11DeviceContext::IASetInputLayout(MockObject* p_input_layout)
+{
+    RequireObjectOfType(p_input_layout, MockObjectType::InputLayout, "IASetInputLayout requires an input layout.");
+    m_state.m_p_input_layout = p_input_layout;
+    Record(MockCallType::IASetInputLayout, p_input_layout, 0);
+}
+
+void CMockD3D11DeviceContext::IASetVertexBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, MockObject* const* p_buffers, const std::uint32_t*, const std::uint32_t*)
+{
+    BindObjects(m_state.m_p_vertex_buffers, start_slot, buffer_count, p_buffers, MockObjectType::Buffer, "IASetVertexBuffers requires buffers within the slot range.");
+    Record(MockCallType::IASetVertexBuffers, p_buffers == nullptr ? nullptr : p_buffers[0], buffer_count);
+}
+
+void CMockD3D11DeviceContext::IASetIndexBuffer(MockObject* p_index_buffer, std::uint32_t format, std::uint32_t offset)
+{
+    RequireObjectOfType(p_index_buffer, MockObjectType::Buffer, "IASetIndexBuffer requires a buffer.");
+    if (p_index_buffer != nullptr && GetIndexSize(format) == 0)
+    {
+        throw std::invalid_argument{"Index buffer format must be R16_UINT or R32_UINT."};
+    }
+    m_state.m_p_index_buffer = p_index_buffer;
+    m_state.m_index_format = format;
+    m_state.m_index_offset = offset;
+    Record(MockCallType::IASetIndexBuffer, p_index_buffer, format);
+}
+
+void CMockD3D11DeviceContext::VSSetShader(MockObject* p_shader, const void* const*, std::uint32_t)
+{
+    RequireObjectOfType(p_shader, MockObjectType::VertexShader, "VSSetShader requires a vertex shader.");
+    m_state.m_p_vertex_shader = p_shader;
+    Record(MockCallType::VSSetShader, p_shader, 0);
+}
+
+void CMockD3D11DeviceContext::GSSetShader(MockObject* p_shader, const void* const*, std::uint32_t)
+{
+    RequireObjectOfType(p_shader, MockObjectType::GeometryShader, "GSSetShader requires a geometry shader.");
+    m_state.m_p_geometry_shader = p_shader;
+    Record(MockCallType::GSSetShader, p_shader, 0);
+}
+
+void CMockD3D11DeviceContext::PSSetShader(MockObject* p_shader, const void* const*, std::uint32_t)
+{
+    RequireObjectOfType(p_shader, MockObjectType::PixelShader, "PSSetShader requires a pixel shader.");
+    m_state.m_p_pixel_shader = p_shader;
+    Record(MockCallType::PSSetShader, p_shader, 0);
+}
+
+void CMockD3D11DeviceContext::VSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, MockObject* const* p_buffers)
+{
+    BindObjects(m_state.m_p_vs_constant_buffers, start_slot, buffer_count, p_buffers, MockObjectType::Buffer, "VSSetConstantBuffers requires buffers within the slot range.");
+    Record(MockCallType::VSSetConstantBuffers, p_buffers == nullptr ? nullptr : p_buffers[0], buffer_count);
+}
+
+void CMockD3D11DeviceContext::PSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, MockObject* const* p_buffers)
+{
+    BindObjects(m_state.m_p_ps_constant_buffers, start_slot, buffer_count, p_buffers, MockObjectType::Buffer, "PSSetConstantBuffers requires buffers within the slot range.");
+    Record(MockCallType::PSSetConstantBuffers, p_buffers == nullptr ? nullptr : p_buffers[0], buffer_count);
+}
+
+void CMockD3D11DeviceContext::PSSetShaderResources(std::uint32_t start_slot, std::uint32_t view_count, MockObject* const* p_views)
+{
+    BindObjects(m_state.m_p_ps_shader_resources, start_slot, view_count, p_views, MockObjectType::ShaderResourceView, "PSSetShaderResources requires shader resource views within the slot range.");
+    // 与D3D11相同，仍绑定为渲染目标的资源不能同时作为输入，绑定被置空
+    for (std::uint32_t i = start_slot; i < start_slot + view_count; ++i)
+    {
+        auto*& p_view = m_state.m_p_ps_shader_resources[i];
+        if (p_view == nullptr)
+        {
+            continue;
+        }
+        const bool is_render_target = std::any_of(m_state.m_p_render_targets.begin(), m_state.m_p_render_targets.end(), [p_view](const MockObject* p_render_target_view)
+                                                  { return p_render_target_view != nullptr && p_render_target_view->m_p_resource == p_view->m_p_resource; });
+        if (is_render_target)
+        {
+            p_view = nullptr;
+            ++m_statistics.m_binding_hazard_count;
+        }
+    }
+    Record(MockCallType::PSSetShaderResources, p_views == nullptr ? nullptr : p_views[0], view_count);
+}
+
+void CMockD3D11DeviceContext::PSSetSamplers(std::uint32_t start_slot, std::uint32_t sampler_count, MockObject* const* p_samplers)
+{
+    BindObjects(m_state.m_p_ps_samplers, start_slot, sampler_count, p_samplers, MockObjectType::SamplerState, "PSSetSamplers requires sampler states within the slot range.");
+    Record(MockCallType::PSSetSamplers, p_samplers == nullptr ? nullptr : p_samplers[0], sampler_count);
+}
+
+void CMockD3D11DeviceContext::RSSetState(MockObject* p_rasterizer_state)
+{
+    RequireObjectOfType(p_rasterizer_state, MockObjectType::RasterizerState, "RSSetState requires a rasterizer state.");
+    m_state.m_p_rasterizer_state = p_rasterizer_state;
+    Record(MockCallType::RSSetState, p_rasterizer_state, 0);
+}
+
+void CMockD3D11DeviceContext::RSSetViewports(std::uint32_t viewport_count, const MockViewport* p_viewports)
+{
+    RequireSlotRange(0, viewport_count, VIEWPORT_SLOT_COUNT, "RSSetViewports accepts at most 16 viewports.");
+    for (std::uint32_t i = 0; i < viewport_count; ++i)
+    {
+        const auto& viewport = p_viewports[i];
+        if (!(viewport.m_width >= 0.0f && viewport.m_height >= 0.0f && viewport.m_min_depth <= viewport.m_max_depth))
+        {
+            throw std::invalid_argument{"Viewport size must not be negative and depth range must be ordered."};
+        }
+        m_state.m_viewports[i] = viewport;
+    }
+    m_state.m_viewport_count = viewport_count;
+    Record(MockCallType::RSSetViewports, nullptr, viewport_count);
+}
+
+void CMockD3D11DeviceContext::OMSetBlendState(MockObject* p_blend_state, const float*, std::uint32_t sample_mask)
+{
+    RequireObjectOfType(p_blend_state, MockObjectType::BlendState, "OMSetBlendState requires a blend state.");
+    m_state.m_p_blend_state = p_blend_state;
+    m_state.m_sample_mask = sample_mask;
+    Record(MockCallType::OMSetBlendState, p_blend_state, sample_mask);
+}
+
+void CMockD3D11DeviceContext::OMSetDepthStencilState(MockObject* p_depth_stencil_state, std::uint32_t stencil_ref)
+{
+    RequireObjectOfType(p_depth_stencil_state, MockObjectType::DepthStencilState, "OMSetDepthStencilState requires a depth stencil state.");
+    m_state.m_p_depth_stencil_state = p_depth_stencil_state;
+    Record(MockCallType::OMSetDepthStencilState, p_depth_stencil_state, stencil_ref);
+}
+
+void CMockD3D11DeviceContext::OMSetRenderTargets(std::uint32_t view_count, MockObject* const* p_render_target_views, MockObject* p_depth_stencil_view)
+{
+    if (p_depth_stencil_view != nullptr)
+    {
+        throw std::invalid_argument{"Depth stencil views are not supported by the mock device."};
+    }
+    m_state.m_p_render_targets.fill(nullptr);
+    BindObjects(m_state.m_p_render_targets, 0, view_count, p_render_target_views, MockObjectType::RenderTargetView, "OMSetRenderTargets requires render target views within the slot range.");
+    // 与D3D11相同，作为渲染目标的资源从着色器资源中解除绑定
+    for (const auto* p_render_target_view : m_state.m_p_render_targets)
+    {
+        if (p_render_target_view == nullptr)
+        {
+            continue;
+        }
+        for (auto*& p_shader_resource_view : m_state.m_p_ps_shader_resources)
+        {
+            if (p_shader_resource_view != nullptr && p_shader_resource_view->m_p_resource == p_render_target_view->m_p_resource)
+            {
+                p_shader_resource_view = nullptr;
+                ++m_statistics.m_binding_hazard_count;
+            }
+        }
+    }
+    Record(MockCallType::OMSetRenderTargets, p_render_target_views == nullptr ? nullptr : p_render_target_views[0], view_count);
+}
+
+void CMockD3D11DeviceContext::SOSetTargets(std::uint32_t target_count, MockObject* const* p_targets, const std::uint32_t*)
+{
+    for (std::uint32_t i = 0; p_targets != nullptr && i < target_count; ++i)
+    {
+        if (p_targets[i] != nullptr)
+        {
+            throw std::invalid_argument{"Stream output is not supported by the mock device."};
+        }
+    }
+    Record(MockCallType::SOSetTargets, nullptr, target_count);
+}
+
+void CMockD3D11DeviceContext::Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location)
+{
+    Record(MockCallType::Draw, nullptr, vertex_count);
+    if (ValidateDraw(false, start_vertex_location, vertex_count))
+    {
+        m_statistics.m_vertex_count += vertex_count;
+    }
+}
+
+void CMockD3D11DeviceContext::DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t)
+{
+    Record(MockCallType::DrawIndexed, m_state.m_p_index_buffer, index_count);
+    if (ValidateDraw(true, start_index_location, index_count))
+    {
+        m_statistics.m_index_count += index_count;
+    }
+}
+
+void CMockD3D11DeviceContext::UpdateSubresource(MockObject* p_resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch, std::uint32_t)
+{
+    if (!IsResource(p_resource) || GetResourceUsage(*p_resource) != GpuUsage::DEFAULT)
+    {
+        throw std::invalid_argument{"UpdateSubresource requires a resource with DEFAULT usage."};
+    }
+    const auto layout = GetSubresourceLayout(*p_resource, subresource);
+    const auto row_width = layout.m_row_pitch / layout.m_bytes_per_element;
+    MockBox box{0, 0, 0, row_width, layout.m_row_count, 1};
+    if (p_box != nullptr)
+    {
+        box = *p_box;
+    }
+    if (box.left >= box.right || box.top >= box.bottom || box.right > row_width || box.bottom > layout.m_row_count)
+    {
+        // 空的区域不执行任何操作，与D3D11相同
+        if (box.left >= box.right || box.top >= box.bottom)
+        {
+            Record(MockCallType::UpdateSubresource, p_resource, 0);
+            return;
+        }
+        throw std::out_of_range{"UpdateSubresource box exceeds the subresource."};
+    }
+    const auto copy_width = static_cast<std::size_t>(box.right - box.left) * layout.m_bytes_per_element;
+    const auto* p_source_row = static_cast<const std::uint8_t*>(p_source);
+    for (auto y = box.top; y < box.bottom; ++y)
+    {
+        std::memcpy(layout.m_p_data + static_cast<std::size_t>(y) * layout.m_row_pitch + static_cast<std::size_t>(box.left) * layout.m_bytes_per_element,
+                    p_source_row,
+                    copy_width);
+        p_source_row += row_pitch;
+    }
+    const auto uploaded_bytes = copy_width * (box.bottom - box.top);
+    m_statistics.m_uploaded_bytes += uploaded_bytes;
+    Record(MockCallType::UpdateSubresource, p_resource, uploaded_bytes);
+}
+
+void CMockD3D11DeviceContext::Map(MockObject* p_resource, std::uint32_t subresource, std::uint32_t map_type, std::uint32_t, MockMappedSubresource* p_mapped_resource)
+{
+    if (!IsResource(p_resource) || p_mapped_resource == nullptr)
+    {
+        throw std::invalid_argument{"Map requires a buffer or texture and an output structure."};
+    }
+    if (p_resource->m_is_mapped)
+    {
+        throw std::logic_error{"Resource is already mapped."};
+    }
+    const auto usage = GetResourceUsage(*p_resource);
+    const auto cpu_access_flags = GetResourceCpuAccessFlags(*p_resource);
+    bool is_allowed = false;
+    if (usage == GpuUsage::DYNAMIC)
+    {
+        is_allowed = map_type == GpuMap::WRITE_DISCARD || map_type == GpuMap::WRITE_NO_OVERWRITE;
+    }
+    else if (usage == GpuUsage::STAGING)
+    {
+        const bool needs_read = map_type == GpuMap::READ || map_type == GpuMap::READ_WRITE;
+        const bool needs_write = map_type == GpuMap::WRITE || map_type == GpuMap::READ_WRITE;
+        is_allowed = (needs_read || needs_write) &&
+                     (!needs_read || (cpu_access_flags & GpuCpuAccessFlag::READ) != 0) &&
+                     (!needs_write || (cpu_access_flags & GpuCpuAccessFlag::WRITE) != 0);
+    }
+    if (!is_allowed)
+    {
+        throw std::invalid_argument{"Map type does not match the usage and CPU access flags of the resource."};
+    }
+    const auto layout = GetSubresourceLayout(*p_resource, subresource);
+    p_mapped_resource->m_p_data = layout.m_p_data;
+    p_mapped_resource->m_row_pitch = layout.m_row_pitch;
+    p_mapped_resource->m_depth_pitch = layout.m_row_pitch * layout.m_row_count;
+    p_resource->m_is_mapped = true;
+    Record(MockCallType::Map, p_resource, map_type);
+}
+
+void CMockD3D11DeviceContext::Unmap(MockObject* p_resource, std::uint32_t)
+{
+    if (!IsResource(p_resource) || !p_resource->m_is_mapped)
+    {
+        throw std::logic_error{"Unmap requires a mapped resource."};
+    }
+    p_resource->m_is_mapped = false;
+    Record(MockCallType::Unmap, p_resource, 0);
+}
+
+void CMockD3D11DeviceContext::CopyResource(MockObject* p_destination, MockObject* p_source)
+{
+    if (!IsResource(p_destination) || !IsResource(p_source) || p_destination == p_source ||
+        p_destination->m_type != p_source->m_type ||
+        p_destination->m_data.size() != p_source->m_data.size() ||
+        GetResourceUsage(*p_destination) == GpuUsage::IMMUTABLE)
+    {
+        throw std::invalid_argument{"CopyResource requires two distinct resources of the same type and size with a writable destination."};
+    }
+    std::memcpy(p_destination->m_data.data(), p_source->m_data.data(), p_source->m_data.size());
+    m_statistics.m_copied_bytes += p_source->m_data.size();
+    Record(MockCallType::CopyResource, p_destination, p_source->m_data.size());
+}
+
+void CMockD3D11DeviceContext::ClearRenderTargetView(MockObject* p_render_target_view, const float color[4])
+{
+    if (p_render_target_view == nullptr || p_render_target_view->m_type != MockObjectType::RenderTargetView)
+    {
+        throw std::invalid_argument{"ClearRenderTargetView requires a render target view."};
+    }
+    auto& texture = *p_render_target_view->m_p_resource;
+    const auto format = std::get<GpuTexture2DDescription>(texture.m_description).m_format;
+    const auto layout = GetSubresourceLayout(texture, 0);
+    std::array<std::uint8_t, 4> texel{};
+    switch (format)
+    {
+    case GpuFormat::B8G8R8A8_UNORM:
+        texel = {QuantizeUnorm(color[2]), QuantizeUnorm(color[1]), QuantizeUnorm(color[0]), QuantizeUnorm(color[3])};
+        break;
+    case GpuFormat::R8G8B8A8_UNORM:
+        texel = {QuantizeUnorm(color[0]), QuantizeUnorm(color[1]), QuantizeUnorm(color[2]), QuantizeUnorm(color[3])};
+        break;
+    case GpuFormat::R8_UNORM:
+        texel[0] = QuantizeUnorm(color[0]);
+        break;
+    case GpuFormat::A8_UNORM:
+        texel[0] = QuantizeUnorm(color[3]);
+        break;
+    default:
+        // 其它格式只用于顶点和索引，不会作为渲染目标
+        break;
+    }
+    for (std::uint32_t y = 0; y < layout.m_row_count; ++y)
+    {
+        auto* p_row = layout.m_p_data + static_cast<std::size_t>(y) * layout.m_row_pitch;
+        for (std::uint32_t offset = 0; offset < layout.m_row_pitch; offset += layout.m_bytes_per_element)
+        {
+            std::memcpy(p_row + offset, texel.data(), layout.m_bytes_per_element);
+        }
+    }
+    Record(MockCallType::ClearRenderTargetView, p_render_target_view, 0);
+}
+
+void CMockD3D11DeviceContext::Flush()
+{
+    Record(MockCallType::Flush, nullptr, 0);
+}
+
+void CMockD3D11DeviceContext::Unbind(const MockObject* p_object) noexcept
+{
+    auto unbind_single = [p_object](MockObject*& p_bound_object)
+    {
+        if (p_bound_object == p_object)
+        {
+            p_bound_object = nullptr;
+        }
+    };
+    unbind_single(m_state.m_p_input_layout);
+    unbind_single(m_state.m_p_index_buffer);
+    unbind_single(m_state.m_p_vertex_shader);
+    unbind_single(m_state.m_p_geometry_shader);
+    unbind_single(m_state.m_p_pixel_shader);
+    unbind_single(m_state.m_p_rasterizer_state);
+    unbind_single(m_state.m_p_blend_state);
+    unbind_single(m_state.m_p_depth_stencil_state);
+    UnbindObject(m_state.m_p_vertex_buffers, p_object);
+    UnbindObject(m_state.m_p_vs_constant_buffers, p_object);
+    UnbindObject(m_state.m_p_ps_constant_buffers, p_object);
+    UnbindObject(m_state.m_p_ps_shader_resources, p_object);
+    UnbindObject(m_state.m_p_ps_samplers, p_object);
+    UnbindObject(m_state.m_p_render_targets, p_object);
+}
+
+void CMockD3D11DeviceContext::SetRecording(bool is_recording) noexcept
+{
+    m_is_recording = is_recording;
+}
+
+auto CMockD3D11DeviceContext::GetCalls() const noexcept
+    -> const std::vector<MockCall>&
+{
+    return m_calls;
+}
+
+void CMockD3D11DeviceContext::ClearCalls() noexcept
+{
+    m_calls.clear();
+}
+
+auto CMockD3D11DeviceContext::GetStatistics() const noexcept
+    -> const MockContextStatistics&
+{
+    return m_statistics;
+}
+
+void CMockD3D11Device::Require(bool condition, const char* p_message)
+{
+    if (!condition)
+    {
+        ++m_statistics.m_rejected_count;
+        throw std::invalid_argument{p_message};
+    }
+}
+
+auto CMockD3D11Device::AddObject(std::unique_ptr<MockObject> p_object)
+    -> MockObject*
+{
+    p_object->m_table_index = m_objects.size();
+    ++m_statistics.m_object_counts[static_cast<std::size_t>(p_object->m_type)];
+    ++m_statistics.m_created_count;
+    if (IsResource(p_object.get()))
+    {
+        m_statistics.m_backing_bytes += p_object->m_data.size();
+        m_statistics.m_peak_backing_bytes = (std::max)(m_statistics.m_peak_backing_bytes, m_statistics.m_backing_bytes);
+    }
+    m_objects.push_back(std::move(p_object));
+    return m_objects.back().get();
+}
+
+void CMockD3D11Device::ValidateUsage(std::uint32_t usage, std::uint32_t bind_flags, std::uint32_t cpu_access_flags, bool has_initial_data)
+{
+    switch (usage)
+    {
+    case GpuUsage::DEFAULT:
+        Require(cpu_access_flags == 0, "DEFAULT resources must not have CPU access flags.");
+        break;
+    case GpuUsage::IMMUTABLE:
+        Require(has_initial_data, "IMMUTABLE resources require initial data.");
+        Require(cpu_access_flags == 0, "IMMUTABLE resources must not have CPU access flags.");
+        Require((bind_flags & (GpuBindFlag::RENDER_TARGET | GpuBindFlag::DEPTH_STENCIL | GpuBindFlag::UNORDERED_ACCESS | GpuBindFlag::STREAM_OUTPUT)) == 0,
+                "IMMUTABLE resources cannot be bound for output.");
+        break;
+    case GpuUsage::DYNAMIC:
+        Require(cpu_access_flags == GpuCpuAccessFlag::WRITE, "DYNAMIC resources require exactly CPU write access.");
+        Require((bind_flags & (GpuBindFlag::RENDER_TARGET | GpuBindFlag::DEPTH_STENCIL | GpuBindFlag::UNORDERED_ACCESS | GpuBindFlag::STREAM_OUTPUT)) == 0,
+                "DYNAMIC resources cannot be bound for output.");
+        break;
+    case GpuUsage::STAGING:
+        Require(bind_flags == 0, "STAGING resources cannot be bound to the pipeline.");
+        Require(cpu_access_flags != 0, "STAGING resources require CPU access flags.");
+        break;
+    default:
+        Require(false, "Unknown resource usage.");
+    }
+    Require((cpu_access_flags & ~(GpuCpuAccessFlag::READ | GpuCpuAccessFlag::WRITE)) == 0, "Unknown CPU access flags.");
+}
+
+void CMockD3D11Device::SetPerfLinter(CPerfLinter* p_perf_linter) noexcept
+{
+    m_p_perf_linter = p_perf_linter;
+}
+
+auto CMockD3D11Device::CreateBuffer(const GpuBufferDescription& description, const GpuSubresourceData* p_initial_data, const std::source_location& location)
+    -> MockObject*
+{
+    const bool has_initial_data = p_initial_data != nullptr && p_initial_data->m_p_data != nullptr;
+    Require(description.m_byte_width != 0, "Buffer size must not be zero.");
+    ValidateUsage(description.m_usage, description.m_bind_flags, description.m_cpu_access_flags, has_initial_data);
+    if ((description.m_bind_flags & GpuBindFlag::CONSTANT_BUFFER) != 0)
+    {
+        Require(description.m_bind_flags == GpuBindFlag::CONSTANT_BUFFER, "Constant buffers cannot be combined with other bind flags.");
+        Require(description.m_byte_width % 16 == 0 && description.m_byte_width <= MAX_CONSTANT_BUFFER_SIZE,
+                "Constant buffer size must be a multiple of 16 and at most 65536 bytes.");
+    }
+    Require((description.m_bind_flags & (GpuBindFlag::RENDER_TARGET | GpuBindFlag::DEPTH_STENCIL)) == 0, "Buffers cannot be bound as render or depth targets.");
+    if (m_p_perf_linter != nullptr)
+    {
+        m_p_perf_linter->Check(LintBufferDescription{description.m_byte_width, description.m_usage, description.m_bind_flags, description.m_cpu_access_flags, has_initial_data}, location);
+    }
+
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::Buffer;
+    p_object->m_description = description;
+    p_object->m_data.resize(description.m_byte_width);
+    if (has_initial_data)
+    {
+        std::memcpy(p_object->m_data.data(), p_initial_data->m_p_data, description.m_byte_width);
+    }
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateTexture2D(const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data, const std::source_location& location)
+    -> MockObject*
+{
+    const bool has_initial_data = p_initial_data != nullptr;
+    const auto bytes_per_pixel = GpuFormat::GetBytesPerPixel(description.m_format);
+    Require(description.m_width != 0 && description.m_height != 0 &&
+                description.m_width <= MAX_TEXTURE_DIMENSION && description.m_height <= MAX_TEXTURE_DIMENSION,
+            "Texture size must be between 1 and 16384.");
+    Require(bytes_per_pixel != 0, "Texture format is not supported.");
+    Require(description.m_array_size != 0, "Texture array size must not be zero.");
+    Require(description.m_sample_count == 1 || (description.m_mip_levels == 1 && description.m_usage == GpuUsage::DEFAULT),
+            "Multisampled textures must have one mip level and DEFAULT usage.");
+    const auto full_mip_level_count = GetFullMipLevelCount(description.m_width, description.m_height);
+    Require(description.m_mip_levels <= full_mip_level_count, "Texture has more mip levels than its size allows.");
+    ValidateUsage(description.m_usage, description.m_bind_flags, description.m_cpu_access_flags, has_initial_data);
+    Require((description.m_bind_flags & (GpuBindFlag::VERTEX_BUFFER | GpuBindFlag::INDEX_BUFFER | GpuBindFlag::CONSTANT_BUFFER | GpuBindFlag::STREAM_OUTPUT)) == 0,
+            "Textures cannot be bound as buffers.");
+    if (m_p_perf_linter != nullptr)
+    {
+        m_p_perf_linter->Check(LintTextureDescription{description.m_width, description.m_height, description.m_mip_levels, description.m_array_size, description.m_format, description.m_usage, description.m_bind_flags, description.m_cpu_access_flags, has_initial_data}, location);
+    }
+
+    auto resolved_description = description;
+    if (resolved_description.m_mip_levels == 0)
+    {
+        resolved_description.m_mip_levels = full_mip_level_count;
+    }
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::Texture2D;
+    p_object->m_description = resolved_description;
+    const auto subresource_count = resolved_description.m_mip_levels * resolved_description.m_array_size;
+    p_object->m_subresource_offsets.reserve(subresource_count);
+    p_object->m_subresource_row_pitches.reserve(subresource_count);
+    std::size_t total_size = 0;
+    for (std::uint32_t slice = 0; slice < resolved_description.m_array_size; ++slice)
+    {
+        for (std::uint32_t mip = 0; mip < resolved_description.m_mip_levels; ++mip)
+        {
+            const auto row_pitch = (std::max)(description.m_width >> mip, 1u) * bytes_per_pixel;
+            p_object->m_subresource_offsets.push_back(total_size);
+            p_object->m_subresource_row_pitches.push_back(row_pitch);
+            total_size += static_cast<std::size_t>(row_pitch) * (std::max)(description.m_height >> mip, 1u);
+        }
+    }
+    p_object->m_data.resize(total_size);
+    if (has_initial_data)
+    {
+        for (std::uint32_t subresource = 0; subresource < subresource_count; ++subresource)
+        {
+            const auto& initial_data = p_initial_data[subresource];
+            const auto layout = GetSubresourceLayout(*p_object, subresource);
+            Require(initial_data.m_p_data != nullptr && initial_data.m_row_pitch >= layout.m_row_pitch,
+                    "Initial data of every subresource requires data and a sufficient row pitch.");
+            const auto* p_source_row = static_cast<const std::uint8_t*>(initial_data.m_p_data);
+            for (std::uint32_t y = 0; y < layout.m_row_count; ++y)
+            {
+                std::memcpy(layout.m_p_data + static_cast<std::size_t>(y) * layout.m_row_pitch, p_source_row, layout.m_row_pitch);
+                p_source_row += initial_data.m_row_pitch;
+            }
+        }
+    }
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateView(MockObjectType type, MockObject* p_resource, std::uint32_t required_bind_flag)
+    -> MockObject*
+{
+    Require(p_resource != nullptr && p_resource->m_type == MockObjectType::Texture2D, "Views can only be created for textures.");
+    Require((std::get<GpuTexture2DDescription>(p_resource->m_description).m_bind_flags & required_bind_flag) != 0,
+            "Texture was not created with the bind flag required by the view.");
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = type;
+    p_object->m_p_resource = p_resource;
+    ++p_resource->m_view_count;
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateShaderResourceView(MockObject* p_resource)
+    -> MockObject*
+{
+    return CreateView(MockObjectType::ShaderResourceView, p_resource, GpuBindFlag::SHADER_RESOURCE);
+}
+
+auto CMockD3D11Device::CreateRenderTargetView(MockObject* p_resource)
+    -> MockObject*
+{
+    return CreateView(MockObjectType::RenderTargetView, p_resource, GpuBindFlag::RENDER_TARGET);
+}
+
+auto CMockD3D11Device::CreateShader(MockObjectType type, const void* p_byte_code, std::size_t byte_code_size)
+    -> MockObject*
+{
+    Require(p_byte_code != nullptr && byte_code_size != 0, "Shader byte code must not be empty.");
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = type;
+    const auto* p_bytes = static_cast<const std::uint8_t*>(p_byte_code);
+    p_object->m_data.assign(p_bytes, p_bytes + byte_code_size);
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateVertexShader(const void* p_byte_code, std::size_t byte_code_size)
+    -> MockObject*
+{
+    return CreateShader(MockObjectType::VertexShader, p_byte_code, byte_code_size);
+}
+
+auto CMockD3D11Device::CreateGeometryShader(const void* p_byte_code, std::size_t byte_code_size)
+    -> MockObject*
+{
+    return CreateShader(MockObjectType::GeometryShader, p_byte_code, byte_code_size);
+}
+
+auto CMockD3D11Device::CreatePixelShader(const void* p_byte_code, std::size_t byte_code_size)
+    -> MockObject*
+{
+    return CreateShader(MockObjectType::PixelShader, p_byte_code, byte_code_size);
+}
+
+auto CMockD3D11Device::CreateInputLayout(const GpuInputElementDescription* p_elements, std::uint32_t element_count, const void* p_byte_code, std::size_t byte_code_size)
+    -> MockObject*
+{
+    Require(p_elements != nullptr && element_count != 0 && element_count <= MAX_INPUT_ELEMENT_COUNT, "Input layout requires 1 to 32 elements.");
+    Require(p_byte_code != nullptr && byte_code_size != 0, "Input layout requires the vertex shader byte code.");
+    std::vector<GpuInputElementDescription> elements(p_elements, p_elements + element_count);
+    for (const auto& element : elements)
+    {
+        Require(element.m_p_semantic_name != nullptr && element.m_p_semantic_name[0] != '\0', "Input element requires a semantic name.");
+        Require(GpuFormat::GetBytesPerPixel(element.m_format) != 0, "Input element format is not supported.");
+        Require(element.m_input_slot < CMockD3D11DeviceContext::VERTEX_BUFFER_SLOT_COUNT, "Input element slot is out of range.");
+    }
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::InputLayout;
+    p_object->m_description = std::move(elements);
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateSamplerState(const GpuSamplerDescription& description, float sampling_scale, const std::source_location& location)
+    -> MockObject*
+{
+    Require(description.m_filter != GpuFilter::ANISOTROPIC || (description.m_max_anisotropy >= 1 && description.m_max_anisotropy <= 16),
+            "Anisotropic sampler requires a maximum anisotropy between 1 and 16.");
+    if (m_p_perf_linter != nullptr)
+    {
+        m_p_perf_linter->Check(LintSamplerDescription{description.m_filter, description.m_max_anisotropy, sampling_scale}, location);
+    }
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::SamplerState;
+    p_object->m_description = description;
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateBlendState(const GpuBlendDescription& description, const std::source_location& location)
+    -> MockObject*
+{
+    Require(description.m_write_mask <= 0xF, "Render target write mask has only four bits.");
+    if (m_p_perf_linter != nullptr)
+    {
+        m_p_perf_linter->Check(LintBlendDescription{description.m_is_blend_enabled, description.m_source_blend, description.m_destination_blend, description.m_blend_operation, description.m_source_alpha_blend, description.m_destination_alpha_blend, description.m_alpha_blend_operation}, location);
+    }
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::BlendState;
+    p_object->m_description = description;
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateRasterizerState(const GpuRasterizerDescription& description)
+    -> MockObject*
+{
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::RasterizerState;
+    p_object->m_description = description;
+    return AddObject(std::move(p_object));
+}
+
+auto CMockD3D11Device::CreateDepthStencilState(const GpuDepthStencilDescription& description)
+    -> MockObject*
+{
+    auto p_object = std::make_unique<MockObject>();
+    p_object->m_type = MockObjectType::DepthStencilState;
+    p_object->m_description = description;
+    return AddObject(std::move(p_object));
+}
+
+void CMockD3D11Device::Release(MockObject* p_object)
+{
+    if (p_object == nullptr)
+    {
+        return;
+    }
+    if (p_object->m_table_index >= m_objects.size() || m_objects[p_object->m_table_index].get() != p_object)
+    {
+        throw std::invalid_argument{"Object was not created by this device or was already released."};
+    }
+    if (p_object->m_view_count != 0)
+    {
+        throw std::logic_error{"Resource is still referenced by a view."};
+    }
+    m_immediate_context.Unbind(p_object);
+    if (p_object->m_p_resource != nullptr)
+    {
+        --p_object->m_p_resource->m_view_count;
+    }
+    --m_statistics.m_object_counts[static_cast<std::size_t>(p_object->m_type)];
+    ++m_statistics.m_released_count;
+    if (IsResource(p_object))
+    {
+        m_statistics.m_backing_bytes -= p_object->m_data.size();
+    }
+    // 用末尾的对象填补空位
+    const auto table_index = p_object->m_table_index;
+    if (table_index != m_objects.size() - 1)
+    {
+        m_objects[table_index] = std::move(m_objects.back());
+        m_objects[table_index]->m_table_index = table_index;
+    }
+    m_objects.pop_back();
+}
+
+auto CMockD3D11Device::GetImmediateContext() noexcept
+    -> CMockD3D11DeviceContext&
+{
+    return m_immediate_context;
+}
+
+auto CMockD3D11Device::GetStatistics() const noexcept
+    -> const MockDeviceStatistics&
+{
+    return m_statistics;
+}
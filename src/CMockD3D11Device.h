@@ -0,0 +1,363 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <source_location>
+#include <variant>
+#include <vector>
+#include "GpuResourceDescription.h"
+#include "PerfLint.h"
+
+namespace GpuMap
+{
+    constexpr std::uint32_t READ = 1;
+    constexpr std::uint32_t WRITE = 2;
+    constexpr std::uint32_t READ_WRITE = 3;
+    constexpr std::uint32_t WRITE_DISCARD = 4;
+    constexpr std::uint32_t WRITE_NO_OVERWRITE = 5;
+}
+
+#ifdef _WIN32
+static_assert(GpuMap::READ == D3D11_MAP_READ);
+static_assert(GpuMap::WRITE == D3D11_MAP_WRITE);
+static_assert(GpuMap::READ_WRITE == D3D11_MAP_READ_WRITE);
+static_assert(GpuMap::WRITE_DISCARD == D3D11_MAP_WRITE_DISCARD);
+static_assert(GpuMap::WRITE_NO_OVERWRITE == D3D11_MAP_WRITE_NO_OVERWRITE);
+#endif
+
+/**
+ * @brief 成员与D3D11_BOX同名，同一段代码可以套用真实上下文和模拟上下文
+ */
+struct MockBox
+{
+    std::uint32_t left{};
+    std::uint32_t top{};
+    std::uint32_t front{};
+    std::uint32_t right{};
+    std::uint32_t bottom{};
+    std::uint32_t back{};
+};
+
+struct MockViewport
+{
+    float m_top_left_x{};
+    float m_top_left_y{};
+    float m_width{};
+    float m_height{};
+    float m_min_depth{};
+    float m_max_depth{1.0f};
+};
+
+struct MockMappedSubresource
+{
+    void* m_p_data{};
+    std::uint32_t m_row_pitch{};
+    std::uint32_t m_depth_pitch{};
+};
+
+enum class MockObjectType : std::uint8_t
+{
+    Buffer,
+    Texture2D,
+    ShaderResourceView,
+    RenderTargetView,
+    VertexShader,
+    GeometryShader,
+    PixelShader,
+    InputLayout,
+    SamplerState,
+    BlendState,
+    RasterizerState,
+    DepthStencilState,
+};
+
+constexpr std::size_t MOCK_OBJECT_TYPE_COUNT = 12;
+
+/**
+ * @brief 模拟设备创建的对象，缓冲和纹理在m_data中保存CPU端的内容，着色器保存字节码
+ */
+struct MockObject
+{
+    MockObjectType m_type{};
+    std::variant<
+        std::monostate,
+        GpuBufferDescription,
+        GpuTexture2DDescription,
+        std::vector<GpuInputElementDescription>,
+        GpuSamplerDescription,
+        GpuBlendDescription,
+        GpuRasterizerDescription,
+        GpuDepthStencilDescription>
+        m_description{};
+    std::vector<std::uint8_t> m_data{};
+    /**
+     * @brief 纹理各子资源在m_data中的偏移和行距，下标为mip + array_slice * mip_levels
+     */
+    std::vector<std::size_t> m_subresource_offsets{};
+    std::vector<std::uint32_t> m_subresource_row_pitches{};
+    /**
+     * @brief 视图引用的资源
+     */
+    MockObject* m_p_resource{};
+    std::uint32_t m_view_count{};
+    bool m_is_mapped{};
+    // 在设备对象表中的位置，用于O(1)释放
+    std::size_t m_table_index{};
+};
+
+enum class MockCallType : std::uint8_t
+{
+    IASetPrimitiveTopology,
+    IASetInputLayout,
+    IASetVertexBuffers,
+    IASetIndexBuffer,
+    VSSetShader,
+    GSSetShader,
+    PSSetShader,
+    VSSetConstantBuffers,
+    PSSetConstantBuffers,
+    PSSetShaderResources,
+    PSSetSamplers,
+    RSSetState,
+    RSSetViewports,
+    OMSetBlendState,
+    OMSetDepthStencilState,
+    OMSetRenderTargets,
+    SOSetTargets,
+    Draw,
+    DrawIndexed,
+    UpdateSubresource,
+    Map,
+    Unmap,
+    CopyResource,
+    ClearRenderTargetView,
+    Flush,
+};
+
+constexpr std::size_t MOCK_CALL_TYPE_COUNT = 25;
+
+auto GetMockCallTypeName(MockCallType type) noexcept
+    -> const char*;
+
+/**
+ * @brief 一次上下文调用：m_p_object为第一个对象参数，m_value为数量或字节数 \n
+ * 对象释放后m_p_object只能用于比较，不能解引用
+ */
+struct MockCall
+{
+    MockCallType m_type{};
+    const MockObject* m_p_object{};
+    std::uint64_t m_value{};
+};
+
+struct MockContextStatistics
+{
+    std::array<std::uint64_t, MOCK_CALL_TYPE_COUNT> m_call_counts{};
+    std::uint64_t m_index_count{};
+    std::uint64_t m_vertex_count{};
+    std::uint64_t m_uploaded_bytes{};
+    std::uint64_t m_copied_bytes{};
+    /**
+     * @brief 因管线状态不完整或越界而被丢弃的绘制调用数，对应调试层的错误
+     */
+    std::uint64_t m_invalid_draw_count{};
+    /**
+     * @brief 同一资源同时绑定为着色器资源和渲染目标、被自动解除绑定的次数，对应调试层的警告
+     */
+    std::uint64_t m_binding_hazard_count{};
+};
+
+struct MockDeviceStatistics
+{
+    std::array<std::uint32_t, MOCK_OBJECT_TYPE_COUNT> m_object_counts{};
+    std::uint64_t m_created_count{};
+    std::uint64_t m_released_count{};
+    /**
+     * @brief 描述非法、创建失败的次数
+     */
+    std::uint64_t m_rejected_count{};
+    std::uint64_t m_backing_bytes{};
+    std::uint64_t m_peak_backing_bytes{};
+};
+
+/**
+ * @brief 模拟的立即上下文，成员函数与ID3D11DeviceContext中本项目用到的部分同名同参数顺序 \n
+ * 记录管线状态并在绘制时检查其完整性，上传、映射和复制直接读写资源的CPU端内存，不执行着色器 \n
+ * 参数非法（对象类型不符、槽位越界、映射用法不符）时抛出std::invalid_argument或std::out_of_range
+ */
+class CMockD3D11DeviceContext
+{
+public:
+    constexpr static std::uint32_t VERTEX_BUFFER_SLOT_COUNT = 32;
+    constexpr static std::uint32_t CONSTANT_BUFFER_SLOT_COUNT = 14;
+    constexpr static std::uint32_t SHADER_RESOURCE_SLOT_COUNT = 128;
+    constexpr static std::uint32_t SAMPLER_SLOT_COUNT = 16;
+    constexpr static std::uint32_t RENDER_TARGET_SLOT_COUNT = 8;
+    constexpr static std::uint32_t VIEWPORT_SLOT_COUNT = 16;
+
+private:
+    struct PipelineState
+    {
+        std::uint32_t m_primitive_topology{};
+        MockObject* m_p_input_layout{};
+        std::array<MockObject*, VERTEX_BUFFER_SLOT_COUNT> m_p_vertex_buffers{};
+        MockObject* m_p_index_buffer{};
+        std::uint32_t m_index_format{};
+        std::uint32_t m_index_offset{};
+        MockObject* m_p_vertex_shader{};
+        MockObject* m_p_geometry_shader{};
+        MockObject* m_p_pixel_shader{};
+        std::array<MockObject*, CONSTANT_BUFFER_SLOT_COUNT> m_p_vs_constant_buffers{};
+        std::array<MockObject*, CONSTANT_BUFFER_SLOT_COUNT> m_p_ps_constant_buffers{};
+        std::array<MockObject*, SHADER_RESOURCE_SLOT_COUNT> m_p_ps_shader_resources{};
+        std::array<MockObject*, SAMPLER_SLOT_COUNT> m_p_ps_samplers{};
+        MockObject* m_p_rasterizer_state{};
+        std::uint32_t m_viewport_count{};
+        std::array<MockViewport, VIEWPORT_SLOT_COUNT> m_viewports{};
+        MockObject* m_p_blend_state{};
+        std::uint32_t m_sample_mask{0xFFFFFFFFu};
+        MockObject* m_p_depth_stencil_state{};
+        std::array<MockObject*, RENDER_TARGET_SLOT_COUNT> m_p_render_targets{};
+    };
+
+    PipelineState m_state{};
+    bool m_is_recording{};
+    std::vector<MockCall> m_calls{};
+    MockContextStatistics m_statistics{};
+
+    void Record(MockCallType type, const MockObject* p_object, std::uint64_t value);
+    /**
+     * @brief 绘制前检查管线状态，不完整时计入m_invalid_draw_count并返回false
+     */
+    bool ValidateDraw(bool is_indexed, std::uint64_t first_index, std::uint64_t index_count) noexcept;
+
+public:
+    CMockD3D11DeviceContext() = default;
+    ~CMockD3D11DeviceContext() = default;
+    CMockD3D11DeviceContext(const CMockD3D11DeviceContext&) = delete;
+    CMockD3D11DeviceContext& operator=(const CMockD3D11DeviceContext&) = delete;
+
+    void IASetPrimitiveTopology(std::uint32_t topology);
+    void IASetInputLayout(MockObject* p_input_layout);
+    void IASetVertexBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, MockObject* const* p_buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets);
+    void IASetIndexBuffer(MockObject* p_index_buffer, std::uint32_t format, std::uint32_t offset);
+    void VSSetShader(MockObject* p_shader, const void* const* p_class_instances, std::uint32_t class_instance_count);
+    void GSSetShader(MockObject* p_shader, const void* const* p_class_instances, std::uint32_t class_instance_count);
+    void PSSetShader(MockObject* p_shader, const void* const* p_class_instances, std::uint32_t class_instance_count);
+    void VSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, MockObject* const* p_buffers);
+    void PSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, MockObject* const* p_buffers);
+    void PSSetShaderResources(std::uint32_t start_slot, std::uint32_t view_count, MockObject* const* p_views);
+    void PSSetSamplers(std::uint32_t start_slot, std::uint32_t sampler_count, MockObject* const* p_samplers);
+    void RSSetState(MockObject* p_rasterizer_state);
+    void RSSetViewports(std::uint32_t viewport_count, const MockViewport* p_viewports);
+    void OMSetBlendState(MockObject* p_blend_state, const float* p_blend_factor, std::uint32_t sample_mask);
+    void OMSetDepthStencilState(MockObject* p_depth_stencil_state, std::uint32_t stencil_ref);
+    void OMSetRenderTargets(std::uint32_t view_count, MockObject* const* p_render_target_views, MockObject* p_depth_stencil_view);
+    /**
+     * @brief 不模拟流输出，只接受解除绑定
+     */
+    void SOSetTargets(std::uint32_t target_count, MockObject* const* p_targets, const std::uint32_t* p_offsets);
+
+    void Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location);
+    void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location);
+
+    /**
+     * @brief 把数据复制到DEFAULT资源的CPU端内存，p_box为nullptr时覆盖整个子资源
+     */
+    void UpdateSubresource(MockObject* p_resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch, std::uint32_t depth_pitch);
+    /**
+     * @brief DYNAMIC资源只能以WRITE_DISCARD或WRITE_NO_OVERWRITE映射，STAGING资源的映射方式须与CPU访问标志相符
+     */
+    void Map(MockObject* p_resource, std::uint32_t subresource, std::uint32_t map_type, std::uint32_t map_flags, MockMappedSubresource* p_mapped_resource);
+    void Unmap(MockObject* p_resource, std::uint32_t subresource);
+    void CopyResource(MockObject* p_destination, MockObject* p_source);
+    /**
+     * @brief 以渲染目标的格式量化颜色并填充第0个子资源
+     */
+    void ClearRenderTargetView(MockObject* p_render_target_view, const float color[4]);
+    void Flush();
+
+    /**
+     * @brief 释放对象前解除它在管线中的全部绑定
+     */
+    void Unbind(const MockObject* p_object) noexcept;
+    /**
+     * @brief 是否把每次调用追加到调用记录中，统计数据始终更新
+     */
+    void SetRecording(bool is_recording) noexcept;
+    auto GetCalls() const noexcept
+        -> const std::vector<MockCall>&;
+    void ClearCalls() noexcept;
+    auto GetStatistics() const noexcept
+        -> const MockContextStatistics&;
+};
+
+/**
+ * @brief 可移植的模拟D3D11设备，提供ID3D11Device中本项目用到的创建函数，在没有GPU和Windows SDK的环境中运行管线的建立和每帧代码 \n
+ * 按D3D11的规则检查描述，非法时抛出std::invalid_argument；为缓冲和纹理分配CPU端内存并复制初始数据 \n
+ * 设置了CPerfLinter时同时按性能规则检查描述，警告中的位置为创建函数的调用者 \n
+ * 对象由设备持有，Release或设备析构时释放；释放仍被视图引用的资源抛出std::logic_error
+ */
+class CMockD3D11Device
+{
+private:
+    std::vector<std::unique_ptr<MockObject>> m_objects{};
+    CMockD3D11DeviceContext m_immediate_context{};
+    CPerfLinter* m_p_perf_linter{};
+    MockDeviceStatistics m_statistics{};
+
+    void Require(bool condition, const char* p_message);
+    auto AddObject(std::unique_ptr<MockObject> p_object)
+        -> MockObject*;
+    auto CreateShader(MockObjectType type, const void* p_byte_code, std::size_t byte_code_size)
+        -> MockObject*;
+    auto CreateView(MockObjectType type, MockObject* p_resource, std::uint32_t required_bind_flag)
+        -> MockObject*;
+    void ValidateUsage(std::uint32_t usage, std::uint32_t bind_flags, std::uint32_t cpu_access_flags, bool has_initial_data);
+
+public:
+    CMockD3D11Device() = default;
+    ~CMockD3D11Device() = default;
+    CMockD3D11Device(const CMockD3D11Device&) = delete;
+    CMockD3D11Device& operator=(const CMockD3D11Device&) = delete;
+
+    void SetPerfLinter(CPerfLinter* p_perf_linter) noexcept;
+
+    auto CreateBuffer(const GpuBufferDescription& description, const GpuSubresourceData* p_initial_data, const std::source_location& location = std::source_location::current())
+        -> MockObject*;
+    /**
+     * @brief p_initial_data为nullptr或按mip + array_slice * mip_levels排列的每个子资源的数据
+     */
+    auto CreateTexture2D(const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data, const std::source_location& location = std::source_location::current())
+        -> MockObject*;
+    auto CreateShaderResourceView(MockObject* p_resource)
+        -> MockObject*;
+    auto CreateRenderTargetView(MockObject* p_resource)
+        -> MockObject*;
+    auto CreateVertexShader(const void* p_byte_code, std::size_t byte_code_size)
+        -> MockObject*;
+    auto CreateGeometryShader(const void* p_byte_code, std::size_t byte_code_size)
+        -> MockObject*;
+    auto CreatePixelShader(const void* p_byte_code, std::size_t byte_code_size)
+        -> MockObject*;
+    auto CreateInputLayout(const GpuInputElementDescription* p_elements, std::uint32_t element_count, const void* p_byte_code, std::size_t byte_code_size)
+        -> MockObject*;
+    auto CreateSamplerState(const GpuSamplerDescription& description, float sampling_scale = 0.0f, const std::source_location& location = std::source_location::current())
+        -> MockObject*;
+    auto CreateBlendState(const GpuBlendDescription& description, const std::source_location& location = std::source_location::current())
+        -> MockObject*;
+    auto CreateRasterizerState(const GpuRasterizerDescription& description)
+        -> MockObject*;
+    auto CreateDepthStencilState(const GpuDepthStencilDescription& description)
+        -> MockObject*;
+    /**
+     * @brief 释放对象并从立即上下文的管线中解除绑定
+     */
+    void Release(MockObject* p_object);
+
+    auto GetImmediateContext() noexcept
+        -> CMockD3D11DeviceContext&;
+    auto GetStatistics() const noexcept
+        -> const MockDeviceStatistics&;
+};
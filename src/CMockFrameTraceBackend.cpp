@@ -0,0 +1,301 @@
+#include "CMockFrameTraceBackend.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+CMockFrameTraceBackend::CMockFrameTraceBackend(CMockD3D11Device& device)
+    : m_device{device}, m_context{device.GetImmediateContext()}
+{
+}
+
+CMockFrameTraceBackend::~CMockFrameTraceBackend()
+{
+    ReleaseObjects();
+}
+
+auto CMockFrameTraceBackend::GetObject(std::uint32_t id) const
+    -> MockObject*
+{
+    if (id >= m_p_objects.size())
+    {
+        throw std::out_of_range{"Frame trace object id is out of range."};
+    }
+    return m_p_objects[id];
+}
+
+auto CMockFrameTraceBackend::GetObjects(std::span<const std::uint32_t> ids)
+    -> MockObject* const*
+{
+    m_p_scratch_objects.resize(ids.size());
+    std::transform(ids.begin(), ids.end(), m_p_scratch_objects.begin(), [this](std::uint32_t id)
+                   { return GetObject(id); });
+    return ids.empty() ? nullptr : m_p_scratch_objects.data();
+}
+
+void CMockFrameTraceBackend::SetObject(std::uint32_t id, MockObject* p_object)
+{
+    if (id == 0 || id >= m_p_objects.size())
+    {
+        m_device.Release(p_object);
+        throw std::out_of_range{"Frame trace object id is out of range."};
+    }
+    // 帧内重复创建时替换旧对象
+    if (m_p_objects[id] != nullptr)
+    {
+        m_device.Release(m_p_objects[id]);
+    }
+    m_p_objects[id] = p_object;
+}
+
+void CMockFrameTraceBackend::ReleaseObjects()
+{
+    // 视图总是在资源之后创建，逆序释放不会遇到仍被引用的资源
+    for (auto it = m_p_objects.rbegin(); it != m_p_objects.rend(); ++it)
+    {
+        if (*it != nullptr)
+        {
+            m_device.Release(*it);
+        }
+    }
+    m_p_objects.clear();
+}
+
+void CMockFrameTraceBackend::Reset(std::uint32_t object_count)
+{
+    ReleaseObjects();
+    m_p_objects.resize(std::size_t{object_count} + 1);
+}
+
+void CMockFrameTraceBackend::CreateBuffer(std::uint32_t id, const GpuBufferDescription& description, const void* p_initial_data)
+{
+    const GpuSubresourceData initial_data{p_initial_data, description.m_byte_width};
+    SetObject(id, m_device.CreateBuffer(description, p_initial_data != nullptr ? &initial_data : nullptr));
+}
+
+void CMockFrameTraceBackend::CreateTexture2D(std::uint32_t id, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data)
+{
+    SetObject(id, m_device.CreateTexture2D(description, p_initial_data));
+}
+
+void CMockFrameTraceBackend::CreateView(std::uint32_t id, MockObjectType type, std::uint32_t resource_id)
+{
+    auto* p_resource = GetObject(resource_id);
+    if (p_resource == nullptr)
+    {
+        // 视图所属的资源不在跟踪中，视图同样回放为空
+        return;
+    }
+    switch (type)
+    {
+    case MockObjectType::ShaderResourceView:
+        SetObject(id, m_device.CreateShaderResourceView(p_resource));
+        break;
+    case MockObjectType::RenderTargetView:
+        SetObject(id, m_device.CreateRenderTargetView(p_resource));
+        break;
+    default:
+        throw std::invalid_argument{"Frame trace view type is invalid."};
+    }
+}
+
+void CMockFrameTraceBackend::CreateShader(std::uint32_t id, MockObjectType type, std::span<const std::uint8_t> byte_code)
+{
+    switch (type)
+    {
+    case MockObjectType::VertexShader:
+        SetObject(id, m_device.CreateVertexShader(byte_code.data(), byte_code.size()));
+        break;
+    case MockObjectType::GeometryShader:
+        SetObject(id, m_device.CreateGeometryShader(byte_code.data(), byte_code.size()));
+        break;
+    case MockObjectType::PixelShader:
+        SetObject(id, m_device.CreatePixelShader(byte_code.data(), byte_code.size()));
+        break;
+    default:
+        throw std::invalid_argument{"Frame trace shader type is invalid."};
+    }
+}
+
+void CMockFrameTraceBackend::CreateInputLayout(std::uint32_t id, std::span<const GpuInputElementDescription> elements, std::span<const std::uint8_t> byte_code)
+{
+    SetObject(id, m_device.CreateInputLayout(elements.data(), static_cast<std::uint32_t>(elements.size()), byte_code.data(), byte_code.size()));
+}
+
+void CMockFrameTraceBackend::CreateSamplerState(std::uint32_t id, const GpuSamplerDescription& description)
+{
+    SetObject(id, m_device.CreateSamplerState(description));
+}
+
+void CMockFrameTraceBackend::CreateBlendState(std::uint32_t id, const GpuBlendDescription& description)
+{
+    SetObject(id, m_device.CreateBlendState(description));
+}
+
+void CMockFrameTraceBackend::CreateRasterizerState(std::uint32_t id, const GpuRasterizerDescription& description)
+{
+    SetObject(id, m_device.CreateRasterizerState(description));
+}
+
+void CMockFrameTraceBackend::CreateDepthStencilState(std::uint32_t id, const GpuDepthStencilDescription& description)
+{
+    SetObject(id, m_device.CreateDepthStencilState(description));
+}
+
+void CMockFrameTraceBackend::IASetPrimitiveTopology(std::uint32_t topology)
+{
+    m_context.IASetPrimitiveTopology(topology);
+}
+
+void CMockFrameTraceBackend::IASetInputLayout(std::uint32_t input_layout)
+{
+    m_context.IASetInputLayout(GetObject(input_layout));
+}
+
+void CMockFrameTraceBackend::IASetVertexBuffers(std::uint32_t start_slot, std::span<const std::uint32_t> buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets)
+{
+    m_context.IASetVertexBuffers(start_slot, static_cast<std::uint32_t>(buffers.size()), GetObjects(buffers), p_strides, p_offsets);
+}
+
+void CMockFrameTraceBackend::IASetIndexBuffer(std::uint32_t index_buffer, std::uint32_t format, std::uint32_t offset)
+{
+    m_context.IASetIndexBuffer(GetObject(index_buffer), format, offset);
+}
+
+void CMockFrameTraceBackend::SetShader(MockObjectType stage, std::uint32_t shader)
+{
+    switch (stage)
+    {
+    case MockObjectType::VertexShader:
+        m_context.VSSetShader(GetObject(shader), nullptr, 0);
+        break;
+    case MockObjectType::GeometryShader:
+        m_context.GSSetShader(GetObject(shader), nullptr, 0);
+        break;
+    case MockObjectType::PixelShader:
+        m_context.PSSetShader(GetObject(shader), nullptr, 0);
+        break;
+    default:
+        throw std::invalid_argument{"Frame trace shader stage is invalid."};
+    }
+}
+
+void CMockFrameTraceBackend::SetObjects(FrameTraceOpcode opcode, std::uint32_t start_slot, std::span<const std::uint32_t> objects)
+{
+    const auto count = static_cast<std::uint32_t>(objects.size());
+    switch (opcode)
+    {
+    case FrameTraceOpcode::VSSetConstantBuffers:
+        m_context.VSSetConstantBuffers(start_slot, count, GetObjects(objects));
+        break;
+    case FrameTraceOpcode::PSSetConstantBuffers:
+        m_context.PSSetConstantBuffers(start_slot, count, GetObjects(objects));
+        break;
+    case FrameTraceOpcode::PSSetShaderResources:
+        m_context.PSSetShaderResources(start_slot, count, GetObjects(objects));
+        break;
+    case FrameTraceOpcode::PSSetSamplers:
+        m_context.PSSetSamplers(start_slot, count, GetObjects(objects));
+        break;
+    default:
+        throw std::invalid_argument{"Frame trace binding opcode is invalid."};
+    }
+}
+
+void CMockFrameTraceBackend::RSSetState(std::uint32_t rasterizer_state)
+{
+    m_context.RSSetState(GetObject(rasterizer_state));
+}
+
+void CMockFrameTraceBackend::RSSetViewports(std::span<const MockViewport> viewports)
+{
+    m_context.RSSetViewports(static_cast<std::uint32_t>(viewports.size()), viewports.data());
+}
+
+void CMockFrameTraceBackend::OMSetBlendState(std::uint32_t blend_state, const float* p_blend_factor, std::uint32_t sample_mask)
+{
+    m_context.OMSetBlendState(GetObject(blend_state), p_blend_factor, sample_mask);
+}
+
+void CMockFrameTraceBackend::OMSetDepthStencilState(std::uint32_t depth_stencil_state, std::uint32_t stencil_ref)
+{
+    m_context.OMSetDepthStencilState(GetObject(depth_stencil_state), stencil_ref);
+}
+
+void CMockFrameTraceBackend::OMSetRenderTargets(std::span<const std::uint32_t> render_target_views, std::uint32_t depth_stencil_view)
+{
+    m_context.OMSetRenderTargets(static_cast<std::uint32_t>(render_target_views.size()), GetObjects(render_target_views), GetObject(depth_stencil_view));
+}
+
+void CMockFrameTraceBackend::SOSetTargets(std::uint32_t target_count)
+{
+    m_context.SOSetTargets(target_count, nullptr, nullptr);
+}
+
+void CMockFrameTraceBackend::Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location)
+{
+    m_context.Draw(vertex_count, start_vertex_location);
+}
+
+void CMockFrameTraceBackend::DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location)
+{
+    m_context.DrawIndexed(index_count, start_index_location, base_vertex_location);
+}
+
+void CMockFrameTraceBackend::UpdateSubresource(std::uint32_t resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch)
+{
+    auto* p_resource = GetObject(resource);
+    if (p_resource != nullptr)
+    {
+        m_context.UpdateSubresource(p_resource, subresource, p_box, p_source, row_pitch, 0);
+    }
+}
+
+void CMockFrameTraceBackend::MapAndUnmap(std::uint32_t resource, std::uint32_t subresource, std::uint32_t map_type, const void* p_written_data, std::uint32_t row_pitch, std::uint32_t size)
+{
+    auto* p_resource = GetObject(resource);
+    if (p_resource == nullptr)
+    {
+        return;
+    }
+    MockMappedSubresource mapped{};
+    m_context.Map(p_resource, subresource, map_type, 0, &mapped);
+    if (p_written_data != nullptr && row_pitch != 0)
+    {
+        const auto* p_source = static_cast<const std::uint8_t*>(p_written_data);
+        auto* p_destination = static_cast<std::uint8_t*>(mapped.m_p_data);
+        for (std::uint32_t offset = 0; offset + row_pitch <= size; offset += row_pitch)
+        {
+            std::memcpy(p_destination, p_source + offset, row_pitch);
+            p_destination += mapped.m_row_pitch;
+        }
+    }
+    m_context.Unmap(p_resource, subresource);
+}
+
+void CMockFrameTraceBackend::CopyResource(std::uint32_t destination, std::uint32_t source)
+{
+    auto* p_destination = GetObject(destination);
+    auto* p_source = GetObject(source);
+    if (p_destination != nullptr && p_source != nullptr)
+    {
+        m_context.CopyResource(p_destination, p_source);
+    }
+}
+
+void CMockFrameTraceBackend::ClearRenderTargetView(std::uint32_t render_target_view, const float color[4])
+{
+    auto* p_render_target_view = GetObject(render_target_view);
+    if (p_render_target_view != nullptr)
+    {
+        m_context.ClearRenderTargetView(p_render_target_view, color);
+    }
+}
+
+void CMockFrameTraceBackend::Flush()
+{
+    m_context.Flush();
+}
+
+void CMockFrameTraceBackend::Finish()
+{
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "CMockD3D11Device.h"
+#include "FrameTrace.h"
+
+/**
+ * @brief 在CMockD3D11Device上回放帧跟踪，用于在没有GPU的环境中检查跟踪的完整性并测量CPU端的开销 \n
+ * 跟踪中没有创建命令的对象（例如交换链的后备缓冲）回放为空，对应的绑定按空对象处理
+ */
+class CMockFrameTraceBackend final : public IFrameTraceBackend
+{
+private:
+    CMockD3D11Device& m_device;
+    CMockD3D11DeviceContext& m_context;
+    /**
+     * @brief 下标为跟踪中的对象编号，0始终为空
+     */
+    std::vector<MockObject*> m_p_objects{};
+    std::vector<MockObject*> m_p_scratch_objects{};
+
+    auto GetObject(std::uint32_t id) const
+        -> MockObject*;
+    auto GetObjects(std::span<const std::uint32_t> ids)
+        -> MockObject* const*;
+    void SetObject(std::uint32_t id, MockObject* p_object);
+    void ReleaseObjects();
+
+public:
+    explicit CMockFrameTraceBackend(CMockD3D11Device& device);
+    ~CMockFrameTraceBackend() override;
+    CMockFrameTraceBackend(const CMockFrameTraceBackend&) = delete;
+    CMockFrameTraceBackend& operator=(const CMockFrameTraceBackend&) = delete;
+
+    void Reset(std::uint32_t object_count) override;
+    void CreateBuffer(std::uint32_t id, const GpuBufferDescription& description, const void* p_initial_data) override;
+    void CreateTexture2D(std::uint32_t id, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data) override;
+    void CreateView(std::uint32_t id, MockObjectType type, std::uint32_t resource_id) override;
+    void CreateShader(std::uint32_t id, MockObjectType type, std::span<const std::uint8_t> byte_code) override;
+    void CreateInputLayout(std::uint32_t id, std::span<const GpuInputElementDescription> elements, std::span<const std::uint8_t> byte_code) override;
+    void CreateSamplerState(std::uint32_t id, const GpuSamplerDescription& description) override;
+    void CreateBlendState(std::uint32_t id, const GpuBlendDescription& description) override;
+    void CreateRasterizerState(std::uint32_t id, const GpuRasterizerDescription& description) override;
+    void CreateDepthStencilState(std::uint32_t id, const GpuDepthStencilDescription& description) override;
+
+    void IASetPrimitiveTopology(std::uint32_t topology) override;
+    void IASetInputLayout(std::uint32_t input_layout) override;
+    void IASetVertexBuffers(std::uint32_t start_slot, std::span<const std::uint32_t> buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets) override;
+    void IASetIndexBuffer(std::uint32_t index_buffer, std::uint32_t format, std::uint32_t offset) override;
+    void SetShader(MockObjectType stage, std::uint32_t shader) override;
+    void SetObjects(FrameTraceOpcode opcode, std::uint32_t start_slot, std::span<const std::uint32_t> objects) override;
+    void RSSetState(std::uint32_t rasterizer_state) override;
+    void RSSetViewports(std::span<const MockViewport> viewports) override;
+    void OMSetBlendState(std::uint32_t blend_state, const float* p_blend_factor, std::uint32_t sample_mask) override;
+    void OMSetDepthStencilState(std::uint32_t depth_stencil_state, std::uint32_t stencil_ref) override;
+    void OMSetRenderTargets(std::span<const std::uint32_t> render_target_views, std::uint32_t depth_stencil_view) override;
+    void SOSetTargets(std::uint32_t target_count) override;
+    void Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location) override;
+    void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location) override;
+    void UpdateSubresource(std::uint32_t resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch) override;
+    void MapAndUnmap(std::uint32_t resource, std::uint32_t subresource, std::uint32_t map_type, const void* p_written_data, std::uint32_t row_pitch, std::uint32_t size) override;
+    void CopyResource(std::uint32_t destination, std::uint32_t source) override;
+    void ClearRenderTargetView(std::uint32_t render_target_view, const float color[4]) override;
+    void Flush() override;
+    void Finish() override;
+};
@@ -0,0 +1,84 @@
+#include "CMockManifestBackend.h"
+#include <stdexcept>
+
+CMockManifestBackend::CMockManifestBackend(CMockD3D11Device& device) noexcept
+    : m_p_device{&device}
+{
+}
+
+void CMockManifestBackend::Reset(CMockD3D11Device& device) noexcept
+{
+    m_p_device = &device;
+}
+
+auto CMockManifestBackend::Create(const ManifestEntry& entry) const
+    -> MockObject*
+{
+    const auto initial_data = entry.GetInitialData();
+    const auto* p_initial_data = initial_data.empty() ? nullptr : initial_data.data();
+    switch (entry.m_kind)
+    {
+    case ManifestResourceKind::Buffer:
+        return m_p_device->CreateBuffer(std::get<GpuBufferDescription>(entry.m_description), p_initial_data);
+    case ManifestResourceKind::Texture2D:
+        return m_p_device->CreateTexture2D(std::get<GpuTexture2DDescription>(entry.m_description), p_initial_data);
+    case ManifestResourceKind::VertexShader:
+        return m_p_device->CreateVertexShader(entry.m_data.data(), entry.m_data.size());
+    case ManifestResourceKind::PixelShader:
+        return m_p_device->CreatePixelShader(entry.m_data.data(), entry.m_data.size());
+    case ManifestResourceKind::InputLayout:
+    {
+        const auto elements = entry.GetInputElements();
+        return m_p_device->CreateInputLayout(elements.data(), static_cast<std::uint32_t>(elements.size()), entry.m_data.data(), entry.m_data.size());
+    }
+    case ManifestResourceKind::SamplerState:
+        return m_p_device->CreateSamplerState(std::get<GpuSamplerDescription>(entry.m_description));
+    case ManifestResourceKind::RasterizerState:
+        return m_p_device->CreateRasterizerState(std::get<GpuRasterizerDescription>(entry.m_description));
+    case ManifestResourceKind::BlendState:
+        return m_p_device->CreateBlendState(std::get<GpuBlendDescription>(entry.m_description));
+    case ManifestResourceKind::DepthStencilState:
+        return m_p_device->CreateDepthStencilState(std::get<GpuDepthStencilDescription>(entry.m_description));
+    case ManifestResourceKind::ShaderResourceView:
+        return m_p_device->CreateShaderResourceView(Get(MockHandle{entry.m_parent_handle_value}));
+    case ManifestResourceKind::RenderTargetView:
+        return m_p_device->CreateRenderTargetView(Get(MockHandle{entry.m_parent_handle_value}));
+    default:
+        throw std::logic_error{"Unknown manifest resource kind."};
+    }
+}
+
+auto CMockManifestBackend::Register(const ManifestEntry&, MockObject*& p_object)
+    -> std::uint32_t
+{
+    return m_objects.Insert(p_object).m_value;
+}
+
+void CMockManifestBackend::Replace(const ManifestEntry& entry, MockObject*& p_object)
+{
+    auto* p_slot = m_objects.Get(MockHandle{entry.m_handle_value});
+    if (p_slot == nullptr)
+    {
+        throw std::logic_error{"Replacing a manifest entry whose handle is no longer valid."};
+    }
+    *p_slot = p_object;
+}
+
+auto CMockManifestBackend::GetTraceObject(ManifestResourceKind, std::uint32_t handle_value) const
+    -> const void*
+{
+    return Get(MockHandle{handle_value});
+}
+
+auto CMockManifestBackend::Get(MockHandle handle) const noexcept
+    -> MockObject*
+{
+    auto* p_result = m_objects.Get(handle);
+    return p_result == nullptr ? nullptr : *p_result;
+}
+
+auto CMockManifestBackend::GetDevice() const noexcept
+    -> CMockD3D11Device&
+{
+    return *m_p_device;
+}
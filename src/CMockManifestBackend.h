@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include "CHandleTable.h"
+#include "CMockD3D11Device.h"
+#include "CResourceManifest.h"
+
+using MockHandle = Handle<MockObject*>;
+
+/**
+ * @brief 资源清单在模拟设备上的后端，使窗口程序的管线建立代码可以在模拟设备上运行 \n
+ * 对象由设备持有，句柄表只保存指针；所有种类的对象共用一张句柄表 \n
+ * 模拟设备不是线程安全的，重建时只用一个线程创建对象
+ */
+class CMockManifestBackend
+{
+private:
+    CMockD3D11Device* m_p_device{};
+    CHandleTable<MockObject*> m_objects{};
+
+public:
+    using Object = MockObject*;
+    using Buffer = MockHandle;
+    using Texture = MockHandle;
+    using ShaderResourceView = MockHandle;
+    using RenderTargetView = MockHandle;
+    using VertexShader = MockHandle;
+    using PixelShader = MockHandle;
+    using InputLayout = MockHandle;
+    using SamplerState = MockHandle;
+    using RasterizerState = MockHandle;
+    using BlendState = MockHandle;
+    using DepthStencilState = MockHandle;
+    using Viewport = MockViewport;
+    using PrimitiveTopology = std::uint32_t;
+    using Format = std::uint32_t;
+    constexpr static unsigned MAX_RECOVERY_WORKER_COUNT = 1;
+
+    explicit CMockManifestBackend(CMockD3D11Device& device) noexcept;
+
+    /**
+     * @brief 之后的对象在device上创建，旧对象仍归旧设备所有
+     */
+    void Reset(CMockD3D11Device& device) noexcept;
+    auto Create(const ManifestEntry& entry) const
+        -> MockObject*;
+    auto Register(const ManifestEntry& entry, MockObject*& p_object)
+        -> std::uint32_t;
+    void Replace(const ManifestEntry& entry, MockObject*& p_object);
+    auto GetTraceObject(ManifestResourceKind kind, std::uint32_t handle_value) const
+        -> const void*;
+    auto Get(MockHandle handle) const noexcept
+        -> MockObject*;
+    auto GetDevice() const noexcept
+        -> CMockD3D11Device&;
+};
+
+using CMockResourceManifest = CResourceManifest<CMockManifestBackend>;
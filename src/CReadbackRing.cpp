@@ -0,0 +1,117 @@
+#include "CReadbackRing.h"
+#include <algorithm>
+#include <stdexcept>
+
+CReadbackRing::CReadbackRing(IReadbackBackend& backend, const ReadbackRingConfig& config)
+    : m_backend{backend}, m_config{config}
+{
+    if (m_config.m_width == 0 || m_config.m_height == 0 || m_config.m_ring_depth == 0)
+    {
+        throw std::invalid_argument{"Size and depth of readback ring must not be zero."};
+    }
+    m_slots.resize(m_config.m_ring_depth);
+    for (auto& slot : m_slots)
+    {
+        slot.m_backend_index = m_backend.CreateStagingSlot(m_config.m_width, m_config.m_height);
+    }
+}
+
+CReadbackRing::~CReadbackRing()
+{
+    Release();
+}
+
+bool CReadbackRing::Request(std::uint32_t source)
+{
+    ++m_frame_index;
+    ++m_statistics.m_request_count;
+    // 按环的顺序找空闲槽，全部在途时跳过本帧而不是等待
+    for (std::uint32_t i = 0; i < m_slots.size(); ++i)
+    {
+        const auto slot_index = (m_next_slot + i) % static_cast<std::uint32_t>(m_slots.size());
+        auto& slot = m_slots[slot_index];
+        if (slot.m_state != SlotState::Free)
+        {
+            continue;
+        }
+        m_backend.CopyToSlot(slot.m_backend_index, source);
+        slot.m_state = SlotState::Pending;
+        slot.m_frame_index = m_frame_index;
+        m_next_slot = (slot_index + 1) % static_cast<std::uint32_t>(m_slots.size());
+        return true;
+    }
+    ++m_statistics.m_skipped_count;
+    return false;
+}
+
+auto CReadbackRing::TryAcquireLatest()
+    -> std::optional<ReadbackView>
+{
+    Slot* p_latest_ready_slot = nullptr;
+    for (auto& slot : m_slots)
+    {
+        if (slot.m_state == SlotState::Pending &&
+            (p_latest_ready_slot == nullptr || slot.m_frame_index > p_latest_ready_slot->m_frame_index) &&
+            m_backend.IsSlotReady(slot.m_backend_index))
+        {
+            p_latest_ready_slot = &slot;
+        }
+    }
+    if (p_latest_ready_slot == nullptr)
+    {
+        return std::nullopt;
+    }
+    // 更早的请求已经没有意义，空出暂存槽给后续帧
+    for (auto& slot : m_slots)
+    {
+        if (slot.m_state == SlotState::Pending && slot.m_frame_index < p_latest_ready_slot->m_frame_index)
+        {
+            slot.m_state = SlotState::Free;
+            ++m_statistics.m_superseded_count;
+        }
+    }
+    Release();
+
+    const auto mapped = m_backend.MapSlot(p_latest_ready_slot->m_backend_index);
+    p_latest_ready_slot->m_state = SlotState::Mapped;
+    m_mapped_slot = static_cast<std::uint32_t>(p_latest_ready_slot - m_slots.data());
+
+    const auto latency_frames = m_frame_index - p_latest_ready_slot->m_frame_index;
+    ++m_statistics.m_acquired_count;
+    m_statistics.m_total_latency_frames += latency_frames;
+    m_statistics.m_max_latency_frames = (std::max)(m_statistics.m_max_latency_frames, latency_frames);
+    m_statistics.m_bytes_read += static_cast<std::uint64_t>(m_config.m_width) * m_config.m_height * m_config.m_bytes_per_pixel;
+
+    ReadbackView view{};
+    view.m_p_data = mapped.m_p_data;
+    view.m_row_pitch = mapped.m_row_pitch;
+    view.m_width = m_config.m_width;
+    view.m_height = m_config.m_height;
+    view.m_bytes_per_pixel = m_config.m_bytes_per_pixel;
+    view.m_frame_index = p_latest_ready_slot->m_frame_index;
+    return view;
+}
+
+void CReadbackRing::Release()
+{
+    if (!m_mapped_slot)
+    {
+        return;
+    }
+    auto& slot = m_slots[*m_mapped_slot];
+    m_backend.UnmapSlot(slot.m_backend_index);
+    slot.m_state = SlotState::Free;
+    m_mapped_slot.reset();
+}
+
+bool CReadbackRing::HasPendingRequest() const noexcept
+{
+    return std::any_of(m_slots.begin(), m_slots.end(), [](const Slot& slot)
+                       { return slot.m_state == SlotState::Pending; });
+}
+
+auto CReadbackRing::GetStatistics() const noexcept
+    -> const ReadbackStatistics&
+{
+    return m_statistics;
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "CUploadEngine.h"
+
+/**
+ * @brief 读回环的后端，负责创建暂存槽、发出复制命令并查询复制是否完成
+ */
+class IReadbackBackend
+{
+public:
+    virtual ~IReadbackBackend() = default;
+
+    /**
+     * @brief 创建一个CPU可读的暂存槽，返回从0开始连续的编号
+     */
+    virtual auto CreateStagingSlot(std::uint32_t width, std::uint32_t height)
+        -> std::uint32_t = 0;
+    /**
+     * @brief 把source的左上角复制到暂存槽，并在复制之后插入完成标记
+     *
+     * @param source 后端可识别的源纹理编号
+     */
+    virtual void CopyToSlot(std::uint32_t slot, std::uint32_t source) = 0;
+    /**
+     * @brief 复制是否已经完成，不得等待
+     */
+    virtual bool IsSlotReady(std::uint32_t slot) = 0;
+    /**
+     * @brief 映射已完成的暂存槽供CPU读取
+     */
+    virtual auto MapSlot(std::uint32_t slot)
+        -> MappedStagingBlock = 0;
+    virtual void UnmapSlot(std::uint32_t slot) = 0;
+};
+
+struct ReadbackRingConfig
+{
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_bytes_per_pixel{4};
+    /**
+     * @brief 暂存槽数量；为N时通常读到N-1或N-2帧之前的内容
+     */
+    std::uint32_t m_ring_depth{3};
+};
+
+/**
+ * @brief 直接指向映射内存的只读视图，行距以m_row_pitch为准，可能大于宽度乘以像素大小
+ */
+struct ReadbackView
+{
+    const std::uint8_t* m_p_data{};
+    std::uint32_t m_row_pitch{};
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_bytes_per_pixel{};
+    /**
+     * @brief 发出该次读回请求时的帧序号
+     */
+    std::uint64_t m_frame_index{};
+
+    auto GetRow(std::uint32_t y) const noexcept
+        -> const std::uint8_t*
+    {
+        return m_p_data + static_cast<std::size_t>(y) * m_row_pitch;
+    }
+};
+
+struct ReadbackStatistics
+{
+    std::uint64_t m_request_count{};
+    std::uint64_t m_acquired_count{};
+    /**
+     * @brief 没有空闲暂存槽、跳过的请求数
+     */
+    std::uint64_t m_skipped_count{};
+    /**
+     * @brief 完成前就被更新的帧取代、没有被读取的请求数
+     */
+    std::uint64_t m_superseded_count{};
+    /**
+     * @brief 读取到的帧与读取时最新请求之间相差的帧数之和，除以m_acquired_count即平均延迟
+     */
+    std::uint64_t m_total_latency_frames{};
+    std::uint64_t m_max_latency_frames{};
+    std::uint64_t m_bytes_read{};
+};
+
+/**
+ * @brief 异步读回环：每帧把源纹理复制到一个暂存槽，之后只读取已经完成的暂存槽，从不等待GPU \n
+ * 直接Map刚写入的纹理会让CPU等待GPU执行完之前的全部命令，这里以几帧延迟换取不阻塞
+ */
+class CReadbackRing
+{
+private:
+    enum class SlotState
+    {
+        Free,
+        Pending,
+        Mapped,
+    };
+    struct Slot
+    {
+        std::uint32_t m_backend_index{};
+        SlotState m_state{SlotState::Free};
+        std::uint64_t m_frame_index{};
+    };
+
+    IReadbackBackend& m_backend;
+    ReadbackRingConfig m_config{};
+    std::vector<Slot> m_slots{};
+    std::uint32_t m_next_slot{};
+    std::uint64_t m_frame_index{};
+    std::optional<std::uint32_t> m_mapped_slot{};
+    ReadbackStatistics m_statistics{};
+
+public:
+    CReadbackRing(IReadbackBackend& backend, const ReadbackRingConfig& config);
+    ~CReadbackRing();
+    CReadbackRing(const CReadbackRing&) = delete;
+    CReadbackRing& operator=(const CReadbackRing&) = delete;
+
+    /**
+     * @brief 请求读回source，在该帧的绘制命令之后调用；没有空闲暂存槽时跳过并返回false
+     */
+    bool Request(std::uint32_t source);
+    /**
+     * @brief 取得已经完成的最新一帧并释放之前的视图，比它更早的未完成请求被丢弃，不等待GPU
+     *
+     * @return 没有新完成的帧时返回std::nullopt，之前返回的视图仍然有效
+     */
+    auto TryAcquireLatest()
+        -> std::optional<ReadbackView>;
+    /**
+     * @brief 释放TryAcquireLatest返回的视图，使其暂存槽可以复用
+     */
+    void Release();
+    /**
+     * @brief 是否还有未完成的请求
+     */
+    bool HasPendingRequest() const noexcept;
+
+    auto GetStatistics() const noexcept
+        -> const ReadbackStatistics&;
+};
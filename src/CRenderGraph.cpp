@@ -0,0 +1,255 @@
+#include "CRenderGraph.h"
+#include <algorithm>
+#include <stdexcept>
+
+CRenderGraph::CPassBuilder::CPassBuilder(CRenderGraph& graph, std::uint32_t pass_index) noexcept
+    : m_graph{graph}, m_pass_index{pass_index}
+{
+}
+
+auto CRenderGraph::CPassBuilder::Read(RenderGraphResourceId resource)
+    -> CPassBuilder&
+{
+    m_graph.CheckResource(resource);
+    m_graph.m_passes[m_pass_index].m_reads.push_back(resource);
+    return *this;
+}
+
+auto CRenderGraph::CPassBuilder::Write(RenderGraphResourceId resource)
+    -> CPassBuilder&
+{
+    m_graph.CheckResource(resource);
+    m_graph.m_passes[m_pass_index].m_writes.push_back(resource);
+    return *this;
+}
+
+auto CRenderGraph::CPassBuilder::SetHasSideEffect()
+    -> CPassBuilder&
+{
+    m_graph.m_passes[m_pass_index].m_has_side_effect = true;
+    return *this;
+}
+
+void CRenderGraph::CheckResource(RenderGraphResourceId resource) const
+{
+    if (resource >= m_resources.size())
+    {
+        throw std::out_of_range{"Render graph resource id is invalid."};
+    }
+}
+
+auto CRenderGraph::CreateTexture(const std::string& name, const TextureDescription& description)
+    -> RenderGraphResourceId
+{
+    Resource resource{};
+    resource.m_name = name;
+    resource.m_description = description;
+    m_resources.push_back(resource);
+    m_is_compiled = false;
+    return static_cast<RenderGraphResourceId>(m_resources.size() - 1);
+}
+
+auto CRenderGraph::ImportTexture(const std::string& name, const TextureDescription& description, std::uint32_t external_index)
+    -> RenderGraphResourceId
+{
+    auto result = CreateTexture(name, description);
+    m_resources[result].m_is_imported = true;
+    m_resources[result].m_external_index = external_index;
+    return result;
+}
+
+void CRenderGraph::MarkOutput(RenderGraphResourceId resource)
+{
+    CheckResource(resource);
+    m_resources[resource].m_is_output = true;
+    m_is_compiled = false;
+}
+
+void CRenderGraph::AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute)
+{
+    Pass pass{};
+    pass.m_name = name;
+    pass.m_execute = std::move(execute);
+    m_passes.push_back(std::move(pass));
+    CPassBuilder builder{*this, static_cast<std::uint32_t>(m_passes.size() - 1)};
+    setup(builder);
+    m_is_compiled = false;
+}
+
+void CRenderGraph::CullPasses()
+{
+    // pass按声明顺序执行，因此从后往前遍历即可得到所有被需要的资源
+    std::vector<bool> is_needed(m_resources.size(), false);
+    for (std::size_t i = 0; i < m_resources.size(); ++i)
+    {
+        is_needed[i] = m_resources[i].m_is_output;
+    }
+    m_statistics.m_culled_pass_count = 0;
+    for (auto it = m_passes.rbegin(); it != m_passes.rend(); ++it)
+    {
+        auto& pass = *it;
+        pass.m_is_alive = pass.m_has_side_effect ||
+                          std::any_of(pass.m_writes.begin(), pass.m_writes.end(), [&is_needed](RenderGraphResourceId resource)
+                                      { return is_needed[resource]; });
+        if (!pass.m_is_alive)
+        {
+            ++m_statistics.m_culled_pass_count;
+            continue;
+        }
+        for (auto resource : pass.m_reads)
+        {
+            is_needed[resource] = true;
+        }
+    }
+}
+
+void CRenderGraph::ComputeLifetimes()
+{
+    constexpr auto NEVER_USED = (std::numeric_limits<std::uint32_t>::max)();
+    for (auto& resource : m_resources)
+    {
+        resource.m_first_pass = NEVER_USED;
+        resource.m_last_pass = 0;
+        resource.m_physical_index = NEVER_USED;
+    }
+    for (std::uint32_t pass_index = 0; pass_index < m_passes.size(); ++pass_index)
+    {
+        const auto& pass = m_passes[pass_index];
+        if (!pass.m_is_alive)
+        {
+            continue;
+        }
+        auto touch = [this, pass_index](RenderGraphResourceId id)
+        {
+            auto& resource = m_resources[id];
+            resource.m_first_pass = (std::min)(resource.m_first_pass, pass_index);
+            resource.m_last_pass = (std::max)(resource.m_last_pass, pass_index);
+        };
+        std::for_each(pass.m_reads.begin(), pass.m_reads.end(), touch);
+        std::for_each(pass.m_writes.begin(), pass.m_writes.end(), touch);
+    }
+    // 输出资源需要存活到图执行结束
+    const auto last_pass = m_passes.empty() ? 0 : static_cast<std::uint32_t>(m_passes.size() - 1);
+    for (auto& resource : m_resources)
+    {
+        if (resource.m_is_output && resource.m_first_pass != NEVER_USED)
+        {
+            resource.m_last_pass = last_pass;
+        }
+    }
+}
+
+void CRenderGraph::AssignPhysicalTextures()
+{
+    constexpr auto NEVER_USED = (std::numeric_limits<std::uint32_t>::max)();
+    m_physical_textures.clear();
+    m_statistics.m_transient_texture_count = 0;
+    m_statistics.m_total_transient_bytes = 0;
+    m_statistics.m_physical_bytes = 0;
+
+    std::vector<std::uint32_t> free_physical_textures{};
+    for (std::uint32_t pass_index = 0; pass_index < m_passes.size(); ++pass_index)
+    {
+        if (!m_passes[pass_index].m_is_alive)
+        {
+            continue;
+        }
+        // 先为本pass开始使用的资源分配，再回收本pass后不再使用的资源，保证同一pass的输入输出不会别名
+        for (auto& resource : m_resources)
+        {
+            if (resource.m_is_imported || resource.m_first_pass != pass_index)
+            {
+                continue;
+            }
+            ++m_statistics.m_transient_texture_count;
+            m_statistics.m_total_transient_bytes += resource.m_description.GetSizeInBytes();
+            auto it = std::find_if(free_physical_textures.begin(), free_physical_textures.end(), [this, &resource](std::uint32_t physical_index)
+                                   { return m_physical_textures[physical_index] == resource.m_description; });
+            if (it != free_physical_textures.end())
+            {
+                resource.m_physical_index = *it;
+                free_physical_textures.erase(it);
+            }
+            else
+            {
+                resource.m_physical_index = static_cast<std::uint32_t>(m_physical_textures.size());
+                m_physical_textures.push_back(resource.m_description);
+                m_statistics.m_physical_bytes += resource.m_description.GetSizeInBytes();
+            }
+        }
+        for (const auto& resource : m_resources)
+        {
+            if (!resource.m_is_imported && resource.m_physical_index != NEVER_USED && resource.m_last_pass == pass_index)
+            {
+                free_physical_textures.push_back(resource.m_physical_index);
+            }
+        }
+    }
+    m_statistics.m_physical_texture_count = static_cast<std::uint32_t>(m_physical_textures.size());
+}
+
+void CRenderGraph::Compile()
+{
+    m_statistics.m_declared_pass_count = static_cast<std::uint32_t>(m_passes.size());
+    CullPasses();
+    ComputeLifetimes();
+    AssignPhysicalTextures();
+    m_is_compiled = true;
+}
+
+void CRenderGraph::Execute()
+{
+    if (!m_is_compiled)
+    {
+        Compile();
+    }
+    for (const auto& pass : m_passes)
+    {
+        if (pass.m_is_alive && pass.m_execute)
+        {
+            pass.m_execute(*this);
+        }
+    }
+}
+
+void CRenderGraph::Clear() noexcept
+{
+    m_resources.clear();
+    m_passes.clear();
+    m_physical_textures.clear();
+    m_statistics = {};
+    m_is_compiled = false;
+}
+
+auto CRenderGraph::ResolveTexture(RenderGraphResourceId resource) const
+    -> RenderGraphTextureBinding
+{
+    CheckResource(resource);
+    const auto& current = m_resources[resource];
+    if (current.m_is_imported)
+    {
+        return {true, current.m_external_index};
+    }
+    if (!m_is_compiled || current.m_physical_index >= m_physical_textures.size())
+    {
+        throw std::logic_error{"Render graph resource is not allocated: " + current.m_name};
+    }
+    return {false, current.m_physical_index};
+}
+
+auto CRenderGraph::GetPhysicalTextures() const noexcept
+    -> const std::vector<TextureDescription>&
+{
+    return m_physical_textures;
+}
+
+auto CRenderGraph::GetStatistics() const noexcept
+    -> const RenderGraphStatistics&
+{
+    return m_statistics;
+}
+
+bool CRenderGraph::IsPassAlive(std::uint32_t pass_index) const
+{
+    return m_passes.at(pass_index).m_is_alive;
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "GpuResourceDescription.h"
+
+using RenderGraphResourceId = std::uint32_t;
+
+/**
+ * @brief 虚拟资源解析后的结果：导入资源返回导入时给出的外部编号，临时资源返回物理纹理池中的编号
+ */
+struct RenderGraphTextureBinding
+{
+    bool m_is_imported{};
+    std::uint32_t m_index{};
+};
+
+struct RenderGraphStatistics
+{
+    std::uint32_t m_declared_pass_count{};
+    std::uint32_t m_culled_pass_count{};
+    std::uint32_t m_transient_texture_count{};
+    std::uint32_t m_physical_texture_count{};
+    /**
+     * @brief 不做别名时所有存活临时纹理的总字节数
+     */
+    std::uint64_t m_total_transient_bytes{};
+    /**
+     * @brief 别名后物理纹理池的总字节数
+     */
+    std::uint64_t m_physical_bytes{};
+};
+
+/**
+ * @brief 声明式渲染图：pass声明读写的资源，编译时裁剪无用pass、计算资源生命周期，
+ * 并让生命周期不重叠且描述相同的临时纹理共用同一块物理纹理
+ */
+class CRenderGraph
+{
+public:
+    constexpr static RenderGraphResourceId INVALID_RESOURCE = (std::numeric_limits<RenderGraphResourceId>::max)();
+
+    class CPassBuilder
+    {
+        friend class CRenderGraph;
+
+    private:
+        CRenderGraph& m_graph;
+        std::uint32_t m_pass_index;
+
+        CPassBuilder(CRenderGraph& graph, std::uint32_t pass_index) noexcept;
+
+    public:
+        auto Read(RenderGraphResourceId resource)
+            -> CPassBuilder&;
+        auto Write(RenderGraphResourceId resource)
+            -> CPassBuilder&;
+        /**
+         * @brief 标记该pass有图外可见的副作用，不会被裁剪
+         */
+        auto SetHasSideEffect()
+            -> CPassBuilder&;
+    };
+
+    using SetupFunction = std::function<void(CPassBuilder&)>;
+    using ExecuteFunction = std::function<void(const CRenderGraph&)>;
+
+private:
+    struct Resource
+    {
+        std::string m_name{};
+        TextureDescription m_description{};
+        bool m_is_imported{};
+        bool m_is_output{};
+        std::uint32_t m_external_index{};
+        std::uint32_t m_first_pass{};
+        std::uint32_t m_last_pass{};
+        std::uint32_t m_physical_index{};
+    };
+    struct Pass
+    {
+        std::string m_name{};
+        std::vector<RenderGraphResourceId> m_reads{};
+        std::vector<RenderGraphResourceId> m_writes{};
+        ExecuteFunction m_execute{};
+        bool m_has_side_effect{};
+        bool m_is_alive{};
+    };
+
+    std::vector<Resource> m_resources{};
+    std::vector<Pass> m_passes{};
+    std::vector<TextureDescription> m_physical_textures{};
+    RenderGraphStatistics m_statistics{};
+    bool m_is_compiled{};
+
+    void CheckResource(RenderGraphResourceId resource) const;
+    void CullPasses();
+    void ComputeLifetimes();
+    void AssignPhysicalTextures();
+
+public:
+    CRenderGraph() = default;
+    ~CRenderGraph() = default;
+
+    /**
+     * @brief 创建由渲染图管理的临时纹理
+     */
+    auto CreateTexture(const std::string& name, const TextureDescription& description)
+        -> RenderGraphResourceId;
+    /**
+     * @brief 导入外部纹理（如后台缓冲区、GDI纹理），不参与别名
+     *
+     * @param external_index 解析时原样返回给调用者的编号
+     */
+    auto ImportTexture(const std::string& name, const TextureDescription& description, std::uint32_t external_index)
+        -> RenderGraphResourceId;
+    /**
+     * @brief 标记资源为渲染图的输出，写入它的pass不会被裁剪
+     */
+    void MarkOutput(RenderGraphResourceId resource);
+    void AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+    void Compile();
+    /**
+     * @brief 按顺序执行所有存活的pass，未编译时先编译
+     */
+    void Execute();
+    /**
+     * @brief 按顺序对每个存活的pass调用execute_pass(pass序号)，代替声明时给出的函数 \n
+     * 图只编译一次、每帧参数不同时使用，不必每帧重建图
+     */
+    template <class Function>
+    void Execute(Function&& execute_pass) const
+    {
+        if (!m_is_compiled)
+        {
+            throw std::logic_error{"Render graph must be compiled before executing with per-frame functions."};
+        }
+        for (std::uint32_t i = 0; i < m_passes.size(); ++i)
+        {
+            if (m_passes[i].m_is_alive)
+            {
+                execute_pass(i);
+            }
+        }
+    }
+    void Clear() noexcept;
+
+    auto ResolveTexture(RenderGraphResourceId resource) const
+        -> RenderGraphTextureBinding;
+    /**
+     * @brief 编译后物理纹理池的描述，下标即物理编号
+     */
+    auto GetPhysicalTextures() const noexcept
+        -> const std::vector<TextureDescription>&;
+    auto GetStatistics() const noexcept
+        -> const RenderGraphStatistics&;
+    bool IsPassAlive(std::uint32_t pass_index) const;
+};
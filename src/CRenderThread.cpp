@@ -0,0 +1,96 @@
+#include "CRenderThread.h"
+#include <stdexcept>
+#include <utility>
+
+CRenderThread::CRenderThread(CommandHandler command_handler, FrameFunction frame_function, std::size_t queue_capacity)
+    : m_command_handler{std::move(command_handler)},
+      m_frame_function{std::move(frame_function)},
+      m_queue{queue_capacity},
+      m_thread{[this]()
+               { Run(); }}
+{
+}
+
+CRenderThread::~CRenderThread()
+{
+    m_is_stopping.store(true, std::memory_order_release);
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void CRenderThread::Run() noexcept
+{
+    try
+    {
+        RenderCommand command{};
+        while (!m_is_stopping.load(std::memory_order_acquire))
+        {
+            while (m_queue.TryPop(command))
+            {
+                m_command_handler(command);
+            }
+            if (m_frame_function())
+            {
+                m_frame_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    catch (...)
+    {
+        m_p_exception = std::current_exception();
+    }
+    m_has_exited.store(true, std::memory_order_release);
+}
+
+bool CRenderThread::TryPost(const RenderCommand& command)
+{
+    return m_queue.TryPush(command);
+}
+
+void CRenderThread::Post(const RenderCommand& command)
+{
+    if (m_queue.TryPush(command))
+    {
+        return;
+    }
+    ++m_blocked_post_count;
+    while (!m_queue.TryPush(command))
+    {
+        if (m_has_exited.load(std::memory_order_acquire))
+        {
+            throw std::runtime_error{"Render thread has exited."};
+        }
+        std::this_thread::yield();
+    }
+}
+
+void CRenderThread::Stop()
+{
+    m_is_stopping.store(true, std::memory_order_release);
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+    if (m_p_exception)
+    {
+        std::rethrow_exception(std::exchange(m_p_exception, nullptr));
+    }
+}
+
+bool CRenderThread::IsRunning() const noexcept
+{
+    return !m_has_exited.load(std::memory_order_acquire);
+}
+
+auto CRenderThread::GetStatistics() const noexcept
+    -> RenderThreadStatistics
+{
+    RenderThreadStatistics statistics{};
+    statistics.m_queue = m_queue.GetStatistics();
+    statistics.m_queue_depth = m_queue.GetDepth();
+    statistics.m_blocked_post_count = m_blocked_post_count;
+    statistics.m_frame_count = m_frame_count.load(std::memory_order_relaxed);
+    return statistics;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include "CSpscQueue.h"
+
+enum class RenderCommandType : std::uint32_t
+{
+    /**
+     * @brief 表面内容需要整体重新合成，例如窗口被重新显示
+     */
+    InvalidateSurface,
+    /**
+     * @brief 修改alpha增量，新值在m_value中
+     */
+    SetAlphaIncrement,
+    /**
+     * @brief 把下一帧的合成结果保存为图片
+     */
+    CaptureFrame,
+};
+
+/**
+ * @brief UI线程发送给渲染线程的命令，保持为平凡类型以便放入无锁队列
+ */
+struct RenderCommand
+{
+    RenderCommandType m_type{};
+    float m_value{};
+};
+
+struct RenderThreadStatistics
+{
+    SpscQueueStatistics m_queue{};
+    std::size_t m_queue_depth{};
+    /**
+     * @brief Post因队列已满而等待的次数
+     */
+    std::uint64_t m_blocked_post_count{};
+    std::uint64_t m_frame_count{};
+};
+
+/**
+ * @brief 独占设备上下文的渲染线程：每帧先处理队列中的全部命令，再调用帧函数构建并呈现一帧 \n
+ * 帧函数应在有限时间内返回（例如带超时地等待交换链），以便及时响应Stop \n
+ * Post、TryPost和GetStatistics只能由同一个线程（通常是UI线程）调用
+ */
+class CRenderThread
+{
+public:
+    using CommandHandler = std::function<void(const RenderCommand&)>;
+    /**
+     * @brief 构建一帧，返回是否实际呈现了一帧；等待超时时返回false
+     */
+    using FrameFunction = std::function<bool()>;
+
+private:
+    CommandHandler m_command_handler;
+    FrameFunction m_frame_function;
+    CSpscQueue<RenderCommand> m_queue;
+    std::atomic<bool> m_is_stopping{false};
+    std::atomic<bool> m_has_exited{false};
+    std::atomic<std::uint64_t> m_frame_count{0};
+    std::uint64_t m_blocked_post_count{};
+    std::exception_ptr m_p_exception{};
+    // 最后初始化，线程启动时其它成员都已构造完成
+    std::thread m_thread;
+
+    void Run() noexcept;
+
+public:
+    /**
+     * @brief 创建并启动渲染线程，两个函数都在渲染线程上调用
+     *
+     * @param queue_capacity 命令队列容量，必须是2的幂
+     */
+    CRenderThread(CommandHandler command_handler, FrameFunction frame_function, std::size_t queue_capacity = 256);
+    ~CRenderThread();
+    CRenderThread(const CRenderThread&) = delete;
+    CRenderThread& operator=(const CRenderThread&) = delete;
+
+    /**
+     * @brief 发送命令，队列已满时立即返回false
+     */
+    bool TryPost(const RenderCommand& command);
+    /**
+     * @brief 发送命令，队列已满时让出时间片等待渲染线程消费；渲染线程已退出时抛出std::runtime_error
+     */
+    void Post(const RenderCommand& command);
+    /**
+     * @brief 通知渲染线程退出并等待，渲染线程中抛出的异常在此重新抛出
+     */
+    void Stop();
+    /**
+     * @brief 渲染线程是否仍在运行，帧函数或命令处理函数抛出异常后返回false
+     */
+    bool IsRunning() const noexcept;
+
+    auto GetStatistics() const noexcept
+        -> RenderThreadStatistics;
+};
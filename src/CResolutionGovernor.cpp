@@ -0,0 +1,130 @@
+#include "CResolutionGovernor.h"
+#include <algorithm>
+#include <stdexcept>
+
+CResolutionGovernor::CResolutionGovernor(const ResolutionGovernorConfig& config)
+    : m_config{config}
+{
+    if (m_config.m_scales.empty() || m_config.m_frame_budget_ms <= 0.0)
+    {
+        throw std::invalid_argument{"Resolution governor needs at least one scale and a positive frame budget."};
+    }
+    if (m_config.m_upscale_load >= m_config.m_downscale_load)
+    {
+        throw std::invalid_argument{"Upscale load of resolution governor must be lower than downscale load."};
+    }
+    m_statistics.m_frames_at_scale.assign(m_config.m_scales.size(), 0);
+}
+
+void CResolutionGovernor::ChangeScale(std::size_t new_scale_index)
+{
+    ResolutionDecision decision{};
+    decision.m_frame_index = m_statistics.m_frame_count;
+    decision.m_old_scale = m_config.m_scales[m_scale_index];
+    decision.m_new_scale = m_config.m_scales[new_scale_index];
+    decision.m_smoothed_load = m_smoothed_load;
+    if (m_config.m_decision_history_size != 0)
+    {
+        if (m_decisions.size() < m_config.m_decision_history_size)
+        {
+            m_decisions.push_back(decision);
+        }
+        else
+        {
+            m_decisions[m_next_decision] = decision;
+        }
+        m_next_decision = (m_next_decision + 1) % m_config.m_decision_history_size;
+    }
+
+    if (new_scale_index > m_scale_index)
+    {
+        ++m_statistics.m_downscale_count;
+    }
+    else
+    {
+        ++m_statistics.m_upscale_count;
+    }
+    m_scale_index = new_scale_index;
+    m_over_budget_frame_count = 0;
+    m_under_budget_frame_count = 0;
+    // 旧比例下的负载不能代表新比例，平滑值从下一帧重新开始
+    m_has_sample = false;
+}
+
+auto CResolutionGovernor::Update(const FrameLoadSample& sample)
+    -> float
+{
+    // CPU和GPU并行执行，较慢的一方决定帧耗时
+    const auto load = (std::max)(sample.m_cpu_frame_ms, sample.m_gpu_frame_ms) / m_config.m_frame_budget_ms;
+    m_smoothed_load = m_has_sample ? m_smoothed_load + m_config.m_smoothing * (load - m_smoothed_load) : load;
+    m_has_sample = true;
+    ++m_statistics.m_frames_at_scale[m_scale_index];
+
+    if (m_smoothed_load > m_config.m_downscale_load)
+    {
+        ++m_over_budget_frame_count;
+        m_under_budget_frame_count = 0;
+    }
+    else if (m_smoothed_load < m_config.m_upscale_load)
+    {
+        ++m_under_budget_frame_count;
+        m_over_budget_frame_count = 0;
+    }
+    else
+    {
+        m_over_budget_frame_count = 0;
+        m_under_budget_frame_count = 0;
+    }
+
+    if (m_over_budget_frame_count >= m_config.m_downscale_frame_count && m_scale_index + 1 < m_config.m_scales.size())
+    {
+        ChangeScale(m_scale_index + 1);
+    }
+    else if (m_under_budget_frame_count >= m_config.m_upscale_frame_count && m_scale_index != 0)
+    {
+        // 按像素数估计恢复后的负载，估计值会越过降低阈值时保持不变，避免升一级后立刻又降回来
+        const double scale_ratio = m_config.m_scales[m_scale_index - 1] / m_config.m_scales[m_scale_index];
+        if (m_smoothed_load * scale_ratio * scale_ratio < m_config.m_downscale_load)
+        {
+            ChangeScale(m_scale_index - 1);
+        }
+        else
+        {
+            m_under_budget_frame_count = 0;
+        }
+    }
+    ++m_statistics.m_frame_count;
+    return GetScale();
+}
+
+auto CResolutionGovernor::GetScale() const noexcept
+    -> float
+{
+    return m_config.m_scales[m_scale_index];
+}
+
+auto CResolutionGovernor::GetSmoothedLoad() const noexcept
+    -> double
+{
+    return m_smoothed_load;
+}
+
+auto CResolutionGovernor::GetStatistics() const noexcept
+    -> const ResolutionGovernorStatistics&
+{
+    return m_statistics;
+}
+
+auto CResolutionGovernor::GetRecentDecisions() const
+    -> std::vector<ResolutionDecision>
+{
+    if (m_decisions.size() < m_config.m_decision_history_size)
+    {
+        return m_decisions;
+    }
+    std::vector<ResolutionDecision> result{};
+    result.reserve(m_decisions.size());
+    result.insert(result.end(), m_decisions.begin() + m_next_decision, m_decisions.end());
+    result.insert(result.end(), m_decisions.begin(), m_decisions.begin() + m_next_decision);
+    return result;
+}
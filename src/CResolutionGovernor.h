@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ResolutionGovernorConfig
+{
+    /**
+     * @brief 每帧的时间预算，单位为毫秒
+     */
+    double m_frame_budget_ms{16.0};
+    /**
+     * @brief 可选的渲染比例，从高到低排列，第一个应为1
+     */
+    std::vector<float> m_scales{1.0f, 0.75f, 0.5f};
+    /**
+     * @brief 平滑后的负载（耗时/预算）高于该值时降低分辨率
+     */
+    double m_downscale_load{0.9};
+    /**
+     * @brief 平滑后的负载低于该值时恢复分辨率，与m_downscale_load之间的区间即迟滞区间
+     */
+    double m_upscale_load{0.6};
+    /**
+     * @brief 负载需要连续越界的帧数，恢复比降低更保守
+     */
+    std::uint32_t m_downscale_frame_count{5};
+    std::uint32_t m_upscale_frame_count{60};
+    /**
+     * @brief 指数滑动平均的系数
+     */
+    double m_smoothing{0.1};
+    /**
+     * @brief 保留的最近决策数量
+     */
+    std::size_t m_decision_history_size{32};
+};
+
+struct FrameLoadSample
+{
+    double m_cpu_frame_ms{};
+    /**
+     * @brief GPU耗时，没有GPU计时时为0
+     */
+    double m_gpu_frame_ms{};
+};
+
+struct ResolutionDecision
+{
+    std::uint64_t m_frame_index{};
+    float m_old_scale{};
+    float m_new_scale{};
+    double m_smoothed_load{};
+};
+
+struct ResolutionGovernorStatistics
+{
+    std::uint64_t m_frame_count{};
+    std::uint64_t m_downscale_count{};
+    std::uint64_t m_upscale_count{};
+    /**
+     * @brief 处于各个渲染比例的帧数，与ResolutionGovernorConfig::m_scales一一对应
+     */
+    std::vector<std::uint64_t> m_frames_at_scale{};
+};
+
+/**
+ * @brief 按帧耗时调整内部渲染比例的控制器：负载持续偏高时逐级降低，持续偏低时逐级恢复， \n
+ * 两个阈值之间的迟滞区间、连续帧数要求和恢复前的负载估计避免在临界负载下来回切换
+ */
+class CResolutionGovernor
+{
+private:
+    ResolutionGovernorConfig m_config{};
+    std::size_t m_scale_index{};
+    double m_smoothed_load{};
+    bool m_has_sample{};
+    std::uint32_t m_over_budget_frame_count{};
+    std::uint32_t m_under_budget_frame_count{};
+    ResolutionGovernorStatistics m_statistics{};
+    std::vector<ResolutionDecision> m_decisions{};
+    std::size_t m_next_decision{};
+
+    void ChangeScale(std::size_t new_scale_index);
+
+public:
+    explicit CResolutionGovernor(const ResolutionGovernorConfig& config = {});
+    ~CResolutionGovernor() = default;
+
+    /**
+     * @brief 每帧结束时调用一次
+     *
+     * @return 下一帧使用的渲染比例
+     */
+    auto Update(const FrameLoadSample& sample)
+        -> float;
+
+    auto GetScale() const noexcept
+        -> float;
+    auto GetSmoothedLoad() const noexcept
+        -> double;
+    auto GetStatistics() const noexcept
+        -> const ResolutionGovernorStatistics&;
+    /**
+     * @brief 按时间顺序返回最近的决策
+     */
+    auto GetRecentDecisions() const
+        -> std::vector<ResolutionDecision>;
+};
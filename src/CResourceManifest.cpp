@@ -0,0 +1,93 @@
+#include "CResourceManifest.h"
+
+void ManifestEntry::CopyInitialData(const GpuSubresourceData* p_initial_data, std::uint32_t subresource_count, std::uint32_t height, std::uint32_t mip_levels)
+{
+    if (p_initial_data == nullptr)
+    {
+        return;
+    }
+    for (std::uint32_t i = 0; i < subresource_count; ++i)
+    {
+        const auto& subresource = p_initial_data[i];
+        const auto mip_level = mip_levels == 0 ? 0 : i % mip_levels;
+        const auto size = mip_levels == 0
+                              ? static_cast<std::size_t>(height)
+                              : static_cast<std::size_t>(subresource.m_row_pitch) * (std::max)(1u, height >> mip_level);
+        m_subresources.push_back({m_data.size(), subresource.m_row_pitch});
+        const auto* p_begin = static_cast<const std::uint8_t*>(subresource.m_p_data);
+        m_data.insert(m_data.end(), p_begin, p_begin + size);
+    }
+}
+
+auto ManifestEntry::GetInitialData() const
+    -> std::vector<GpuSubresourceData>
+{
+    std::vector<GpuSubresourceData> result{};
+    for (const auto& subresource : m_subresources)
+    {
+        result.push_back({m_data.data() + subresource.m_offset, subresource.m_row_pitch});
+    }
+    return result;
+}
+
+auto ManifestEntry::GetInputElements() const
+    -> std::vector<GpuInputElementDescription>
+{
+    auto result = m_input_elements;
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        result[i].m_p_semantic_name = m_semantic_names[i].c_str();
+    }
+    return result;
+}
+
+bool ManifestEntry::IsView() const noexcept
+{
+    return m_kind == ManifestResourceKind::ShaderResourceView || m_kind == ManifestResourceKind::RenderTargetView;
+}
+
+void ManifestEntry::RecordToTrace(CFrameTraceWriter& writer, const void* p_object, const void* p_parent) const
+{
+    switch (m_kind)
+    {
+    case ManifestResourceKind::Buffer:
+        writer.CreateBuffer(p_object, std::get<GpuBufferDescription>(m_description), m_data.empty() ? nullptr : m_data.data());
+        break;
+    case ManifestResourceKind::Texture2D:
+    {
+        const auto initial_data = GetInitialData();
+        writer.CreateTexture2D(p_object, std::get<GpuTexture2DDescription>(m_description), initial_data.empty() ? nullptr : initial_data.data());
+        break;
+    }
+    case ManifestResourceKind::VertexShader:
+        writer.CreateShader(p_object, MockObjectType::VertexShader, m_data.data(), m_data.size());
+        break;
+    case ManifestResourceKind::PixelShader:
+        writer.CreateShader(p_object, MockObjectType::PixelShader, m_data.data(), m_data.size());
+        break;
+    case ManifestResourceKind::InputLayout:
+    {
+        const auto elements = GetInputElements();
+        writer.CreateInputLayout(p_object, elements.data(), static_cast<std::uint32_t>(elements.size()), m_data.data(), m_data.size());
+        break;
+    }
+    case ManifestResourceKind::SamplerState:
+        writer.CreateSamplerState(p_object, std::get<GpuSamplerDescription>(m_description));
+        break;
+    case ManifestResourceKind::RasterizerState:
+        writer.CreateRasterizerState(p_object, std::get<GpuRasterizerDescription>(m_description));
+        break;
+    case ManifestResourceKind::BlendState:
+        writer.CreateBlendState(p_object, std::get<GpuBlendDescription>(m_description));
+        break;
+    case ManifestResourceKind::DepthStencilState:
+        writer.CreateDepthStencilState(p_object, std::get<GpuDepthStencilDescription>(m_description));
+        break;
+    case ManifestResourceKind::ShaderResourceView:
+        writer.CreateView(p_object, MockObjectType::ShaderResourceView, p_parent);
+        break;
+    case ManifestResourceKind::RenderTargetView:
+        writer.CreateView(p_object, MockObjectType::RenderTargetView, p_parent);
+        break;
+    }
+}
@@ -0,0 +1,418 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+#include "CGpuMemoryBudget.h"
+#include "FrameTrace.h"
+#include "GpuResourceDescription.h"
+#include "PerfLint.h"
+
+enum class ManifestResourceKind : std::uint8_t
+{
+    Buffer,
+    Texture2D,
+    VertexShader,
+    PixelShader,
+    InputLayout,
+    SamplerState,
+    RasterizerState,
+    BlendState,
+    DepthStencilState,
+    ShaderResourceView,
+    RenderTargetView
+};
+
+struct ManifestRecoveryStatistics
+{
+    std::uint32_t m_resource_count{};
+    std::uint32_t m_worker_count{};
+    double m_independent_phase_ms{};
+    double m_dependent_phase_ms{};
+    double m_total_ms{};
+};
+
+struct ManifestSubresource
+{
+    std::size_t m_offset{};
+    std::uint32_t m_row_pitch{};
+};
+
+/**
+ * @brief 清单中的一个资源：与平台无关的描述、初始数据和着色器字节码，后端据此在设备上创建对象
+ */
+struct ManifestEntry
+{
+    ManifestResourceKind m_kind{};
+    std::uint32_t m_handle_value{};
+    std::variant<
+        std::monostate,
+        GpuBufferDescription,
+        GpuTexture2DDescription,
+        GpuSamplerDescription,
+        GpuRasterizerDescription,
+        GpuBlendDescription,
+        GpuDepthStencilDescription>
+        m_description{};
+    /**
+     * @brief 资源的初始数据，或着色器/输入布局使用的字节码
+     */
+    std::vector<std::uint8_t> m_data{};
+    std::vector<ManifestSubresource> m_subresources{};
+    /**
+     * @brief 语义名保存在m_semantic_names中，条目移动后指针会失效，使用时经GetInputElements取得
+     */
+    std::vector<GpuInputElementDescription> m_input_elements{};
+    std::vector<std::string> m_semantic_names{};
+    /**
+     * @brief 视图所属纹理的句柄
+     */
+    std::uint32_t m_parent_handle_value{};
+    /**
+     * @brief 缓冲和纹理在显存预算中的记账，随条目一起销毁时释放
+     */
+    CGpuMemoryReservation m_reservation{};
+
+    /**
+     * @brief 复制初始数据；缓冲区只有一个子资源，mip_levels为0，以height传入字节数
+     */
+    void CopyInitialData(const GpuSubresourceData* p_initial_data, std::uint32_t subresource_count, std::uint32_t height, std::uint32_t mip_levels);
+    auto GetInitialData() const
+        -> std::vector<GpuSubresourceData>;
+    auto GetInputElements() const
+        -> std::vector<GpuInputElementDescription>;
+    bool IsView() const noexcept;
+    /**
+     * @brief 按条目的描述写入创建命令，视图按纹理的默认视图记录
+     */
+    void RecordToTrace(CFrameTraceWriter& writer, const void* p_object, const void* p_parent) const;
+};
+
+/**
+ * @brief 资源清单：通过它创建的每个资源都会记录与平台无关的描述、初始数据和着色器字节码， \n
+ * 设备丢失后可以在新设备上一次性并行重建全部资源，并保持后端登记表中的句柄不变 \n
+ * Backend在具体的设备上创建和登记对象，需要提供： \n
+ * 句柄类型Buffer、Texture、ShaderResourceView、RenderTargetView、VertexShader、PixelShader、InputLayout、SamplerState、RasterizerState、BlendState、DepthStencilState； \n
+ * 上下文使用的Viewport、PrimitiveTopology和Format类型；持有新对象的Object类型； \n
+ * Create(entry)创建对象，Register(entry, object)登记并返回句柄值，Replace(entry, object)替换句柄指向的对象， \n
+ * GetTraceObject(kind, handle_value)返回帧跟踪中代表对象的指针，Get(handle)以句柄查找对象
+ */
+template <class Backend>
+class CResourceManifest
+{
+public:
+    using Buffer = typename Backend::Buffer;
+    using Texture = typename Backend::Texture;
+    using ShaderResourceView = typename Backend::ShaderResourceView;
+    using RenderTargetView = typename Backend::RenderTargetView;
+    using VertexShader = typename Backend::VertexShader;
+    using PixelShader = typename Backend::PixelShader;
+    using InputLayout = typename Backend::InputLayout;
+    using SamplerState = typename Backend::SamplerState;
+    using RasterizerState = typename Backend::RasterizerState;
+    using BlendState = typename Backend::BlendState;
+    using DepthStencilState = typename Backend::DepthStencilState;
+    using Viewport = typename Backend::Viewport;
+    using PrimitiveTopology = typename Backend::PrimitiveTopology;
+    using Format = typename Backend::Format;
+
+private:
+    Backend m_backend;
+    std::vector<ManifestEntry> m_entries{};
+    CGpuMemoryBudget* m_p_memory_budget{};
+    CPerfLinter* m_p_perf_linter{};
+
+    template <class Handle>
+    auto RecordAndRegister(ManifestEntry&& entry)
+        -> Handle
+    {
+        auto object = m_backend.Create(entry);
+        entry.m_handle_value = m_backend.Register(entry, object);
+        m_entries.push_back(std::move(entry));
+        return Handle{m_entries.back().m_handle_value};
+    }
+    /**
+     * @brief 预留显存后创建资源，预留保存在条目中；创建失败时条目不加入清单，预留随之释放
+     */
+    template <class Handle>
+    auto ReserveAndRegister(ManifestEntry&& entry, GpuMemoryCategory category, std::uint64_t bytes)
+        -> Handle
+    {
+        // 没有设置预算时预留不记账
+        entry.m_reservation = CGpuMemoryReservation{m_p_memory_budget, category, bytes};
+        return RecordAndRegister<Handle>(std::move(entry));
+    }
+    static auto MakeShaderEntry(ManifestResourceKind kind, const void* p_byte_code, std::size_t byte_code_size)
+        -> ManifestEntry
+    {
+        ManifestEntry entry{};
+        entry.m_kind = kind;
+        const auto* p_begin = static_cast<const std::uint8_t*>(p_byte_code);
+        entry.m_data.assign(p_begin, p_begin + byte_code_size);
+        return entry;
+    }
+
+public:
+    template <class... Args>
+    explicit CResourceManifest(Args&&... args)
+        : m_backend{std::forward<Args>(args)...}
+    {
+    }
+    ~CResourceManifest() = default;
+    CResourceManifest(const CResourceManifest&) = delete;
+    CResourceManifest& operator=(const CResourceManifest&) = delete;
+
+    /**
+     * @brief 之后创建的缓冲和纹理都在p_budget中记账，超过硬上限时抛出std::runtime_error；为空时不记账 \n
+     * 清单中的资源在设备丢失后按原样重建，记账不变；清单销毁时释放全部记账，所以p_budget必须比清单存活得更久
+     */
+    void SetMemoryBudget(CGpuMemoryBudget* p_budget) noexcept
+    {
+        m_p_memory_budget = p_budget;
+    }
+    /**
+     * @brief 之后创建缓冲、纹理、采样器和混合状态时用p_linter检查描述，警告记录调用者的位置；为空时不检查
+     */
+    void SetPerfLinter(CPerfLinter* p_linter) noexcept
+    {
+        m_p_perf_linter = p_linter;
+    }
+
+    auto CreateBuffer(const GpuBufferDescription& description, const GpuSubresourceData* p_initial_data, const std::source_location& location = std::source_location::current())
+        -> Buffer
+    {
+        if (m_p_perf_linter != nullptr)
+        {
+            m_p_perf_linter->Check(LintBufferDescription{description.m_byte_width, description.m_usage, description.m_bind_flags, description.m_cpu_access_flags, p_initial_data != nullptr}, location);
+        }
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::Buffer;
+        entry.m_description = description;
+        entry.CopyInitialData(p_initial_data, 1, description.m_byte_width, 0);
+        return ReserveAndRegister<Buffer>(std::move(entry), GpuMemoryCategory::Buffer, description.m_byte_width);
+    }
+    /**
+     * @brief p_initial_data为nullptr或按mip + array_slice * mip_levels排列的每个子资源的数据
+     */
+    auto CreateTexture2D(const GpuTexture2DDescription& description,
+                         const GpuSubresourceData* p_initial_data,
+                         GpuMemoryCategory category = GpuMemoryCategory::Intermediate,
+                         const std::source_location& location = std::source_location::current())
+        -> Texture
+    {
+        if (m_p_perf_linter != nullptr)
+        {
+            m_p_perf_linter->Check(LintTextureDescription{description.m_width,
+                                                          description.m_height,
+                                                          description.m_mip_levels,
+                                                          description.m_array_size,
+                                                          description.m_format,
+                                                          description.m_usage,
+                                                          description.m_bind_flags,
+                                                          description.m_cpu_access_flags,
+                                                          p_initial_data != nullptr},
+                                   location);
+        }
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::Texture2D;
+        entry.m_description = description;
+        const auto mip_levels = (std::max)(1u, description.m_mip_levels);
+        entry.CopyInitialData(p_initial_data, mip_levels * description.m_array_size, description.m_height, mip_levels);
+        const auto bytes = EstimateTexture2DBytes(description.m_width, description.m_height, description.m_format, description.m_mip_levels, description.m_array_size);
+        return ReserveAndRegister<Texture>(std::move(entry), category, bytes);
+    }
+    auto CreateVertexShader(const void* p_byte_code, std::size_t byte_code_size)
+        -> VertexShader
+    {
+        return RecordAndRegister<VertexShader>(MakeShaderEntry(ManifestResourceKind::VertexShader, p_byte_code, byte_code_size));
+    }
+    auto CreatePixelShader(const void* p_byte_code, std::size_t byte_code_size)
+        -> PixelShader
+    {
+        return RecordAndRegister<PixelShader>(MakeShaderEntry(ManifestResourceKind::PixelShader, p_byte_code, byte_code_size));
+    }
+    auto CreateInputLayout(const GpuInputElementDescription* p_elements, std::uint32_t element_count, const void* p_byte_code, std::size_t byte_code_size)
+        -> InputLayout
+    {
+        auto entry = MakeShaderEntry(ManifestResourceKind::InputLayout, p_byte_code, byte_code_size);
+        entry.m_input_elements.assign(p_elements, p_elements + element_count);
+        for (auto& element : entry.m_input_elements)
+        {
+            entry.m_semantic_names.emplace_back(element.m_p_semantic_name);
+            element.m_p_semantic_name = nullptr;
+        }
+        return RecordAndRegister<InputLayout>(std::move(entry));
+    }
+    /**
+     * @brief 创建采样器
+     *
+     * @param sampling_scale 采样时一个纹素对应的像素数，供性能检查使用，为0表示未知
+     */
+    auto CreateSamplerState(const GpuSamplerDescription& description, float sampling_scale = 0.0f, const std::source_location& location = std::source_location::current())
+        -> SamplerState
+    {
+        if (m_p_perf_linter != nullptr)
+        {
+            m_p_perf_linter->Check(LintSamplerDescription{description.m_filter, description.m_max_anisotropy, sampling_scale}, location);
+        }
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::SamplerState;
+        entry.m_description = description;
+        return RecordAndRegister<SamplerState>(std::move(entry));
+    }
+    auto CreateRasterizerState(const GpuRasterizerDescription& description)
+        -> RasterizerState
+    {
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::RasterizerState;
+        entry.m_description = description;
+        return RecordAndRegister<RasterizerState>(std::move(entry));
+    }
+    auto CreateBlendState(const GpuBlendDescription& description, const std::source_location& location = std::source_location::current())
+        -> BlendState
+    {
+        if (m_p_perf_linter != nullptr)
+        {
+            m_p_perf_linter->Check(LintBlendDescription{description.m_is_blend_enabled,
+                                                        description.m_source_blend,
+                                                        description.m_destination_blend,
+                                                        description.m_blend_operation,
+                                                        description.m_source_alpha_blend,
+                                                        description.m_destination_alpha_blend,
+                                                        description.m_alpha_blend_operation},
+                                   location);
+        }
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::BlendState;
+        entry.m_description = description;
+        return RecordAndRegister<BlendState>(std::move(entry));
+    }
+    auto CreateDepthStencilState(const GpuDepthStencilDescription& description)
+        -> DepthStencilState
+    {
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::DepthStencilState;
+        entry.m_description = description;
+        return RecordAndRegister<DepthStencilState>(std::move(entry));
+    }
+    /**
+     * @brief 创建纹理的默认着色器资源视图
+     */
+    auto CreateShaderResourceView(Texture texture)
+        -> ShaderResourceView
+    {
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::ShaderResourceView;
+        entry.m_parent_handle_value = texture.m_value;
+        return RecordAndRegister<ShaderResourceView>(std::move(entry));
+    }
+    /**
+     * @brief 创建纹理的默认渲染目标视图
+     */
+    auto CreateRenderTargetView(Texture texture)
+        -> RenderTargetView
+    {
+        ManifestEntry entry{};
+        entry.m_kind = ManifestResourceKind::RenderTargetView;
+        entry.m_parent_handle_value = texture.m_value;
+        return RecordAndRegister<RenderTargetView>(std::move(entry));
+    }
+
+    /**
+     * @brief 在新设备上重建清单中的全部资源：先并行创建互不依赖的资源，再创建视图
+     *
+     * @param args 转交给Backend::Reset，指定新设备
+     * @return ManifestRecoveryStatistics 各阶段耗时
+     */
+    template <class... Args>
+    auto Recreate(Args&&... args)
+        -> ManifestRecoveryStatistics
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto begin = Clock::now();
+
+        m_backend.Reset(std::forward<Args>(args)...);
+
+        std::vector<std::size_t> independent_entries{};
+        std::vector<std::size_t> dependent_entries{};
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            (m_entries[i].IsView() ? dependent_entries : independent_entries).push_back(i);
+        }
+
+        ManifestRecoveryStatistics result{};
+        result.m_resource_count = static_cast<std::uint32_t>(m_entries.size());
+        result.m_worker_count = (std::max)(1u, (std::min)({std::thread::hardware_concurrency(), static_cast<unsigned>(independent_entries.size()), Backend::MAX_RECOVERY_WORKER_COUNT}));
+
+        // 后端的Create可以在至多MAX_RECOVERY_WORKER_COUNT个线程中同时调用，这里按序号交错分给各个线程；登记表不是线程安全的，替换在主线程完成
+        std::vector<typename Backend::Object> created_objects(m_entries.size());
+        auto create_in_parallel = [this, &created_objects, worker_count = result.m_worker_count](const std::vector<std::size_t>& entry_indexes)
+        {
+            std::vector<std::future<void>> workers{};
+            for (unsigned worker = 0; worker < worker_count; ++worker)
+            {
+                workers.push_back(std::async(std::launch::async, [this, &created_objects, &entry_indexes, worker, worker_count]()
+                                             {
+                                                 for (std::size_t i = worker; i < entry_indexes.size(); i += worker_count)
+                                                 {
+                                                     const auto entry_index = entry_indexes[i];
+                                                     created_objects[entry_index] = m_backend.Create(m_entries[entry_index]);
+                                                 } }));
+            }
+            for (auto& worker : workers)
+            {
+                worker.get();
+            }
+            for (auto entry_index : entry_indexes)
+            {
+                m_backend.Replace(m_entries[entry_index], created_objects[entry_index]);
+            }
+        };
+
+        create_in_parallel(independent_entries);
+        const auto independent_end = Clock::now();
+        create_in_parallel(dependent_entries);
+        const auto end = Clock::now();
+
+        result.m_independent_phase_ms = std::chrono::duration<double, std::milli>(independent_end - begin).count();
+        result.m_dependent_phase_ms = std::chrono::duration<double, std::milli>(end - independent_end).count();
+        result.m_total_ms = std::chrono::duration<double, std::milli>(end - begin).count();
+        return result;
+    }
+
+    /**
+     * @brief 按创建顺序把清单中的全部资源写入帧跟踪
+     */
+    void RecordToTrace(CFrameTraceWriter& writer) const
+    {
+        for (const auto& entry : m_entries)
+        {
+            const auto* p_parent = entry.IsView() ? m_backend.GetTraceObject(ManifestResourceKind::Texture2D, entry.m_parent_handle_value) : nullptr;
+            entry.RecordToTrace(writer, m_backend.GetTraceObject(entry.m_kind, entry.m_handle_value), p_parent);
+        }
+    }
+
+    /**
+     * @brief 以句柄查找对象，句柄失效时返回nullptr
+     */
+    template <class Handle>
+    auto Get(Handle handle) const noexcept
+    {
+        return m_backend.Get(handle);
+    }
+    auto GetBackend() noexcept
+        -> Backend&
+    {
+        return m_backend;
+    }
+    auto GetResourceCount() const noexcept
+        -> std::size_t
+    {
+        return m_entries.size();
+    }
+};
@@ -18,7 +18,7 @@ const char* CDXShaderException::what() const noexcept
 }
 
 auto CShader::Compile() const
-    -> Microsoft::WRL::ComPtr<ID3DBlob>
+    -> ID3DBlob*
 {
     if (m_is_macro_changed && !m_macros.empty())
     {
@@ -53,7 +53,7 @@ auto CShader::Compile() const
         m_is_config_changed = false;
     }
 
-    return m_p_cached_byte_code;
+    return m_p_cached_byte_code.Get();
 }
 
 auto CShader::GetCode() const noexcept
@@ -82,6 +82,11 @@ public:
     auto SetInclude(ID3DInclude* p_indclude) noexcept
         -> CShader&;
 
+    /**
+     * @brief 编译着色器，配置未改变时直接返回缓存的字节码
+     *
+     * @return ID3DBlob* 由本对象持有的字节码，不增加引用计数；再次修改配置并编译后失效
+     */
     auto Compile() const
-        -> Microsoft::WRL::ComPtr<ID3DBlob>;
+        -> ID3DBlob*;
 };
\ No newline at end of file
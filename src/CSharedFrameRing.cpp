@@ -0,0 +1,257 @@
+#include "CSharedFrameRing.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::size_t SHARED_FRAME_ALIGNMENT = 64;
+
+    constexpr auto AlignUp(std::size_t value, std::size_t alignment) noexcept
+        -> std::size_t
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    constexpr auto GetHeaderSize() noexcept
+        -> std::size_t
+    {
+        return AlignUp(sizeof(SharedFrameRingHeader), SHARED_FRAME_ALIGNMENT);
+    }
+
+    constexpr auto GetSlotHeaderSize() noexcept
+        -> std::size_t
+    {
+        return AlignUp(sizeof(SharedFrameSlotHeader), SHARED_FRAME_ALIGNMENT);
+    }
+
+    auto ClampRect(const SurfaceRect& rect, std::uint32_t width, std::uint32_t height) noexcept
+        -> SurfaceRect
+    {
+        const auto x = (std::min)(rect.m_x, width);
+        const auto y = (std::min)(rect.m_y, height);
+        return {x, y, (std::min)(rect.m_width, width - x), (std::min)(rect.m_height, height - y)};
+    }
+
+    auto GetBoundingRect(const std::vector<SurfaceRect>& rects) noexcept
+        -> SurfaceRect
+    {
+        auto left = rects.front().m_x;
+        auto top = rects.front().m_y;
+        auto right = left + rects.front().m_width;
+        auto bottom = top + rects.front().m_height;
+        for (const auto& rect : rects)
+        {
+            left = (std::min)(left, rect.m_x);
+            top = (std::min)(top, rect.m_y);
+            right = (std::max)(right, rect.m_x + rect.m_width);
+            bottom = (std::max)(bottom, rect.m_y + rect.m_height);
+        }
+        return {left, top, right - left, bottom - top};
+    }
+}
+
+CSharedFrameWriter::CSharedFrameWriter(const std::string& name, std::uint32_t width, std::uint32_t height, std::uint32_t slot_count)
+{
+    if (width == 0 || height == 0 || slot_count == 0)
+    {
+        throw std::invalid_argument{"Size and slot count of shared frame ring must not be zero."};
+    }
+    const auto row_pitch = AlignUp(static_cast<std::size_t>(width) * 4, SHARED_FRAME_ALIGNMENT);
+    const auto slot_size = GetSlotHeaderSize() + row_pitch * height;
+    m_region = CSharedMemoryRegion::Create(name, GetHeaderSize() + slot_size * slot_count);
+
+    // 共享内存已经清零，原子变量的初始值与默认构造一致
+    m_p_header = new (m_region.GetData()) SharedFrameRingHeader{};
+    m_p_header->m_magic = SharedFrameRingHeader::MAGIC;
+    m_p_header->m_version = SharedFrameRingHeader::VERSION;
+    m_p_header->m_slot_count = slot_count;
+    m_p_header->m_width = width;
+    m_p_header->m_height = height;
+    m_p_header->m_row_pitch = static_cast<std::uint32_t>(row_pitch);
+    m_p_header->m_slot_size = slot_size;
+    for (std::uint32_t slot = 0; slot < slot_count; ++slot)
+    {
+        new (m_region.GetData() + GetHeaderSize() + slot_size * slot) SharedFrameSlotHeader{};
+    }
+    m_slot_sequences.resize(slot_count);
+    m_recent_dirty_rects.resize(slot_count);
+}
+
+auto CSharedFrameWriter::GetSlotHeader(std::uint32_t slot) const noexcept
+    -> SharedFrameSlotHeader*
+{
+    return reinterpret_cast<SharedFrameSlotHeader*>(m_region.GetData() + GetHeaderSize() + m_p_header->m_slot_size * slot);
+}
+
+auto CSharedFrameWriter::GetSlotPixels(std::uint32_t slot) const noexcept
+    -> std::uint8_t*
+{
+    return reinterpret_cast<std::uint8_t*>(GetSlotHeader(slot)) + GetSlotHeaderSize();
+}
+
+auto CSharedFrameWriter::Publish(const std::uint8_t* p_source, std::uint32_t source_row_pitch, const std::vector<SurfaceRect>& dirty_rects)
+    -> std::uint64_t
+{
+    const auto width = m_p_header->m_width;
+    const auto height = m_p_header->m_height;
+    const auto slot_count = m_p_header->m_slot_count;
+    const auto sequence = ++m_sequence;
+    const auto slot = static_cast<std::uint32_t>(sequence % slot_count);
+
+    auto& current_rects = m_recent_dirty_rects[sequence % slot_count];
+    current_rects.clear();
+    if (dirty_rects.empty())
+    {
+        current_rects.push_back({0, 0, width, height});
+    }
+    for (const auto& rect : dirty_rects)
+    {
+        const auto clamped_rect = ClampRect(rect, width, height);
+        if (clamped_rect.m_width != 0 && clamped_rect.m_height != 0)
+        {
+            current_rects.push_back(clamped_rect);
+        }
+    }
+
+    auto& slot_header = *GetSlotHeader(slot);
+    auto* const p_pixels = GetSlotPixels(slot);
+    const auto row_pitch = m_p_header->m_row_pitch;
+    const auto copy_rect = [&](const SurfaceRect& rect)
+    {
+        const auto row_size = static_cast<std::size_t>(rect.m_width) * 4;
+        for (auto y = rect.m_y; y < rect.m_y + rect.m_height; ++y)
+        {
+            std::memcpy(p_pixels + static_cast<std::size_t>(y) * row_pitch + static_cast<std::size_t>(rect.m_x) * 4,
+                        p_source + static_cast<std::size_t>(y) * source_row_pitch + static_cast<std::size_t>(rect.m_x) * 4,
+                        row_size);
+        }
+        m_statistics.m_bytes_copied += row_size * rect.m_height;
+    };
+
+    // 顺序锁：先置为奇数，读者据此丢弃读取期间被改写的帧
+    const auto lock_version = slot_header.m_lock_version.load(std::memory_order_relaxed);
+    slot_header.m_lock_version.store(lock_version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // 槽中恰好是slot_count帧之前的内容时，只需补上之后每一帧的脏矩形
+    if (sequence > slot_count && m_slot_sequences[slot] == sequence - slot_count)
+    {
+        for (const auto& rects : m_recent_dirty_rects)
+        {
+            std::for_each(rects.begin(), rects.end(), copy_rect);
+        }
+    }
+    else
+    {
+        copy_rect({0, 0, width, height});
+        ++m_statistics.m_full_copy_count;
+    }
+    m_slot_sequences[slot] = sequence;
+
+    slot_header.m_sequence.store(sequence, std::memory_order_relaxed);
+    slot_header.m_timestamp_ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    if (current_rects.size() > SharedFrameSlotHeader::MAX_DIRTY_RECT_COUNT)
+    {
+        slot_header.m_dirty_rect_count = 1;
+        slot_header.m_dirty_rects[0] = GetBoundingRect(current_rects);
+    }
+    else
+    {
+        slot_header.m_dirty_rect_count = static_cast<std::uint32_t>(current_rects.size());
+        std::copy(current_rects.begin(), current_rects.end(), slot_header.m_dirty_rects.begin());
+    }
+
+    slot_header.m_lock_version.store(lock_version + 2, std::memory_order_release);
+    m_p_header->m_latest_sequence.store(sequence, std::memory_order_release);
+    ++m_statistics.m_frame_count;
+    return sequence;
+}
+
+auto CSharedFrameWriter::GetStatistics() const noexcept
+    -> const SharedFrameWriterStatistics&
+{
+    return m_statistics;
+}
+
+CSharedFrameReader::CSharedFrameReader(const std::string& name)
+    : m_region{CSharedMemoryRegion::Open(name)}
+{
+    if (m_region.GetSize() < GetHeaderSize())
+    {
+        throw std::runtime_error{"Shared frame ring is too small."};
+    }
+    m_p_header = reinterpret_cast<const SharedFrameRingHeader*>(m_region.GetData());
+    if (m_p_header->m_magic != SharedFrameRingHeader::MAGIC || m_p_header->m_version != SharedFrameRingHeader::VERSION)
+    {
+        throw std::runtime_error{"Shared memory does not contain a frame ring of a supported version."};
+    }
+    m_slot_count = m_p_header->m_slot_count;
+    m_slot_size = m_p_header->m_slot_size;
+    if (m_slot_count == 0)
+    {
+        throw std::runtime_error{"Shared frame ring has no slots."};
+    }
+    const auto pixel_size = static_cast<std::uint64_t>(m_p_header->m_row_pitch) * m_p_header->m_height;
+    if (m_p_header->m_row_pitch < static_cast<std::uint64_t>(m_p_header->m_width) * 4 || m_slot_size < GetSlotHeaderSize() + pixel_size)
+    {
+        throw std::runtime_error{"Shared frame ring slots are too small for the frame size in its header."};
+    }
+    // 先相除再比较，槽大小和数量再大也不会溢出
+    if ((m_region.GetSize() - GetHeaderSize()) / m_slot_size < m_slot_count)
+    {
+        throw std::runtime_error{"Shared frame ring is smaller than its header describes."};
+    }
+}
+
+auto CSharedFrameReader::TryAcquireLatest(std::uint64_t last_sequence) const noexcept
+    -> std::optional<SharedFrameView>
+{
+    const auto latest_sequence = m_p_header->m_latest_sequence.load(std::memory_order_acquire);
+    if (latest_sequence == 0 || latest_sequence <= last_sequence)
+    {
+        return std::nullopt;
+    }
+    const auto slot = static_cast<std::uint32_t>(latest_sequence % m_slot_count);
+    const auto* const p_slot = m_region.GetData() + GetHeaderSize() + m_slot_size * slot;
+    const auto& slot_header = *reinterpret_cast<const SharedFrameSlotHeader*>(p_slot);
+
+    const auto lock_version = slot_header.m_lock_version.load(std::memory_order_acquire);
+    // 写入者已经在改写该槽（说明又发布了slot_count帧以上），下次再取
+    if ((lock_version & 1) != 0 || slot_header.m_sequence.load(std::memory_order_relaxed) != latest_sequence)
+    {
+        return std::nullopt;
+    }
+    SharedFrameView view{};
+    view.m_p_data = p_slot + GetSlotHeaderSize();
+    view.m_row_pitch = m_p_header->m_row_pitch;
+    view.m_width = m_p_header->m_width;
+    view.m_height = m_p_header->m_height;
+    view.m_sequence = latest_sequence;
+    view.m_p_dirty_rects = slot_header.m_dirty_rects.data();
+    view.m_dirty_rect_count = (std::min)(slot_header.m_dirty_rect_count, SharedFrameSlotHeader::MAX_DIRTY_RECT_COUNT);
+    view.m_slot = slot;
+    view.m_lock_version = lock_version;
+    return view;
+}
+
+bool CSharedFrameReader::Validate(const SharedFrameView& view) const noexcept
+{
+    const auto* const p_slot = m_region.GetData() + GetHeaderSize() + m_slot_size * view.m_slot;
+    const auto& slot_header = *reinterpret_cast<const SharedFrameSlotHeader*>(p_slot);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot_header.m_lock_version.load(std::memory_order_relaxed) == view.m_lock_version;
+}
+
+std::uint32_t CSharedFrameReader::GetWidth() const noexcept
+{
+    return m_p_header->m_width;
+}
+
+std::uint32_t CSharedFrameReader::GetHeight() const noexcept
+{
+    return m_p_header->m_height;
+}
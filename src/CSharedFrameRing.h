@@ -0,0 +1,170 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "CMappedSurface.h"
+#include "CSharedMemoryRegion.h"
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared frame ring requires lock-free 64-bit atomics.");
+
+/**
+ * @brief 共享内存开头的环描述，由写入者初始化后只读，只有m_latest_sequence会变化
+ */
+struct SharedFrameRingHeader
+{
+    constexpr static std::uint32_t MAGIC = 0x46524D53;
+    constexpr static std::uint32_t VERSION = 1;
+
+    std::uint32_t m_magic{};
+    std::uint32_t m_version{};
+    std::uint32_t m_slot_count{};
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_row_pitch{};
+    std::uint64_t m_slot_size{};
+    /**
+     * @brief 最新的完整帧的序号，从1开始，0表示还没有帧
+     */
+    alignas(64) std::atomic<std::uint64_t> m_latest_sequence{};
+};
+
+/**
+ * @brief 每个槽开头的帧描述，像素紧随其后；m_lock_version是顺序锁，奇数表示写入者正在改写该槽
+ */
+struct SharedFrameSlotHeader
+{
+    constexpr static std::uint32_t MAX_DIRTY_RECT_COUNT = 16;
+
+    std::atomic<std::uint64_t> m_lock_version{};
+    std::atomic<std::uint64_t> m_sequence{};
+    std::uint64_t m_timestamp_ns{};
+    /**
+     * @brief 相对上一帧的变化区域，超过MAX_DIRTY_RECT_COUNT时合并为包围盒
+     */
+    std::uint32_t m_dirty_rect_count{};
+    std::array<SurfaceRect, MAX_DIRTY_RECT_COUNT> m_dirty_rects{};
+};
+
+struct SharedFrameWriterStatistics
+{
+    std::uint64_t m_frame_count{};
+    std::uint64_t m_bytes_copied{};
+    /**
+     * @brief 槽中是更早的帧、只能整帧复制的次数
+     */
+    std::uint64_t m_full_copy_count{};
+};
+
+/**
+ * @brief 把合成好的帧写入共享内存中的固定槽位环，读者在其它进程中直接映射读取 \n
+ * 每个槽保存的是slot_count帧之前的内容，写入时只需复制这期间所有帧的脏矩形
+ */
+class CSharedFrameWriter
+{
+private:
+    CSharedMemoryRegion m_region{};
+    SharedFrameRingHeader* m_p_header{};
+    std::uint64_t m_sequence{};
+    std::vector<std::uint64_t> m_slot_sequences{};
+    // 以帧序号对槽数取模为下标，保存最近slot_count帧的脏矩形
+    std::vector<std::vector<SurfaceRect>> m_recent_dirty_rects{};
+    SharedFrameWriterStatistics m_statistics{};
+
+    auto GetSlotHeader(std::uint32_t slot) const noexcept
+        -> SharedFrameSlotHeader*;
+    auto GetSlotPixels(std::uint32_t slot) const noexcept
+        -> std::uint8_t*;
+
+public:
+    /**
+     * @brief 创建名为name的共享内存并初始化环
+     *
+     * @param slot_count 槽数；读者读得比写入者慢slot_count帧时读到的帧会被覆盖
+     */
+    CSharedFrameWriter(const std::string& name, std::uint32_t width, std::uint32_t height, std::uint32_t slot_count = 3);
+    ~CSharedFrameWriter() = default;
+    CSharedFrameWriter(const CSharedFrameWriter&) = delete;
+    CSharedFrameWriter& operator=(const CSharedFrameWriter&) = delete;
+
+    /**
+     * @brief 写入并发布一帧
+     *
+     * @param p_source BGRA8像素，行距为source_row_pitch
+     * @param dirty_rects 相对上一次发布的变化区域，为空表示整帧都变了
+     * @return 该帧的序号
+     */
+    auto Publish(const std::uint8_t* p_source, std::uint32_t source_row_pitch, const std::vector<SurfaceRect>& dirty_rects)
+        -> std::uint64_t;
+
+    auto GetStatistics() const noexcept
+        -> const SharedFrameWriterStatistics&;
+};
+
+/**
+ * @brief 指向共享内存中一帧的只读视图，读完后必须用CSharedFrameReader::Validate确认没有被覆盖
+ */
+struct SharedFrameView
+{
+    const std::uint8_t* m_p_data{};
+    std::uint32_t m_row_pitch{};
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint64_t m_sequence{};
+    /**
+     * @brief 相对序号为m_sequence-1的帧的变化区域；读者跳过了帧时应当整帧读取
+     */
+    const SurfaceRect* m_p_dirty_rects{};
+    std::uint32_t m_dirty_rect_count{};
+    std::uint32_t m_slot{};
+    std::uint64_t m_lock_version{};
+
+    auto GetRow(std::uint32_t y) const noexcept
+        -> const std::uint8_t*
+    {
+        return m_p_data + static_cast<std::size_t>(y) * m_row_pitch;
+    }
+};
+
+/**
+ * @brief 映射写入者创建的共享内存，不加锁地读取最新的帧
+ */
+class CSharedFrameReader
+{
+private:
+    CSharedMemoryRegion m_region{};
+    const SharedFrameRingHeader* m_p_header{};
+    /**
+     * @brief 构造时检查过的槽数量和槽大小，之后不再从另一个进程可写的头部读取
+     */
+    std::uint32_t m_slot_count{};
+    std::uint64_t m_slot_size{};
+
+public:
+    /**
+     * @brief 打开共享内存并检查环描述，格式不符时抛出std::runtime_error
+     */
+    explicit CSharedFrameReader(const std::string& name);
+    ~CSharedFrameReader() = default;
+    CSharedFrameReader(const CSharedFrameReader&) = delete;
+    CSharedFrameReader& operator=(const CSharedFrameReader&) = delete;
+
+    /**
+     * @brief 取得最新的帧
+     *
+     * @param last_sequence 读者上一次读到的帧序号
+     * @return 没有更新的帧，或写入者正在改写该槽时返回std::nullopt
+     */
+    auto TryAcquireLatest(std::uint64_t last_sequence) const noexcept
+        -> std::optional<SharedFrameView>;
+    /**
+     * @brief 读取视图之后调用，返回false表示读取期间该槽被改写，读到的内容应当丢弃
+     */
+    bool Validate(const SharedFrameView& view) const noexcept;
+
+    std::uint32_t GetWidth() const noexcept;
+    std::uint32_t GetHeight() const noexcept;
+};
@@ -0,0 +1,192 @@
+#include "CSharedMemoryRegion.h"
+#include <stdexcept>
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifndef _WIN32
+    // POSIX要求shm名称以'/'开头且不再包含'/'
+    auto ToPosixName(const std::string& name)
+        -> std::string
+    {
+        return name.empty() || name.front() != '/' ? "/" + name : name;
+    }
+#endif
+}
+
+auto CSharedMemoryRegion::Create(const std::string& name, std::size_t size)
+    -> CSharedMemoryRegion
+{
+    if (size == 0)
+    {
+        throw std::invalid_argument{"Size of shared memory must not be zero."};
+    }
+    CSharedMemoryRegion region{};
+    region.m_name = name;
+    region.m_size = size;
+    region.m_is_owner = true;
+#ifdef _WIN32
+    const auto large_size = static_cast<std::uint64_t>(size);
+    region.m_mapping_handle = ::CreateFileMappingA(
+        INVALID_HANDLE_VALUE,
+        NULL,
+        PAGE_READWRITE,
+        static_cast<DWORD>(large_size >> 32),
+        static_cast<DWORD>(large_size),
+        name.c_str());
+    if (region.m_mapping_handle == NULL || ::GetLastError() == ERROR_ALREADY_EXISTS)
+    {
+        throw std::runtime_error{"CreateFileMapping failed."};
+    }
+    region.m_p_data = static_cast<std::uint8_t*>(::MapViewOfFile(region.m_mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (region.m_p_data == nullptr)
+    {
+        throw std::runtime_error{"MapViewOfFile failed."};
+    }
+#else
+    const auto posix_name = ToPosixName(name);
+    const int file_descriptor = ::shm_open(posix_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (file_descriptor < 0)
+    {
+        region.m_is_owner = false;
+        throw std::runtime_error{"shm_open failed."};
+    }
+    if (::ftruncate(file_descriptor, static_cast<off_t>(size)) != 0)
+    {
+        ::close(file_descriptor);
+        throw std::runtime_error{"ftruncate of shared memory failed."};
+    }
+    void* p_data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    ::close(file_descriptor);
+    if (p_data == MAP_FAILED)
+    {
+        throw std::runtime_error{"mmap of shared memory failed."};
+    }
+    region.m_p_data = static_cast<std::uint8_t*>(p_data);
+#endif
+    return region;
+}
+
+auto CSharedMemoryRegion::Open(const std::string& name)
+    -> CSharedMemoryRegion
+{
+    CSharedMemoryRegion region{};
+    region.m_name = name;
+#ifdef _WIN32
+    region.m_mapping_handle = ::OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+    if (region.m_mapping_handle == NULL)
+    {
+        throw std::runtime_error{"OpenFileMapping failed."};
+    }
+    region.m_p_data = static_cast<std::uint8_t*>(::MapViewOfFile(region.m_mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (region.m_p_data == nullptr)
+    {
+        throw std::runtime_error{"MapViewOfFile failed."};
+    }
+    MEMORY_BASIC_INFORMATION memory_information{};
+    ::VirtualQuery(region.m_p_data, &memory_information, sizeof(memory_information));
+    region.m_size = memory_information.RegionSize;
+#else
+    const int file_descriptor = ::shm_open(ToPosixName(name).c_str(), O_RDWR, 0);
+    if (file_descriptor < 0)
+    {
+        throw std::runtime_error{"shm_open failed."};
+    }
+    struct stat file_status{};
+    if (::fstat(file_descriptor, &file_status) != 0 || file_status.st_size <= 0)
+    {
+        ::close(file_descriptor);
+        throw std::runtime_error{"fstat of shared memory failed."};
+    }
+    region.m_size = static_cast<std::size_t>(file_status.st_size);
+    void* p_data = ::mmap(nullptr, region.m_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    ::close(file_descriptor);
+    if (p_data == MAP_FAILED)
+    {
+        throw std::runtime_error{"mmap of shared memory failed."};
+    }
+    region.m_p_data = static_cast<std::uint8_t*>(p_data);
+#endif
+    return region;
+}
+
+CSharedMemoryRegion::~CSharedMemoryRegion()
+{
+    Close();
+}
+
+CSharedMemoryRegion::CSharedMemoryRegion(CSharedMemoryRegion&& other) noexcept
+    : m_name{std::move(other.m_name)},
+      m_p_data{std::exchange(other.m_p_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)},
+      m_is_owner{std::exchange(other.m_is_owner, false)}
+#ifdef _WIN32
+      ,
+      m_mapping_handle{std::exchange(other.m_mapping_handle, nullptr)}
+#endif
+{
+}
+
+CSharedMemoryRegion& CSharedMemoryRegion::operator=(CSharedMemoryRegion&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_name = std::move(other.m_name);
+        m_p_data = std::exchange(other.m_p_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_is_owner = std::exchange(other.m_is_owner, false);
+#ifdef _WIN32
+        m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void CSharedMemoryRegion::Close() noexcept
+{
+#ifdef _WIN32
+    // 文件映射在最后一个句柄关闭后自动删除
+    if (m_p_data != nullptr)
+    {
+        ::UnmapViewOfFile(m_p_data);
+    }
+    if (m_mapping_handle != nullptr)
+    {
+        ::CloseHandle(m_mapping_handle);
+    }
+    m_mapping_handle = nullptr;
+#else
+    if (m_p_data != nullptr)
+    {
+        ::munmap(m_p_data, m_size);
+    }
+    if (m_is_owner)
+    {
+        ::shm_unlink(ToPosixName(m_name).c_str());
+    }
+#endif
+    m_p_data = nullptr;
+    m_size = 0;
+    m_is_owner = false;
+}
+
+auto CSharedMemoryRegion::GetData() const noexcept
+    -> std::uint8_t*
+{
+    return m_p_data;
+}
+
+auto CSharedMemoryRegion::GetSize() const noexcept
+    -> std::size_t
+{
+    return m_size;
+}
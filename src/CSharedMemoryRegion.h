@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 具名共享内存：Windows上是页面文件支持的文件映射，其它平台是POSIX shm对象 \n
+ * 创建者负责删除名称，打开者只映射；同一名称可以在多个进程中同时映射
+ */
+class CSharedMemoryRegion
+{
+private:
+    std::string m_name{};
+    std::uint8_t* m_p_data{};
+    std::size_t m_size{};
+    bool m_is_owner{};
+#ifdef _WIN32
+    void* m_mapping_handle{};
+#endif
+
+    void Close() noexcept;
+
+public:
+    /**
+     * @brief 创建并映射size字节的共享内存，内容初始化为0；同名对象已存在时抛出std::runtime_error
+     */
+    static auto Create(const std::string& name, std::size_t size)
+        -> CSharedMemoryRegion;
+    /**
+     * @brief 映射已存在的共享内存，大小由创建者决定
+     */
+    static auto Open(const std::string& name)
+        -> CSharedMemoryRegion;
+
+    CSharedMemoryRegion() = default;
+    ~CSharedMemoryRegion();
+    CSharedMemoryRegion(const CSharedMemoryRegion&) = delete;
+    CSharedMemoryRegion& operator=(const CSharedMemoryRegion&) = delete;
+    CSharedMemoryRegion(CSharedMemoryRegion&& other) noexcept;
+    CSharedMemoryRegion& operator=(CSharedMemoryRegion&& other) noexcept;
+
+    auto GetData() const noexcept
+        -> std::uint8_t*;
+    auto GetSize() const noexcept
+        -> std::size_t;
+};
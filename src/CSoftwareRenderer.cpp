@@ -0,0 +1,99 @@
+#include "CSoftwareRenderer.h"
+#include <array>
+#include <stdexcept>
+#include <vector>
+#include "AlphaFix.h"
+
+namespace
+{
+    /**
+     * @brief 与UNORM格式的混合一致，乘积除以255后四舍五入
+     */
+    constexpr std::uint32_t BlendChannel(std::uint32_t src, std::uint32_t src_alpha, std::uint32_t dst, std::uint32_t dst_alpha) noexcept
+    {
+        const auto value = (src * src_alpha + dst * (255 - dst_alpha) + 127) / 255;
+        return value > 255 ? 255 : value;
+    }
+
+    void BlendPixel(const std::uint8_t* p_src, std::uint32_t src_alpha, std::uint8_t* p_dst) noexcept
+    {
+        const std::uint32_t dst_alpha = p_dst[3];
+        p_dst[0] = static_cast<std::uint8_t>(BlendChannel(p_src[0], src_alpha, p_dst[0], dst_alpha));
+        p_dst[1] = static_cast<std::uint8_t>(BlendChannel(p_src[1], src_alpha, p_dst[1], dst_alpha));
+        p_dst[2] = static_cast<std::uint8_t>(BlendChannel(p_src[2], src_alpha, p_dst[2], dst_alpha));
+        p_dst[3] = static_cast<std::uint8_t>(src_alpha);
+    }
+}
+
+auto CSoftwareRenderer::GetAlphaIncrement() const noexcept
+    -> std::uint8_t
+{
+    return m_alpha_increment;
+}
+
+auto CSoftwareRenderer::SetAlphaIncrement(std::uint8_t alpha_increment) noexcept
+    -> CSoftwareRenderer&
+{
+    m_alpha_increment = alpha_increment;
+    return *this;
+}
+
+auto CSoftwareRenderer::SetTextColor(std::uint8_t b, std::uint8_t g, std::uint8_t r) noexcept
+    -> CSoftwareRenderer&
+{
+    m_text_color[0] = b;
+    m_text_color[1] = g;
+    m_text_color[2] = r;
+    return *this;
+}
+
+void CSoftwareRenderer::RenderAlphaIncreasePass(const CBgraImage& source, CBgraImage& target) const
+{
+    if (source.GetWidth() != target.GetWidth() || source.GetHeight() != target.GetHeight())
+    {
+        throw std::invalid_argument{"Source and target of alpha increase pass must have the same size."};
+    }
+    const auto width = source.GetWidth();
+    const auto row_size = width * CBgraImage::BYTES_PER_PIXEL;
+    // 逐行先用向量化的alpha修正（color.w = min(1, color.w + increment)）写入暂存行，再逐像素混合
+    std::vector<std::uint8_t> fixed_row(row_size);
+    for (std::uint32_t y = 0; y < source.GetHeight(); ++y)
+    {
+        AlphaFix::IncreaseAlpha(source.GetRow(y), row_size, fixed_row.data(), row_size, width, 1, m_alpha_increment);
+        const auto* p_src = fixed_row.data();
+        auto* p_dst = target.GetRow(y);
+        for (std::uint32_t x = 0; x < width; ++x, p_src += CBgraImage::BYTES_PER_PIXEL, p_dst += CBgraImage::BYTES_PER_PIXEL)
+        {
+            BlendPixel(p_src, p_src[3], p_dst);
+        }
+    }
+}
+
+void CSoftwareRenderer::RenderCoverageAlphaIncreasePass(const CCoverageImage& source, CBgraImage& target) const
+{
+    if (source.GetWidth() != target.GetWidth() || source.GetHeight() != target.GetHeight())
+    {
+        throw std::invalid_argument{"Source and target of alpha increase pass must have the same size."};
+    }
+    const auto width = source.GetWidth();
+    // GDI不写入alpha，还原出的源像素alpha为0
+    const std::uint32_t src_alpha = m_alpha_increment;
+    // 覆盖率只有256种取值，预先算好每种覆盖率对应的源像素
+    std::array<std::array<std::uint8_t, 3>, 256> coverage_to_color{};
+    for (std::uint32_t coverage = 0; coverage < coverage_to_color.size(); ++coverage)
+    {
+        for (std::size_t channel = 0; channel < 3; ++channel)
+        {
+            coverage_to_color[coverage][channel] = static_cast<std::uint8_t>((m_text_color[channel] * coverage + 127) / 255);
+        }
+    }
+    for (std::uint32_t y = 0; y < source.GetHeight(); ++y)
+    {
+        const auto* p_coverage = source.GetRow(y);
+        auto* p_dst = target.GetRow(y);
+        for (std::uint32_t x = 0; x < width; ++x, p_dst += CBgraImage::BYTES_PER_PIXEL)
+        {
+            BlendPixel(coverage_to_color[p_coverage[x]].data(), src_alpha, p_dst);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include "CBgraImage.h"
+#include "CCoverageImage.h"
+
+/**
+ * @brief 在CPU上复现main中的D3D11管线：PsGdiTexturePreprocessor像素着色器与混合状态 \n
+ * 混合状态为 rgb = src.rgb * src.a + dst.rgb * (1 - dst.a)，alpha = src.a
+ */
+class CSoftwareRenderer
+{
+private:
+    std::uint8_t m_alpha_increment{1};
+    std::uint8_t m_text_color[3]{255, 255, 255};
+
+public:
+    CSoftwareRenderer() = default;
+    ~CSoftwareRenderer() = default;
+
+    /**
+     * @brief 获取alpha修正时加上的值，以1/255为单位
+     */
+    auto GetAlphaIncrement() const noexcept
+        -> std::uint8_t;
+    auto SetAlphaIncrement(std::uint8_t alpha_increment) noexcept
+        -> CSoftwareRenderer&;
+    /**
+     * @brief 设置覆盖率模式下文字的颜色
+     */
+    auto SetTextColor(std::uint8_t b, std::uint8_t g, std::uint8_t r) noexcept
+        -> CSoftwareRenderer&;
+
+    /**
+     * @brief 将source经alpha修正后混合到target上，两者尺寸必须相同
+     *
+     * @param source 对应GDI绘制的初始纹理
+     * @param target 对应最终纹理
+     */
+    void RenderAlphaIncreasePass(const CBgraImage& source, CBgraImage& target) const;
+    /**
+     * @brief 与PsCoverageTexturePreprocessor一致：以文字颜色乘覆盖率还原出GDI的BGRA输出， \n
+     * 再执行与RenderAlphaIncreasePass相同的alpha修正和混合
+     *
+     * @param source 覆盖率图像
+     * @param target 对应最终纹理
+     */
+    void RenderCoverageAlphaIncreasePass(const CCoverageImage& source, CBgraImage& target) const;
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct SpscQueueStatistics
+{
+    std::uint64_t m_push_count{};
+    std::uint64_t m_pop_count{};
+    /**
+     * @brief 队列已满导致写入失败的次数，即生产者遇到的背压
+     */
+    std::uint64_t m_full_count{};
+    /**
+     * @brief 生产者观察到的最大排队深度
+     */
+    std::uint64_t m_max_depth{};
+};
+
+/**
+ * @brief 有界无锁单生产者单消费者队列：容量为2的幂，读写序号单调递增，各自只由一方写入 \n
+ * 每一方缓存对方的序号，只有缓存值显示队列已满或已空时才读取对方的原子变量，减少缓存行争用 \n
+ * TryPush只能由同一个生产者线程调用，TryPop只能由同一个消费者线程调用，统计信息可在任意线程读取
+ *
+ * @tparam T 队列元素类型，需要可默认构造和可移动赋值
+ */
+template <class T>
+class CSpscQueue
+{
+    static_assert(std::is_default_constructible_v<T>, "Element of SPSC queue must be default constructible.");
+    static_assert(std::is_nothrow_move_assignable_v<T>, "Element of SPSC queue must be nothrow move assignable.");
+
+private:
+    // 常见CPU的缓存行大小，生产者和消费者各自的数据放在不同的缓存行上
+    constexpr static std::size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> m_slots;
+    std::size_t m_mask;
+
+    // 消费者写入
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cached_tail{0};
+    std::atomic<std::uint64_t> m_pop_count{0};
+
+    // 生产者写入
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cached_head{0};
+    std::atomic<std::uint64_t> m_push_count{0};
+    std::atomic<std::uint64_t> m_full_count{0};
+    std::atomic<std::uint64_t> m_max_depth{0};
+
+    static void Increase(std::atomic<std::uint64_t>& counter) noexcept
+    {
+        // 计数器只有一个写入方，不需要读-改-写原子操作
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template <class U>
+    bool Push(U&& value)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head == m_slots.size())
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head == m_slots.size())
+            {
+                Increase(m_full_count);
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = std::forward<U>(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        Increase(m_push_count);
+        const auto depth = static_cast<std::uint64_t>(tail + 1 - m_cached_head);
+        if (depth > m_max_depth.load(std::memory_order_relaxed))
+        {
+            m_max_depth.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @brief 创建队列
+     *
+     * @param capacity 队列容量，必须是2的幂
+     */
+    explicit CSpscQueue(std::size_t capacity)
+        : m_slots(capacity), m_mask{capacity - 1}
+    {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+        {
+            throw std::invalid_argument{"Capacity of SPSC queue must be a power of two."};
+        }
+    }
+    ~CSpscQueue() = default;
+    CSpscQueue(const CSpscQueue&) = delete;
+    CSpscQueue& operator=(const CSpscQueue&) = delete;
+
+    /**
+     * @brief 生产者写入一个元素
+     *
+     * @return false 队列已满，元素未写入
+     */
+    bool TryPush(const T& value)
+    {
+        return Push(value);
+    }
+    bool TryPush(T&& value)
+    {
+        return Push(std::move(value));
+    }
+    /**
+     * @brief 消费者取出一个元素
+     *
+     * @return false 队列为空，out保持不变
+     */
+    bool TryPop(T& out) noexcept
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail)
+            {
+                return false;
+            }
+        }
+        out = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        Increase(m_pop_count);
+        return true;
+    }
+
+    auto GetCapacity() const noexcept
+        -> std::size_t
+    {
+        return m_slots.size();
+    }
+    /**
+     * @brief 当前排队的元素数量，在其它线程读取时只是一个近似值
+     */
+    auto GetDepth() const noexcept
+        -> std::size_t
+    {
+        // 先读消费者序号，保证读到的生产者序号不小于它
+        const auto head = m_head.load(std::memory_order_acquire);
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+    auto GetStatistics() const noexcept
+        -> SpscQueueStatistics
+    {
+        SpscQueueStatistics statistics{};
+        statistics.m_push_count = m_push_count.load(std::memory_order_relaxed);
+        statistics.m_pop_count = m_pop_count.load(std::memory_order_relaxed);
+        statistics.m_full_count = m_full_count.load(std::memory_order_relaxed);
+        statistics.m_max_depth = m_max_depth.load(std::memory_order_relaxed);
+        return statistics;
+    }
+};
@@ -0,0 +1,141 @@
+#include "CSwapChainPresenter.h"
+#include <algorithm>
+
+using Microsoft::WRL::ComPtr;
+
+CSwapChainPresenter::CSwapChainPresenter(ID3D11Device* p_device, HWND hwnd, SIZE size, const SwapChainPresenterConfig& config)
+    : m_config{config}
+{
+    // flip模型至少需要两个缓冲区
+    m_config.m_buffer_count = (std::max)(m_config.m_buffer_count, 2u);
+    m_config.m_max_frame_latency = (std::max)(m_config.m_max_frame_latency, 1u);
+
+    ComPtr<IDXGIDevice1> p_dxgi_device{};
+    ThrowIfFailed(p_device->QueryInterface(IID_PPV_ARGS(&p_dxgi_device)));
+    ComPtr<IDXGIAdapter> p_adapter{};
+    ThrowIfFailed(p_dxgi_device->GetAdapter(&p_adapter));
+    ComPtr<IDXGIFactory2> p_factory{};
+    ThrowIfFailed(p_adapter->GetParent(IID_PPV_ARGS(&p_factory)));
+
+    if (m_config.m_use_frame_latency_waitable_object)
+    {
+        m_swap_chain_flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    }
+
+    DXGI_SWAP_CHAIN_DESC1 swap_chain_desc{};
+    swap_chain_desc.Width = size.cx;
+    swap_chain_desc.Height = size.cy;
+    swap_chain_desc.Format = m_config.m_format;
+    swap_chain_desc.Stereo = FALSE;
+    swap_chain_desc.SampleDesc.Count = 1;
+    swap_chain_desc.SampleDesc.Quality = 0;
+    swap_chain_desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+    swap_chain_desc.BufferCount = m_config.m_buffer_count;
+    swap_chain_desc.Scaling = DXGI_SCALING_NONE;
+    swap_chain_desc.SwapEffect = m_config.m_swap_effect;
+    swap_chain_desc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
+    swap_chain_desc.Flags = m_swap_chain_flags;
+
+    auto hr = p_factory->CreateSwapChainForHwnd(
+        p_device,
+        hwnd,
+        &swap_chain_desc,
+        NULL,
+        NULL,
+        &m_p_swap_chain);
+    // Windows 10之前的系统不支持FLIP_DISCARD，退回FLIP_SEQUENTIAL
+    if (FAILED(hr) && m_config.m_swap_effect == DXGI_SWAP_EFFECT_FLIP_DISCARD)
+    {
+        m_config.m_swap_effect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+        swap_chain_desc.SwapEffect = m_config.m_swap_effect;
+        hr = p_factory->CreateSwapChainForHwnd(
+            p_device,
+            hwnd,
+            &swap_chain_desc,
+            NULL,
+            NULL,
+            &m_p_swap_chain);
+    }
+    ThrowIfFailed(hr, "Create flip model swap chain failed.");
+    ThrowIfFailed(p_factory->MakeWindowAssociation(hwnd, DXGI_MWA_NO_ALT_ENTER));
+
+    if (m_config.m_use_frame_latency_waitable_object)
+    {
+        ThrowIfFailed(m_p_swap_chain.As(&m_p_swap_chain2));
+        ThrowIfFailed(m_p_swap_chain2->SetMaximumFrameLatency(m_config.m_max_frame_latency));
+        m_frame_latency_waitable_object = m_p_swap_chain2->GetFrameLatencyWaitableObject();
+    }
+    else
+    {
+        ThrowIfFailed(p_dxgi_device->SetMaximumFrameLatency(m_config.m_max_frame_latency));
+    }
+
+    CreateBackBufferView(p_device);
+}
+
+CSwapChainPresenter::~CSwapChainPresenter()
+{
+    if (m_frame_latency_waitable_object != NULL)
+    {
+        ::CloseHandle(m_frame_latency_waitable_object);
+    }
+}
+
+void CSwapChainPresenter::CreateBackBufferView(ID3D11Device* p_device)
+{
+    ThrowIfFailed(m_p_swap_chain->GetBuffer(0, IID_PPV_ARGS(&m_p_back_buffer)));
+    ThrowIfFailed(p_device->CreateRenderTargetView(m_p_back_buffer.Get(), NULL, &m_p_back_buffer_rtv));
+}
+
+bool CSwapChainPresenter::WaitForNextFrame(DWORD timeout_ms) const
+{
+    if (m_frame_latency_waitable_object == NULL)
+    {
+        return true;
+    }
+    return ::WaitForSingleObjectEx(m_frame_latency_waitable_object, timeout_ms, TRUE) == WAIT_OBJECT_0;
+}
+
+auto CSwapChainPresenter::GetFrameLatencyWaitableObject() const noexcept
+    -> HANDLE
+{
+    return m_frame_latency_waitable_object;
+}
+
+auto CSwapChainPresenter::Present()
+    -> HRESULT
+{
+    return m_p_swap_chain->Present(m_config.m_sync_interval, 0);
+}
+
+void CSwapChainPresenter::Resize(ID3D11Device* p_device, SIZE size)
+{
+    // ResizeBuffers要求先释放所有对后台缓冲区的引用
+    m_p_back_buffer_rtv.Reset();
+    m_p_back_buffer.Reset();
+    ThrowIfFailed(m_p_swap_chain->ResizeBuffers(
+        0,
+        size.cx,
+        size.cy,
+        DXGI_FORMAT_UNKNOWN,
+        m_swap_chain_flags));
+    CreateBackBufferView(p_device);
+}
+
+auto CSwapChainPresenter::GetBackBuffer() const noexcept
+    -> ID3D11Texture2D*
+{
+    return m_p_back_buffer.Get();
+}
+
+auto CSwapChainPresenter::GetBackBufferRenderTargetView() const noexcept
+    -> ID3D11RenderTargetView*
+{
+    return m_p_back_buffer_rtv.Get();
+}
+
+auto CSwapChainPresenter::GetConfig() const noexcept
+    -> const SwapChainPresenterConfig&
+{
+    return m_config;
+}
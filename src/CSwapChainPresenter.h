@@ -0,0 +1,76 @@
+#pragma once
+#include <Windows.h>
+#include <wrl/client.h>
+#include <dxgi1_3.h>
+#include <d3d11_2.h>
+#include "HResultException.h"
+
+/**
+ * @brief 交换链呈现配置
+ */
+struct SwapChainPresenterConfig
+{
+    /**
+     * @brief 后台缓冲区数量，flip模型要求至少为2
+     */
+    UINT m_buffer_count{2};
+    /**
+     * @brief 允许排队的最大帧数，配合等待对象使用时1即为最低延迟
+     */
+    UINT m_max_frame_latency{1};
+    /**
+     * @brief Present时使用的垂直同步间隔
+     */
+    UINT m_sync_interval{1};
+    DXGI_FORMAT m_format{DXGI_FORMAT_B8G8R8A8_UNORM};
+    DXGI_SWAP_EFFECT m_swap_effect{DXGI_SWAP_EFFECT_FLIP_DISCARD};
+    bool m_use_frame_latency_waitable_object{true};
+};
+
+/**
+ * @brief 基于flip模型交换链的呈现层，渲染循环在构建每一帧前应先调用WaitForNextFrame
+ */
+class CSwapChainPresenter
+{
+private:
+    SwapChainPresenterConfig m_config{};
+    Microsoft::WRL::ComPtr<IDXGISwapChain1> m_p_swap_chain{};
+    Microsoft::WRL::ComPtr<IDXGISwapChain2> m_p_swap_chain2{};
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> m_p_back_buffer{};
+    Microsoft::WRL::ComPtr<ID3D11RenderTargetView> m_p_back_buffer_rtv{};
+    HANDLE m_frame_latency_waitable_object{NULL};
+    UINT m_swap_chain_flags{};
+
+    void CreateBackBufferView(ID3D11Device* p_device);
+
+public:
+    CSwapChainPresenter(ID3D11Device* p_device, HWND hwnd, SIZE size, const SwapChainPresenterConfig& config = {});
+    ~CSwapChainPresenter();
+    CSwapChainPresenter(const CSwapChainPresenter&) = delete;
+    CSwapChainPresenter& operator=(const CSwapChainPresenter&) = delete;
+
+    /**
+     * @brief 等待交换链允许提交下一帧
+     *
+     * @param timeout_ms 等待超时时间
+     * @return true 可以开始构建下一帧
+     * @return false 超时
+     */
+    bool WaitForNextFrame(DWORD timeout_ms = INFINITE) const;
+    /**
+     * @brief 获取帧延迟等待对象，未启用时返回NULL；句柄由本对象持有，调用者不得关闭
+     */
+    auto GetFrameLatencyWaitableObject() const noexcept
+        -> HANDLE;
+
+    auto Present()
+        -> HRESULT;
+    void Resize(ID3D11Device* p_device, SIZE size);
+
+    auto GetBackBuffer() const noexcept
+        -> ID3D11Texture2D*;
+    auto GetBackBufferRenderTargetView() const noexcept
+        -> ID3D11RenderTargetView*;
+    auto GetConfig() const noexcept
+        -> const SwapChainPresenterConfig&;
+};
@@ -0,0 +1,281 @@
+#include "CTimingWheel.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+CTimingWheel::CTimingWheel(Clock::time_point start_time, const TimingWheelConfig& config)
+    : m_config{config}, m_start_time{start_time}
+{
+    if (m_config.m_tick_duration <= std::chrono::nanoseconds::zero())
+    {
+        throw std::invalid_argument{"Tick duration of timing wheel must be positive."};
+    }
+    for (auto& level_heads : m_slot_heads)
+    {
+        level_heads.fill(INVALID_NODE);
+    }
+    m_nodes.reserve(m_config.m_initial_capacity);
+    m_free_nodes.reserve(m_config.m_initial_capacity);
+    m_expired_timers.reserve(m_config.m_initial_capacity);
+}
+
+auto CTimingWheel::ToTick(Clock::time_point time) const noexcept
+    -> std::uint64_t
+{
+    if (time <= m_start_time)
+    {
+        return 0;
+    }
+    return static_cast<std::uint64_t>((time - m_start_time) / m_config.m_tick_duration);
+}
+
+auto CTimingWheel::ToTicks(Clock::duration duration) const noexcept
+    -> std::uint64_t
+{
+    if (duration <= Clock::duration::zero())
+    {
+        return 0;
+    }
+    const auto nanoseconds = static_cast<std::uint64_t>(std::chrono::ceil<std::chrono::nanoseconds>(duration).count());
+    const auto tick_duration = static_cast<std::uint64_t>(m_config.m_tick_duration.count());
+    return (std::max)(std::uint64_t{1}, (nanoseconds + tick_duration - 1) / tick_duration);
+}
+
+bool CTimingWheel::IsValid(TimerHandle handle) const noexcept
+{
+    const auto index = handle.GetIndex();
+    return !handle.IsNull() &&
+           index < m_nodes.size() &&
+           m_nodes[index].m_is_active &&
+           m_nodes[index].m_generation == handle.GetGeneration();
+}
+
+void CTimingWheel::Link(std::uint32_t node_index) noexcept
+{
+    auto& node = m_nodes[node_index];
+    // 按与当前时间槽的距离选择层，槽号取到期时间在该层的对应位，保证下移发生在到期之前
+    const auto delta = node.m_expiry_tick - m_current_tick;
+    std::uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+    const auto slot = static_cast<std::uint32_t>((node.m_expiry_tick >> (SLOT_BITS * level)) & (SLOT_COUNT - 1));
+    auto& head = m_slot_heads[level][slot];
+    node.m_level = static_cast<std::uint8_t>(level);
+    node.m_slot = static_cast<std::uint8_t>(slot);
+    node.m_previous = INVALID_NODE;
+    node.m_next = head;
+    if (head != INVALID_NODE)
+    {
+        m_nodes[head].m_previous = node_index;
+    }
+    head = node_index;
+    m_occupied_slots[level] |= std::uint64_t{1} << slot;
+}
+
+void CTimingWheel::Unlink(std::uint32_t node_index) noexcept
+{
+    auto& node = m_nodes[node_index];
+    if (node.m_previous != INVALID_NODE)
+    {
+        m_nodes[node.m_previous].m_next = node.m_next;
+    }
+    else
+    {
+        m_slot_heads[node.m_level][node.m_slot] = node.m_next;
+        if (node.m_next == INVALID_NODE)
+        {
+            m_occupied_slots[node.m_level] &= ~(std::uint64_t{1} << node.m_slot);
+        }
+    }
+    if (node.m_next != INVALID_NODE)
+    {
+        m_nodes[node.m_next].m_previous = node.m_previous;
+    }
+    node.m_previous = INVALID_NODE;
+    node.m_next = INVALID_NODE;
+}
+
+void CTimingWheel::FreeNode(std::uint32_t node_index) noexcept
+{
+    auto& node = m_nodes[node_index];
+    node.m_is_active = false;
+    // 代数为0会使句柄可能为0，跳过
+    const auto next_generation = static_cast<std::uint16_t>((node.m_generation + 1) & TimerHandle::GENERATION_MASK);
+    node.m_generation = next_generation == 0 ? 1 : next_generation;
+    // 节点数不超过预留容量时不会分配内存
+    m_free_nodes.push_back(node_index);
+    --m_active_count;
+}
+
+auto CTimingWheel::DetachSlot(std::uint32_t level, std::uint32_t slot) noexcept
+    -> std::uint32_t
+{
+    const auto head = m_slot_heads[level][slot];
+    m_slot_heads[level][slot] = INVALID_NODE;
+    m_occupied_slots[level] &= ~(std::uint64_t{1} << slot);
+    return head;
+}
+
+auto CTimingWheel::GetNextEventTick() const noexcept
+    -> std::optional<std::uint64_t>
+{
+    std::optional<std::uint64_t> result{};
+    for (std::uint32_t level = 0; level < LEVEL_COUNT; ++level)
+    {
+        const auto occupied_slots = m_occupied_slots[level];
+        if (occupied_slots == 0)
+        {
+            continue;
+        }
+        // 从下一个槽开始找第一个非空槽，当前槽本身排在一整圈之后
+        const auto shift = SLOT_BITS * level;
+        const auto current_slot_tick = m_current_tick >> shift;
+        const auto first_slot = static_cast<int>((current_slot_tick + 1) & (SLOT_COUNT - 1));
+        const auto distance = static_cast<std::uint64_t>(std::countr_zero(std::rotr(occupied_slots, first_slot))) + 1;
+        const auto event_tick = (current_slot_tick + distance) << shift;
+        if (!result || event_tick < *result)
+        {
+            result = event_tick;
+        }
+    }
+    return result;
+}
+
+void CTimingWheel::ProcessTick(std::uint64_t target_tick)
+{
+    // 先从高层向低层下移，到期时间恰好是当前时间槽的定时器会落到第0层的当前槽
+    for (auto level = LEVEL_COUNT - 1; level > 0; --level)
+    {
+        const auto shift = SLOT_BITS * level;
+        if ((m_current_tick & ((std::uint64_t{1} << shift) - 1)) != 0)
+        {
+            continue;
+        }
+        const auto slot = static_cast<std::uint32_t>((m_current_tick >> shift) & (SLOT_COUNT - 1));
+        auto node_index = DetachSlot(level, slot);
+        while (node_index != INVALID_NODE)
+        {
+            const auto next_index = m_nodes[node_index].m_next;
+            Link(node_index);
+            ++m_statistics.m_cascaded_count;
+            node_index = next_index;
+        }
+    }
+
+    auto node_index = DetachSlot(0, static_cast<std::uint32_t>(m_current_tick & (SLOT_COUNT - 1)));
+    if (node_index != INVALID_NODE)
+    {
+        ++m_statistics.m_expiring_tick_count;
+    }
+    while (node_index != INVALID_NODE)
+    {
+        auto& node = m_nodes[node_index];
+        const auto next_index = node.m_next;
+        m_expired_timers.push_back({TimerHandle::Make(node_index, node.m_generation), node.m_user_data});
+        ++m_statistics.m_fired_count;
+        if (node.m_period_ticks == 0)
+        {
+            FreeNode(node_index);
+        }
+        else
+        {
+            // 跳过本次Advance中已经错过的周期，避免追赶时同一个定时器重复触发
+            const auto missed_period_count = node.m_expiry_tick + node.m_period_ticks <= target_tick
+                                                 ? (target_tick - node.m_expiry_tick) / node.m_period_ticks
+                                                 : 0;
+            node.m_expiry_tick += node.m_period_ticks * (missed_period_count + 1);
+            Link(node_index);
+        }
+        node_index = next_index;
+    }
+}
+
+auto CTimingWheel::Schedule(Clock::duration delay, Clock::duration period, std::uint64_t user_data)
+    -> TimerHandle
+{
+    std::uint32_t node_index{};
+    if (!m_free_nodes.empty())
+    {
+        node_index = m_free_nodes.back();
+        m_free_nodes.pop_back();
+    }
+    else
+    {
+        node_index = static_cast<std::uint32_t>(m_nodes.size());
+        if (node_index > TimerHandle::INDEX_MASK)
+        {
+            throw std::length_error{"Timing wheel is full."};
+        }
+        m_nodes.emplace_back();
+    }
+    auto& node = m_nodes[node_index];
+    node.m_expiry_tick = m_current_tick + (std::max)(std::uint64_t{1}, ToTicks(delay));
+    node.m_period_ticks = ToTicks(period);
+    node.m_user_data = user_data;
+    node.m_is_active = true;
+    Link(node_index);
+    ++m_active_count;
+    ++m_statistics.m_scheduled_count;
+    return TimerHandle::Make(node_index, node.m_generation);
+}
+
+bool CTimingWheel::Cancel(TimerHandle handle) noexcept
+{
+    if (!IsValid(handle))
+    {
+        return false;
+    }
+    Unlink(handle.GetIndex());
+    FreeNode(handle.GetIndex());
+    ++m_statistics.m_cancelled_count;
+    return true;
+}
+
+bool CTimingWheel::IsActive(TimerHandle handle) const noexcept
+{
+    return IsValid(handle);
+}
+
+auto CTimingWheel::Advance(Clock::time_point now)
+    -> const std::vector<ExpiredTimer>&
+{
+    m_expired_timers.clear();
+    const auto target_tick = ToTick(now);
+    while (m_current_tick < target_tick)
+    {
+        const auto next_event_tick = GetNextEventTick();
+        if (!next_event_tick || *next_event_tick > target_tick)
+        {
+            m_current_tick = target_tick;
+            break;
+        }
+        m_current_tick = *next_event_tick;
+        ProcessTick(target_tick);
+    }
+    return m_expired_timers;
+}
+
+auto CTimingWheel::GetNextDeadline() const noexcept
+    -> std::optional<Clock::time_point>
+{
+    const auto next_event_tick = GetNextEventTick();
+    if (!next_event_tick)
+    {
+        return std::nullopt;
+    }
+    return m_start_time + std::chrono::duration_cast<Clock::duration>(m_config.m_tick_duration * static_cast<std::int64_t>(*next_event_tick));
+}
+
+auto CTimingWheel::GetActiveCount() const noexcept
+    -> std::size_t
+{
+    return m_active_count;
+}
+
+auto CTimingWheel::GetStatistics() const noexcept
+    -> const TimingWheelStatistics&
+{
+    return m_statistics;
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "CHandleTable.h"
+
+struct TimingWheelTimer;
+using TimerHandle = Handle<TimingWheelTimer>;
+
+struct TimingWheelConfig
+{
+    /**
+     * @brief 一个时间槽的长度，同一个槽内到期的定时器在同一次Advance中返回，通常取一帧的时长
+     */
+    std::chrono::nanoseconds m_tick_duration{16'666'667};
+    /**
+     * @brief 预先分配的定时器数量，超过后Schedule才会分配内存
+     */
+    std::size_t m_initial_capacity{1024};
+};
+
+struct ExpiredTimer
+{
+    TimerHandle m_handle{};
+    std::uint64_t m_user_data{};
+};
+
+struct TimingWheelStatistics
+{
+    std::uint64_t m_scheduled_count{};
+    std::uint64_t m_cancelled_count{};
+    std::uint64_t m_fired_count{};
+    /**
+     * @brief 从高层时间轮下移到低层的次数
+     */
+    std::uint64_t m_cascaded_count{};
+    /**
+     * @brief 有定时器到期的时间槽数量，与m_fired_count之差即被合并的到期次数
+     */
+    std::uint64_t m_expiring_tick_count{};
+};
+
+/**
+ * @brief 分层时间轮：每层64个槽，第L层的一个槽覆盖64^L个时间槽，四层共覆盖2^24个时间槽 \n
+ * 定时器放在预分配的节点池中，以侵入式双向链表挂在槽上，插入和取消都是O(1) \n
+ * 每层用64位掩码记录非空的槽，Advance直接跳到下一个需要处理的时间槽，空闲的时间槽没有开销
+ */
+class CTimingWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    constexpr static std::uint32_t LEVEL_COUNT = 4;
+    constexpr static std::uint32_t SLOT_BITS = 6;
+    constexpr static std::uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+
+private:
+    constexpr static std::uint32_t INVALID_NODE = 0xFFFFFFFFu;
+
+    struct TimerNode
+    {
+        std::uint64_t m_expiry_tick{};
+        /**
+         * @brief 周期，单位为时间槽；为0时是一次性定时器
+         */
+        std::uint64_t m_period_ticks{};
+        std::uint64_t m_user_data{};
+        std::uint32_t m_previous{INVALID_NODE};
+        std::uint32_t m_next{INVALID_NODE};
+        std::uint16_t m_generation{1};
+        std::uint8_t m_level{};
+        std::uint8_t m_slot{};
+        bool m_is_active{};
+    };
+
+    TimingWheelConfig m_config{};
+    Clock::time_point m_start_time{};
+    std::uint64_t m_current_tick{};
+    std::vector<TimerNode> m_nodes{};
+    std::vector<std::uint32_t> m_free_nodes{};
+    std::array<std::array<std::uint32_t, SLOT_COUNT>, LEVEL_COUNT> m_slot_heads{};
+    std::array<std::uint64_t, LEVEL_COUNT> m_occupied_slots{};
+    std::vector<ExpiredTimer> m_expired_timers{};
+    std::size_t m_active_count{};
+    TimingWheelStatistics m_statistics{};
+
+    auto ToTick(Clock::time_point time) const noexcept
+        -> std::uint64_t;
+    auto ToTicks(Clock::duration duration) const noexcept
+        -> std::uint64_t;
+    bool IsValid(TimerHandle handle) const noexcept;
+    void Link(std::uint32_t node_index) noexcept;
+    void Unlink(std::uint32_t node_index) noexcept;
+    void FreeNode(std::uint32_t node_index) noexcept;
+    /**
+     * @brief 从slot_heads中取出一个槽的整条链表并清空该槽
+     */
+    auto DetachSlot(std::uint32_t level, std::uint32_t slot) noexcept
+        -> std::uint32_t;
+    /**
+     * @brief 下一个需要处理的时间槽：第0层为确切的到期时间，更高层为该槽下移的时间，不早于其中定时器的到期时间
+     */
+    auto GetNextEventTick() const noexcept
+        -> std::optional<std::uint64_t>;
+    /**
+     * @brief 处理m_current_tick这个时间槽，target_tick为本次Advance的终点
+     */
+    void ProcessTick(std::uint64_t target_tick);
+
+public:
+    /**
+     * @brief 创建时间轮
+     *
+     * @param start_time 第0个时间槽的开始时间
+     */
+    explicit CTimingWheel(Clock::time_point start_time, const TimingWheelConfig& config = {});
+    ~CTimingWheel() = default;
+
+    /**
+     * @brief 添加定时器，延迟从上一次Advance的时间槽起算，向上取整到时间槽且至少为一个时间槽
+     *
+     * @param period 重复周期，为0时只触发一次
+     * @param user_data 到期时原样返回
+     */
+    auto Schedule(Clock::duration delay, Clock::duration period, std::uint64_t user_data)
+        -> TimerHandle;
+    /**
+     * @brief 取消定时器，句柄已失效（已取消或一次性定时器已触发）时返回false
+     */
+    bool Cancel(TimerHandle handle) noexcept;
+    bool IsActive(TimerHandle handle) const noexcept;
+    /**
+     * @brief 处理到now为止的全部时间槽；周期定时器错过多个周期时只触发一次
+     *
+     * @return 到期的定时器，在下一次调用Advance前有效
+     */
+    auto Advance(Clock::time_point now)
+        -> const std::vector<ExpiredTimer>&;
+    /**
+     * @brief 渲染循环应该醒来的最晚时间，可能早于实际到期时间（高层时间轮下移时）；没有定时器时返回std::nullopt
+     */
+    auto GetNextDeadline() const noexcept
+        -> std::optional<Clock::time_point>;
+
+    auto GetActiveCount() const noexcept
+        -> std::size_t;
+    auto GetStatistics() const noexcept
+        -> const TimingWheelStatistics&;
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+struct TripleBufferStatistics
+{
+    std::uint64_t m_publish_count{};
+    /**
+     * @brief 内容与上一次发布相同而跳过的次数
+     */
+    std::uint64_t m_unchanged_publish_count{};
+    /**
+     * @brief 消费者取到新快照的次数
+     */
+    std::uint64_t m_consume_count{};
+    /**
+     * @brief 发布时上一个快照还未被消费者取走而被覆盖的次数
+     */
+    std::uint64_t m_overwritten_count{};
+};
+
+/**
+ * @brief 无等待的三重缓冲：生产者和消费者各持有一个槽位，第三个槽位用于交换， \n
+ * 发布和获取各只需一次原子交换，消费者总是拿到最新的完整快照，不会读到写了一半的数据 \n
+ * Publish只能由同一个生产者线程调用，Update和Get只能由同一个消费者线程调用； \n
+ * 多个采样线程应各自使用一个三重缓冲
+ *
+ * @tparam T 快照类型，必须是平凡可复制的，用逐字节比较判断内容是否改变
+ */
+template <class T>
+class CTripleBuffer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshot of triple buffer must be trivially copyable.");
+
+private:
+    constexpr static std::uint8_t INDEX_MASK = 0x3;
+    // 交换槽位中的快照还没有被消费者取走
+    constexpr static std::uint8_t FRESH_BIT = 0x4;
+
+    // 每个槽位独占缓存行，生产者写入时不影响消费者读取
+    struct alignas(64) Slot
+    {
+        T m_value;
+    };
+
+    std::array<Slot, 3> m_slots{};
+    alignas(64) std::atomic<std::uint8_t> m_middle{1};
+
+    // 生产者持有
+    alignas(64) std::uint8_t m_write_index{0};
+    bool m_has_published{false};
+    T m_last_published{};
+    std::atomic<std::uint64_t> m_publish_count{0};
+    std::atomic<std::uint64_t> m_unchanged_publish_count{0};
+    std::atomic<std::uint64_t> m_overwritten_count{0};
+
+    // 消费者持有
+    alignas(64) std::uint8_t m_read_index{2};
+    std::atomic<std::uint64_t> m_consume_count{0};
+
+    static void Increase(std::atomic<std::uint64_t>& counter) noexcept
+    {
+        // 计数器只有一个写入方，不需要读-改-写原子操作
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+public:
+    explicit CTripleBuffer(const T& initial_value = {}) noexcept
+        : m_last_published{initial_value}
+    {
+        for (auto& slot : m_slots)
+        {
+            slot.m_value = initial_value;
+        }
+    }
+    ~CTripleBuffer() = default;
+    CTripleBuffer(const CTripleBuffer&) = delete;
+    CTripleBuffer& operator=(const CTripleBuffer&) = delete;
+
+    /**
+     * @brief 生产者发布一个快照，内容与上一次发布的相同时不发布
+     *
+     * @return true 快照已发布
+     * @return false 内容未改变
+     */
+    bool Publish(const T& value) noexcept
+    {
+        if (m_has_published && std::memcmp(&m_last_published, &value, sizeof(T)) == 0)
+        {
+            Increase(m_unchanged_publish_count);
+            return false;
+        }
+        m_has_published = true;
+        m_last_published = value;
+        m_slots[m_write_index].m_value = value;
+        const auto old_middle = m_middle.exchange(static_cast<std::uint8_t>(m_write_index | FRESH_BIT), std::memory_order_acq_rel);
+        m_write_index = old_middle & INDEX_MASK;
+        Increase(m_publish_count);
+        if ((old_middle & FRESH_BIT) != 0)
+        {
+            Increase(m_overwritten_count);
+        }
+        return true;
+    }
+    /**
+     * @brief 消费者取得最新发布的快照
+     *
+     * @return true 取到了新快照
+     * @return false 自上次调用以来没有新的发布，Get返回的快照不变，可以跳过渲染
+     */
+    bool Update() noexcept
+    {
+        // 没有新快照时只读取，不改写共享的缓存行
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+        {
+            return false;
+        }
+        const auto old_middle = m_middle.exchange(m_read_index, std::memory_order_acq_rel);
+        m_read_index = old_middle & INDEX_MASK;
+        Increase(m_consume_count);
+        return true;
+    }
+    /**
+     * @brief 消费者当前持有的快照，在下一次Update之前保持不变
+     */
+    auto Get() const noexcept
+        -> const T&
+    {
+        return m_slots[m_read_index].m_value;
+    }
+
+    auto GetStatistics() const noexcept
+        -> TripleBufferStatistics
+    {
+        TripleBufferStatistics statistics{};
+        statistics.m_publish_count = m_publish_count.load(std::memory_order_relaxed);
+        statistics.m_unchanged_publish_count = m_unchanged_publish_count.load(std::memory_order_relaxed);
+        statistics.m_consume_count = m_consume_count.load(std::memory_order_relaxed);
+        statistics.m_overwritten_count = m_overwritten_count.load(std::memory_order_relaxed);
+        return statistics;
+    }
+};
@@ -0,0 +1,184 @@
+#include "CUploadEngine.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+CUploadEngine::CUploadEngine(IUploadBackend& backend, IFrameFence& fence, const UploadEngineConfig& config)
+    : m_backend{backend}, m_fence{fence}, m_config{config}
+{
+    if (m_config.m_block_width == 0 || m_config.m_block_height == 0 || m_config.m_bytes_per_pixel == 0)
+    {
+        throw std::invalid_argument{"Staging block of upload engine must not be empty."};
+    }
+    m_config.m_ring_depth = (std::max)(1u, m_config.m_ring_depth);
+    m_config.m_max_block_count = (std::max)(m_config.m_ring_depth, m_config.m_max_block_count);
+    for (std::uint32_t i = 0; i < m_config.m_ring_depth; ++i)
+    {
+        AddBlock();
+    }
+}
+
+void CUploadEngine::AddBlock()
+{
+    StagingBlock block{};
+    block.m_backend_index = m_backend.CreateStagingBlock(m_config.m_block_width, m_config.m_block_height);
+    m_blocks.push_back(std::move(block));
+}
+
+bool CUploadEngine::TryAllocate(StagingBlock& block, std::uint32_t width, std::uint32_t height, std::uint32_t& x, std::uint32_t& y) noexcept
+{
+    // 按行(shelf)装箱：放不下当前行时另起一行
+    if (block.m_cursor_x + width > m_config.m_block_width)
+    {
+        block.m_shelf_y += block.m_shelf_height;
+        block.m_cursor_x = 0;
+        block.m_shelf_height = 0;
+    }
+    if (block.m_shelf_y + height > m_config.m_block_height)
+    {
+        return false;
+    }
+    x = block.m_cursor_x;
+    y = block.m_shelf_y;
+    block.m_cursor_x += width;
+    block.m_shelf_height = (std::max)(block.m_shelf_height, height);
+    return true;
+}
+
+void CUploadEngine::SubmitBlock(StagingBlock& block)
+{
+    if (block.m_mapped.m_p_data == nullptr)
+    {
+        return;
+    }
+    m_backend.UnmapStagingBlock(block.m_backend_index);
+    block.m_mapped = {};
+    m_backend.CopyRegions(block.m_backend_index, block.m_regions.data(), block.m_regions.size());
+    m_statistics.m_copy_count += block.m_regions.size();
+    ++m_statistics.m_submit_count;
+    block.m_regions.clear();
+    block.m_fence_value = m_fence.GetNextValue();
+    block.m_cursor_x = 0;
+    block.m_shelf_y = 0;
+    block.m_shelf_height = 0;
+}
+
+auto CUploadEngine::AcquireNextBlock()
+    -> StagingBlock*
+{
+    const auto next_block = (m_current_block + 1) % static_cast<std::uint32_t>(m_blocks.size());
+    if (m_blocks[next_block].m_fence_value <= m_fence.GetCompletedValue())
+    {
+        m_current_block = next_block;
+        return &m_blocks[m_current_block];
+    }
+    if (m_blocks.size() < m_config.m_max_block_count)
+    {
+        // 下一个暂存块仍在使用中，插入一个新块而不是等待
+        ++m_statistics.m_ring_exhausted_count;
+        m_blocks.insert(m_blocks.begin() + next_block, StagingBlock{});
+        m_blocks[next_block].m_backend_index = m_backend.CreateStagingBlock(m_config.m_block_width, m_config.m_block_height);
+        m_current_block = next_block;
+        return &m_blocks[m_current_block];
+    }
+    // 等待GPU会让CPU写入阻塞在栅栏上，而且栅栏查询可能还没有提交给GPU；留给调用者下一帧重试
+    return nullptr;
+}
+
+auto CUploadEngine::GetWritableBlock()
+    -> StagingBlock*
+{
+    auto* p_block = &m_blocks[m_current_block];
+    if (p_block->m_mapped.m_p_data == nullptr && p_block->m_fence_value > m_fence.GetCompletedValue())
+    {
+        p_block = AcquireNextBlock();
+        if (p_block == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    if (p_block->m_mapped.m_p_data == nullptr)
+    {
+        p_block->m_mapped = m_backend.MapStagingBlock(p_block->m_backend_index);
+    }
+    return p_block;
+}
+
+bool CUploadEngine::Upload(std::uint32_t destination, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height, const void* p_source, std::uint32_t source_row_pitch)
+{
+    const auto* p_source_bytes = static_cast<const std::uint8_t*>(p_source);
+    ++m_statistics.m_upload_count;
+    // 超过暂存块大小的上传拆分为多个分块
+    for (std::uint32_t tile_y = 0; tile_y < height; tile_y += m_config.m_block_height)
+    {
+        const auto tile_height = (std::min)(m_config.m_block_height, height - tile_y);
+        for (std::uint32_t tile_x = 0; tile_x < width; tile_x += m_config.m_block_width)
+        {
+            const auto tile_width = (std::min)(m_config.m_block_width, width - tile_x);
+            auto* p_block = GetWritableBlock();
+            std::uint32_t staging_x = 0;
+            std::uint32_t staging_y = 0;
+            if (p_block != nullptr && !TryAllocate(*p_block, tile_width, tile_height, staging_x, staging_y))
+            {
+                SubmitBlock(*p_block);
+                p_block = GetWritableBlock();
+                if (p_block != nullptr)
+                {
+                    TryAllocate(*p_block, tile_width, tile_height, staging_x, staging_y);
+                }
+            }
+            if (p_block == nullptr)
+            {
+                ++m_statistics.m_rejected_upload_count;
+                return false;
+            }
+
+            const auto row_size = static_cast<std::size_t>(tile_width) * m_config.m_bytes_per_pixel;
+            for (std::uint32_t row = 0; row < tile_height; ++row)
+            {
+                const auto* p_source_row = p_source_bytes +
+                                           static_cast<std::size_t>(tile_y + row) * source_row_pitch +
+                                           static_cast<std::size_t>(tile_x) * m_config.m_bytes_per_pixel;
+                auto* p_staging_row = p_block->m_mapped.m_p_data +
+                                      static_cast<std::size_t>(staging_y + row) * p_block->m_mapped.m_row_pitch +
+                                      static_cast<std::size_t>(staging_x) * m_config.m_bytes_per_pixel;
+                std::memcpy(p_staging_row, p_source_row, row_size);
+            }
+            m_statistics.m_bytes_uploaded += row_size * tile_height;
+
+            UploadCopyRegion region{};
+            region.m_destination = destination;
+            region.m_source_x = staging_x;
+            region.m_source_y = staging_y;
+            region.m_destination_x = x + tile_x;
+            region.m_destination_y = y + tile_y;
+            region.m_width = tile_width;
+            region.m_height = tile_height;
+            p_block->m_regions.push_back(region);
+        }
+    }
+    return true;
+}
+
+void CUploadEngine::Submit()
+{
+    auto& block = m_blocks[m_current_block];
+    if (block.m_regions.empty())
+    {
+        return;
+    }
+    // 当前块交给GPU后，下一次上传时由GetWritableBlock轮转到下一个可用块
+    SubmitBlock(block);
+}
+
+auto CUploadEngine::GetStatistics() const noexcept
+    -> const UploadEngineStatistics&
+{
+    return m_statistics;
+}
+
+auto CUploadEngine::GetBlockCount() const noexcept
+    -> std::size_t
+{
+    return m_blocks.size();
+}
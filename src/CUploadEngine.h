@@ -0,0 +1,138 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "FrameFence.h"
+
+/**
+ * @brief 从暂存块的(m_source_x, m_source_y)复制到目标纹理的(m_destination_x, m_destination_y)
+ */
+struct UploadCopyRegion
+{
+    std::uint32_t m_destination{};
+    std::uint32_t m_source_x{};
+    std::uint32_t m_source_y{};
+    std::uint32_t m_destination_x{};
+    std::uint32_t m_destination_y{};
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+};
+
+struct MappedStagingBlock
+{
+    std::uint8_t* m_p_data{};
+    std::uint32_t m_row_pitch{};
+};
+
+/**
+ * @brief 上传引擎的后端，负责创建和映射暂存块并提交复制命令
+ */
+class IUploadBackend
+{
+public:
+    virtual ~IUploadBackend() = default;
+
+    /**
+     * @brief 创建一个二维暂存块，返回从0开始连续的编号
+     */
+    virtual auto CreateStagingBlock(std::uint32_t width, std::uint32_t height)
+        -> std::uint32_t = 0;
+    /**
+     * @brief 映射暂存块供CPU写入；上传引擎只会映射栅栏已完成的暂存块，所以不应等待
+     */
+    virtual auto MapStagingBlock(std::uint32_t block)
+        -> MappedStagingBlock = 0;
+    virtual void UnmapStagingBlock(std::uint32_t block) = 0;
+    virtual void CopyRegions(std::uint32_t block, const UploadCopyRegion* p_regions, std::size_t count) = 0;
+};
+
+struct UploadEngineConfig
+{
+    std::uint32_t m_block_width{1024};
+    std::uint32_t m_block_height{256};
+    std::uint32_t m_bytes_per_pixel{4};
+    /**
+     * @brief 初始暂存块数量，即流水线深度
+     */
+    std::uint32_t m_ring_depth{3};
+    /**
+     * @brief 暂存块数量上限，达到上限且下一个暂存块仍在使用中时拒绝上传而不是等待GPU
+     */
+    std::uint32_t m_max_block_count{16};
+};
+
+struct UploadEngineStatistics
+{
+    std::uint64_t m_bytes_uploaded{};
+    std::uint64_t m_upload_count{};
+    std::uint64_t m_copy_count{};
+    std::uint64_t m_submit_count{};
+    /**
+     * @brief 下一个暂存块仍被GPU使用、不得不新建暂存块的次数
+     */
+    std::uint64_t m_ring_exhausted_count{};
+    /**
+     * @brief 暂存块数量达到上限、没有可写的暂存块而被拒绝的上传次数
+     */
+    std::uint64_t m_rejected_upload_count{};
+};
+
+/**
+ * @brief 批量流水线上传引擎：把许多小块上传合并写入共享的暂存块，暂存块按栅栏轮转， \n
+ * 提交时统一发出复制命令；CPU只写入GPU已用完的暂存块，不足时扩充而不是等待
+ */
+class CUploadEngine
+{
+private:
+    struct StagingBlock
+    {
+        std::uint32_t m_backend_index{};
+        std::uint64_t m_fence_value{};
+        MappedStagingBlock m_mapped{};
+        std::uint32_t m_cursor_x{};
+        std::uint32_t m_shelf_y{};
+        std::uint32_t m_shelf_height{};
+        std::vector<UploadCopyRegion> m_regions{};
+    };
+
+    IUploadBackend& m_backend;
+    IFrameFence& m_fence;
+    UploadEngineConfig m_config{};
+    std::vector<StagingBlock> m_blocks{};
+    std::uint32_t m_current_block{};
+    UploadEngineStatistics m_statistics{};
+
+    void AddBlock();
+    bool TryAllocate(StagingBlock& block, std::uint32_t width, std::uint32_t height, std::uint32_t& x, std::uint32_t& y) noexcept;
+    void SubmitBlock(StagingBlock& block);
+    /**
+     * @brief 轮转到下一个GPU已用完的暂存块，必要时新建；达到上限时返回nullptr，从不等待
+     */
+    auto AcquireNextBlock()
+        -> StagingBlock*;
+    auto GetWritableBlock()
+        -> StagingBlock*;
+
+public:
+    CUploadEngine(IUploadBackend& backend, IFrameFence& fence, const UploadEngineConfig& config = {});
+    ~CUploadEngine() = default;
+    CUploadEngine(const CUploadEngine&) = delete;
+    CUploadEngine& operator=(const CUploadEngine&) = delete;
+
+    /**
+     * @brief 把一块像素加入上传队列，数据立即复制到暂存块，调用返回后p_source即可复用
+     *
+     * @param destination 后端可识别的目标纹理编号
+     * @param p_source 源像素，行距为source_row_pitch
+     * @return 暂存块全部被GPU占用时返回false，此时该块像素可能只有一部分被加入队列，调用者应在之后重新上传整块
+     */
+    bool Upload(std::uint32_t destination, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height, const void* p_source, std::uint32_t source_row_pitch);
+    /**
+     * @brief 提交当前暂存块中积累的全部复制，每帧在使用目标纹理之前调用一次
+     */
+    void Submit();
+
+    auto GetStatistics() const noexcept
+        -> const UploadEngineStatistics&;
+    auto GetBlockCount() const noexcept
+        -> std::size_t;
+};
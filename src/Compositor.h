@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "CMappedSurface.h"
+
+enum class CompositorKind
+{
+    Cpu,
+    D3D11
+};
+
+constexpr auto GetCompositorKindName(CompositorKind kind) noexcept
+    -> const char*
+{
+    return kind == CompositorKind::Cpu ? "cpu" : "d3d11";
+}
+
+/**
+ * @brief 把GDI表面经alpha修正合成到窗口的实现，CPU和D3D11两条路径共用此接口
+ */
+class ICompositor
+{
+public:
+    virtual ~ICompositor() = default;
+
+    virtual auto GetKind() const noexcept
+        -> CompositorKind = 0;
+    virtual void Resize(std::uint32_t width, std::uint32_t height) = 0;
+    /**
+     * @brief 合成一帧
+     *
+     * @param source 表面的前台缓冲区
+     * @param updated_rects 自上一帧以来更新过的区域，没有更新时为空
+     */
+    virtual void Composite(const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects) = 0;
+};
+
+/**
+ * @brief 把已有的渲染流程（例如main中的D3D11管线）包装为ICompositor
+ */
+class CFunctionCompositor final : public ICompositor
+{
+public:
+    using CompositeFunction = std::function<void(const MappedSurfaceBuffer&, const std::vector<SurfaceRect>&)>;
+    using ResizeFunction = std::function<void(std::uint32_t, std::uint32_t)>;
+
+private:
+    CompositorKind m_kind;
+    CompositeFunction m_composite;
+    ResizeFunction m_resize;
+
+public:
+    CFunctionCompositor(CompositorKind kind, CompositeFunction composite, ResizeFunction resize = {})
+        : m_kind{kind}, m_composite{std::move(composite)}, m_resize{std::move(resize)}
+    {
+    }
+    ~CFunctionCompositor() override = default;
+
+    auto GetKind() const noexcept
+        -> CompositorKind override
+    {
+        return m_kind;
+    }
+    void Resize(std::uint32_t width, std::uint32_t height) override
+    {
+        if (m_resize)
+        {
+            m_resize(width, height);
+        }
+    }
+    void Composite(const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects) override
+    {
+        m_composite(source, updated_rects);
+    }
+};
@@ -0,0 +1,56 @@
+#include "CompositorCostModel.h"
+#include <algorithm>
+
+auto CompositorCostModel::Calibrate(const MeasureFunction& measure, const CompositorCalibrationConfig& config)
+    -> CompositorCost
+{
+    const auto small_width = config.m_small_width;
+    const auto small_height = config.m_small_height;
+    const auto large_width = small_width * config.m_large_scale;
+    const auto large_height = small_height * config.m_large_scale;
+    const auto draw_count = (std::max)(2u, config.m_draw_count);
+    const auto small_pixel_count = static_cast<double>(small_width) * small_height;
+    const auto large_pixel_count = static_cast<double>(large_width) * large_height;
+
+    const auto small_us = measure(small_width, small_height, 1);
+    const auto large_us = measure(large_width, large_height, 1);
+    const auto multi_draw_us = measure(small_width, small_height, draw_count);
+
+    // 测量有噪声，解出的参数可能为负，按0处理
+    CompositorCost result{};
+    result.m_per_pixel_us = (std::max)(0.0, (large_us - small_us) / (large_pixel_count - small_pixel_count));
+    result.m_per_draw_us = (std::max)(0.0, (multi_draw_us - small_us) / (draw_count - 1) - result.m_per_pixel_us * small_pixel_count);
+    result.m_fixed_us = (std::max)(0.0, small_us - result.m_per_draw_us - result.m_per_pixel_us * small_pixel_count);
+    return result;
+}
+
+CCompositorSelector::CCompositorSelector(const CompositorCost& cpu_cost, const CompositorCost& gpu_cost, double hysteresis)
+    : m_cpu_cost{cpu_cost}, m_gpu_cost{gpu_cost}, m_hysteresis{hysteresis}
+{
+}
+
+auto CCompositorSelector::Select(std::uint32_t width, std::uint32_t height, std::uint32_t draw_count)
+    -> CompositorKind
+{
+    const auto pixel_count = static_cast<std::uint64_t>(width) * height;
+    const auto other_kind = m_current_kind == CompositorKind::Cpu ? CompositorKind::D3D11 : CompositorKind::Cpu;
+    const auto current_us = GetCost(m_current_kind).EstimateMicroseconds(pixel_count, draw_count);
+    const auto other_us = GetCost(other_kind).EstimateMicroseconds(pixel_count, draw_count);
+    if (other_us * (1.0 + m_hysteresis) < current_us)
+    {
+        m_current_kind = other_kind;
+    }
+    return m_current_kind;
+}
+
+auto CCompositorSelector::GetCurrentKind() const noexcept
+    -> CompositorKind
+{
+    return m_current_kind;
+}
+
+auto CCompositorSelector::GetCost(CompositorKind kind) const noexcept
+    -> const CompositorCost&
+{
+    return kind == CompositorKind::Cpu ? m_cpu_cost : m_gpu_cost;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include "Compositor.h"
+
+/**
+ * @brief 合成一帧的线性耗时模型：fixed + draw_count * (per_draw + per_pixel * pixel_count)，单位为微秒
+ */
+struct CompositorCost
+{
+    double m_fixed_us{};
+    double m_per_draw_us{};
+    double m_per_pixel_us{};
+
+    constexpr auto EstimateMicroseconds(std::uint64_t pixel_count, std::uint32_t draw_count) const noexcept
+        -> double
+    {
+        return m_fixed_us + draw_count * (m_per_draw_us + m_per_pixel_us * static_cast<double>(pixel_count));
+    }
+};
+
+struct CompositorCalibrationConfig
+{
+    std::uint32_t m_small_width{350};
+    std::uint32_t m_small_height{100};
+    /**
+     * @brief 大尺寸的宽高是小尺寸的倍数
+     */
+    std::uint32_t m_large_scale{4};
+    std::uint32_t m_draw_count{8};
+};
+
+namespace CompositorCostModel
+{
+    /**
+     * @brief 测量合成一帧耗时的函数，参数为宽、高、绘制次数，返回微秒
+     */
+    using MeasureFunction = std::function<double(std::uint32_t, std::uint32_t, std::uint32_t)>;
+
+    /**
+     * @brief 测量小尺寸单次绘制、大尺寸单次绘制、小尺寸多次绘制三个点，解出线性模型的三个参数
+     */
+    auto Calibrate(const MeasureFunction& measure, const CompositorCalibrationConfig& config = {})
+        -> CompositorCost;
+}
+
+/**
+ * @brief 按耗时模型为给定的表面尺寸选择更便宜的合成路径 \n
+ * 只有另一条路径便宜超过hysteresis比例时才切换，避免在临界尺寸附近来回切换
+ */
+class CCompositorSelector
+{
+private:
+    CompositorCost m_cpu_cost{};
+    CompositorCost m_gpu_cost{};
+    double m_hysteresis{};
+    CompositorKind m_current_kind{CompositorKind::D3D11};
+
+public:
+    CCompositorSelector(const CompositorCost& cpu_cost, const CompositorCost& gpu_cost, double hysteresis = 0.15);
+    ~CCompositorSelector() = default;
+
+    /**
+     * @brief 在表面尺寸或绘制次数改变时调用，返回选中的路径
+     */
+    auto Select(std::uint32_t width, std::uint32_t height, std::uint32_t draw_count = 1)
+        -> CompositorKind;
+    auto GetCurrentKind() const noexcept
+        -> CompositorKind;
+    auto GetCost(CompositorKind kind) const noexcept
+        -> const CompositorCost&;
+};
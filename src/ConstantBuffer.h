@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief HLSL常量缓冲区的打包规则：以16字节为一个寄存器，成员不能跨越寄存器边界， \n
+ * 超过16字节的成员（矩阵、float4数组）必须从寄存器边界开始，整体大小是16的倍数
+ */
+namespace HlslPacking
+{
+    constexpr std::size_t REGISTER_SIZE = 16;
+
+    constexpr bool IsMemberPacked(std::size_t offset, std::size_t size) noexcept
+    {
+        if (size > REGISTER_SIZE)
+        {
+            return offset % REGISTER_SIZE == 0;
+        }
+        return offset / REGISTER_SIZE == (offset + size - 1) / REGISTER_SIZE;
+    }
+    constexpr bool IsSizePacked(std::size_t size) noexcept
+    {
+        return size != 0 && size % REGISTER_SIZE == 0;
+    }
+}
+
+/**
+ * @brief 检查C++结构体的成员与HLSL cbuffer中同序声明的成员偏移一致 \n
+ * HLSL数组的每个元素独占一个寄存器，所以数组成员只能使用float4等16字节的元素类型
+ */
+#define HLSL_CHECK_PACKING(Type, member)                                                        \
+    static_assert(HlslPacking::IsMemberPacked(offsetof(Type, member), sizeof(Type::member)), \
+                  #Type "::" #member " crosses a 16-byte HLSL register boundary.")
+
+/**
+ * @brief 与类型无关的常量缓冲区数据，供上传方统一处理
+ */
+class CConstantBufferBase
+{
+private:
+    void* m_p_data;
+    std::size_t m_size;
+    bool m_is_dirty{true};
+
+protected:
+    CConstantBufferBase(void* p_data, std::size_t size) noexcept
+        : m_p_data{p_data}, m_size{size}
+    {
+    }
+    ~CConstantBufferBase() = default;
+
+    void* GetMutableData() noexcept
+    {
+        m_is_dirty = true;
+        return m_p_data;
+    }
+
+public:
+    CConstantBufferBase(const CConstantBufferBase&) = delete;
+    CConstantBufferBase& operator=(const CConstantBufferBase&) = delete;
+
+    auto GetData() const noexcept
+        -> const void*
+    {
+        return m_p_data;
+    }
+    auto GetSize() const noexcept
+        -> std::size_t
+    {
+        return m_size;
+    }
+    bool IsDirty() const noexcept
+    {
+        return m_is_dirty;
+    }
+    void MarkDirty() noexcept
+    {
+        m_is_dirty = true;
+    }
+    void ClearDirty() noexcept
+    {
+        m_is_dirty = false;
+    }
+};
+
+/**
+ * @brief 类型化的常量缓冲区，修改后标记为脏，由上传方在每帧绘制前统一写入GPU
+ *
+ * @tparam T 与HLSL cbuffer布局一致的结构体，成员应使用HLSL_CHECK_PACKING检查
+ */
+template <class T>
+class CConstantBuffer final : public CConstantBufferBase
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Constant buffer must be trivially copyable.");
+    static_assert(HlslPacking::IsSizePacked(sizeof(T)), "Size of constant buffer must be a multiple of 16 bytes.");
+
+private:
+    T m_value;
+
+public:
+    explicit CConstantBuffer(const T& value = {}) noexcept
+        : CConstantBufferBase{&m_value, sizeof(T)}, m_value{value}
+    {
+    }
+    ~CConstantBuffer() = default;
+
+    auto Get() const noexcept
+        -> const T&
+    {
+        return m_value;
+    }
+    /**
+     * @brief 获取可修改的引用并标记为脏
+     */
+    auto Edit() noexcept
+        -> T&
+    {
+        return *static_cast<T*>(GetMutableData());
+    }
+    /**
+     * @brief 只有内容确实改变时才标记为脏
+     */
+    void Set(const T& value) noexcept
+    {
+        if (std::memcmp(&m_value, &value, sizeof(T)) != 0)
+        {
+            Edit() = value;
+        }
+    }
+};
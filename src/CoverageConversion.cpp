@@ -0,0 +1,73 @@
+#include "CoverageConversion.h"
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DX11RENDERING2DDEMO_COVERAGE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    void ConvertRowScalar(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width) noexcept
+    {
+        for (std::uint32_t x = 0; x < width; ++x, p_source += 4)
+        {
+            p_target[x] = (std::max)({p_source[0], p_source[1], p_source[2]});
+        }
+    }
+
+#ifdef DX11RENDERING2DDEMO_COVERAGE_SSE2
+    /**
+     * @brief 4个像素的b、g、r最大值，结果位于每个32位元素的最低字节，其余字节为0
+     */
+    inline __m128i MaxOfColorChannels(__m128i pixels) noexcept
+    {
+        auto result = _mm_max_epu8(pixels, _mm_srli_epi32(pixels, 8));
+        result = _mm_max_epu8(result, _mm_srli_epi32(pixels, 16));
+        return _mm_and_si128(result, _mm_set1_epi32(0xFF));
+    }
+
+    void ConvertRowSse2(const std::uint8_t* p_source, std::uint8_t* p_target, std::uint32_t width) noexcept
+    {
+        std::uint32_t x = 0;
+        for (; x + 16 <= width; x += 16, p_source += 64)
+        {
+            const auto* p_source_vector = reinterpret_cast<const __m128i*>(p_source);
+            const auto coverage0 = MaxOfColorChannels(_mm_loadu_si128(p_source_vector + 0));
+            const auto coverage1 = MaxOfColorChannels(_mm_loadu_si128(p_source_vector + 1));
+            const auto coverage2 = MaxOfColorChannels(_mm_loadu_si128(p_source_vector + 2));
+            const auto coverage3 = MaxOfColorChannels(_mm_loadu_si128(p_source_vector + 3));
+            // 所有值都不超过255，有符号饱和打包不会改变数值
+            const auto coverage01 = _mm_packs_epi32(coverage0, coverage1);
+            const auto coverage23 = _mm_packs_epi32(coverage2, coverage3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p_target + x), _mm_packus_epi16(coverage01, coverage23));
+        }
+        ConvertRowScalar(p_source, p_target + x, width - x);
+    }
+#endif
+}
+
+void CoverageConversion::ConvertBgraToCoverageScalar(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height) noexcept
+{
+    for (std::uint32_t y = 0; y < height; ++y)
+    {
+        ConvertRowScalar(p_source + static_cast<std::size_t>(y) * source_row_pitch,
+                         p_target + static_cast<std::size_t>(y) * target_row_pitch,
+                         width);
+    }
+}
+
+void CoverageConversion::ConvertBgraToCoverage(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height) noexcept
+{
+#ifdef DX11RENDERING2DDEMO_COVERAGE_SSE2
+    for (std::uint32_t y = 0; y < height; ++y)
+    {
+        ConvertRowSse2(p_source + static_cast<std::size_t>(y) * source_row_pitch,
+                       p_target + static_cast<std::size_t>(y) * target_row_pitch,
+                       width);
+    }
+#else
+    ConvertBgraToCoverageScalar(p_source, source_row_pitch, p_target, target_row_pitch, width, height);
+#endif
+}
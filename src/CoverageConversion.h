@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief 把GDI输出的BGRA像素转换为覆盖率 \n
+ * GDI在黑色背景上以单色绘制文字，覆盖率取b、g、r三者的最大值，GDI不写入的alpha被忽略
+ */
+namespace CoverageConversion
+{
+    /**
+     * @brief 逐像素的参考实现
+     */
+    void ConvertBgraToCoverageScalar(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height) noexcept;
+    /**
+     * @brief 在支持SSE2时每次处理16个像素，结果与ConvertBgraToCoverageScalar完全一致
+     */
+    void ConvertBgraToCoverage(const std::uint8_t* p_source, std::uint32_t source_row_pitch, std::uint8_t* p_target, std::uint32_t target_row_pitch, std::uint32_t width, std::uint32_t height) noexcept;
+}
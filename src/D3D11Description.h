@@ -0,0 +1,130 @@
+#pragma once
+#include <cfloat>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <d3d11.h>
+#include "GpuResourceDescription.h"
+
+/**
+ * @brief 把与平台无关的描述转换为D3D11的描述，资源清单和帧跟踪回放共用 \n
+ * 描述中没有的字段取本项目使用的固定值：采样器钳位寻址，光栅化实心填充、剔除背面，深度比较LESS，模板操作KEEP
+ */
+namespace D3D11Description
+{
+    inline auto From(const GpuBufferDescription& description) noexcept
+        -> D3D11_BUFFER_DESC
+    {
+        D3D11_BUFFER_DESC result{};
+        result.ByteWidth = description.m_byte_width;
+        result.Usage = static_cast<D3D11_USAGE>(description.m_usage);
+        result.BindFlags = description.m_bind_flags;
+        result.CPUAccessFlags = description.m_cpu_access_flags;
+        return result;
+    }
+
+    inline auto From(const GpuTexture2DDescription& description) noexcept
+        -> D3D11_TEXTURE2D_DESC
+    {
+        D3D11_TEXTURE2D_DESC result{};
+        result.Width = description.m_width;
+        result.Height = description.m_height;
+        result.MipLevels = description.m_mip_levels;
+        result.ArraySize = description.m_array_size;
+        result.Format = static_cast<DXGI_FORMAT>(description.m_format);
+        result.SampleDesc.Count = description.m_sample_count;
+        result.Usage = static_cast<D3D11_USAGE>(description.m_usage);
+        result.BindFlags = description.m_bind_flags;
+        result.CPUAccessFlags = description.m_cpu_access_flags;
+        return result;
+    }
+
+    inline auto From(const GpuSamplerDescription& description) noexcept
+        -> D3D11_SAMPLER_DESC
+    {
+        D3D11_SAMPLER_DESC result{};
+        result.Filter = static_cast<D3D11_FILTER>(description.m_filter);
+        result.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+        result.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+        result.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+        result.MaxAnisotropy = description.m_max_anisotropy;
+        result.ComparisonFunc = D3D11_COMPARISON_NEVER;
+        result.MinLOD = -FLT_MAX;
+        result.MaxLOD = FLT_MAX;
+        return result;
+    }
+
+    inline auto From(const GpuBlendDescription& description) noexcept
+        -> D3D11_BLEND_DESC
+    {
+        D3D11_BLEND_DESC result{};
+        auto& render_target = result.RenderTarget[0];
+        render_target.BlendEnable = description.m_is_blend_enabled ? TRUE : FALSE;
+        render_target.SrcBlend = static_cast<D3D11_BLEND>(description.m_source_blend);
+        render_target.DestBlend = static_cast<D3D11_BLEND>(description.m_destination_blend);
+        render_target.BlendOp = static_cast<D3D11_BLEND_OP>(description.m_blend_operation);
+        render_target.SrcBlendAlpha = static_cast<D3D11_BLEND>(description.m_source_alpha_blend);
+        render_target.DestBlendAlpha = static_cast<D3D11_BLEND>(description.m_destination_alpha_blend);
+        render_target.BlendOpAlpha = static_cast<D3D11_BLEND_OP>(description.m_alpha_blend_operation);
+        render_target.RenderTargetWriteMask = description.m_write_mask;
+        return result;
+    }
+
+    inline auto From(const GpuRasterizerDescription& description) noexcept
+        -> D3D11_RASTERIZER_DESC
+    {
+        D3D11_RASTERIZER_DESC result{};
+        result.FillMode = D3D11_FILL_SOLID;
+        result.CullMode = D3D11_CULL_BACK;
+        result.DepthClipEnable = description.m_is_depth_clip_enabled ? TRUE : FALSE;
+        result.ScissorEnable = description.m_is_scissor_enabled ? TRUE : FALSE;
+        return result;
+    }
+
+    inline auto From(const GpuDepthStencilDescription& description) noexcept
+        -> D3D11_DEPTH_STENCIL_DESC
+    {
+        D3D11_DEPTH_STENCIL_DESC result{};
+        result.DepthEnable = description.m_is_depth_enabled ? TRUE : FALSE;
+        result.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+        result.DepthFunc = D3D11_COMPARISON_LESS;
+        result.StencilEnable = description.m_is_stencil_enabled ? TRUE : FALSE;
+        result.StencilReadMask = D3D11_DEFAULT_STENCIL_READ_MASK;
+        result.StencilWriteMask = D3D11_DEFAULT_STENCIL_WRITE_MASK;
+        const D3D11_DEPTH_STENCILOP_DESC stencil_op{D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_COMPARISON_ALWAYS};
+        result.FrontFace = stencil_op;
+        result.BackFace = stencil_op;
+        return result;
+    }
+
+    /**
+     * @brief 语义名指向elements中的字符串，elements必须比结果存活得更久
+     */
+    inline auto From(std::span<const GpuInputElementDescription> elements)
+        -> std::vector<D3D11_INPUT_ELEMENT_DESC>
+    {
+        std::vector<D3D11_INPUT_ELEMENT_DESC> result(elements.size());
+        for (std::size_t i = 0; i < elements.size(); ++i)
+        {
+            result[i].SemanticName = elements[i].m_p_semantic_name;
+            result[i].SemanticIndex = elements[i].m_semantic_index;
+            result[i].Format = static_cast<DXGI_FORMAT>(elements[i].m_format);
+            result[i].InputSlot = elements[i].m_input_slot;
+            result[i].AlignedByteOffset = elements[i].m_aligned_byte_offset;
+            result[i].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+        }
+        return result;
+    }
+
+    inline auto From(std::span<const GpuSubresourceData> subresources)
+        -> std::vector<D3D11_SUBRESOURCE_DATA>
+    {
+        std::vector<D3D11_SUBRESOURCE_DATA> result(subresources.size());
+        for (std::size_t i = 0; i < subresources.size(); ++i)
+        {
+            result[i].pSysMem = subresources[i].m_p_data;
+            result[i].SysMemPitch = subresources[i].m_row_pitch;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,79 @@
+#include "DeviceContextCounters.h"
+
+auto GetContextCallCategoryName(ContextCallCategory category) noexcept
+    -> const char*
+{
+    switch (category)
+    {
+    case ContextCallCategory::Draw:
+        return "draw";
+    case ContextCallCategory::ShaderBind:
+        return "shader bind";
+    case ContextCallCategory::StateBind:
+        return "state bind";
+    case ContextCallCategory::ResourceBind:
+        return "resource bind";
+    case ContextCallCategory::Upload:
+        return "upload";
+    case ContextCallCategory::Other:
+        return "other";
+    }
+    return "unknown";
+}
+
+auto ContextFrameCounters::GetTotalCpuNanoseconds() const noexcept
+    -> std::uint64_t
+{
+    std::uint64_t result = 0;
+    for (const auto& category : m_categories)
+    {
+        result += category.m_cpu_ns;
+    }
+    return result;
+}
+
+void CContextFrameRing::Push(const ContextFrameCounters& frame) noexcept
+{
+    m_frames[m_next] = frame;
+    m_next = (m_next + 1) % CAPACITY;
+    if (m_count < CAPACITY)
+    {
+        ++m_count;
+    }
+}
+
+auto CContextFrameRing::GetCount() const noexcept
+    -> std::size_t
+{
+    return m_count;
+}
+
+auto CContextFrameRing::GetFrame(std::size_t age) const noexcept
+    -> const ContextFrameCounters&
+{
+    return m_frames[(m_next + CAPACITY - 1 - age) % CAPACITY];
+}
+
+auto CContextFrameRing::Sum() const noexcept
+    -> ContextFrameCounters
+{
+    ContextFrameCounters result{};
+    for (std::size_t age = 0; age < m_count; ++age)
+    {
+        const auto& frame = GetFrame(age);
+        for (std::size_t i = 0; i < CONTEXT_CALL_CATEGORY_COUNT; ++i)
+        {
+            result.m_categories[i].m_call_count += frame.m_categories[i].m_call_count;
+            result.m_categories[i].m_cpu_ns += frame.m_categories[i].m_cpu_ns;
+        }
+        result.m_shader_switch_count += frame.m_shader_switch_count;
+        result.m_redundant_shader_bind_count += frame.m_redundant_shader_bind_count;
+        result.m_index_count += frame.m_index_count;
+        result.m_uploaded_bytes += frame.m_uploaded_bytes;
+    }
+    if (m_count != 0)
+    {
+        result.m_frame_index = GetFrame(0).m_frame_index;
+    }
+    return result;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum class ContextCallCategory : std::uint8_t
+{
+    /**
+     * @brief Draw、DrawIndexed等绘制调用
+     */
+    Draw,
+    /**
+     * @brief 绑定着色器
+     */
+    ShaderBind,
+    /**
+     * @brief 绑定图元拓扑、输入布局、视口、光栅化/混合/深度模板状态和采样器
+     */
+    StateBind,
+    /**
+     * @brief 绑定顶点/索引/常量缓冲、着色器资源视图和渲染目标
+     */
+    ResourceBind,
+    /**
+     * @brief UpdateSubresource、Map/Unmap和资源间复制
+     */
+    Upload,
+    /**
+     * @brief Flush、查询和清除
+     */
+    Other,
+};
+
+constexpr std::size_t CONTEXT_CALL_CATEGORY_COUNT = 6;
+
+auto GetContextCallCategoryName(ContextCallCategory category) noexcept
+    -> const char*;
+
+struct ContextCategoryCounters
+{
+    std::uint32_t m_call_count{};
+    /**
+     * @brief 调用在CPU上花费的时间之和
+     */
+    std::uint64_t m_cpu_ns{};
+};
+
+struct ContextFrameCounters
+{
+    std::uint64_t m_frame_index{};
+    std::array<ContextCategoryCounters, CONTEXT_CALL_CATEGORY_COUNT> m_categories{};
+    /**
+     * @brief 绑定了与该阶段当前着色器不同的着色器的次数
+     */
+    std::uint32_t m_shader_switch_count{};
+    /**
+     * @brief 重复绑定同一个着色器的次数
+     */
+    std::uint32_t m_redundant_shader_bind_count{};
+    std::uint64_t m_index_count{};
+    std::uint64_t m_uploaded_bytes{};
+
+    auto GetCategory(ContextCallCategory category) const noexcept
+        -> const ContextCategoryCounters&
+    {
+        return m_categories[static_cast<std::size_t>(category)];
+    }
+    auto GetTotalCpuNanoseconds() const noexcept
+        -> std::uint64_t;
+};
+
+/**
+ * @brief 保存最近CAPACITY帧计数的环，写满后覆盖最早的帧，不分配内存
+ */
+class CContextFrameRing
+{
+public:
+    constexpr static std::size_t CAPACITY = 128;
+
+private:
+    std::array<ContextFrameCounters, CAPACITY> m_frames{};
+    std::size_t m_next{};
+    std::size_t m_count{};
+
+public:
+    void Push(const ContextFrameCounters& frame) noexcept;
+    auto GetCount() const noexcept
+        -> std::size_t;
+    /**
+     * @brief age为0时是最近一帧，必须小于GetCount()
+     */
+    auto GetFrame(std::size_t age) const noexcept
+        -> const ContextFrameCounters&;
+    /**
+     * @brief 环中全部帧的计数之和，m_frame_index为最近一帧的序号
+     */
+    auto Sum() const noexcept
+        -> ContextFrameCounters;
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief 64位绘制排序键，从高位到低位： \n
+ * 不透明：layer(8) | 0(1) | shader(12) | texture(16) | state(12) | sequence(15) \n
+ * 半透明：layer(8) | 1(1) | sequence(15) | shader(12) | texture(16) | state(12) \n
+ * layer是不可跨越的顺序约束；不透明绘制在层内按状态聚合，半透明绘制在层内保持提交顺序
+ */
+namespace DrawSortKey
+{
+    constexpr std::uint32_t LAYER_BITS = 8;
+    constexpr std::uint32_t SHADER_BITS = 12;
+    constexpr std::uint32_t TEXTURE_BITS = 16;
+    constexpr std::uint32_t STATE_BITS = 12;
+    constexpr std::uint32_t SEQUENCE_BITS = 15;
+
+    constexpr std::uint32_t MAX_LAYER = (1u << LAYER_BITS) - 1;
+    constexpr std::uint32_t MAX_SHADER = (1u << SHADER_BITS) - 1;
+    constexpr std::uint32_t MAX_TEXTURE = (1u << TEXTURE_BITS) - 1;
+    constexpr std::uint32_t MAX_STATE = (1u << STATE_BITS) - 1;
+    constexpr std::uint32_t MAX_SEQUENCE = (1u << SEQUENCE_BITS) - 1;
+
+    static_assert(LAYER_BITS + 1 + SHADER_BITS + TEXTURE_BITS + STATE_BITS + SEQUENCE_BITS == 64);
+
+    struct Fields
+    {
+        std::uint32_t m_layer{};
+        bool m_is_translucent{};
+        std::uint32_t m_shader{};
+        std::uint32_t m_texture{};
+        std::uint32_t m_state{};
+        std::uint32_t m_sequence{};
+    };
+
+    constexpr std::uint64_t Pack(const Fields& fields) noexcept
+    {
+        const std::uint64_t layer = fields.m_layer & MAX_LAYER;
+        const std::uint64_t shader = fields.m_shader & MAX_SHADER;
+        const std::uint64_t texture = fields.m_texture & MAX_TEXTURE;
+        const std::uint64_t state = fields.m_state & MAX_STATE;
+        const std::uint64_t sequence = fields.m_sequence & MAX_SEQUENCE;
+        std::uint64_t result = layer << (64 - LAYER_BITS);
+        if (fields.m_is_translucent)
+        {
+            result |= std::uint64_t{1} << (63 - LAYER_BITS);
+            result |= sequence << (SHADER_BITS + TEXTURE_BITS + STATE_BITS);
+            result |= shader << (TEXTURE_BITS + STATE_BITS);
+            result |= texture << STATE_BITS;
+            result |= state;
+        }
+        else
+        {
+            result |= shader << (TEXTURE_BITS + STATE_BITS + SEQUENCE_BITS);
+            result |= texture << (STATE_BITS + SEQUENCE_BITS);
+            result |= state << SEQUENCE_BITS;
+            result |= sequence;
+        }
+        return result;
+    }
+
+    constexpr auto Unpack(std::uint64_t key) noexcept
+        -> Fields
+    {
+        Fields result{};
+        result.m_layer = static_cast<std::uint32_t>(key >> (64 - LAYER_BITS));
+        result.m_is_translucent = ((key >> (63 - LAYER_BITS)) & 1) != 0;
+        if (result.m_is_translucent)
+        {
+            result.m_sequence = static_cast<std::uint32_t>(key >> (SHADER_BITS + TEXTURE_BITS + STATE_BITS)) & MAX_SEQUENCE;
+            result.m_shader = static_cast<std::uint32_t>(key >> (TEXTURE_BITS + STATE_BITS)) & MAX_SHADER;
+            result.m_texture = static_cast<std::uint32_t>(key >> STATE_BITS) & MAX_TEXTURE;
+            result.m_state = static_cast<std::uint32_t>(key) & MAX_STATE;
+        }
+        else
+        {
+            result.m_shader = static_cast<std::uint32_t>(key >> (TEXTURE_BITS + STATE_BITS + SEQUENCE_BITS)) & MAX_SHADER;
+            result.m_texture = static_cast<std::uint32_t>(key >> (STATE_BITS + SEQUENCE_BITS)) & MAX_TEXTURE;
+            result.m_state = static_cast<std::uint32_t>(key >> SEQUENCE_BITS) & MAX_STATE;
+            result.m_sequence = static_cast<std::uint32_t>(key) & MAX_SEQUENCE;
+        }
+        return result;
+    }
+
+    static_assert(Unpack(Pack({3, false, 7, 9, 11, 13})).m_texture == 9);
+    static_assert(Unpack(Pack({3, true, 7, 9, 11, 13})).m_sequence == 13);
+    static_assert(Pack({0, true, 0, 0, 0, 0}) > Pack({0, false, MAX_SHADER, MAX_TEXTURE, MAX_STATE, MAX_SEQUENCE}));
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief 按帧递增的栅栏：每帧结束时Signal一次，GPU执行到该位置后GetCompletedValue随之增加
+ */
+class IFrameFence
+{
+public:
+    virtual ~IFrameFence() = default;
+
+    /**
+     * @brief 下一次Signal将会使用的值，也就是当前正在录制的帧的栅栏值
+     */
+    virtual auto GetNextValue() const noexcept
+        -> std::uint64_t = 0;
+    /**
+     * @brief 在命令流中插入栅栏，返回插入的值
+     */
+    virtual auto Signal()
+        -> std::uint64_t = 0;
+    /**
+     * @brief GPU已经执行完成的最大栅栏值，从未完成过时为0
+     */
+    virtual auto GetCompletedValue()
+        -> std::uint64_t = 0;
+};
+
+/**
+ * @brief 由调用者手动推进的CPU栅栏，用于测试和没有GPU的后端
+ */
+class CCpuFrameFence final : public IFrameFence
+{
+private:
+    std::atomic<std::uint64_t> m_next_value{1};
+    std::atomic<std::uint64_t> m_completed_value{0};
+
+public:
+    CCpuFrameFence() = default;
+    ~CCpuFrameFence() override = default;
+
+    auto GetNextValue() const noexcept
+        -> std::uint64_t override
+    {
+        return m_next_value.load(std::memory_order_acquire);
+    }
+    auto Signal()
+        -> std::uint64_t override
+    {
+        return m_next_value.fetch_add(1, std::memory_order_acq_rel);
+    }
+    auto GetCompletedValue()
+        -> std::uint64_t override
+    {
+        return m_completed_value.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 模拟GPU执行到value为止的所有栅栏，value不会超过已Signal的值
+     */
+    void Complete(std::uint64_t value) noexcept
+    {
+        const auto last_signaled_value = m_next_value.load(std::memory_order_acquire) - 1;
+        value = value < last_signaled_value ? value : last_signaled_value;
+        auto completed_value = m_completed_value.load(std::memory_order_acquire);
+        while (completed_value < value && !m_completed_value.compare_exchange_weak(completed_value, value, std::memory_order_acq_rel))
+        {
+        }
+    }
+    /**
+     * @brief 模拟GPU执行完所有已Signal的栅栏
+     */
+    void CompleteAll() noexcept
+    {
+        Complete(m_next_value.load(std::memory_order_acquire) - 1);
+    }
+};
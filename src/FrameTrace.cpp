@@ -0,0 +1,763 @@
+#include "FrameTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::size_t SECTION_ALIGNMENT = 16;
+    constexpr std::uint64_t COMMANDS_OFFSET = 64;
+
+    static_assert(static_cast<std::size_t>(FrameTraceOpcode::Flush) + 1 == FRAME_TRACE_OPCODE_COUNT);
+    static_assert(sizeof(FrameTraceHeader) <= COMMANDS_OFFSET);
+
+    constexpr auto AlignUp(std::uint64_t value, std::uint64_t alignment) noexcept
+        -> std::uint64_t
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    auto GetMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept
+        -> std::uint32_t
+    {
+        std::uint32_t count = 1;
+        for (auto size = (std::max)(width, height); size > 1; size /= 2)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    template <class T>
+    auto ReadBlob(std::span<const std::uint8_t> blob, std::size_t offset = 0)
+        -> T
+    {
+        if (offset + sizeof(T) > blob.size())
+        {
+            throw std::runtime_error{"Frame trace command data is truncated."};
+        }
+        T value{};
+        std::memcpy(&value, blob.data() + offset, sizeof(T));
+        return value;
+    }
+
+    auto GetIds(std::span<const std::uint8_t> blob, std::uint32_t count, std::size_t offset = 0)
+        -> std::span<const std::uint32_t>
+    {
+        if (offset + std::size_t{count} * sizeof(std::uint32_t) > blob.size())
+        {
+            throw std::runtime_error{"Frame trace command data is truncated."};
+        }
+        // 每个命令的数据按16字节对齐，其中的数组按4字节对齐
+        return {reinterpret_cast<const std::uint32_t*>(blob.data() + offset), count};
+    }
+
+    void Require(bool condition)
+    {
+        if (!condition)
+        {
+            throw std::runtime_error{"Frame trace command data is truncated."};
+        }
+    }
+
+    void Execute(const FrameTraceCommand& command, std::span<const std::uint8_t> blob, IFrameTraceBackend& backend)
+    {
+        const auto& arguments = command.m_arguments;
+        switch (command.m_opcode)
+        {
+        case FrameTraceOpcode::CreateBuffer:
+        {
+            const auto description = ReadBlob<GpuBufferDescription>(blob);
+            const auto* p_initial_data = blob.data() + sizeof(description);
+            Require(arguments[0] == 0 || blob.size() >= sizeof(description) + description.m_byte_width);
+            backend.CreateBuffer(command.m_object, description, arguments[0] != 0 ? p_initial_data : nullptr);
+            break;
+        }
+        case FrameTraceOpcode::CreateTexture2D:
+        {
+            const auto description = ReadBlob<GpuTexture2DDescription>(blob);
+            const auto bytes_per_pixel = GpuFormat::GetBytesPerPixel(description.m_format);
+            if (arguments[0] == 0 || bytes_per_pixel == 0)
+            {
+                backend.CreateTexture2D(command.m_object, description, nullptr);
+                break;
+            }
+            std::vector<GpuSubresourceData> initial_data{};
+            std::size_t offset = sizeof(description);
+            for (std::uint32_t slice = 0; slice < description.m_array_size; ++slice)
+            {
+                for (std::uint32_t mip = 0; mip < description.m_mip_levels; ++mip)
+                {
+                    const auto row_pitch = (std::max)(description.m_width >> mip, 1u) * bytes_per_pixel;
+                    const auto height = (std::max)(description.m_height >> mip, 1u);
+                    Require(offset + std::size_t{row_pitch} * height <= blob.size());
+                    initial_data.push_back({blob.data() + offset, row_pitch});
+                    offset += std::size_t{row_pitch} * height;
+                }
+            }
+            backend.CreateTexture2D(command.m_object, description, initial_data.data());
+            break;
+        }
+        case FrameTraceOpcode::CreateView:
+            backend.CreateView(command.m_object, static_cast<MockObjectType>(arguments[0]), arguments[1]);
+            break;
+        case FrameTraceOpcode::CreateShader:
+            backend.CreateShader(command.m_object, static_cast<MockObjectType>(arguments[0]), blob);
+            break;
+        case FrameTraceOpcode::CreateInputLayout:
+        {
+            const auto element_count = arguments[0];
+            Require(std::size_t{element_count} * sizeof(FrameTraceInputElement) <= blob.size());
+            Require(std::size_t{arguments[1]} + arguments[2] <= blob.size());
+            std::vector<GpuInputElementDescription> elements(element_count);
+            for (std::uint32_t i = 0; i < element_count; ++i)
+            {
+                const auto element = ReadBlob<FrameTraceInputElement>(blob, i * sizeof(FrameTraceInputElement));
+                Require(element.m_semantic_name_offset < blob.size() &&
+                        std::find(blob.begin() + element.m_semantic_name_offset, blob.end(), std::uint8_t{0}) != blob.end());
+                elements[i].m_p_semantic_name = reinterpret_cast<const char*>(blob.data() + element.m_semantic_name_offset);
+                elements[i].m_semantic_index = element.m_semantic_index;
+                elements[i].m_format = element.m_format;
+                elements[i].m_input_slot = element.m_input_slot;
+                elements[i].m_aligned_byte_offset = element.m_aligned_byte_offset;
+            }
+            backend.CreateInputLayout(command.m_object, elements, blob.subspan(arguments[1], arguments[2]));
+            break;
+        }
+        case FrameTraceOpcode::CreateSamplerState:
+            backend.CreateSamplerState(command.m_object, ReadBlob<GpuSamplerDescription>(blob));
+            break;
+        case FrameTraceOpcode::CreateBlendState:
+            backend.CreateBlendState(command.m_object, ReadBlob<GpuBlendDescription>(blob));
+            break;
+        case FrameTraceOpcode::CreateRasterizerState:
+            backend.CreateRasterizerState(command.m_object, ReadBlob<GpuRasterizerDescription>(blob));
+            break;
+        case FrameTraceOpcode::CreateDepthStencilState:
+            backend.CreateDepthStencilState(command.m_object, ReadBlob<GpuDepthStencilDescription>(blob));
+            break;
+        case FrameTraceOpcode::BeginFrame:
+            break;
+        case FrameTraceOpcode::IASetPrimitiveTopology:
+            backend.IASetPrimitiveTopology(arguments[0]);
+            break;
+        case FrameTraceOpcode::IASetInputLayout:
+            backend.IASetInputLayout(command.m_object);
+            break;
+        case FrameTraceOpcode::IASetVertexBuffers:
+        {
+            const auto count = arguments[1];
+            const auto buffers = GetIds(blob, count);
+            const auto strides = GetIds(blob, count, sizeof(std::uint32_t) * count);
+            const auto offsets = GetIds(blob, count, sizeof(std::uint32_t) * count * 2);
+            backend.IASetVertexBuffers(arguments[0], buffers, strides.data(), offsets.data());
+            break;
+        }
+        case FrameTraceOpcode::IASetIndexBuffer:
+            backend.IASetIndexBuffer(command.m_object, arguments[0], arguments[1]);
+            break;
+        case FrameTraceOpcode::VSSetShader:
+            backend.SetShader(MockObjectType::VertexShader, command.m_object);
+            break;
+        case FrameTraceOpcode::GSSetShader:
+            backend.SetShader(MockObjectType::GeometryShader, command.m_object);
+            break;
+        case FrameTraceOpcode::PSSetShader:
+            backend.SetShader(MockObjectType::PixelShader, command.m_object);
+            break;
+        case FrameTraceOpcode::VSSetConstantBuffers:
+        case FrameTraceOpcode::PSSetConstantBuffers:
+        case FrameTraceOpcode::PSSetShaderResources:
+        case FrameTraceOpcode::PSSetSamplers:
+            backend.SetObjects(command.m_opcode, arguments[0], GetIds(blob, arguments[1]));
+            break;
+        case FrameTraceOpcode::RSSetState:
+            backend.RSSetState(command.m_object);
+            break;
+        case FrameTraceOpcode::RSSetViewports:
+        {
+            Require(std::size_t{arguments[0]} * sizeof(MockViewport) <= blob.size());
+            backend.RSSetViewports({reinterpret_cast<const MockViewport*>(blob.data()), arguments[0]});
+            break;
+        }
+        case FrameTraceOpcode::OMSetBlendState:
+        {
+            const auto blend_factor = ReadBlob<std::array<float, 4>>(blob);
+            backend.OMSetBlendState(command.m_object, blend_factor.data(), arguments[0]);
+            break;
+        }
+        case FrameTraceOpcode::OMSetDepthStencilState:
+            backend.OMSetDepthStencilState(command.m_object, arguments[0]);
+            break;
+        case FrameTraceOpcode::OMSetRenderTargets:
+            backend.OMSetRenderTargets(GetIds(blob, arguments[0]), arguments[1]);
+            break;
+        case FrameTraceOpcode::SOSetTargets:
+            backend.SOSetTargets(arguments[0]);
+            break;
+        case FrameTraceOpcode::Draw:
+            backend.Draw(arguments[0], arguments[1]);
+            break;
+        case FrameTraceOpcode::DrawIndexed:
+            backend.DrawIndexed(arguments[0], arguments[1], static_cast<std::int32_t>(arguments[2]));
+            break;
+        case FrameTraceOpcode::UpdateSubresource:
+        {
+            const auto box = ReadBlob<MockBox>(blob);
+            Require(box.bottom <= box.top || blob.size() >= sizeof(MockBox) + std::size_t{arguments[1]} * (box.bottom - box.top));
+            backend.UpdateSubresource(command.m_object, arguments[0], arguments[2] != 0 ? &box : nullptr, blob.data() + sizeof(MockBox), arguments[1]);
+            break;
+        }
+        case FrameTraceOpcode::MapAndUnmap:
+            backend.MapAndUnmap(command.m_object, arguments[0], arguments[1], blob.empty() ? nullptr : blob.data(), arguments[2], static_cast<std::uint32_t>(blob.size()));
+            break;
+        case FrameTraceOpcode::CopyResource:
+            backend.CopyResource(command.m_object, arguments[0]);
+            break;
+        case FrameTraceOpcode::ClearRenderTargetView:
+        {
+            const auto color = ReadBlob<std::array<float, 4>>(blob);
+            backend.ClearRenderTargetView(command.m_object, color.data());
+            break;
+        }
+        case FrameTraceOpcode::Flush:
+            backend.Flush();
+            break;
+        }
+    }
+}
+
+auto GetFrameTraceOpcodeName(FrameTraceOpcode opcode) noexcept
+    -> const char*
+{
+    constexpr std::array<const char*, FRAME_TRACE_OPCODE_COUNT> NAMES{
+        "CreateBuffer",
+        "CreateTexture2D",
+        "CreateView",
+        "CreateShader",
+        "CreateInputLayout",
+        "CreateSamplerState",
+        "CreateBlendState",
+        "CreateRasterizerState",
+        "CreateDepthStencilState",
+        "BeginFrame",
+        "IASetPrimitiveTopology",
+        "IASetInputLayout",
+        "IASetVertexBuffers",
+        "IASetIndexBuffer",
+        "VSSetShader",
+        "GSSetShader",
+        "PSSetShader",
+        "VSSetConstantBuffers",
+        "PSSetConstantBuffers",
+        "PSSetShaderResources",
+        "PSSetSamplers",
+        "RSSetState",
+        "RSSetViewports",
+        "OMSetBlendState",
+        "OMSetDepthStencilState",
+        "OMSetRenderTargets",
+        "SOSetTargets",
+        "Draw",
+        "DrawIndexed",
+        "UpdateSubresource",
+        "MapAndUnmap",
+        "CopyResource",
+        "ClearRenderTargetView",
+        "Flush"};
+    const auto index = static_cast<std::size_t>(opcode);
+    return index < NAMES.size() ? NAMES[index] : "Unknown";
+}
+
+auto CFrameTraceWriter::AddCommand(FrameTraceOpcode opcode, std::uint32_t object, std::array<std::uint32_t, 4> arguments)
+    -> FrameTraceCommand&
+{
+    // 每个命令的数据从16字节边界开始，回放时可以直接按数组读取
+    m_blob.resize(AlignUp(m_blob.size(), SECTION_ALIGNMENT));
+    auto& command = m_commands.emplace_back();
+    command.m_opcode = opcode;
+    command.m_object = object;
+    command.m_arguments = arguments;
+    command.m_blob_offset = m_blob.size();
+    m_statistics.m_command_count = static_cast<std::uint32_t>(m_commands.size());
+    return command;
+}
+
+void CFrameTraceWriter::AppendBlob(const void* p_data, std::size_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    const auto* p_bytes = static_cast<const std::uint8_t*>(p_data);
+    if (p_bytes == nullptr)
+    {
+        m_blob.resize(m_blob.size() + size);
+    }
+    else
+    {
+        m_blob.insert(m_blob.end(), p_bytes, p_bytes + size);
+    }
+    m_commands.back().m_blob_size += static_cast<std::uint32_t>(size);
+    m_statistics.m_blob_bytes = m_blob.size();
+}
+
+auto CFrameTraceWriter::AddObject(const void* p_object, MockObjectType type)
+    -> ObjectInfo&
+{
+    if (p_object == nullptr)
+    {
+        throw std::invalid_argument{"Traced object must not be null."};
+    }
+    // 对象释放后地址可能被新对象复用，按新对象重新编号
+    auto& info = m_objects[p_object];
+    info = {};
+    info.m_id = ++m_statistics.m_object_count;
+    info.m_type = type;
+    return info;
+}
+
+auto CFrameTraceWriter::GetObjectId(const void* p_object)
+    -> std::uint32_t
+{
+    if (p_object == nullptr)
+    {
+        return 0;
+    }
+    auto [iterator, is_inserted] = m_objects.try_emplace(p_object);
+    if (is_inserted)
+    {
+        iterator->second.m_id = ++m_statistics.m_object_count;
+        ++m_statistics.m_unknown_object_count;
+    }
+    return iterator->second.m_id;
+}
+
+auto CFrameTraceWriter::FindObject(const void* p_object) const noexcept
+    -> const ObjectInfo*
+{
+    const auto iterator = m_objects.find(p_object);
+    return iterator == m_objects.end() ? nullptr : &iterator->second;
+}
+
+auto CFrameTraceWriter::GetSubresourceExtent(const void* p_resource, std::uint32_t subresource) const noexcept
+    -> std::array<std::uint32_t, 2>
+{
+    const auto* p_info = FindObject(p_resource);
+    if (p_info == nullptr)
+    {
+        return {0, 0};
+    }
+    if (p_info->m_type == MockObjectType::Buffer)
+    {
+        return {p_info->m_buffer.m_byte_width, 1};
+    }
+    if (p_info->m_type != MockObjectType::Texture2D)
+    {
+        return {0, 0};
+    }
+    const auto& texture = p_info->m_texture;
+    const auto mip = subresource % texture.m_mip_levels;
+    return {(std::max)(texture.m_width >> mip, 1u) * GpuFormat::GetBytesPerPixel(texture.m_format), (std::max)(texture.m_height >> mip, 1u)};
+}
+
+void CFrameTraceWriter::AppendRows(const void* p_source, std::uint32_t source_row_pitch, std::uint32_t row_size, std::uint32_t row_count)
+{
+    const auto* p_bytes = static_cast<const std::uint8_t*>(p_source);
+    for (std::uint32_t row = 0; row < row_count; ++row)
+    {
+        AppendBlob(p_bytes == nullptr ? nullptr : p_bytes + std::size_t{row} * source_row_pitch, row_size);
+    }
+}
+
+void CFrameTraceWriter::RecordUpdateSubresource(const void* p_resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch)
+{
+    const auto* p_info = FindObject(p_resource);
+    const auto bytes_per_element = p_info != nullptr && p_info->m_type == MockObjectType::Texture2D
+                                       ? GpuFormat::GetBytesPerPixel(p_info->m_texture.m_format)
+                                       : 1u;
+    MockBox box{};
+    if (p_box != nullptr)
+    {
+        box = *p_box;
+    }
+    else
+    {
+        const auto extent = GetSubresourceExtent(p_resource, subresource);
+        box = {0, 0, 0, bytes_per_element == 0 ? 0 : extent[0] / bytes_per_element, extent[1], 1};
+    }
+    const auto row_size = box.right > box.left ? (box.right - box.left) * bytes_per_element : 0;
+    const auto row_count = box.bottom > box.top ? box.bottom - box.top : 0;
+    AddCommand(FrameTraceOpcode::UpdateSubresource, GetObjectId(p_resource), {subresource, row_size, p_box != nullptr ? 1u : 0u});
+    AppendBlob(&box, sizeof(box));
+    AppendRows(p_source, row_pitch, row_size, row_count);
+}
+
+void CFrameTraceWriter::Clear() noexcept
+{
+    m_commands.clear();
+    m_blob.clear();
+    m_objects.clear();
+    m_pending_maps.clear();
+    m_frame_begin_index = 0;
+    m_has_frame_begun = false;
+    m_statistics = {};
+}
+
+void CFrameTraceWriter::CreateBuffer(const void* p_object, const GpuBufferDescription& description, const void* p_initial_data)
+{
+    auto& info = AddObject(p_object, MockObjectType::Buffer);
+    info.m_buffer = description;
+    AddCommand(FrameTraceOpcode::CreateBuffer, info.m_id, {p_initial_data != nullptr ? 1u : 0u});
+    AppendBlob(&description, sizeof(description));
+    if (p_initial_data != nullptr)
+    {
+        AppendBlob(p_initial_data, description.m_byte_width);
+    }
+}
+
+void CFrameTraceWriter::CreateTexture2D(const void* p_object, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data)
+{
+    auto resolved_description = description;
+    if (resolved_description.m_mip_levels == 0)
+    {
+        resolved_description.m_mip_levels = GetMipLevelCount(description.m_width, description.m_height);
+    }
+    auto& info = AddObject(p_object, MockObjectType::Texture2D);
+    info.m_texture = resolved_description;
+    const auto id = info.m_id;
+    AddCommand(FrameTraceOpcode::CreateTexture2D, id, {p_initial_data != nullptr ? 1u : 0u});
+    AppendBlob(&resolved_description, sizeof(resolved_description));
+    if (p_initial_data == nullptr)
+    {
+        return;
+    }
+    const auto subresource_count = resolved_description.m_mip_levels * resolved_description.m_array_size;
+    for (std::uint32_t subresource = 0; subresource < subresource_count; ++subresource)
+    {
+        const auto extent = GetSubresourceExtent(p_object, subresource);
+        AppendRows(p_initial_data[subresource].m_p_data, p_initial_data[subresource].m_row_pitch, extent[0], extent[1]);
+    }
+}
+
+void CFrameTraceWriter::CreateView(const void* p_object, MockObjectType type, const void* p_resource)
+{
+    const auto resource_id = GetObjectId(p_resource);
+    const auto id = AddObject(p_object, type).m_id;
+    AddCommand(FrameTraceOpcode::CreateView, id, {static_cast<std::uint32_t>(type), resource_id});
+}
+
+void CFrameTraceWriter::CreateShader(const void* p_object, MockObjectType type, const void* p_byte_code, std::size_t byte_code_size)
+{
+    const auto id = AddObject(p_object, type).m_id;
+    AddCommand(FrameTraceOpcode::CreateShader, id, {static_cast<std::uint32_t>(type)});
+    AppendBlob(p_byte_code, byte_code_size);
+}
+
+void CFrameTraceWriter::CreateInputLayout(const void* p_object, const GpuInputElementDescription* p_elements, std::uint32_t element_count, const void* p_byte_code, std::size_t byte_code_size)
+{
+    const auto id = AddObject(p_object, MockObjectType::InputLayout).m_id;
+    const auto byte_code_offset = static_cast<std::uint32_t>(sizeof(FrameTraceInputElement) * element_count);
+    auto string_offset = byte_code_offset + static_cast<std::uint32_t>(byte_code_size);
+    AddCommand(FrameTraceOpcode::CreateInputLayout, id, {element_count, byte_code_offset, static_cast<std::uint32_t>(byte_code_size)});
+    for (std::uint32_t i = 0; i < element_count; ++i)
+    {
+        FrameTraceInputElement element{};
+        element.m_semantic_name_offset = string_offset;
+        element.m_semantic_index = p_elements[i].m_semantic_index;
+        element.m_format = p_elements[i].m_format;
+        element.m_input_slot = p_elements[i].m_input_slot;
+        element.m_aligned_byte_offset = p_elements[i].m_aligned_byte_offset;
+        AppendBlob(&element, sizeof(element));
+        string_offset += static_cast<std::uint32_t>(std::strlen(p_elements[i].m_p_semantic_name) + 1);
+    }
+    AppendBlob(p_byte_code, byte_code_size);
+    for (std::uint32_t i = 0; i < element_count; ++i)
+    {
+        AppendBlob(p_elements[i].m_p_semantic_name, std::strlen(p_elements[i].m_p_semantic_name) + 1);
+    }
+}
+
+void CFrameTraceWriter::CreateSamplerState(const void* p_object, const GpuSamplerDescription& description)
+{
+    AddCommand(FrameTraceOpcode::CreateSamplerState, AddObject(p_object, MockObjectType::SamplerState).m_id);
+    AppendBlob(&description, sizeof(description));
+}
+
+void CFrameTraceWriter::CreateBlendState(const void* p_object, const GpuBlendDescription& description)
+{
+    AddCommand(FrameTraceOpcode::CreateBlendState, AddObject(p_object, MockObjectType::BlendState).m_id);
+    AppendBlob(&description, sizeof(description));
+}
+
+void CFrameTraceWriter::CreateRasterizerState(const void* p_object, const GpuRasterizerDescription& description)
+{
+    AddCommand(FrameTraceOpcode::CreateRasterizerState, AddObject(p_object, MockObjectType::RasterizerState).m_id);
+    AppendBlob(&description, sizeof(description));
+}
+
+void CFrameTraceWriter::CreateDepthStencilState(const void* p_object, const GpuDepthStencilDescription& description)
+{
+    AddCommand(FrameTraceOpcode::CreateDepthStencilState, AddObject(p_object, MockObjectType::DepthStencilState).m_id);
+    AppendBlob(&description, sizeof(description));
+}
+
+void CFrameTraceWriter::BeginFrame()
+{
+    if (m_has_frame_begun)
+    {
+        throw std::logic_error{"Frame trace already contains a frame."};
+    }
+    m_frame_begin_index = static_cast<std::uint32_t>(m_commands.size());
+    m_has_frame_begun = true;
+    AddCommand(FrameTraceOpcode::BeginFrame, 0);
+}
+
+void CFrameTraceWriter::IASetPrimitiveTopology(std::uint32_t topology)
+{
+    AddCommand(FrameTraceOpcode::IASetPrimitiveTopology, 0, {topology});
+}
+
+void CFrameTraceWriter::IASetInputLayout(const void* p_input_layout)
+{
+    AddCommand(FrameTraceOpcode::IASetInputLayout, GetObjectId(p_input_layout));
+}
+
+void CFrameTraceWriter::IASetIndexBuffer(const void* p_index_buffer, std::uint32_t format, std::uint32_t offset)
+{
+    AddCommand(FrameTraceOpcode::IASetIndexBuffer, GetObjectId(p_index_buffer), {format, offset});
+}
+
+void CFrameTraceWriter::VSSetShader(const void* p_shader, const void*, std::uint32_t)
+{
+    AddCommand(FrameTraceOpcode::VSSetShader, GetObjectId(p_shader));
+}
+
+void CFrameTraceWriter::GSSetShader(const void* p_shader, const void*, std::uint32_t)
+{
+    AddCommand(FrameTraceOpcode::GSSetShader, GetObjectId(p_shader));
+}
+
+void CFrameTraceWriter::PSSetShader(const void* p_shader, const void*, std::uint32_t)
+{
+    AddCommand(FrameTraceOpcode::PSSetShader, GetObjectId(p_shader));
+}
+
+void CFrameTraceWriter::RSSetState(const void* p_rasterizer_state)
+{
+    AddCommand(FrameTraceOpcode::RSSetState, GetObjectId(p_rasterizer_state));
+}
+
+void CFrameTraceWriter::OMSetBlendState(const void* p_blend_state, const float* p_blend_factor, std::uint32_t sample_mask)
+{
+    // 与D3D11一致，混合因子为nullptr时按全1处理
+    std::array<float, 4> blend_factor{1.0f, 1.0f, 1.0f, 1.0f};
+    if (p_blend_factor != nullptr)
+    {
+        std::copy_n(p_blend_factor, blend_factor.size(), blend_factor.begin());
+    }
+    AddCommand(FrameTraceOpcode::OMSetBlendState, GetObjectId(p_blend_state), {sample_mask});
+    AppendBlob(blend_factor.data(), sizeof(blend_factor));
+}
+
+void CFrameTraceWriter::OMSetDepthStencilState(const void* p_depth_stencil_state, std::uint32_t stencil_ref)
+{
+    AddCommand(FrameTraceOpcode::OMSetDepthStencilState, GetObjectId(p_depth_stencil_state), {stencil_ref});
+}
+
+void CFrameTraceWriter::Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location)
+{
+    AddCommand(FrameTraceOpcode::Draw, 0, {vertex_count, start_vertex_location});
+}
+
+void CFrameTraceWriter::DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location)
+{
+    AddCommand(FrameTraceOpcode::DrawIndexed, 0, {index_count, start_index_location, static_cast<std::uint32_t>(base_vertex_location)});
+}
+
+void CFrameTraceWriter::Map(const void* p_resource, std::uint32_t, std::uint32_t map_type, const FrameTraceMappedData& mapped)
+{
+    m_pending_maps[p_resource] = {mapped, map_type};
+}
+
+void CFrameTraceWriter::Unmap(const void* p_resource, std::uint32_t subresource)
+{
+    const auto iterator = m_pending_maps.find(p_resource);
+    if (iterator == m_pending_maps.end())
+    {
+        return;
+    }
+    const auto pending = iterator->second;
+    m_pending_maps.erase(iterator);
+
+    const auto is_written = pending.m_map_type != GpuMap::READ;
+    const auto extent = is_written ? GetSubresourceExtent(p_resource, subresource) : std::array<std::uint32_t, 2>{0, 0};
+    AddCommand(FrameTraceOpcode::MapAndUnmap, GetObjectId(p_resource), {subresource, pending.m_map_type, extent[0]});
+    if (is_written && pending.m_mapped.m_p_data != nullptr)
+    {
+        // 缓冲的映射只有一行，行距可能为0
+        const auto source_row_pitch = extent[1] > 1 ? pending.m_mapped.m_row_pitch : extent[0];
+        AppendRows(pending.m_mapped.m_p_data, source_row_pitch, extent[0], extent[1]);
+    }
+}
+
+void CFrameTraceWriter::CopyResource(const void* p_destination, const void* p_source)
+{
+    AddCommand(FrameTraceOpcode::CopyResource, GetObjectId(p_destination), {GetObjectId(p_source)});
+}
+
+void CFrameTraceWriter::ClearRenderTargetView(const void* p_render_target_view, const float color[4])
+{
+    AddCommand(FrameTraceOpcode::ClearRenderTargetView, GetObjectId(p_render_target_view));
+    AppendBlob(color, sizeof(float) * 4);
+}
+
+void CFrameTraceWriter::Flush()
+{
+    AddCommand(FrameTraceOpcode::Flush, 0);
+}
+
+auto CFrameTraceWriter::Serialize() const
+    -> std::vector<std::uint8_t>
+{
+    FrameTraceHeader header{};
+    header.m_object_count = m_statistics.m_object_count;
+    header.m_command_count = static_cast<std::uint32_t>(m_commands.size());
+    header.m_commands_offset = COMMANDS_OFFSET;
+    header.m_blob_offset = AlignUp(COMMANDS_OFFSET + sizeof(FrameTraceCommand) * m_commands.size(), SECTION_ALIGNMENT);
+    header.m_blob_size = m_blob.size();
+    header.m_frame_begin_index = m_has_frame_begun ? m_frame_begin_index : header.m_command_count;
+
+    std::vector<std::uint8_t> data(header.m_blob_offset + header.m_blob_size);
+    std::memcpy(data.data(), &header, sizeof(header));
+    if (!m_commands.empty())
+    {
+        std::memcpy(data.data() + header.m_commands_offset, m_commands.data(), sizeof(FrameTraceCommand) * m_commands.size());
+    }
+    if (!m_blob.empty())
+    {
+        std::memcpy(data.data() + header.m_blob_offset, m_blob.data(), m_blob.size());
+    }
+    return data;
+}
+
+void CFrameTraceWriter::WriteToFile(const std::string& path) const
+{
+    const auto data = Serialize();
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())))
+    {
+        throw std::runtime_error{"Failed to write frame trace: " + path};
+    }
+}
+
+auto CFrameTraceWriter::GetStatistics() const noexcept
+    -> const FrameTraceWriterStatistics&
+{
+    return m_statistics;
+}
+
+CFrameTraceReader::CFrameTraceReader(const std::uint8_t* p_data, std::size_t size)
+    : m_p_data{p_data}, m_size{size}
+{
+    if (p_data == nullptr || size < sizeof(FrameTraceHeader))
+    {
+        throw std::runtime_error{"Frame trace is too small."};
+    }
+    std::memcpy(&m_header, p_data, sizeof(m_header));
+    if (m_header.m_magic != FrameTraceHeader::MAGIC || m_header.m_version != FrameTraceHeader::VERSION ||
+        m_header.m_header_size != sizeof(FrameTraceHeader))
+    {
+        throw std::runtime_error{"Unsupported frame trace format."};
+    }
+    const auto commands_end = m_header.m_commands_offset + std::uint64_t{sizeof(FrameTraceCommand)} * m_header.m_command_count;
+    if (m_header.m_commands_offset % alignof(FrameTraceCommand) != 0 || m_header.m_blob_offset % SECTION_ALIGNMENT != 0 ||
+        m_header.m_commands_offset < sizeof(FrameTraceHeader) || commands_end > size ||
+        m_header.m_blob_offset < commands_end || m_header.m_blob_offset + m_header.m_blob_size > size ||
+        m_header.m_frame_begin_index > m_header.m_command_count)
+    {
+        throw std::runtime_error{"Frame trace sections are out of range."};
+    }
+    m_p_commands = reinterpret_cast<const FrameTraceCommand*>(p_data + m_header.m_commands_offset);
+    m_p_blob = p_data + m_header.m_blob_offset;
+    for (const auto& command : GetCommands())
+    {
+        if (static_cast<std::size_t>(command.m_opcode) >= FRAME_TRACE_OPCODE_COUNT || command.m_object > m_header.m_object_count ||
+            command.m_blob_offset + command.m_blob_size > m_header.m_blob_size)
+        {
+            throw std::runtime_error{"Frame trace contains an invalid command."};
+        }
+    }
+}
+
+auto CFrameTraceReader::GetHeader() const noexcept
+    -> const FrameTraceHeader&
+{
+    return m_header;
+}
+
+auto CFrameTraceReader::GetCommands() const noexcept
+    -> std::span<const FrameTraceCommand>
+{
+    return {m_p_commands, m_header.m_command_count};
+}
+
+auto CFrameTraceReader::GetBlob(const FrameTraceCommand& command) const noexcept
+    -> std::span<const std::uint8_t>
+{
+    return {m_p_blob + command.m_blob_offset, command.m_blob_size};
+}
+
+auto FrameTraceReplay::Replay(const CFrameTraceReader& reader, IFrameTraceBackend& backend, std::uint32_t frame_count, bool is_timing_commands)
+    -> FrameTraceReplayStatistics
+{
+    using Clock = std::chrono::steady_clock;
+    const auto to_ms = [](Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    FrameTraceReplayStatistics statistics{};
+    const auto commands = reader.GetCommands();
+    const auto setup_commands = commands.first(reader.GetHeader().m_frame_begin_index);
+    const auto frame_commands = commands.subspan(reader.GetHeader().m_frame_begin_index);
+
+    const auto setup_start = Clock::now();
+    backend.Reset(reader.GetHeader().m_object_count);
+    for (const auto& command : setup_commands)
+    {
+        Execute(command, reader.GetBlob(command), backend);
+    }
+    backend.Finish();
+    statistics.m_setup_ms = to_ms(Clock::now() - setup_start);
+
+    statistics.m_min_frame_ms = frame_count == 0 ? 0.0 : std::numeric_limits<double>::max();
+    double total_frame_ms = 0.0;
+    for (std::uint32_t frame = 0; frame < frame_count; ++frame)
+    {
+        const auto frame_start = Clock::now();
+        for (const auto& command : frame_commands)
+        {
+            if (!is_timing_commands)
+            {
+                Execute(command, reader.GetBlob(command), backend);
+                continue;
+            }
+            const auto command_start = Clock::now();
+            Execute(command, reader.GetBlob(command), backend);
+            auto& timing = statistics.m_opcode_timings[static_cast<std::size_t>(command.m_opcode)];
+            ++timing.m_count;
+            timing.m_total_ns += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - command_start).count());
+        }
+        backend.Finish();
+        const auto frame_ms = to_ms(Clock::now() - frame_start);
+        total_frame_ms += frame_ms;
+        statistics.m_min_frame_ms = (std::min)(statistics.m_min_frame_ms, frame_ms);
+        statistics.m_max_frame_ms = (std::max)(statistics.m_max_frame_ms, frame_ms);
+    }
+    statistics.m_frame_count = frame_count;
+    statistics.m_average_frame_ms = frame_count == 0 ? 0.0 : total_frame_ms / frame_count;
+    return statistics;
+}
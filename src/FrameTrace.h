@@ -0,0 +1,495 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "CMockD3D11Device.h"
+
+/**
+ * @brief 帧跟踪中的命令，设备和上下文的每种调用对应一种 \n
+ * 创建命令的m_object为新对象的编号，描述结构体放在数据区的开头，之后是初始数据或字节码
+ */
+enum class FrameTraceOpcode : std::uint16_t
+{
+    /**
+     * @brief 数据：GpuBufferDescription，m_arguments[0]不为0时之后是初始数据
+     */
+    CreateBuffer,
+    /**
+     * @brief 数据：mip数已确定的GpuTexture2DDescription，m_arguments[0]不为0时之后是紧密排列的全部子资源
+     */
+    CreateTexture2D,
+    /**
+     * @brief m_arguments[0]为MockObjectType，m_arguments[1]为纹理编号
+     */
+    CreateView,
+    /**
+     * @brief m_arguments[0]为MockObjectType，数据：字节码
+     */
+    CreateShader,
+    /**
+     * @brief m_arguments[0]为元素数，数据：FrameTraceInputElement数组、字节码和语义名称；m_arguments[1]和[2]为字节码的偏移和大小
+     */
+    CreateInputLayout,
+    CreateSamplerState,
+    CreateBlendState,
+    CreateRasterizerState,
+    CreateDepthStencilState,
+    /**
+     * @brief 之前是建立对象的命令，之后是一帧的上下文调用，回放时只有之后的部分重复执行
+     */
+    BeginFrame,
+    IASetPrimitiveTopology,
+    IASetInputLayout,
+    /**
+     * @brief m_arguments[0]为起始槽，[1]为数量；数据：对象编号、步长和偏移三个数组
+     */
+    IASetVertexBuffers,
+    IASetIndexBuffer,
+    VSSetShader,
+    GSSetShader,
+    PSSetShader,
+    VSSetConstantBuffers,
+    PSSetConstantBuffers,
+    PSSetShaderResources,
+    PSSetSamplers,
+    RSSetState,
+    RSSetViewports,
+    OMSetBlendState,
+    OMSetDepthStencilState,
+    /**
+     * @brief m_arguments[0]为数量，[1]为深度模板视图编号；数据：渲染目标视图编号
+     */
+    OMSetRenderTargets,
+    SOSetTargets,
+    Draw,
+    DrawIndexed,
+    /**
+     * @brief m_arguments[0]为子资源，[1]为数据的行距，[2]不为0时有区域；数据：MockBox和紧密排列的行
+     */
+    UpdateSubresource,
+    /**
+     * @brief 一对Map和Unmap，在Unmap时记录；m_arguments[0]为子资源，[1]为映射方式，[2]为数据的行距 \n
+     * 以写方式映射时数据为解除映射前子资源的全部内容，行紧密排列
+     */
+    MapAndUnmap,
+    CopyResource,
+    ClearRenderTargetView,
+    Flush,
+};
+
+constexpr std::size_t FRAME_TRACE_OPCODE_COUNT = 34;
+
+auto GetFrameTraceOpcodeName(FrameTraceOpcode opcode) noexcept
+    -> const char*;
+
+/**
+ * @brief 跟踪文件的开头，全部偏移都相对于文件开头，各段按16字节对齐，文件映射后可以直接使用
+ */
+struct FrameTraceHeader
+{
+    constexpr static std::uint32_t MAGIC = 0x43525446; // "FTRC"
+    constexpr static std::uint16_t VERSION = 1;
+
+    std::uint32_t m_magic{MAGIC};
+    std::uint16_t m_version{VERSION};
+    std::uint16_t m_header_size{sizeof(FrameTraceHeader)};
+    std::uint32_t m_object_count{};
+    std::uint32_t m_command_count{};
+    std::uint64_t m_commands_offset{};
+    std::uint64_t m_blob_offset{};
+    std::uint64_t m_blob_size{};
+    /**
+     * @brief BeginFrame命令的序号，没有时等于m_command_count
+     */
+    std::uint32_t m_frame_begin_index{};
+    std::uint32_t m_reserved{};
+};
+
+/**
+ * @brief 定长的命令记录，变长的参数放在数据区中
+ */
+struct FrameTraceCommand
+{
+    FrameTraceOpcode m_opcode{};
+    std::uint16_t m_reserved{};
+    /**
+     * @brief 第一个对象参数的编号，0表示空
+     */
+    std::uint32_t m_object{};
+    std::array<std::uint32_t, 4> m_arguments{};
+    /**
+     * @brief 数据在数据区中的偏移
+     */
+    std::uint64_t m_blob_offset{};
+    std::uint32_t m_blob_size{};
+    std::uint32_t m_reserved_2{};
+};
+
+struct FrameTraceInputElement
+{
+    /**
+     * @brief 语义名称在命令数据中的偏移，以'\0'结尾
+     */
+    std::uint32_t m_semantic_name_offset{};
+    std::uint32_t m_semantic_index{};
+    std::uint32_t m_format{};
+    std::uint32_t m_input_slot{};
+    std::uint32_t m_aligned_byte_offset{};
+};
+
+static_assert(sizeof(FrameTraceHeader) == 48);
+static_assert(sizeof(FrameTraceCommand) == 40);
+static_assert(std::is_trivially_copyable_v<GpuBufferDescription> && std::is_trivially_copyable_v<GpuTexture2DDescription>);
+static_assert(std::is_trivially_copyable_v<GpuBlendDescription> && std::is_trivially_copyable_v<MockViewport> && std::is_trivially_copyable_v<MockBox>);
+
+/**
+ * @brief 映射后可写入的内存和行距，由捕获的上下文从各自的映射结构中取出
+ */
+struct FrameTraceMappedData
+{
+    const void* m_p_data{};
+    std::uint32_t m_row_pitch{};
+};
+
+inline auto GetFrameTraceMappedData(const MockMappedSubresource& mapped) noexcept
+    -> FrameTraceMappedData
+{
+    return {mapped.m_p_data, mapped.m_row_pitch};
+}
+
+#ifdef _WIN32
+inline auto GetFrameTraceMappedData(const D3D11_MAPPED_SUBRESOURCE& mapped) noexcept
+    -> FrameTraceMappedData
+{
+    return {mapped.pData, mapped.RowPitch};
+}
+#endif
+
+struct FrameTraceWriterStatistics
+{
+    std::uint32_t m_object_count{};
+    std::uint32_t m_command_count{};
+    std::uint64_t m_blob_bytes{};
+    /**
+     * @brief 上下文调用中出现、但没有经由创建命令记录的对象数，回放时这些对象为空
+     */
+    std::uint32_t m_unknown_object_count{};
+};
+
+/**
+ * @brief 帧跟踪的写入端：创建函数记录对象的描述和初始数据，上下文函数与ID3D11DeviceContext同名同参数顺序 \n
+ * 对象以指针区分，真实设备和模拟设备的对象都可以记录；视口和区域须与D3D11_VIEWPORT和D3D11_BOX布局相同 \n
+ * 一般由CCapturingDeviceContext在转发上下文调用的同时调用
+ */
+class CFrameTraceWriter
+{
+private:
+    struct ObjectInfo
+    {
+        std::uint32_t m_id{};
+        MockObjectType m_type{};
+        GpuBufferDescription m_buffer{};
+        GpuTexture2DDescription m_texture{};
+    };
+    struct PendingMap
+    {
+        FrameTraceMappedData m_mapped{};
+        std::uint32_t m_map_type{};
+    };
+
+    std::vector<FrameTraceCommand> m_commands{};
+    std::vector<std::uint8_t> m_blob{};
+    std::unordered_map<const void*, ObjectInfo> m_objects{};
+    std::unordered_map<const void*, PendingMap> m_pending_maps{};
+    std::uint32_t m_frame_begin_index{};
+    bool m_has_frame_begun{};
+    FrameTraceWriterStatistics m_statistics{};
+
+    auto AddCommand(FrameTraceOpcode opcode, std::uint32_t object, std::array<std::uint32_t, 4> arguments = {})
+        -> FrameTraceCommand&;
+    /**
+     * @brief 把数据追加到最后一个命令的数据中
+     */
+    void AppendBlob(const void* p_data, std::size_t size);
+    auto AddObject(const void* p_object, MockObjectType type)
+        -> ObjectInfo&;
+    auto GetObjectId(const void* p_object)
+        -> std::uint32_t;
+    auto FindObject(const void* p_object) const noexcept
+        -> const ObjectInfo*;
+    /**
+     * @brief 子资源的紧密行距和行数，未知对象返回0
+     */
+    auto GetSubresourceExtent(const void* p_resource, std::uint32_t subresource) const noexcept
+        -> std::array<std::uint32_t, 2>;
+    void AppendRows(const void* p_source, std::uint32_t source_row_pitch, std::uint32_t row_size, std::uint32_t row_count);
+    void RecordUpdateSubresource(const void* p_resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch);
+
+    template <class Objects>
+    void AppendObjectIds(Objects p_objects, std::uint32_t count)
+    {
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            std::uint32_t id = 0;
+            if constexpr (!std::is_null_pointer_v<Objects>)
+            {
+                id = p_objects == nullptr ? 0 : GetObjectId(p_objects[i]);
+            }
+            AppendBlob(&id, sizeof(id));
+        }
+    }
+    template <class Objects>
+    void RecordObjectArray(FrameTraceOpcode opcode, std::uint32_t start_slot, std::uint32_t count, Objects p_objects)
+    {
+        AddCommand(opcode, 0, {start_slot, count});
+        AppendObjectIds(p_objects, count);
+    }
+
+public:
+    CFrameTraceWriter() = default;
+    ~CFrameTraceWriter() = default;
+    CFrameTraceWriter(const CFrameTraceWriter&) = delete;
+    CFrameTraceWriter& operator=(const CFrameTraceWriter&) = delete;
+
+    /**
+     * @brief 丢弃已记录的全部命令和对象，开始新的跟踪
+     */
+    void Clear() noexcept;
+
+    void CreateBuffer(const void* p_object, const GpuBufferDescription& description, const void* p_initial_data);
+    /**
+     * @brief p_initial_data为nullptr或按mip + array_slice * mip_levels排列的每个子资源的数据
+     */
+    void CreateTexture2D(const void* p_object, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data);
+    void CreateView(const void* p_object, MockObjectType type, const void* p_resource);
+    void CreateShader(const void* p_object, MockObjectType type, const void* p_byte_code, std::size_t byte_code_size);
+    void CreateInputLayout(const void* p_object, const GpuInputElementDescription* p_elements, std::uint32_t element_count, const void* p_byte_code, std::size_t byte_code_size);
+    void CreateSamplerState(const void* p_object, const GpuSamplerDescription& description);
+    void CreateBlendState(const void* p_object, const GpuBlendDescription& description);
+    void CreateRasterizerState(const void* p_object, const GpuRasterizerDescription& description);
+    void CreateDepthStencilState(const void* p_object, const GpuDepthStencilDescription& description);
+    /**
+     * @brief 标记对象建立完毕，之后的上下文调用属于被捕获的一帧
+     */
+    void BeginFrame();
+
+    void IASetPrimitiveTopology(std::uint32_t topology);
+    void IASetInputLayout(const void* p_input_layout);
+    template <class Buffers>
+    void IASetVertexBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, Buffers p_buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets)
+    {
+        RecordObjectArray(FrameTraceOpcode::IASetVertexBuffers, start_slot, buffer_count, p_buffers);
+        AppendBlob(p_strides, sizeof(std::uint32_t) * buffer_count);
+        AppendBlob(p_offsets, sizeof(std::uint32_t) * buffer_count);
+    }
+    void IASetIndexBuffer(const void* p_index_buffer, std::uint32_t format, std::uint32_t offset);
+    void VSSetShader(const void* p_shader, const void* p_class_instances, std::uint32_t class_instance_count);
+    void GSSetShader(const void* p_shader, const void* p_class_instances, std::uint32_t class_instance_count);
+    void PSSetShader(const void* p_shader, const void* p_class_instances, std::uint32_t class_instance_count);
+    template <class Buffers>
+    void VSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, Buffers p_buffers)
+    {
+        RecordObjectArray(FrameTraceOpcode::VSSetConstantBuffers, start_slot, buffer_count, p_buffers);
+    }
+    template <class Buffers>
+    void PSSetConstantBuffers(std::uint32_t start_slot, std::uint32_t buffer_count, Buffers p_buffers)
+    {
+        RecordObjectArray(FrameTraceOpcode::PSSetConstantBuffers, start_slot, buffer_count, p_buffers);
+    }
+    template <class Views>
+    void PSSetShaderResources(std::uint32_t start_slot, std::uint32_t view_count, Views p_views)
+    {
+        RecordObjectArray(FrameTraceOpcode::PSSetShaderResources, start_slot, view_count, p_views);
+    }
+    template <class Samplers>
+    void PSSetSamplers(std::uint32_t start_slot, std::uint32_t sampler_count, Samplers p_samplers)
+    {
+        RecordObjectArray(FrameTraceOpcode::PSSetSamplers, start_slot, sampler_count, p_samplers);
+    }
+    void RSSetState(const void* p_rasterizer_state);
+    template <class Viewport>
+    void RSSetViewports(std::uint32_t viewport_count, const Viewport* p_viewports)
+    {
+        static_assert(sizeof(Viewport) == sizeof(MockViewport) && std::is_trivially_copyable_v<Viewport>);
+        AddCommand(FrameTraceOpcode::RSSetViewports, 0, {viewport_count});
+        AppendBlob(p_viewports, sizeof(MockViewport) * viewport_count);
+    }
+    void OMSetBlendState(const void* p_blend_state, const float* p_blend_factor, std::uint32_t sample_mask);
+    void OMSetDepthStencilState(const void* p_depth_stencil_state, std::uint32_t stencil_ref);
+    template <class Views>
+    void OMSetRenderTargets(std::uint32_t view_count, Views p_render_target_views, const void* p_depth_stencil_view)
+    {
+        AddCommand(FrameTraceOpcode::OMSetRenderTargets, 0, {view_count, GetObjectId(p_depth_stencil_view)});
+        AppendObjectIds(p_render_target_views, view_count);
+    }
+    template <class Targets>
+    void SOSetTargets(std::uint32_t target_count, Targets, const std::uint32_t*)
+    {
+        // 只记录解除绑定，项目中不使用流输出
+        AddCommand(FrameTraceOpcode::SOSetTargets, 0, {target_count});
+    }
+    void Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location);
+    void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location);
+    /**
+     * @brief 复制被更新的内容；p_box为nullptr时按记录的描述计算整个子资源的大小
+     */
+    template <class Box>
+    void UpdateSubresource(const void* p_resource, std::uint32_t subresource, Box p_box, const void* p_source, std::uint32_t row_pitch, std::uint32_t)
+    {
+        MockBox box{};
+        const MockBox* p_mock_box = nullptr;
+        if constexpr (!std::is_null_pointer_v<Box>)
+        {
+            static_assert(sizeof(*p_box) == sizeof(MockBox) && std::is_trivially_copyable_v<std::remove_pointer_t<Box>>);
+            if (p_box != nullptr)
+            {
+                std::memcpy(&box, p_box, sizeof(box));
+                p_mock_box = &box;
+            }
+        }
+        RecordUpdateSubresource(p_resource, subresource, p_mock_box, p_source, row_pitch);
+    }
+    /**
+     * @brief 在映射成功后调用，mapped为映射得到的内存；命令在Unmap时才写入
+     */
+    void Map(const void* p_resource, std::uint32_t subresource, std::uint32_t map_type, const FrameTraceMappedData& mapped);
+    /**
+     * @brief 在真正解除映射之前调用，以写方式映射时复制写入的内容
+     */
+    void Unmap(const void* p_resource, std::uint32_t subresource);
+    void CopyResource(const void* p_destination, const void* p_source);
+    void ClearRenderTargetView(const void* p_render_target_view, const float color[4]);
+    void Flush();
+
+    /**
+     * @brief 按文件格式写出，失败时抛出std::runtime_error
+     */
+    void WriteToFile(const std::string& path) const;
+    /**
+     * @brief 按文件格式序列化到内存
+     */
+    auto Serialize() const
+        -> std::vector<std::uint8_t>;
+    auto GetStatistics() const noexcept
+        -> const FrameTraceWriterStatistics&;
+};
+
+/**
+ * @brief 帧跟踪的读取端，直接引用映射的文件内容，不复制；构造时检查头部和每个命令的数据范围，非法时抛出std::runtime_error
+ */
+class CFrameTraceReader
+{
+private:
+    const std::uint8_t* m_p_data{};
+    std::size_t m_size{};
+    FrameTraceHeader m_header{};
+    const FrameTraceCommand* m_p_commands{};
+    const std::uint8_t* m_p_blob{};
+
+public:
+    CFrameTraceReader(const std::uint8_t* p_data, std::size_t size);
+
+    auto GetHeader() const noexcept
+        -> const FrameTraceHeader&;
+    auto GetCommands() const noexcept
+        -> std::span<const FrameTraceCommand>;
+    auto GetBlob(const FrameTraceCommand& command) const noexcept
+        -> std::span<const std::uint8_t>;
+};
+
+/**
+ * @brief 回放的目标，对象以跟踪中的编号指定，由后端映射到自己的对象；编号0为空
+ */
+class IFrameTraceBackend
+{
+public:
+    virtual ~IFrameTraceBackend() = default;
+
+    /**
+     * @brief 在创建对象之前调用一次，object_count为跟踪中的对象数
+     */
+    virtual void Reset(std::uint32_t object_count) = 0;
+    virtual void CreateBuffer(std::uint32_t id, const GpuBufferDescription& description, const void* p_initial_data) = 0;
+    virtual void CreateTexture2D(std::uint32_t id, const GpuTexture2DDescription& description, const GpuSubresourceData* p_initial_data) = 0;
+    virtual void CreateView(std::uint32_t id, MockObjectType type, std::uint32_t resource_id) = 0;
+    virtual void CreateShader(std::uint32_t id, MockObjectType type, std::span<const std::uint8_t> byte_code) = 0;
+    virtual void CreateInputLayout(std::uint32_t id, std::span<const GpuInputElementDescription> elements, std::span<const std::uint8_t> byte_code) = 0;
+    virtual void CreateSamplerState(std::uint32_t id, const GpuSamplerDescription& description) = 0;
+    virtual void CreateBlendState(std::uint32_t id, const GpuBlendDescription& description) = 0;
+    virtual void CreateRasterizerState(std::uint32_t id, const GpuRasterizerDescription& description) = 0;
+    virtual void CreateDepthStencilState(std::uint32_t id, const GpuDepthStencilDescription& description) = 0;
+
+    virtual void IASetPrimitiveTopology(std::uint32_t topology) = 0;
+    virtual void IASetInputLayout(std::uint32_t input_layout) = 0;
+    virtual void IASetVertexBuffers(std::uint32_t start_slot, std::span<const std::uint32_t> buffers, const std::uint32_t* p_strides, const std::uint32_t* p_offsets) = 0;
+    virtual void IASetIndexBuffer(std::uint32_t index_buffer, std::uint32_t format, std::uint32_t offset) = 0;
+    /**
+     * @brief stage为VertexShader、GeometryShader或PixelShader
+     */
+    virtual void SetShader(MockObjectType stage, std::uint32_t shader) = 0;
+    /**
+     * @brief opcode为VSSetConstantBuffers、PSSetConstantBuffers、PSSetShaderResources或PSSetSamplers
+     */
+    virtual void SetObjects(FrameTraceOpcode opcode, std::uint32_t start_slot, std::span<const std::uint32_t> objects) = 0;
+    virtual void RSSetState(std::uint32_t rasterizer_state) = 0;
+    virtual void RSSetViewports(std::span<const MockViewport> viewports) = 0;
+    virtual void OMSetBlendState(std::uint32_t blend_state, const float* p_blend_factor, std::uint32_t sample_mask) = 0;
+    virtual void OMSetDepthStencilState(std::uint32_t depth_stencil_state, std::uint32_t stencil_ref) = 0;
+    virtual void OMSetRenderTargets(std::span<const std::uint32_t> render_target_views, std::uint32_t depth_stencil_view) = 0;
+    virtual void SOSetTargets(std::uint32_t target_count) = 0;
+    virtual void Draw(std::uint32_t vertex_count, std::uint32_t start_vertex_location) = 0;
+    virtual void DrawIndexed(std::uint32_t index_count, std::uint32_t start_index_location, std::int32_t base_vertex_location) = 0;
+    /**
+     * @brief p_box为nullptr时更新整个子资源
+     */
+    virtual void UpdateSubresource(std::uint32_t resource, std::uint32_t subresource, const MockBox* p_box, const void* p_source, std::uint32_t row_pitch) = 0;
+    /**
+     * @brief 映射后立即写入或读取并解除映射；p_written_data为nullptr时只读取
+     */
+    virtual void MapAndUnmap(std::uint32_t resource, std::uint32_t subresource, std::uint32_t map_type, const void* p_written_data, std::uint32_t row_pitch, std::uint32_t size) = 0;
+    virtual void CopyResource(std::uint32_t destination, std::uint32_t source) = 0;
+    virtual void ClearRenderTargetView(std::uint32_t render_target_view, const float color[4]) = 0;
+    virtual void Flush() = 0;
+    /**
+     * @brief 等待已提交的工作全部完成，计入每次回放的耗时；CPU后端可以不做任何事
+     */
+    virtual void Finish() = 0;
+};
+
+struct FrameTraceOpcodeTiming
+{
+    std::uint64_t m_count{};
+    std::uint64_t m_total_ns{};
+};
+
+struct FrameTraceReplayStatistics
+{
+    double m_setup_ms{};
+    std::uint32_t m_frame_count{};
+    double m_min_frame_ms{};
+    double m_average_frame_ms{};
+    double m_max_frame_ms{};
+    /**
+     * @brief 各种命令在全部回放帧中的次数和耗时
+     */
+    std::array<FrameTraceOpcodeTiming, FRAME_TRACE_OPCODE_COUNT> m_opcode_timings{};
+};
+
+/**
+ * @brief 在任意后端上回放帧跟踪：先执行一次建立对象的命令，再把被捕获的一帧重复执行若干次并计时
+ */
+namespace FrameTraceReplay
+{
+    /**
+     * @param frame_count 被捕获的一帧的重复次数，每次之后调用后端的Finish
+     * @param is_timing_commands 为true时逐条命令计时，计时本身有几十纳秒的开销
+     */
+    auto Replay(const CFrameTraceReader& reader, IFrameTraceBackend& backend, std::uint32_t frame_count, bool is_timing_commands = false)
+        -> FrameTraceReplayStatistics;
+}
@@ -0,0 +1,229 @@
+#pragma once
+#include <cstdint>
+#ifdef _WIN32
+#include <d3d11.h>
+#endif
+
+/**
+ * @brief 与平台无关的像素格式，数值与DXGI_FORMAT一致，便于在没有Windows SDK的环境中使用
+ */
+namespace GpuFormat
+{
+    constexpr std::uint32_t UNKNOWN = 0;
+    constexpr std::uint32_t R32G32B32_FLOAT = 6;
+    constexpr std::uint32_t R32G32_FLOAT = 16;
+    constexpr std::uint32_t R8G8B8A8_UNORM = 28;
+    constexpr std::uint32_t R32_UINT = 42;
+    constexpr std::uint32_t R16_UINT = 57;
+    constexpr std::uint32_t R8_UNORM = 61;
+    constexpr std::uint32_t R8_UINT = 62;
+    constexpr std::uint32_t A8_UNORM = 65;
+    constexpr std::uint32_t B8G8R8A8_UNORM = 87;
+
+    /**
+     * @brief 获取格式每个像素占用的字节数，未知格式返回0
+     */
+    constexpr std::uint32_t GetBytesPerPixel(std::uint32_t format) noexcept
+    {
+        switch (format)
+        {
+        case R32G32B32_FLOAT:
+            return 12;
+        case R32G32_FLOAT:
+            return 8;
+        case R8G8B8A8_UNORM:
+        case B8G8R8A8_UNORM:
+        case R32_UINT:
+            return 4;
+        case R16_UINT:
+            return 2;
+        case R8_UNORM:
+        case R8_UINT:
+        case A8_UNORM:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+#ifdef _WIN32
+    static_assert(R32G32B32_FLOAT == DXGI_FORMAT_R32G32B32_FLOAT);
+    static_assert(R32G32_FLOAT == DXGI_FORMAT_R32G32_FLOAT);
+    static_assert(R8G8B8A8_UNORM == DXGI_FORMAT_R8G8B8A8_UNORM);
+    static_assert(R32_UINT == DXGI_FORMAT_R32_UINT);
+    static_assert(R16_UINT == DXGI_FORMAT_R16_UINT);
+    static_assert(R8_UNORM == DXGI_FORMAT_R8_UNORM);
+    static_assert(R8_UINT == DXGI_FORMAT_R8_UINT);
+    static_assert(A8_UNORM == DXGI_FORMAT_A8_UNORM);
+    static_assert(B8G8R8A8_UNORM == DXGI_FORMAT_B8G8R8A8_UNORM);
+#endif
+}
+
+struct TextureDescription
+{
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_format{GpuFormat::B8G8R8A8_UNORM};
+
+    constexpr std::uint64_t GetSizeInBytes() const noexcept
+    {
+        return std::uint64_t{m_width} * m_height * GpuFormat::GetBytesPerPixel(m_format);
+    }
+
+    constexpr bool operator==(const TextureDescription&) const noexcept = default;
+};
+
+/**
+ * @brief 与平台无关的资源描述常量，数值与D3D11一致，规则可以在没有Windows SDK的环境中检查
+ */
+namespace GpuUsage
+{
+    constexpr std::uint32_t DEFAULT = 0;
+    constexpr std::uint32_t IMMUTABLE = 1;
+    constexpr std::uint32_t DYNAMIC = 2;
+    constexpr std::uint32_t STAGING = 3;
+}
+
+namespace GpuBindFlag
+{
+    constexpr std::uint32_t VERTEX_BUFFER = 0x1;
+    constexpr std::uint32_t INDEX_BUFFER = 0x2;
+    constexpr std::uint32_t CONSTANT_BUFFER = 0x4;
+    constexpr std::uint32_t SHADER_RESOURCE = 0x8;
+    constexpr std::uint32_t STREAM_OUTPUT = 0x10;
+    constexpr std::uint32_t RENDER_TARGET = 0x20;
+    constexpr std::uint32_t DEPTH_STENCIL = 0x40;
+    constexpr std::uint32_t UNORDERED_ACCESS = 0x80;
+}
+
+namespace GpuCpuAccessFlag
+{
+    constexpr std::uint32_t WRITE = 0x10000;
+    constexpr std::uint32_t READ = 0x20000;
+}
+
+namespace GpuFilter
+{
+    constexpr std::uint32_t MIN_MAG_MIP_POINT = 0;
+    constexpr std::uint32_t MIN_MAG_MIP_LINEAR = 0x15;
+    constexpr std::uint32_t ANISOTROPIC = 0x55;
+    /**
+     * @brief 缩小、放大或mip之间任一方向使用线性或各向异性过滤
+     */
+    constexpr std::uint32_t FILTERING_MASK = 0x55;
+}
+
+namespace GpuBlend
+{
+    constexpr std::uint32_t ZERO = 1;
+    constexpr std::uint32_t ONE = 2;
+    constexpr std::uint32_t SRC_ALPHA = 5;
+    constexpr std::uint32_t INV_DEST_ALPHA = 8;
+    constexpr std::uint32_t OP_ADD = 1;
+}
+
+namespace GpuPrimitiveTopology
+{
+    constexpr std::uint32_t TRIANGLE_LIST = 4;
+}
+
+#ifdef _WIN32
+static_assert(GpuUsage::DEFAULT == D3D11_USAGE_DEFAULT);
+static_assert(GpuUsage::IMMUTABLE == D3D11_USAGE_IMMUTABLE);
+static_assert(GpuUsage::DYNAMIC == D3D11_USAGE_DYNAMIC);
+static_assert(GpuUsage::STAGING == D3D11_USAGE_STAGING);
+static_assert(GpuBindFlag::VERTEX_BUFFER == D3D11_BIND_VERTEX_BUFFER);
+static_assert(GpuBindFlag::INDEX_BUFFER == D3D11_BIND_INDEX_BUFFER);
+static_assert(GpuBindFlag::CONSTANT_BUFFER == D3D11_BIND_CONSTANT_BUFFER);
+static_assert(GpuBindFlag::SHADER_RESOURCE == D3D11_BIND_SHADER_RESOURCE);
+static_assert(GpuBindFlag::STREAM_OUTPUT == D3D11_BIND_STREAM_OUTPUT);
+static_assert(GpuBindFlag::RENDER_TARGET == D3D11_BIND_RENDER_TARGET);
+static_assert(GpuBindFlag::DEPTH_STENCIL == D3D11_BIND_DEPTH_STENCIL);
+static_assert(GpuBindFlag::UNORDERED_ACCESS == D3D11_BIND_UNORDERED_ACCESS);
+static_assert(GpuCpuAccessFlag::WRITE == D3D11_CPU_ACCESS_WRITE);
+static_assert(GpuCpuAccessFlag::READ == D3D11_CPU_ACCESS_READ);
+static_assert(GpuFilter::MIN_MAG_MIP_POINT == D3D11_FILTER_MIN_MAG_MIP_POINT);
+static_assert(GpuFilter::MIN_MAG_MIP_LINEAR == D3D11_FILTER_MIN_MAG_MIP_LINEAR);
+static_assert(GpuFilter::ANISOTROPIC == D3D11_FILTER_ANISOTROPIC);
+static_assert(GpuBlend::ZERO == D3D11_BLEND_ZERO);
+static_assert(GpuBlend::ONE == D3D11_BLEND_ONE);
+static_assert(GpuBlend::SRC_ALPHA == D3D11_BLEND_SRC_ALPHA);
+static_assert(GpuBlend::INV_DEST_ALPHA == D3D11_BLEND_INV_DEST_ALPHA);
+static_assert(GpuBlend::OP_ADD == D3D11_BLEND_OP_ADD);
+static_assert(GpuPrimitiveTopology::TRIANGLE_LIST == D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+#endif
+
+/**
+ * @brief 以下描述只包含本项目用到的字段，帧跟踪、模拟设备和资源清单都以这种形式交换描述
+ */
+struct GpuBufferDescription
+{
+    std::uint32_t m_byte_width{};
+    std::uint32_t m_usage{GpuUsage::DEFAULT};
+    std::uint32_t m_bind_flags{};
+    std::uint32_t m_cpu_access_flags{};
+};
+
+struct GpuTexture2DDescription
+{
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    /**
+     * @brief 为0时创建完整的mip链
+     */
+    std::uint32_t m_mip_levels{1};
+    std::uint32_t m_array_size{1};
+    std::uint32_t m_format{GpuFormat::B8G8R8A8_UNORM};
+    std::uint32_t m_sample_count{1};
+    std::uint32_t m_usage{GpuUsage::DEFAULT};
+    std::uint32_t m_bind_flags{};
+    std::uint32_t m_cpu_access_flags{};
+};
+
+struct GpuSubresourceData
+{
+    const void* m_p_data{};
+    std::uint32_t m_row_pitch{};
+};
+
+struct GpuInputElementDescription
+{
+    const char* m_p_semantic_name{};
+    std::uint32_t m_semantic_index{};
+    std::uint32_t m_format{};
+    std::uint32_t m_input_slot{};
+    std::uint32_t m_aligned_byte_offset{};
+};
+
+struct GpuSamplerDescription
+{
+    std::uint32_t m_filter{GpuFilter::MIN_MAG_MIP_POINT};
+    std::uint32_t m_max_anisotropy{1};
+};
+
+/**
+ * @brief 只描述第0个渲染目标的混合状态
+ */
+struct GpuBlendDescription
+{
+    bool m_is_blend_enabled{};
+    std::uint32_t m_source_blend{GpuBlend::ONE};
+    std::uint32_t m_destination_blend{GpuBlend::ZERO};
+    std::uint32_t m_blend_operation{GpuBlend::OP_ADD};
+    std::uint32_t m_source_alpha_blend{GpuBlend::ONE};
+    std::uint32_t m_destination_alpha_blend{GpuBlend::ZERO};
+    std::uint32_t m_alpha_blend_operation{GpuBlend::OP_ADD};
+    std::uint8_t m_write_mask{0xF};
+};
+
+struct GpuRasterizerDescription
+{
+    bool m_is_scissor_enabled{};
+    bool m_is_depth_clip_enabled{true};
+};
+
+struct GpuDepthStencilDescription
+{
+    bool m_is_depth_enabled{};
+    bool m_is_stencil_enabled{};
+};
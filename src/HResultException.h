@@ -11,6 +11,16 @@
         }                   \
     }
 
+// 交给CDeferredReleaseQueue，待当前帧的栅栏完成后再释放
+#define DEFERRED_RELEASE_COM(queue, p)   \
+    {                                    \
+        if (p)                           \
+        {                                \
+            (queue).DeferRelease((p));   \
+            (p) = (NULL);                \
+        }                                \
+    }
+
 namespace FunctionChecker
 {
     bool CheckLibraryExist(LPCTSTR p_library_name) noexcept;
@@ -0,0 +1,239 @@
+#include "ImageWriter.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    auto OpenBinaryFile(const std::string& path)
+        -> std::ofstream
+    {
+        std::ofstream result{path, std::ios::binary | std::ios::trunc};
+        if (!result)
+        {
+            throw std::runtime_error{"Open image file failed: " + path};
+        }
+        return result;
+    }
+
+    void CheckWriteResult(const std::ofstream& file, const std::string& path)
+    {
+        if (!file)
+        {
+            throw std::runtime_error{"Write image file failed: " + path};
+        }
+    }
+
+    auto MakeCrc32Table() noexcept
+        -> std::array<std::uint32_t, 256>
+    {
+        std::array<std::uint32_t, 256> result{};
+        for (std::uint32_t i = 0; i < result.size(); ++i)
+        {
+            auto value = i;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+            }
+            result[i] = value;
+        }
+        return result;
+    }
+
+    std::uint32_t UpdateCrc32(std::uint32_t crc, const std::uint8_t* p_data, std::size_t size) noexcept
+    {
+        static const auto crc32_table = MakeCrc32Table();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc = crc32_table[(crc ^ p_data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    void AppendBigEndian(std::vector<std::uint8_t>& buffer, std::uint32_t value)
+    {
+        buffer.push_back(static_cast<std::uint8_t>(value >> 24));
+        buffer.push_back(static_cast<std::uint8_t>(value >> 16));
+        buffer.push_back(static_cast<std::uint8_t>(value >> 8));
+        buffer.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void WritePngChunk(std::ofstream& file, const char (&type)[5], const std::vector<std::uint8_t>& data)
+    {
+        std::vector<std::uint8_t> header{};
+        AppendBigEndian(header, static_cast<std::uint32_t>(data.size()));
+        header.insert(header.end(), type, type + 4);
+        auto crc = UpdateCrc32(0xFFFFFFFFu, header.data() + 4, 4);
+        crc = UpdateCrc32(crc, data.data(), data.size()) ^ 0xFFFFFFFFu;
+        std::vector<std::uint8_t> footer{};
+        AppendBigEndian(footer, crc);
+
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+    }
+
+    /**
+     * @brief 将数据包装为仅包含stored块的zlib流
+     */
+    auto MakeStoredZlibStream(const std::vector<std::uint8_t>& data)
+        -> std::vector<std::uint8_t>
+    {
+        constexpr std::size_t MAX_STORED_BLOCK_SIZE = 65535;
+        std::vector<std::uint8_t> result{};
+        result.reserve(data.size() + data.size() / MAX_STORED_BLOCK_SIZE * 5 + 16);
+        // CMF: deflate, 32K窗口；FLG: 使(CMF * 256 + FLG)能被31整除
+        result.push_back(0x78);
+        result.push_back(0x01);
+
+        std::size_t offset = 0;
+        do
+        {
+            const auto block_size = (std::min)(MAX_STORED_BLOCK_SIZE, data.size() - offset);
+            const bool is_final_block = offset + block_size == data.size();
+            result.push_back(is_final_block ? 1 : 0);
+            result.push_back(static_cast<std::uint8_t>(block_size));
+            result.push_back(static_cast<std::uint8_t>(block_size >> 8));
+            result.push_back(static_cast<std::uint8_t>(~block_size));
+            result.push_back(static_cast<std::uint8_t>(~block_size >> 8));
+            result.insert(result.end(), data.begin() + offset, data.begin() + offset + block_size);
+            offset += block_size;
+        } while (offset < data.size());
+
+        std::uint32_t adler_a = 1;
+        std::uint32_t adler_b = 0;
+        for (auto byte : data)
+        {
+            adler_a = (adler_a + byte) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+        }
+        AppendBigEndian(result, (adler_b << 16) | adler_a);
+        return result;
+    }
+}
+
+auto ImageWriter::ParseImageFileFormat(const std::string& name) noexcept
+    -> std::optional<ImageFileFormat>
+{
+    if (name == "none")
+    {
+        return ImageFileFormat::None;
+    }
+    if (name == "raw")
+    {
+        return ImageFileFormat::Raw;
+    }
+    if (name == "ppm")
+    {
+        return ImageFileFormat::Ppm;
+    }
+    if (name == "png")
+    {
+        return ImageFileFormat::Png;
+    }
+    return std::nullopt;
+}
+
+auto ImageWriter::GetFileExtension(ImageFileFormat format) noexcept
+    -> const char*
+{
+    switch (format)
+    {
+    case ImageFileFormat::Raw:
+        return ".bgra";
+    case ImageFileFormat::Ppm:
+        return ".ppm";
+    case ImageFileFormat::Png:
+        return ".png";
+    default:
+        return "";
+    }
+}
+
+void ImageWriter::WriteRaw(const std::string& path, const CBgraImage& image)
+{
+    auto file = OpenBinaryFile(path);
+    const auto row_size = static_cast<std::streamsize>(image.GetWidth()) * CBgraImage::BYTES_PER_PIXEL;
+    for (std::uint32_t y = 0; y < image.GetHeight(); ++y)
+    {
+        file.write(reinterpret_cast<const char*>(image.GetRow(y)), row_size);
+    }
+    CheckWriteResult(file, path);
+}
+
+void ImageWriter::WritePpm(const std::string& path, const CBgraImage& image)
+{
+    auto file = OpenBinaryFile(path);
+    file << "P6\n"
+         << image.GetWidth() << ' ' << image.GetHeight() << "\n255\n";
+    std::vector<std::uint8_t> row(static_cast<std::size_t>(image.GetWidth()) * 3);
+    for (std::uint32_t y = 0; y < image.GetHeight(); ++y)
+    {
+        const auto* p_pixel = image.GetRow(y);
+        for (std::uint32_t x = 0; x < image.GetWidth(); ++x, p_pixel += CBgraImage::BYTES_PER_PIXEL)
+        {
+            row[x * 3 + 0] = p_pixel[2];
+            row[x * 3 + 1] = p_pixel[1];
+            row[x * 3 + 2] = p_pixel[0];
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+    CheckWriteResult(file, path);
+}
+
+void ImageWriter::WritePng(const std::string& path, const CBgraImage& image)
+{
+    auto file = OpenBinaryFile(path);
+    constexpr std::array<std::uint8_t, 8> PNG_SIGNATURE{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(PNG_SIGNATURE.data()), PNG_SIGNATURE.size());
+
+    std::vector<std::uint8_t> header{};
+    AppendBigEndian(header, image.GetWidth());
+    AppendBigEndian(header, image.GetHeight());
+    header.push_back(8); // 位深
+    header.push_back(6); // RGBA
+    header.push_back(0); // deflate
+    header.push_back(0); // 自适应滤波
+    header.push_back(0); // 不交错
+    WritePngChunk(file, "IHDR", header);
+
+    // 每行以滤波类型0(None)开头
+    std::vector<std::uint8_t> scanlines{};
+    scanlines.reserve((static_cast<std::size_t>(image.GetWidth()) * 4 + 1) * image.GetHeight());
+    for (std::uint32_t y = 0; y < image.GetHeight(); ++y)
+    {
+        scanlines.push_back(0);
+        const auto* p_pixel = image.GetRow(y);
+        for (std::uint32_t x = 0; x < image.GetWidth(); ++x, p_pixel += CBgraImage::BYTES_PER_PIXEL)
+        {
+            scanlines.push_back(p_pixel[2]);
+            scanlines.push_back(p_pixel[1]);
+            scanlines.push_back(p_pixel[0]);
+            scanlines.push_back(p_pixel[3]);
+        }
+    }
+    WritePngChunk(file, "IDAT", MakeStoredZlibStream(scanlines));
+    WritePngChunk(file, "IEND", {});
+    CheckWriteResult(file, path);
+}
+
+void ImageWriter::Write(const std::string& path, const CBgraImage& image, ImageFileFormat format)
+{
+    switch (format)
+    {
+    case ImageFileFormat::Raw:
+        WriteRaw(path, image);
+        break;
+    case ImageFileFormat::Ppm:
+        WritePpm(path, image);
+        break;
+    case ImageFileFormat::Png:
+        WritePng(path, image);
+        break;
+    default:
+        break;
+    }
+}
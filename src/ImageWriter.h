@@ -0,0 +1,40 @@
+#pragma once
+#include <optional>
+#include <string>
+#include "CBgraImage.h"
+
+enum class ImageFileFormat
+{
+    None,
+    Raw,
+    Ppm,
+    Png
+};
+
+namespace ImageWriter
+{
+    /**
+     * @brief 将格式名称(none/raw/ppm/png)转换为ImageFileFormat
+     */
+    auto ParseImageFileFormat(const std::string& name) noexcept
+        -> std::optional<ImageFileFormat>;
+    /**
+     * @brief 获取格式对应的文件扩展名，包含'.'
+     */
+    auto GetFileExtension(ImageFileFormat format) noexcept
+        -> const char*;
+
+    /**
+     * @brief 按行紧密排列写出BGRA8原始数据，不含文件头
+     */
+    void WriteRaw(const std::string& path, const CBgraImage& image);
+    /**
+     * @brief 写出二进制PPM(P6)，alpha通道被丢弃
+     */
+    void WritePpm(const std::string& path, const CBgraImage& image);
+    /**
+     * @brief 写出RGBA8 PNG，使用不压缩的deflate块，因此不依赖zlib
+     */
+    void WritePng(const std::string& path, const CBgraImage& image);
+    void Write(const std::string& path, const CBgraImage& image, ImageFileFormat format);
+}
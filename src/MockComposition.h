@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "CBgraImage.h"
+#include "CGdiCompositionPipeline.h"
+#include "CMockD3D11Device.h"
+#include "CMockManifestBackend.h"
+
+constexpr std::uint32_t MOCK_SURFACE_WIDTH = 350;
+constexpr std::uint32_t MOCK_SURFACE_HEIGHT = 100;
+
+using MockCompositionPipeline = CGdiCompositionPipeline<CMockResourceManifest>;
+
+/**
+ * @brief 窗口模式中的合成管线在模拟设备上的实例，后台缓冲区与交换链的一样不经过资源清单 \n
+ * 编译后的着色器字节码通常为1到2KB，这里以同样大小的数据代替
+ */
+struct MockComposition
+{
+    CMockResourceManifest m_manifest;
+    MockHandle m_alpha_increase_constants{};
+    MockHandle m_blit_constants{};
+    MockCompositionPipeline m_pipeline;
+    MockObject* m_p_back_buffer{};
+    MockObject* m_p_back_buffer_rtv{};
+
+    static auto GetConfig()
+        -> GdiCompositionPipelineConfig
+    {
+        static const std::vector<std::uint8_t> byte_code(1536, 0x44);
+        GdiCompositionPipelineConfig config{};
+        config.m_width = MOCK_SURFACE_WIDTH;
+        config.m_height = MOCK_SURFACE_HEIGHT;
+        config.m_vertex_shader = byte_code;
+        config.m_alpha_increase_shader = byte_code;
+        config.m_scaled_blit_shader = byte_code;
+        return config;
+    }
+
+    explicit MockComposition(CMockD3D11Device& device)
+        : m_manifest{device},
+          m_alpha_increase_constants{m_manifest.CreateBuffer({32, GpuUsage::DYNAMIC, GpuBindFlag::CONSTANT_BUFFER, GpuCpuAccessFlag::WRITE}, nullptr)},
+          m_blit_constants{m_manifest.CreateBuffer({16, GpuUsage::DYNAMIC, GpuBindFlag::CONSTANT_BUFFER, GpuCpuAccessFlag::WRITE}, nullptr)},
+          m_pipeline{m_manifest, GetConfig(), m_alpha_increase_constants, m_blit_constants}
+    {
+        GpuTexture2DDescription back_buffer_description{};
+        back_buffer_description.m_width = MOCK_SURFACE_WIDTH;
+        back_buffer_description.m_height = MOCK_SURFACE_HEIGHT;
+        back_buffer_description.m_bind_flags = GpuBindFlag::RENDER_TARGET;
+        m_p_back_buffer = device.CreateTexture2D(back_buffer_description, nullptr);
+        m_p_back_buffer_rtv = device.CreateRenderTargetView(m_p_back_buffer);
+    }
+};
+
+/**
+ * @brief 与窗口模式中CD3D11GdiComposition::Composite相同：写入常量缓冲区，再由合成管线的渲染图上传四分之一表面、alpha修正和输出
+ */
+template <class Context>
+void CompositeMockFrame(Context& context, const MockComposition& composition, const CBgraImage& surface, float render_scale)
+{
+    const auto& manifest = composition.m_manifest;
+    auto write_constants = [&context](MockObject* p_buffer, const auto& constants)
+    {
+        MockMappedSubresource mapped{};
+        context.Map(p_buffer, 0u, GpuMap::WRITE_DISCARD, 0u, &mapped);
+        std::memcpy(mapped.m_p_data, constants.data(), sizeof(constants));
+        context.Unmap(p_buffer, 0u);
+    };
+    write_constants(manifest.Get(composition.m_alpha_increase_constants), std::array<float, 8>{1.0f, 1.0f, 1.0f, 1.0f, 1.0f / 255.0f, 0.0f, 0.0f, 0.0f});
+    write_constants(manifest.Get(composition.m_blit_constants), std::array<float, 4>{render_scale, render_scale, 0.0f, 0.0f});
+    auto draw = [&context]()
+    {
+        context.DrawIndexed(MockCompositionPipeline::GetIndexCount(), 0u, 0);
+    };
+    auto upload = [&]()
+    {
+        const MockBox dirty_box{0, 0, 0, MOCK_SURFACE_WIDTH, MOCK_SURFACE_HEIGHT / 4, 1};
+        context.UpdateSubresource(manifest.Get(composition.m_pipeline.GetGdiInitialTexture()), 0u, &dirty_box, surface.GetData(), surface.GetRowPitch(), 0u);
+    };
+    composition.m_pipeline.Execute(context,
+                                   render_scale,
+                                   composition.m_p_back_buffer,
+                                   composition.m_p_back_buffer_rtv,
+                                   upload,
+                                   draw,
+                                   [](GdiCompositionPass, auto&& run)
+                                   { run(); });
+}
@@ -0,0 +1,154 @@
+#include "OffscreenMode.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+#include "CSoftwareRenderer.h"
+
+namespace
+{
+    auto ParseUnsigned(const std::string& text, const char* p_option_name)
+        -> std::uint32_t
+    {
+        try
+        {
+            std::size_t end = 0;
+            const auto result = std::stoul(text, &end);
+            if (end != text.size())
+            {
+                throw std::invalid_argument{text};
+            }
+            return static_cast<std::uint32_t>(result);
+        }
+        catch (const std::logic_error&)
+        {
+            throw std::invalid_argument{std::string{"Invalid value for "} + p_option_name + ": " + text};
+        }
+    }
+}
+
+auto OffscreenMode::ParseOptions(int argc, const char* const argv[], const OffscreenOptions& defaults)
+    -> std::optional<OffscreenOptions>
+{
+    std::vector<std::string> arguments{argv + (std::min)(argc, 1), argv + argc};
+    if (std::find(arguments.begin(), arguments.end(), "--offscreen") == arguments.end())
+    {
+        return std::nullopt;
+    }
+
+    auto result = defaults;
+    for (std::size_t i = 0; i < arguments.size(); ++i)
+    {
+        const auto& argument = arguments[i];
+        if (argument == "--offscreen")
+        {
+            continue;
+        }
+        if (i + 1 == arguments.size())
+        {
+            throw std::invalid_argument{"Missing value for " + argument};
+        }
+        const auto& value = arguments[++i];
+        if (argument == "--frames")
+        {
+            result.m_frame_count = ParseUnsigned(value, "--frames");
+        }
+        else if (argument == "--size")
+        {
+            const auto separator = value.find('x');
+            if (separator == std::string::npos)
+            {
+                throw std::invalid_argument{"Size should be WxH: " + value};
+            }
+            result.m_width = ParseUnsigned(value.substr(0, separator), "--size");
+            result.m_height = ParseUnsigned(value.substr(separator + 1), "--size");
+        }
+        else if (argument == "--format")
+        {
+            auto format = ImageWriter::ParseImageFileFormat(value);
+            if (!format)
+            {
+                throw std::invalid_argument{"Unknown image format: " + value};
+            }
+            result.m_output_format = *format;
+        }
+        else if (argument == "--output")
+        {
+            result.m_output_prefix = value;
+        }
+        else
+        {
+            throw std::invalid_argument{"Unknown option: " + argument};
+        }
+    }
+    if (result.m_width == 0 || result.m_height == 0)
+    {
+        throw std::invalid_argument{"Offscreen target size must not be empty."};
+    }
+    return result;
+}
+
+void OffscreenMode::DrawTestPattern(CBgraImage& image, std::uint32_t frame_index) noexcept
+{
+    // GDI绘制后alpha通道总是0，这里用滚动的竖条模拟文字笔画
+    for (std::uint32_t y = 0; y < image.GetHeight(); ++y)
+    {
+        auto* p_pixel = image.GetRow(y);
+        for (std::uint32_t x = 0; x < image.GetWidth(); ++x, p_pixel += CBgraImage::BYTES_PER_PIXEL)
+        {
+            const auto u = x + frame_index;
+            const bool is_stroke = (u / 3) % 4 == 0 && (y / 10) % 2 == 0;
+            p_pixel[0] = is_stroke ? 0xFF : static_cast<std::uint8_t>(y * 255 / image.GetHeight());
+            p_pixel[1] = is_stroke ? 0xFF : static_cast<std::uint8_t>(u);
+            p_pixel[2] = is_stroke ? 0xFF : 0;
+            p_pixel[3] = 0;
+        }
+    }
+}
+
+int OffscreenMode::Run(const OffscreenOptions& options)
+{
+    using Clock = std::chrono::steady_clock;
+
+    CBgraImage gdi_initial_image{options.m_width, options.m_height};
+    CBgraImage gdi_final_image{options.m_width, options.m_height};
+    CSoftwareRenderer renderer{};
+    std::vector<double> frame_times_ms{};
+    frame_times_ms.reserve(options.m_frame_count);
+
+    for (std::uint32_t frame_index = 0; frame_index < options.m_frame_count; ++frame_index)
+    {
+        const auto begin = Clock::now();
+        DrawTestPattern(gdi_initial_image, frame_index);
+        gdi_final_image.Fill(0, 0, 0, 0);
+        renderer.RenderAlphaIncreasePass(gdi_initial_image, gdi_final_image);
+        const auto end = Clock::now();
+        frame_times_ms.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+
+        if (options.m_output_format != ImageFileFormat::None)
+        {
+            const auto path = options.m_output_prefix + std::to_string(frame_index) + ImageWriter::GetFileExtension(options.m_output_format);
+            ImageWriter::Write(path, gdi_final_image, options.m_output_format);
+        }
+        std::printf("frame %u: %.3f ms\n", frame_index, frame_times_ms.back());
+    }
+
+    if (!frame_times_ms.empty())
+    {
+        const auto [p_min, p_max] = std::minmax_element(frame_times_ms.begin(), frame_times_ms.end());
+        double total = 0;
+        for (auto frame_time : frame_times_ms)
+        {
+            total += frame_time;
+        }
+        std::printf("%zu frames %ux%u: min %.3f ms, avg %.3f ms, max %.3f ms\n",
+                    frame_times_ms.size(),
+                    options.m_width,
+                    options.m_height,
+                    *p_min,
+                    total / frame_times_ms.size(),
+                    *p_max);
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "CBgraImage.h"
+#include "ImageWriter.h"
+
+/**
+ * @brief 无窗口渲染模式的参数，对应命令行 \n
+ * --offscreen [--frames N] [--size WxH] [--format none|raw|ppm|png] [--output 前缀]
+ */
+struct OffscreenOptions
+{
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_frame_count{60};
+    ImageFileFormat m_output_format{ImageFileFormat::None};
+    std::string m_output_prefix{"frame"};
+};
+
+/**
+ * @brief 不需要显示器和GPU的渲染模式，在CPU后端上执行完整管线并输出图像和每帧耗时
+ */
+namespace OffscreenMode
+{
+    /**
+     * @brief 解析命令行，没有--offscreen时返回std::nullopt；参数非法时抛出std::invalid_argument
+     *
+     * @param defaults 未在命令行指定的参数使用的值
+     */
+    auto ParseOptions(int argc, const char* const argv[], const OffscreenOptions& defaults)
+        -> std::optional<OffscreenOptions>;
+
+    /**
+     * @brief 模拟GDI的输出：alpha全为0，内容随帧序号滚动
+     */
+    void DrawTestPattern(CBgraImage& image, std::uint32_t frame_index) noexcept;
+
+    /**
+     * @brief 执行无窗口渲染
+     *
+     * @return int 进程返回值
+     */
+    int Run(const OffscreenOptions& options);
+}
@@ -0,0 +1,223 @@
+#include "PerfLint.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <utility>
+
+namespace
+{
+    template <class Description>
+    auto As(const PerfLintSubject& subject) noexcept
+        -> const Description*
+    {
+        return std::get_if<Description>(&subject);
+    }
+
+    bool IsDebugLayerInReleaseBuild(const PerfLintSubject& subject)
+    {
+        const auto* p_device = As<LintDeviceDescription>(subject);
+        return p_device != nullptr &&
+               (p_device->m_creation_flags & GpuDeviceCreationFlag::DEBUG_LAYER) != 0 &&
+               !p_device->m_is_debug_build;
+    }
+
+    bool IsStaticBufferDefaultUsage(const PerfLintSubject& subject)
+    {
+        // 带初始数据、只作为顶点/索引缓冲绑定、CPU不访问，创建后通常不再修改
+        constexpr auto STATIC_BIND_FLAGS = GpuBindFlag::VERTEX_BUFFER | GpuBindFlag::INDEX_BUFFER;
+        const auto* p_buffer = As<LintBufferDescription>(subject);
+        return p_buffer != nullptr &&
+               p_buffer->m_usage == GpuUsage::DEFAULT &&
+               p_buffer->m_has_initial_data &&
+               p_buffer->m_cpu_access_flags == 0 &&
+               p_buffer->m_bind_flags != 0 &&
+               (p_buffer->m_bind_flags & ~STATIC_BIND_FLAGS) == 0;
+    }
+
+    bool IsStaticTextureDefaultUsage(const PerfLintSubject& subject)
+    {
+        const auto* p_texture = As<LintTextureDescription>(subject);
+        return p_texture != nullptr &&
+               p_texture->m_usage == GpuUsage::DEFAULT &&
+               p_texture->m_has_initial_data &&
+               p_texture->m_cpu_access_flags == 0 &&
+               p_texture->m_bind_flags == GpuBindFlag::SHADER_RESOURCE;
+    }
+
+    bool IsRenderTargetWithInitialData(const PerfLintSubject& subject)
+    {
+        const auto* p_texture = As<LintTextureDescription>(subject);
+        return p_texture != nullptr &&
+               p_texture->m_has_initial_data &&
+               (p_texture->m_bind_flags & (GpuBindFlag::RENDER_TARGET | GpuBindFlag::DEPTH_STENCIL)) != 0;
+    }
+
+    bool IsStagingTextureWithMipChain(const PerfLintSubject& subject)
+    {
+        const auto* p_texture = As<LintTextureDescription>(subject);
+        return p_texture != nullptr &&
+               p_texture->m_usage == GpuUsage::STAGING &&
+               p_texture->m_mip_levels != 1;
+    }
+
+    bool IsFilteringAtUnitScale(const PerfLintSubject& subject)
+    {
+        const auto* p_sampler = As<LintSamplerDescription>(subject);
+        return p_sampler != nullptr &&
+               p_sampler->m_sampling_scale == 1.0f &&
+               (p_sampler->m_filter & GpuFilter::FILTERING_MASK) != 0;
+    }
+
+    bool IsPassThroughBlend(const PerfLintSubject& subject)
+    {
+        const auto* p_blend = As<LintBlendDescription>(subject);
+        return p_blend != nullptr &&
+               p_blend->m_is_blend_enabled &&
+               p_blend->m_source_blend == GpuBlend::ONE &&
+               p_blend->m_destination_blend == GpuBlend::ZERO &&
+               p_blend->m_blend_operation == GpuBlend::OP_ADD &&
+               p_blend->m_source_alpha_blend == GpuBlend::ONE &&
+               p_blend->m_destination_alpha_blend == GpuBlend::ZERO &&
+               p_blend->m_alpha_blend_operation == GpuBlend::OP_ADD;
+    }
+
+    constexpr std::array RULES{
+        PerfLintRule{
+            "device-debug-layer",
+            PerfLintSeverity::Warning,
+            "device is created with the debug layer in a release build, every API call is validated",
+            "pass D3D11_CREATE_DEVICE_DEBUG only in debug builds",
+            &IsDebugLayerInReleaseBuild},
+        PerfLintRule{
+            "buffer-static-default-usage",
+            PerfLintSeverity::Warning,
+            "vertex/index buffer with initial data and no CPU access uses DEFAULT usage",
+            "use D3D11_USAGE_IMMUTABLE unless the buffer is updated with UpdateSubresource",
+            &IsStaticBufferDefaultUsage},
+        PerfLintRule{
+            "texture-static-default-usage",
+            PerfLintSeverity::Warning,
+            "shader-resource-only texture with initial data and no CPU access uses DEFAULT usage",
+            "use D3D11_USAGE_IMMUTABLE unless the texture is updated after creation",
+            &IsStaticTextureDefaultUsage},
+        PerfLintRule{
+            "texture-render-target-initial-data",
+            PerfLintSeverity::Info,
+            "render target or depth texture is created with initial data that rendering overwrites",
+            "create it without initial data and clear it on first use",
+            &IsRenderTargetWithInitialData},
+        PerfLintRule{
+            "texture-staging-mip-chain",
+            PerfLintSeverity::Info,
+            "staging texture allocates more than one mip level",
+            "set MipLevels to 1 unless every level is read back",
+            &IsStagingTextureWithMipChain},
+        PerfLintRule{
+            "sampler-filtering-at-unit-scale",
+            PerfLintSeverity::Warning,
+            "sampler filters a texture that is drawn texel-to-pixel at 1:1",
+            "use D3D11_FILTER_MIN_MAG_MIP_POINT, the result is identical and cheaper",
+            &IsFilteringAtUnitScale},
+        PerfLintRule{
+            "blend-pass-through",
+            PerfLintSeverity::Warning,
+            "blending is enabled with ONE/ZERO/ADD, which passes the source through",
+            "disable blending for this render target",
+            &IsPassThroughBlend},
+    };
+
+    auto GetFileName(const char* p_path) noexcept
+        -> std::string_view
+    {
+        const std::string_view path{p_path};
+        const auto separator = path.find_last_of("/\\");
+        return separator == std::string_view::npos ? path : path.substr(separator + 1);
+    }
+}
+
+auto PerfLint::GetRules() noexcept
+    -> std::span<const PerfLintRule>
+{
+    return RULES;
+}
+
+auto PerfLint::Evaluate(const PerfLintSubject& subject)
+    -> std::vector<const PerfLintRule*>
+{
+    std::vector<const PerfLintRule*> result{};
+    for (const auto& rule : RULES)
+    {
+        if (rule.m_p_is_violated(subject))
+        {
+            result.push_back(&rule);
+        }
+    }
+    return result;
+}
+
+auto PerfLint::FormatWarning(const PerfLintWarning& warning)
+    -> std::string
+{
+    const auto file_name = GetFileName(warning.m_location.file_name());
+    std::string result{"perf lint "};
+    result += warning.m_p_rule->m_severity == PerfLintSeverity::Warning ? "warning" : "info";
+    result += " [";
+    result += warning.m_p_rule->m_p_id;
+    result += "] ";
+    result += file_name;
+    result += ':';
+    result += std::to_string(warning.m_location.line());
+    result += ": ";
+    result += warning.m_p_rule->m_p_message;
+    result += "; ";
+    result += warning.m_p_rule->m_p_suggestion;
+    return result;
+}
+
+CPerfLinter::CPerfLinter(WarningSink warning_sink)
+    : m_warning_sink{std::move(warning_sink)}
+{
+    if (!m_warning_sink)
+    {
+        m_warning_sink = [](const PerfLintWarning& warning)
+        {
+            std::printf("%s\n", PerfLint::FormatWarning(warning).c_str());
+        };
+    }
+}
+
+auto CPerfLinter::Check(const PerfLintSubject& subject, const std::source_location& location)
+    -> std::size_t
+{
+    ++m_statistics.m_checked_count;
+    std::size_t warning_count = 0;
+    for (const auto* p_rule : PerfLint::Evaluate(subject))
+    {
+        if (std::find(m_disabled_rule_ids.begin(), m_disabled_rule_ids.end(), p_rule->m_p_id) != m_disabled_rule_ids.end())
+        {
+            continue;
+        }
+        m_warnings.push_back({p_rule, location});
+        m_warning_sink(m_warnings.back());
+        ++warning_count;
+    }
+    m_statistics.m_warning_count += warning_count;
+    return warning_count;
+}
+
+void CPerfLinter::DisableRule(std::string_view rule_id)
+{
+    m_disabled_rule_ids.emplace_back(rule_id);
+}
+
+auto CPerfLinter::GetWarnings() const noexcept
+    -> const std::vector<PerfLintWarning>&
+{
+    return m_warnings;
+}
+
+auto CPerfLinter::GetStatistics() const noexcept
+    -> const PerfLintStatistics&
+{
+    return m_statistics;
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#ifdef _WIN32
+#include <d3d11.h>
+#endif
+#include "GpuResourceDescription.h"
+
+namespace GpuDeviceCreationFlag
+{
+    constexpr std::uint32_t SINGLETHREADED = 0x1;
+    // 不命名为DEBUG，调试构建定义了同名的宏
+    constexpr std::uint32_t DEBUG_LAYER = 0x2;
+    constexpr std::uint32_t BGRA_SUPPORT = 0x20;
+}
+
+#ifdef _WIN32
+static_assert(GpuDeviceCreationFlag::SINGLETHREADED == D3D11_CREATE_DEVICE_SINGLETHREADED);
+static_assert(GpuDeviceCreationFlag::DEBUG_LAYER == D3D11_CREATE_DEVICE_DEBUG);
+static_assert(GpuDeviceCreationFlag::BGRA_SUPPORT == D3D11_CREATE_DEVICE_BGRA_SUPPORT);
+#endif
+
+struct LintDeviceDescription
+{
+    std::uint32_t m_creation_flags{};
+    bool m_is_debug_build{};
+};
+
+struct LintBufferDescription
+{
+    std::uint32_t m_byte_width{};
+    std::uint32_t m_usage{};
+    std::uint32_t m_bind_flags{};
+    std::uint32_t m_cpu_access_flags{};
+    bool m_has_initial_data{};
+};
+
+struct LintTextureDescription
+{
+    std::uint32_t m_width{};
+    std::uint32_t m_height{};
+    std::uint32_t m_mip_levels{};
+    std::uint32_t m_array_size{};
+    std::uint32_t m_format{};
+    std::uint32_t m_usage{};
+    std::uint32_t m_bind_flags{};
+    std::uint32_t m_cpu_access_flags{};
+    bool m_has_initial_data{};
+};
+
+struct LintSamplerDescription
+{
+    std::uint32_t m_filter{};
+    std::uint32_t m_max_anisotropy{};
+    /**
+     * @brief 采样时一个纹素对应的像素数，为0表示未知
+     */
+    float m_sampling_scale{};
+};
+
+/**
+ * @brief 只描述第0个渲染目标的混合状态
+ */
+struct LintBlendDescription
+{
+    bool m_is_blend_enabled{};
+    std::uint32_t m_source_blend{};
+    std::uint32_t m_destination_blend{};
+    std::uint32_t m_blend_operation{};
+    std::uint32_t m_source_alpha_blend{};
+    std::uint32_t m_destination_alpha_blend{};
+    std::uint32_t m_alpha_blend_operation{};
+};
+
+using PerfLintSubject = std::variant<
+    LintDeviceDescription,
+    LintBufferDescription,
+    LintTextureDescription,
+    LintSamplerDescription,
+    LintBlendDescription>;
+
+enum class PerfLintSeverity : std::uint8_t
+{
+    Info,
+    Warning,
+};
+
+struct PerfLintRule
+{
+    const char* m_p_id;
+    PerfLintSeverity m_severity;
+    const char* m_p_message;
+    const char* m_p_suggestion;
+    /**
+     * @brief 描述违反该规则时返回true，不适用于该类描述时返回false
+     */
+    bool (*m_p_is_violated)(const PerfLintSubject& subject);
+};
+
+struct PerfLintWarning
+{
+    const PerfLintRule* m_p_rule{};
+    std::source_location m_location{};
+};
+
+/**
+ * @brief 资源创建时的性能规则表，规则是只看描述结构体的纯函数
+ */
+namespace PerfLint
+{
+    auto GetRules() noexcept
+        -> std::span<const PerfLintRule>;
+    /**
+     * @brief 返回subject违反的全部规则
+     */
+    auto Evaluate(const PerfLintSubject& subject)
+        -> std::vector<const PerfLintRule*>;
+    /**
+     * @brief 格式化为一行：严重程度、规则编号、调用位置、说明和建议
+     */
+    auto FormatWarning(const PerfLintWarning& warning)
+        -> std::string;
+}
+
+struct PerfLintStatistics
+{
+    std::uint64_t m_checked_count{};
+    std::uint64_t m_warning_count{};
+};
+
+/**
+ * @brief 在创建资源、状态和设备时按规则表检查描述，记录违反的规则及调用位置并交给输出函数
+ */
+class CPerfLinter
+{
+public:
+    using WarningSink = std::function<void(const PerfLintWarning&)>;
+
+private:
+    WarningSink m_warning_sink{};
+    std::vector<PerfLintWarning> m_warnings{};
+    std::vector<std::string> m_disabled_rule_ids{};
+    PerfLintStatistics m_statistics{};
+
+public:
+    /**
+     * @param warning_sink 每条警告产生时调用，为空时用printf输出
+     */
+    explicit CPerfLinter(WarningSink warning_sink = {});
+    ~CPerfLinter() = default;
+
+    /**
+     * @brief 检查一个描述
+     *
+     * @param location 默认为调用者的位置；经过包装函数转发时应由包装函数的调用者提供
+     * @return 本次产生的警告数
+     */
+    auto Check(const PerfLintSubject& subject, const std::source_location& location = std::source_location::current())
+        -> std::size_t;
+    /**
+     * @brief 不再报告某条规则，用于确认过的例外
+     */
+    void DisableRule(std::string_view rule_id);
+
+    auto GetWarnings() const noexcept
+        -> const std::vector<PerfLintWarning>&;
+    auto GetStatistics() const noexcept
+        -> const PerfLintStatistics&;
+};
@@ -0,0 +1,36 @@
+#include <cstdio>
+#include <exception>
+#include "BenchmarkMode.h"
+#include "OffscreenMode.h"
+
+/**
+ * @brief 不依赖窗口和D3D设备的入口，只提供 --offscreen 和 --benchmark 两种模式 \n
+ * 无窗口渲染的默认尺寸与WindowMode::WINDOW_SIZE一致
+ */
+int main(int argc, char* argv[])
+{
+    try
+    {
+        OffscreenOptions offscreen_defaults{};
+        offscreen_defaults.m_width = 350;
+        offscreen_defaults.m_height = 100;
+        if (auto offscreen_options = OffscreenMode::ParseOptions(argc, argv, offscreen_defaults))
+        {
+            return OffscreenMode::Run(*offscreen_options);
+        }
+        if (auto benchmark_name = BenchmarkMode::ParseBenchmarkName(argc, argv))
+        {
+            return BenchmarkMode::Run(*benchmark_name);
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::fprintf(stderr, "%s\n", exception.what());
+        return 1;
+    }
+    std::fprintf(stderr, "usage: %s --offscreen [--frames N] [--size WxH] [--format none|raw|ppm|png] [--output PREFIX]\n"
+                         "       %s --benchmark NAME|all\n",
+                 argv[0],
+                 argv[0]);
+    return 1;
+}
@@ -0,0 +1,1758 @@
+#include "WindowMode.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <Windows.h>
+#include <wrl/client.h>
+#include <dxgi1_3.h>
+#include <d3d11_2.h>
+#include <DXProgrammableCapture.h>
+#include <dxgitype.h>
+#include "CCapturingDeviceContext.h"
+#include "CCoverageImage.h"
+#include "CCpuCompositor.h"
+#include "CD3D11ConstantBufferManager.h"
+#include "CD3D11FrameFence.h"
+#include "CD3D11FrameTraceBackend.h"
+#include "CD3D11GpuTimerBackend.h"
+#include "CD3D11ReadbackBackend.h"
+#include "CD3D11ResourceManifest.h"
+#include "CD3D11ResourceRegistry.h"
+#include "CD3D11UploadBackend.h"
+#include "CDeferredReleaseQueue.h"
+#include "CDrawQueue.h"
+#include "CGdiCompositionPipeline.h"
+#include "CGdiSurfaceMemory.h"
+#include "CGpuMemoryBudget.h"
+#include "CInstrumentedDeviceContext.h"
+#include "CMappedFile.h"
+#include "CMappedSurface.h"
+#include "CReadbackRing.h"
+#include "CRenderThread.h"
+#include "CResolutionGovernor.h"
+#include "CSharedFrameRing.h"
+#include "CShader.h"
+#include "CSwapChainPresenter.h"
+#include "CTimingWheel.h"
+#include "CTripleBuffer.h"
+#include "CUploadEngine.h"
+#include "CompositorCostModel.h"
+#include "ConstantBuffer.h"
+#include "CoverageConversion.h"
+#include "FrameTrace.h"
+#include "HResultException.h"
+#include "ImageWriter.h"
+#include "PerfLint.h"
+
+using Microsoft::WRL::ComPtr;
+using WindowMode::WINDOW_SIZE;
+
+/**
+ * @brief 析构StaticVariableWrapper包装对象前默认执行的函数，实际上无操作
+ *
+ * @tparam T
+ */
+template <class T>
+class CDefaultStaticVariableWrapperDtor
+{
+public:
+    void operator()(T*) const {};
+};
+/**
+ * @brief 设计上用于静态变量包装类，用于自定义变量默认初始化后行为和析构前行为
+ *
+ * @tparam T 要被包装的类型
+ * @tparam DTOR 自定义执行析构函数前的行为
+ */
+template <class T, class DTOR = CDefaultStaticVariableWrapperDtor<T>>
+class CStaticVariableWrapper : private DTOR
+{
+private:
+    T m_content;
+
+public:
+    /**
+     * @brief 构造一个StaticVariableWrapper
+     *
+     * @tparam CTOR 自定义变量默认初始化后的函数类型
+     * @param ctor 自定义变量默认初始化后的行为，传入变量的指针作为参数
+     * @param dtor 自定义变量执行析构函数前的行为，传入变量的指针作为参数
+     */
+    template <class CTOR>
+    CStaticVariableWrapper(CTOR ctor, DTOR dtor = {})
+        : DTOR{dtor}
+    {
+        ctor(std::addressof(m_content));
+    }
+    ~CStaticVariableWrapper()
+    {
+        (*static_cast<DTOR*>(this))(std::addressof(m_content));
+    }
+    T& Get() noexcept
+    {
+        return m_content;
+    }
+    const T& Get() const noexcept
+    {
+        return m_content;
+    }
+};
+/**
+ * @brief 生成静态变量包装类的函数
+ *
+ * @tparam T 要被包装的类型
+ * @tparam CTOR 自定义变量默认初始化后的函数类型
+ * @tparam DTOR 自定义变量执行析构函数前的函数类型
+ * @param ctor 自定义变量默认初始化后的行为，传入变量的指针作为参数
+ * @param dtor 自定义变量执行析构函数前的行为，传入变量的指针作为参数
+ * @return CStaticVariableWrapper<T, DTOR> 包装后的变量，已经初始化
+ */
+template <class T, class CTOR, class DTOR = CDefaultStaticVariableWrapperDtor<T>>
+auto MakeStaticVariableWrapper(CTOR ctor, DTOR dtor = {})
+    -> CStaticVariableWrapper<T, DTOR>
+{
+    return {ctor, dtor};
+}
+
+/**
+ * @brief 调用指针指向的对象的对应类型的析构函数
+ *
+ * @tparam T 传入的移除了指针后的类型
+ * @param p_memory 指向要执行析构函数的对象的指针
+ */
+template <class T>
+void Destroy(T* p_memory)
+{
+    p_memory->~T();
+}
+
+template <class T, class... Args>
+void EmplaceAt(T* p_memory, Args&&... args)
+{
+    ::new (p_memory) T(std::forward<Args>(args)...);
+}
+
+#define CIMAGE2DEFFECT_SHADER_VS_INPUT_DECLARATION \
+    "struct VsInput"                               \
+    "{"                                            \
+    "float3 position : POSITION0;"                 \
+    "float2 texture0 : TEXCOORD0;"                 \
+    "};"
+
+#define CIMAGE2DEFFECT_SHADER_VS_OUTPUT_DECLARATION \
+    "struct VsOutput"                               \
+    "{"                                             \
+    "float4 position : SV_POSITION;"                \
+    "float2 texture0 : TEXCOORD0;"                  \
+    "};"
+
+namespace D3DQuadrangle
+{
+    const CShader& GetVsShader()
+    {
+        static auto result = MakeStaticVariableWrapper<CShader>(
+            [](CShader* p_content)
+            {
+                p_content->SetCode(
+                             CIMAGE2DEFFECT_SHADER_VS_INPUT_DECLARATION
+                                 CIMAGE2DEFFECT_SHADER_VS_OUTPUT_DECLARATION
+                             R"(
+VsOutput VS(VsInput input){
+   VsOutput result;
+   result.position = float4(input.position, 1.0f);
+   result.texture0 = input.texture0;
+   return result;
+}
+)")
+                    .SetEntryPoint("VS")
+                    .SetName("D3DQuadrangleDefaultVS")
+                    .SetTarget("vs_4_1")
+                    .SetFlags1(D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_WARNINGS_ARE_ERRORS);
+            });
+        return result.Get();
+    }
+}
+
+LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    switch (message)
+    {
+    case WM_DESTROY:
+        ::PostQuitMessage(0);
+        return 0;
+    default:
+        return ::DefWindowProc(hwnd, message, wParam, lParam);
+    }
+}
+
+constexpr auto PIXEL_FORMAT = DXGI_FORMAT_B8G8R8A8_UNORM;
+constexpr auto SHARED_FRAME_NAME = "DX11Rendering2DDemoFrames";
+// 与游戏同时运行，显存占用必须有上限
+constexpr std::uint64_t GPU_MEMORY_BUDGET_BYTES = 32ull << 20;
+constexpr std::uint64_t GPU_MEMORY_HARD_LIMIT_BYTES = 64ull << 20;
+#ifdef DEBUG
+constexpr bool IS_DEBUG_BUILD = true;
+#else
+constexpr bool IS_DEBUG_BUILD = false;
+#endif
+
+constexpr auto COVERAGE_PIXEL_FORMAT = DXGI_FORMAT_R8_UNORM;
+
+/**
+ * @brief 与PsGdiTexturePreprocessor、PsCoverageTexturePreprocessor中的cbuffer AlphaIncreaseConstants对应
+ */
+struct AlphaIncreaseConstants
+{
+    float m_text_color[4]{1.0f, 1.0f, 1.0f, 1.0f};
+    float m_alpha_increment{1.0f / 255.0f};
+    float m_padding[3]{};
+};
+HLSL_CHECK_PACKING(AlphaIncreaseConstants, m_text_color);
+HLSL_CHECK_PACKING(AlphaIncreaseConstants, m_alpha_increment);
+
+/**
+ * @brief 与PsScaledBlit中的cbuffer BlitConstants对应
+ */
+struct BlitConstants
+{
+    float m_uv_scale[2]{1.0f, 1.0f};
+    float m_padding[2]{};
+};
+HLSL_CHECK_PACKING(BlitConstants, m_uv_scale);
+
+/**
+ * @brief 采样线程发布给渲染线程的系统状态，内容不变时不会重新绘制
+ */
+struct SystemStatsSnapshot
+{
+    std::uint32_t m_cpu_percent{};
+    std::uint32_t m_memory_percent{};
+};
+
+/**
+ * @brief 按两次GetSystemTimes之间的差值计算CPU占用率
+ */
+class CSystemStatsSampler
+{
+private:
+    std::uint64_t m_last_idle_time{};
+    std::uint64_t m_last_total_time{};
+
+    static std::uint64_t ToUInt64(const FILETIME& file_time) noexcept
+    {
+        return (static_cast<std::uint64_t>(file_time.dwHighDateTime) << 32) | file_time.dwLowDateTime;
+    }
+
+public:
+    auto Sample()
+        -> SystemStatsSnapshot
+    {
+        SystemStatsSnapshot snapshot{};
+        FILETIME idle_time{};
+        FILETIME kernel_time{};
+        FILETIME user_time{};
+        if (::GetSystemTimes(&idle_time, &kernel_time, &user_time))
+        {
+            // 内核时间中包含了空闲时间
+            const auto idle = ToUInt64(idle_time);
+            const auto total = ToUInt64(kernel_time) + ToUInt64(user_time);
+            const auto total_delta = total - m_last_total_time;
+            if (m_last_total_time != 0 && total_delta != 0)
+            {
+                snapshot.m_cpu_percent = static_cast<std::uint32_t>(100 - (idle - m_last_idle_time) * 100 / total_delta);
+            }
+            m_last_idle_time = idle;
+            m_last_total_time = total;
+        }
+        MEMORYSTATUSEX memory_status{};
+        memory_status.dwLength = sizeof(memory_status);
+        if (::GlobalMemoryStatusEx(&memory_status))
+        {
+            snapshot.m_memory_percent = memory_status.dwMemoryLoad;
+        }
+        return snapshot;
+    }
+};
+
+
+namespace
+{
+    namespace GdiCompositionShaders
+    {
+        const CShader& GetAlphaIncreaseShader()
+        {
+            static auto result = MakeStaticVariableWrapper<CShader>(
+                [](CShader* p_content)
+                {
+                    p_content->SetCode(
+                                 CIMAGE2DEFFECT_SHADER_VS_OUTPUT_DECLARATION
+                                 R"(
+SamplerState input_sampler : register(ps_4_1, s0);
+Texture2D input_texture : register(ps_4_1, t0);
+cbuffer AlphaIncreaseConstants : register(ps_4_1, b0)
+{
+    float4 text_color;
+    float alpha_increment;
+};
+
+float4 PS(VsOutput ps_in) : SV_TARGET
+{
+    float4 color = input_texture.Sample(input_sampler, ps_in.texture0);
+    color.w += alpha_increment;
+    color.w = min(1.0, color.w);
+    return color;
+}
+)")
+                        .SetEntryPoint("PS")
+                        .SetName("PsGdiTexturePreprocessor")
+                        .SetTarget("ps_4_1")
+                        .SetFlags1(D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_WARNINGS_ARE_ERRORS);
+                });
+            return result.Get();
+        }
+
+        const CShader& GetCoverageAlphaIncreaseShader()
+        {
+            static auto result = MakeStaticVariableWrapper<CShader>(
+                [](CShader* p_content)
+                {
+                    p_content->SetCode(
+                                 CIMAGE2DEFFECT_SHADER_VS_OUTPUT_DECLARATION
+                                 R"(
+SamplerState input_sampler : register(ps_4_1, s0);
+Texture2D<float> input_coverage : register(ps_4_1, t0);
+cbuffer AlphaIncreaseConstants : register(ps_4_1, b0)
+{
+    float4 text_color;
+    float alpha_increment;
+};
+
+float4 PS(VsOutput ps_in) : SV_TARGET
+{
+    float coverage = input_coverage.Sample(input_sampler, ps_in.texture0);
+    // 还原出GDI的输出：文字颜色乘覆盖率，alpha为0
+    float4 color = float4(text_color.rgb * coverage, 0.0);
+    color.w += alpha_increment;
+    color.w = min(1.0, color.w);
+    return color;
+}
+)")
+                        .SetEntryPoint("PS")
+                        .SetName("PsCoverageTexturePreprocessor")
+                        .SetTarget("ps_4_1")
+                        .SetFlags1(D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_WARNINGS_ARE_ERRORS);
+                });
+            return result.Get();
+        }
+
+        /**
+         * @brief 降低内部渲染比例时，alpha修正只渲染到gdi_final的左上角，再由该着色器拉伸到后台缓冲区
+         */
+        const CShader& GetScaledBlitShader()
+        {
+            static auto result = MakeStaticVariableWrapper<CShader>(
+                [](CShader* p_content)
+                {
+                    p_content->SetCode(
+                                 CIMAGE2DEFFECT_SHADER_VS_OUTPUT_DECLARATION
+                                 R"(
+SamplerState input_sampler : register(ps_4_1, s0);
+Texture2D input_texture : register(ps_4_1, t0);
+cbuffer BlitConstants : register(ps_4_1, b1)
+{
+    float2 uv_scale;
+};
+
+float4 PS(VsOutput ps_in) : SV_TARGET
+{
+    return input_texture.Sample(input_sampler, ps_in.texture0 * uv_scale);
+}
+)")
+                        .SetEntryPoint("PS")
+                        .SetName("PsScaledBlit")
+                        .SetTarget("ps_4_1")
+                        .SetFlags1(D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_WARNINGS_ARE_ERRORS);
+                });
+            return result.Get();
+        }
+    }
+
+    auto CreateMainWindow()
+        -> HWND
+    {
+        WNDCLASS wc = {};
+        wc.lpfnWndProc = WndProc;
+        wc.hInstance = ::GetModuleHandle(NULL);
+        wc.lpszClassName = CMAKE_PROJECT_NAME;
+        ::RegisterClass(&wc);
+        HWND hwnd = ::CreateWindow(
+            CMAKE_PROJECT_NAME,
+            CMAKE_PROJECT_NAME,
+            WS_VISIBLE | WS_BORDER,
+            0, 0, WINDOW_SIZE.cx, WINDOW_SIZE.cy,
+            NULL,
+            NULL,
+            wc.hInstance,
+            NULL);
+        ::ShowWindow(hwnd, SW_SHOW);
+        return hwnd;
+    }
+
+    /**
+     * @brief 窗口使用的D3D11设备，设备丢失后在同一个对象上重新创建，上下文包装随之指向新的设备上下文
+     */
+    class CWindowDevice
+    {
+    public:
+        using RenderContext = CInstrumentedDeviceContext<CCapturingDeviceContext<ID3D11DeviceContext>>;
+
+    private:
+        ComPtr<ID3D11Device> m_p_device{};
+        ComPtr<ID3D11DeviceContext> m_p_device_context{};
+        ComPtr<ID3D11Device2> m_p_device2{};
+        // 设备、缓冲、纹理、采样器和混合状态的描述在创建时按性能规则检查
+        CPerfLinter m_perf_linter{};
+        // 渲染路径经由它调用设备上下文，按类别统计每帧的调用次数、CPU耗时和上传字节数；捕获帧跟踪时同时写入跟踪
+        CCapturingDeviceContext<ID3D11DeviceContext> m_capturing_context{nullptr};
+        RenderContext m_render_context{nullptr};
+        CFrameTraceWriter m_frame_trace_writer{};
+
+    public:
+        CWindowDevice()
+        {
+            Create();
+        }
+        CWindowDevice(const CWindowDevice&) = delete;
+        CWindowDevice& operator=(const CWindowDevice&) = delete;
+
+        /**
+         * @brief 释放当前的设备并创建新的设备
+         */
+        void Create()
+        {
+            m_p_device2.Reset();
+            m_p_device_context.Reset();
+            m_p_device.Reset();
+            // 调试层会校验每一次调用，只在调试构建中启用
+            UINT device_creation_flags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+            if constexpr (IS_DEBUG_BUILD)
+            {
+                device_creation_flags |= D3D11_CREATE_DEVICE_DEBUG;
+            }
+            m_perf_linter.Check(LintDeviceDescription{device_creation_flags, IS_DEBUG_BUILD});
+            auto feature_levels = D3D_FEATURE_LEVEL_11_1;
+            ThrowIfFailed(D3D11CreateDevice(
+                nullptr,
+                D3D_DRIVER_TYPE_HARDWARE,
+                NULL,
+                device_creation_flags,
+                &feature_levels,
+                1,
+                D3D11_SDK_VERSION,
+                &m_p_device,
+                NULL,
+                &m_p_device_context));
+            m_capturing_context.SetContext(m_p_device_context.Get());
+            m_render_context.SetContext(&m_capturing_context);
+
+            ThrowIfFailed(m_p_device->QueryInterface(IID_PPV_ARGS(&m_p_device2)));
+        }
+
+        auto GetDevice() const noexcept
+            -> ID3D11Device*
+        {
+            return m_p_device.Get();
+        }
+        auto GetDeviceContext() const noexcept
+            -> ID3D11DeviceContext*
+        {
+            return m_p_device_context.Get();
+        }
+        auto GetPerfLinter() noexcept
+            -> CPerfLinter&
+        {
+            return m_perf_linter;
+        }
+        auto GetCapturingContext() noexcept
+            -> CCapturingDeviceContext<ID3D11DeviceContext>&
+        {
+            return m_capturing_context;
+        }
+        auto GetRenderContext() noexcept
+            -> RenderContext&
+        {
+            return m_render_context;
+        }
+        auto GetRenderContext() const noexcept
+            -> const RenderContext&
+        {
+            return m_render_context;
+        }
+        auto GetFrameTraceWriter() noexcept
+            -> CFrameTraceWriter&
+        {
+            return m_frame_trace_writer;
+        }
+    };
+
+    /**
+     * @brief 在本机的设备上回放跟踪文件并输出耗时
+     */
+    auto RunReplayTrace(const std::string& trace_path, const CWindowDevice& device)
+        -> int
+    {
+        const auto trace_file = CMappedFile::Open(trace_path);
+        const CFrameTraceReader trace_reader{trace_file.GetData(), trace_file.GetSize()};
+        CD3D11FrameTraceBackend trace_backend{device.GetDevice(), device.GetDeviceContext()};
+        constexpr std::uint32_t REPLAY_FRAME_COUNT = 500;
+        const auto replay = FrameTraceReplay::Replay(trace_reader, trace_backend, REPLAY_FRAME_COUNT);
+        // 逐条命令计时只反映CPU提交的耗时，单独回放一次以免影响每帧耗时
+        const auto timed_replay = FrameTraceReplay::Replay(trace_reader, trace_backend, REPLAY_FRAME_COUNT / 10, true);
+        std::printf("replay %s: %u commands, setup %.3f ms, %u frames avg %.3f ms (min %.3f, max %.3f)\n",
+                    trace_path.c_str(),
+                    trace_reader.GetHeader().m_command_count,
+                    replay.m_setup_ms,
+                    replay.m_frame_count,
+                    replay.m_average_frame_ms,
+                    replay.m_min_frame_ms,
+                    replay.m_max_frame_ms);
+        for (std::size_t i = 0; i < FRAME_TRACE_OPCODE_COUNT; ++i)
+        {
+            const auto& timing = timed_replay.m_opcode_timings[i];
+            if (timing.m_count != 0)
+            {
+                std::printf("replay %s: %.1f per frame, %.2f us each\n",
+                            GetFrameTraceOpcodeName(static_cast<FrameTraceOpcode>(i)),
+                            static_cast<double>(timing.m_count) / timed_replay.m_frame_count,
+                            timing.m_total_ns / 1000.0 / timing.m_count);
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 交换链、帧围栏、GPU计时和资源清单，设备丢失后随设备一起重建
+     */
+    class CWindowGpuResources
+    {
+    private:
+        CWindowDevice& m_device;
+        HWND m_hwnd;
+        SwapChainPresenterConfig m_presenter_config;
+        // 全部纹理和缓冲都在预算中按类别记账，超过硬上限时创建失败
+        CGpuMemoryBudget m_gpu_memory_budget;
+        CGpuMemoryReservation m_swap_chain_reservation;
+        std::optional<CSwapChainPresenter> m_presenter{};
+        CD3D11FrameFence m_frame_fence;
+        CDeferredReleaseQueue m_deferred_release_queue;
+        // 各阶段的GPU耗时在几帧之后读取
+        CD3D11GpuTimerBackend m_gpu_timer_backend;
+        CGpuTimerRing m_gpu_timer_ring;
+        CD3D11ResourceRegistry m_resource_registry;
+        CD3D11ResourceManifest m_resource_manifest;
+
+        static auto CreatePresenterConfig()
+            -> SwapChainPresenterConfig
+        {
+            SwapChainPresenterConfig presenter_config{};
+            presenter_config.m_buffer_count = 2;
+            presenter_config.m_max_frame_latency = 1;
+            presenter_config.m_format = PIXEL_FORMAT;
+            return presenter_config;
+        }
+        static auto CreateGpuMemoryBudgetConfig()
+            -> GpuMemoryBudgetConfig
+        {
+            GpuMemoryBudgetConfig gpu_memory_budget_config{};
+            gpu_memory_budget_config.m_budget_bytes = GPU_MEMORY_BUDGET_BYTES;
+            gpu_memory_budget_config.m_hard_limit_bytes = GPU_MEMORY_HARD_LIMIT_BYTES;
+            return gpu_memory_budget_config;
+        }
+
+    public:
+        CWindowGpuResources(CWindowDevice& device, HWND hwnd)
+            : m_device{device},
+              m_hwnd{hwnd},
+              m_presenter_config{CreatePresenterConfig()},
+              m_gpu_memory_budget{CreateGpuMemoryBudgetConfig()},
+              m_swap_chain_reservation{
+                  &m_gpu_memory_budget,
+                  GpuMemoryCategory::SwapChain,
+                  EstimateTexture2DBytes(WINDOW_SIZE.cx, WINDOW_SIZE.cy, PIXEL_FORMAT, 1, 1) * m_presenter_config.m_buffer_count},
+              m_frame_fence{device.GetDevice(), device.GetDeviceContext()},
+              m_deferred_release_queue{m_frame_fence},
+              m_gpu_timer_backend{device.GetDevice(), device.GetDeviceContext()},
+              m_gpu_timer_ring{m_gpu_timer_backend},
+              m_resource_registry{&m_deferred_release_queue},
+              m_resource_manifest{device.GetDevice(), m_resource_registry}
+        {
+            m_presenter.emplace(device.GetDevice(), hwnd, WINDOW_SIZE, m_presenter_config);
+            m_resource_manifest.SetMemoryBudget(&m_gpu_memory_budget);
+            m_resource_manifest.SetPerfLinter(&device.GetPerfLinter());
+        }
+        CWindowGpuResources(const CWindowGpuResources&) = delete;
+        CWindowGpuResources& operator=(const CWindowGpuResources&) = delete;
+
+        /**
+         * @brief 设备被移除（驱动更新、TDR等）后重新创建设备，在新设备上按清单重建全部资源，句柄保持不变 \n
+         * 调用前必须先释放其它在旧设备上创建的对象
+         */
+        auto Recreate()
+            -> ManifestRecoveryStatistics
+        {
+            m_presenter.reset();
+            m_deferred_release_queue.ReleaseAll();
+            m_device.Create();
+            m_presenter.emplace(m_device.GetDevice(), m_hwnd, WINDOW_SIZE, m_presenter_config);
+            m_frame_fence.Recreate(m_device.GetDevice(), m_device.GetDeviceContext());
+            m_gpu_timer_backend.Recreate(m_device.GetDevice(), m_device.GetDeviceContext());
+            m_gpu_timer_ring.DiscardPending();
+            return m_resource_manifest.Recreate(m_device.GetDevice());
+        }
+
+        auto GetPresenter() noexcept
+            -> CSwapChainPresenter&
+        {
+            return *m_presenter;
+        }
+        auto GetGpuMemoryBudget() noexcept
+            -> CGpuMemoryBudget&
+        {
+            return m_gpu_memory_budget;
+        }
+        auto GetGpuMemoryBudget() const noexcept
+            -> const CGpuMemoryBudget&
+        {
+            return m_gpu_memory_budget;
+        }
+        auto GetFrameFence() noexcept
+            -> CD3D11FrameFence&
+        {
+            return m_frame_fence;
+        }
+        auto GetDeferredReleaseQueue() noexcept
+            -> CDeferredReleaseQueue&
+        {
+            return m_deferred_release_queue;
+        }
+        auto GetGpuTimerRing() noexcept
+            -> CGpuTimerRing&
+        {
+            return m_gpu_timer_ring;
+        }
+        auto GetGpuTimerRing() const noexcept
+            -> const CGpuTimerRing&
+        {
+            return m_gpu_timer_ring;
+        }
+        auto GetResourceRegistry() noexcept
+            -> CD3D11ResourceRegistry&
+        {
+            return m_resource_registry;
+        }
+        auto GetResourceManifest() noexcept
+            -> CD3D11ResourceManifest&
+        {
+            return m_resource_manifest;
+        }
+    };
+
+    /**
+     * @brief D3D11合成路径：GDI表面中更新过的区域上传到初始纹理，经alpha修正后拉伸到交换链的后台缓冲区
+     */
+    class CD3D11GdiComposition
+    {
+    private:
+        CWindowDevice& m_device;
+        CWindowGpuResources& m_gpu_resources;
+        CMappedSurface& m_gdi_surface;
+        bool m_use_coverage_texture;
+        DXGI_FORMAT m_gdi_initial_format;
+        // 与GdiCompositionPass的顺序对应
+        std::array<std::uint32_t, 3> m_timer_passes;
+        // 参数改变时只需在下一帧写入常量缓冲区，不再需要重新编译着色器
+        CConstantBuffer<AlphaIncreaseConstants> m_alpha_increase_constants{};
+        CConstantBuffer<BlitConstants> m_blit_constants{};
+        CD3D11ConstantBufferManager m_constant_buffer_manager;
+        BufferHandle m_alpha_increase_constants_handle;
+        BufferHandle m_blit_constants_handle;
+        // 与模拟设备上的基准测试共用同一份管线建立和每帧的状态设置代码
+        const CGdiCompositionPipeline<CD3D11ResourceManifest> m_pipeline;
+        CCoverageImage m_gdi_coverage{};
+        std::optional<CD3D11UploadBackend> m_upload_backend{};
+        std::optional<CUploadEngine> m_upload_engine{};
+        DrawCommand m_gdi_quadrangle_draw{};
+        CDrawQueue m_draw_queue{};
+
+        auto CreatePipelineConfig() const
+            -> GdiCompositionPipelineConfig
+        {
+            auto get_byte_code = [](auto* p_blob)
+                -> std::span<const std::uint8_t>
+            {
+                return {static_cast<const std::uint8_t*>(p_blob->GetBufferPointer()), p_blob->GetBufferSize()};
+            };
+            const auto& alpha_increase_shader = m_use_coverage_texture
+                                                    ? GdiCompositionShaders::GetCoverageAlphaIncreaseShader()
+                                                    : GdiCompositionShaders::GetAlphaIncreaseShader();
+            GdiCompositionPipelineConfig pipeline_config{};
+            pipeline_config.m_width = static_cast<std::uint32_t>(WINDOW_SIZE.cx);
+            pipeline_config.m_height = static_cast<std::uint32_t>(WINDOW_SIZE.cy);
+            pipeline_config.m_gdi_initial_format = static_cast<std::uint32_t>(m_gdi_initial_format);
+            pipeline_config.m_gdi_final_format = static_cast<std::uint32_t>(PIXEL_FORMAT);
+            pipeline_config.m_vertex_shader = get_byte_code(D3DQuadrangle::GetVsShader().Compile());
+            pipeline_config.m_alpha_increase_shader = get_byte_code(alpha_increase_shader.Compile());
+            pipeline_config.m_scaled_blit_shader = get_byte_code(GdiCompositionShaders::GetScaledBlitShader().Compile());
+            return pipeline_config;
+        }
+        /**
+         * @brief GDI表面中更新过的区域上传到初始纹理，覆盖率模式下先转换为覆盖率；暂存块用尽时被拒绝的区域重新登记为脏区域，下一帧再上传
+         */
+        void Upload(const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects)
+        {
+            const auto gdi_initial_texture = m_pipeline.GetGdiInitialTexture();
+            const auto uploaded_bytes_before = m_upload_engine->GetStatistics().m_bytes_uploaded;
+            for (const auto& rect : updated_rects)
+            {
+                const auto* p_source = source.m_p_data + static_cast<std::size_t>(rect.m_y) * source.m_row_pitch + static_cast<std::size_t>(rect.m_x) * MappedSurfaceBuffer::BYTES_PER_PIXEL;
+                bool is_uploaded = false;
+                if (m_use_coverage_texture)
+                {
+                    auto* p_coverage = m_gdi_coverage.GetRow(rect.m_y) + rect.m_x;
+                    CoverageConversion::ConvertBgraToCoverage(
+                        p_source,
+                        source.m_row_pitch,
+                        p_coverage,
+                        m_gdi_coverage.GetRowPitch(),
+                        rect.m_width,
+                        rect.m_height);
+                    is_uploaded = m_upload_engine->Upload(gdi_initial_texture.m_value, rect.m_x, rect.m_y, rect.m_width, rect.m_height, p_coverage, m_gdi_coverage.GetRowPitch());
+                }
+                else
+                {
+                    is_uploaded = m_upload_engine->Upload(gdi_initial_texture.m_value, rect.m_x, rect.m_y, rect.m_width, rect.m_height, p_source, source.m_row_pitch);
+                }
+                if (!is_uploaded)
+                {
+                    m_gdi_surface.MarkDirty(rect);
+                }
+            }
+            m_upload_engine->Submit();
+            m_device.GetRenderContext().RecordUploadedBytes(m_upload_engine->GetStatistics().m_bytes_uploaded - uploaded_bytes_before);
+            // 上传引擎经由原始上下文从暂存纹理复制，捕获时按等效的UpdateSubresource记录
+            if (m_device.GetCapturingContext().IsCapturing())
+            {
+                auto& frame_trace_writer = m_device.GetFrameTraceWriter();
+                auto* p_gdi_initial_texture = m_gpu_resources.GetResourceRegistry().Get(gdi_initial_texture);
+                for (const auto& rect : updated_rects)
+                {
+                    const D3D11_BOX box{rect.m_x, rect.m_y, 0, rect.m_x + rect.m_width, rect.m_y + rect.m_height, 1};
+                    if (m_use_coverage_texture)
+                    {
+                        frame_trace_writer.UpdateSubresource(p_gdi_initial_texture, 0, &box, m_gdi_coverage.GetRow(rect.m_y) + rect.m_x, m_gdi_coverage.GetRowPitch(), 0);
+                    }
+                    else
+                    {
+                        const auto* p_source = source.m_p_data + static_cast<std::size_t>(rect.m_y) * source.m_row_pitch + static_cast<std::size_t>(rect.m_x) * MappedSurfaceBuffer::BYTES_PER_PIXEL;
+                        frame_trace_writer.UpdateSubresource(p_gdi_initial_texture, 0, &box, p_source, source.m_row_pitch, 0);
+                    }
+                }
+            }
+        }
+        void DrawQueuedCommands()
+        {
+            auto& render_context = m_device.GetRenderContext();
+            m_draw_queue.ForEachSorted(
+                [&render_context](const DrawCommand& command)
+                {
+                    render_context.DrawIndexed(
+                        command.m_index_count,
+                        command.m_start_index_location,
+                        command.m_base_vertex_location);
+                });
+        }
+
+    public:
+        CD3D11GdiComposition(CWindowDevice& device, CWindowGpuResources& gpu_resources, CMappedSurface& gdi_surface, bool use_coverage_texture)
+            : m_device{device},
+              m_gpu_resources{gpu_resources},
+              m_gdi_surface{gdi_surface},
+              m_use_coverage_texture{use_coverage_texture},
+              m_gdi_initial_format{use_coverage_texture ? COVERAGE_PIXEL_FORMAT : PIXEL_FORMAT},
+              m_timer_passes{
+                  gpu_resources.GetGpuTimerRing().RegisterPass("upload"),
+                  gpu_resources.GetGpuTimerRing().RegisterPass("alpha-increase"),
+                  gpu_resources.GetGpuTimerRing().RegisterPass("blit")},
+              m_constant_buffer_manager{gpu_resources.GetResourceManifest(), gpu_resources.GetResourceRegistry()},
+              m_alpha_increase_constants_handle{m_constant_buffer_manager.Register(m_alpha_increase_constants)},
+              m_blit_constants_handle{m_constant_buffer_manager.Register(m_blit_constants)},
+              m_pipeline{gpu_resources.GetResourceManifest(), CreatePipelineConfig(), m_alpha_increase_constants_handle, m_blit_constants_handle}
+        {
+            Bind();
+            if (m_use_coverage_texture)
+            {
+                m_gdi_coverage.Resize(WINDOW_SIZE.cx, WINDOW_SIZE.cy);
+            }
+            CreateUploadEngine();
+            m_gdi_quadrangle_draw.m_index_count = m_pipeline.GetIndexCount();
+        }
+        CD3D11GdiComposition(const CD3D11GdiComposition&) = delete;
+        CD3D11GdiComposition& operator=(const CD3D11GdiComposition&) = delete;
+
+        /**
+         * @brief 设备丢失重建后需要重新绑定全部管线状态
+         */
+        void Bind()
+        {
+            m_pipeline.Bind(m_device.GetRenderContext());
+        }
+        void CreateUploadEngine()
+        {
+            m_upload_engine.reset();
+            m_upload_backend.emplace(m_device.GetDevice(), m_device.GetDeviceContext(), m_gpu_resources.GetResourceRegistry(), m_gdi_initial_format, &m_gpu_resources.GetGpuMemoryBudget());
+            UploadEngineConfig upload_engine_config{};
+            upload_engine_config.m_bytes_per_pixel = m_use_coverage_texture ? CCoverageImage::BYTES_PER_PIXEL : MappedSurfaceBuffer::BYTES_PER_PIXEL;
+            m_upload_engine.emplace(*m_upload_backend, m_gpu_resources.GetFrameFence(), upload_engine_config);
+        }
+        void ResetUploadEngine()
+        {
+            m_upload_engine.reset();
+            m_upload_backend.reset();
+        }
+        void SetAlphaIncrement(float alpha_increment)
+        {
+            m_alpha_increase_constants.Edit().m_alpha_increment = alpha_increment;
+        }
+        /**
+         * @brief 常量缓冲区在下一帧全部重新写入，用于设备丢失重建后和帧跟踪开始时
+         */
+        void MarkConstantsDirty() noexcept
+        {
+            m_constant_buffer_manager.MarkAllDirty();
+        }
+        /**
+         * @brief 合成一帧；flip模型的交换链在Present后会解除后台缓冲区的绑定，所以每帧都要重新设置渲染目标
+         */
+        void Composite(const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects, float render_scale)
+        {
+            auto& render_context = m_device.GetRenderContext();
+            auto& capturing_context = m_device.GetCapturingContext();
+            m_blit_constants.Set({{render_scale, render_scale}});
+            const auto constant_bytes_before = m_constant_buffer_manager.GetStatistics().m_bytes_updated;
+            m_constant_buffer_manager.Commit(capturing_context.Get());
+            render_context.RecordUploadedBytes(m_constant_buffer_manager.GetStatistics().m_bytes_updated - constant_bytes_before);
+            if (capturing_context.IsCapturing())
+            {
+                m_constant_buffer_manager.RecordToTrace(m_device.GetFrameTraceWriter());
+            }
+            m_draw_queue.Clear();
+            m_draw_queue.Submit(m_gdi_quadrangle_draw, 0, true);
+            auto& gpu_timer_ring = m_gpu_resources.GetGpuTimerRing();
+            const auto& presenter = m_gpu_resources.GetPresenter();
+            m_pipeline.Execute(
+                render_context,
+                render_scale,
+                presenter.GetBackBuffer(),
+                presenter.GetBackBufferRenderTargetView(),
+                [&]()
+                {
+                    Upload(source, updated_rects);
+                },
+                [this]()
+                {
+                    DrawQueuedCommands();
+                },
+                [&](GdiCompositionPass pass, auto&& run)
+                {
+                    const auto timer_pass = m_timer_passes[static_cast<std::size_t>(pass)];
+                    gpu_timer_ring.BeginPass(timer_pass);
+                    run();
+                    gpu_timer_ring.EndPass(timer_pass);
+                });
+        }
+        /**
+         * @brief 在本机上测量本路径的耗时：与alpha修正相同的绘制调用渲染到给定尺寸的纹理，每次都等待GPU完成
+         */
+        auto MeasureMicroseconds(std::uint32_t width, std::uint32_t height, std::uint32_t draw_count)
+            -> double
+        {
+            auto* p_device_context = m_device.GetDeviceContext();
+            auto& frame_fence = m_gpu_resources.GetFrameFence();
+            D3D11_TEXTURE2D_DESC description{};
+            description.ArraySize = 1;
+            description.BindFlags = D3D11_BIND_RENDER_TARGET;
+            description.Format = PIXEL_FORMAT;
+            description.Width = width;
+            description.Height = height;
+            description.MipLevels = 1;
+            description.SampleDesc.Count = 1;
+            ComPtr<ID3D11Texture2D> p_calibration_texture{};
+            ThrowIfFailed(m_device.GetDevice()->CreateTexture2D(&description, NULL, &p_calibration_texture));
+            ComPtr<ID3D11RenderTargetView> p_calibration_rtv{};
+            ThrowIfFailed(m_device.GetDevice()->CreateRenderTargetView(p_calibration_texture.Get(), NULL, &p_calibration_rtv));
+
+            D3D11_VIEWPORT viewport{};
+            viewport.Width = static_cast<FLOAT>(width);
+            viewport.Height = static_cast<FLOAT>(height);
+            viewport.MaxDepth = 1.0f;
+            p_device_context->RSSetViewports(1, &viewport);
+            // 与Composite的alpha修正相同：三角形列表，只绑定一个渲染目标
+            p_device_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            p_device_context->OMSetRenderTargets(1, p_calibration_rtv.GetAddressOf(), NULL);
+            m_constant_buffer_manager.Commit(p_device_context);
+            auto draw_and_wait = [&]()
+            {
+                for (std::uint32_t i = 0; i < draw_count; ++i)
+                {
+                    p_device_context->DrawIndexed(m_gdi_quadrangle_draw.m_index_count, 0, 0);
+                }
+                const auto fence_value = frame_fence.Signal();
+                p_device_context->Flush();
+                while (frame_fence.GetCompletedValue() < fence_value)
+                {
+                    std::this_thread::yield();
+                }
+            };
+            draw_and_wait();
+            constexpr std::uint32_t ITERATIONS = 8;
+            const auto begin = std::chrono::steady_clock::now();
+            for (std::uint32_t i = 0; i < ITERATIONS; ++i)
+            {
+                draw_and_wait();
+            }
+            const auto end = std::chrono::steady_clock::now();
+            p_device_context->OMSetRenderTargets(0, NULL, NULL);
+            Bind();
+            return std::chrono::duration<double, std::micro>(end - begin).count() / ITERATIONS;
+        }
+
+        auto GetPipeline() const noexcept
+            -> const CGdiCompositionPipeline<CD3D11ResourceManifest>&
+        {
+            return m_pipeline;
+        }
+        auto GetUploadPass() const noexcept
+            -> std::uint32_t
+        {
+            return m_timer_passes[static_cast<std::size_t>(GdiCompositionPass::Upload)];
+        }
+    };
+
+    /**
+     * @brief 在本机上测量CPU合成路径的耗时，合成结果上传到给定尺寸的纹理
+     */
+    auto MeasureCpuCompositor(const CWindowDevice& device, std::uint32_t width, std::uint32_t height, std::uint32_t draw_count)
+        -> double
+    {
+        D3D11_TEXTURE2D_DESC description{};
+        description.ArraySize = 1;
+        description.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        description.Format = PIXEL_FORMAT;
+        description.Width = width;
+        description.Height = height;
+        description.MipLevels = 1;
+        description.SampleDesc.Count = 1;
+        ComPtr<ID3D11Texture2D> p_calibration_texture{};
+        ThrowIfFailed(device.GetDevice()->CreateTexture2D(&description, NULL, &p_calibration_texture));
+        return CCpuCompositor::MeasureMicroseconds(
+            width,
+            height,
+            draw_count,
+            [&](const CBgraImage& target)
+            {
+                device.GetDeviceContext()->UpdateSubresource(p_calibration_texture.Get(), 0, NULL, target.GetData(), target.GetRowPitch(), 0);
+            });
+    }
+
+    void WriteCapture(const CBgraImage& image, std::uint64_t frame_index, bool is_verbose)
+    {
+        const auto path = "capture_" + std::to_string(frame_index) + ImageWriter::GetFileExtension(ImageFileFormat::Png);
+        ImageWriter::WritePng(path, image);
+        if (is_verbose)
+        {
+            std::printf("captured %s\n", path.c_str());
+        }
+    }
+
+    /**
+     * @brief 从gdi_final异步读回截图和导出的共享帧，渲染线程不等待GPU
+     */
+    class CFrameReadback
+    {
+    private:
+        CWindowDevice& m_device;
+        CWindowGpuResources& m_gpu_resources;
+        bool m_is_verbose;
+        std::optional<CD3D11ReadbackBackend> m_readback_backend{};
+        std::optional<CReadbackRing> m_capture_ring{};
+        // 导出共享帧时每帧都读回，与截图共用后端但使用独立的暂存槽
+        std::optional<CReadbackRing> m_export_ring{};
+        std::optional<CSharedFrameWriter> m_shared_frame_writer{};
+        const std::vector<SurfaceRect> m_no_updated_rects{};
+
+    public:
+        CFrameReadback(CWindowDevice& device, CWindowGpuResources& gpu_resources, bool export_shared_frames, bool is_verbose)
+            : m_device{device},
+              m_gpu_resources{gpu_resources},
+              m_is_verbose{is_verbose}
+        {
+            if (export_shared_frames)
+            {
+                m_shared_frame_writer.emplace(SHARED_FRAME_NAME, static_cast<std::uint32_t>(WINDOW_SIZE.cx), static_cast<std::uint32_t>(WINDOW_SIZE.cy));
+            }
+            Create();
+        }
+        CFrameReadback(const CFrameReadback&) = delete;
+        CFrameReadback& operator=(const CFrameReadback&) = delete;
+
+        void Create()
+        {
+            Reset();
+            m_readback_backend.emplace(m_device.GetDevice(), m_device.GetDeviceContext(), m_gpu_resources.GetResourceRegistry(), PIXEL_FORMAT, &m_gpu_resources.GetGpuMemoryBudget());
+            ReadbackRingConfig readback_ring_config{};
+            readback_ring_config.m_width = WINDOW_SIZE.cx;
+            readback_ring_config.m_height = WINDOW_SIZE.cy;
+            m_capture_ring.emplace(*m_readback_backend, readback_ring_config);
+            if (m_shared_frame_writer)
+            {
+                m_export_ring.emplace(*m_readback_backend, readback_ring_config);
+            }
+        }
+        void Reset()
+        {
+            m_export_ring.reset();
+            m_capture_ring.reset();
+            m_readback_backend.reset();
+        }
+        void RequestCapture(std::uint32_t texture)
+        {
+            m_capture_ring->Request(texture);
+        }
+        bool HasPendingCapture() const noexcept
+        {
+            return m_capture_ring->HasPendingRequest();
+        }
+        /**
+         * @brief 读回完成后按视图的行距复制出紧密排列的图像并写入文件
+         */
+        void SaveCapture()
+        {
+            const auto view = m_capture_ring->TryAcquireLatest();
+            if (!view)
+            {
+                return;
+            }
+            CBgraImage capture{view->m_width, view->m_height};
+            for (std::uint32_t y = 0; y < view->m_height; ++y)
+            {
+                std::memcpy(capture.GetRow(y), view->GetRow(y), static_cast<std::size_t>(view->m_width) * view->m_bytes_per_pixel);
+            }
+            m_capture_ring->Release();
+            WriteCapture(capture, view->m_frame_index, m_is_verbose);
+        }
+        bool IsExporting() const noexcept
+        {
+            return m_shared_frame_writer.has_value();
+        }
+        bool HasPendingExport() const noexcept
+        {
+            return m_export_ring && m_export_ring->HasPendingRequest();
+        }
+        /**
+         * @brief 读回的帧可能跳过了若干帧，无法得到相对上一次发布的脏矩形，按整帧发布
+         */
+        void Export(std::uint32_t texture)
+        {
+            m_export_ring->Request(texture);
+            if (const auto view = m_export_ring->TryAcquireLatest())
+            {
+                m_shared_frame_writer->Publish(view->m_p_data, view->m_row_pitch, m_no_updated_rects);
+                m_export_ring->Release();
+            }
+        }
+        /**
+         * @brief CPU合成的结果本来就在内存中，直接发布
+         */
+        void Export(const CBgraImage& image)
+        {
+            m_shared_frame_writer->Publish(image.GetRow(0), image.GetRowPitch(), m_no_updated_rects);
+        }
+    };
+
+    /**
+     * @brief 在GDI表面上显示CPU和内存占用率 \n
+     * 采样线程发布系统状态，渲染线程在控件的刷新定时器到期时取最新的快照，数值变化时才重绘该控件
+     */
+    class CSystemStatsOverlay
+    {
+    private:
+        enum class Widget : std::uint64_t
+        {
+            Cpu,
+            Memory,
+        };
+        constexpr static std::uint32_t WIDGET_WIDTH = 120;
+        constexpr static std::uint32_t WIDGET_HEIGHT = 16;
+
+        CMappedSurface& m_gdi_surface;
+        CTripleBuffer<SystemStatsSnapshot> m_system_stats{};
+        std::array<std::optional<std::uint32_t>, 2> m_drawn_values{};
+        CTimingWheel m_widget_timers;
+        std::jthread m_sampling_thread;
+
+        void DrawWidget(Widget widget, const SystemStatsSnapshot& snapshot)
+        {
+            const auto widget_index = static_cast<std::size_t>(widget);
+            const auto value = widget == Widget::Cpu ? snapshot.m_cpu_percent : snapshot.m_memory_percent;
+            if (m_drawn_values[widget_index] == value)
+            {
+                return;
+            }
+            m_drawn_values[widget_index] = value;
+            const SurfaceRect widget_rect{static_cast<std::uint32_t>(widget_index) * WIDGET_WIDTH, 0, WIDGET_WIDTH, WIDGET_HEIGHT};
+            auto hdc = static_cast<HDC>(m_gdi_surface.GetBackBuffer().m_p_native_handle);
+            RECT text_rect{
+                static_cast<LONG>(widget_rect.m_x),
+                static_cast<LONG>(widget_rect.m_y),
+                static_cast<LONG>(widget_rect.m_x + widget_rect.m_width),
+                static_cast<LONG>(widget_rect.m_y + widget_rect.m_height)};
+            ::FillRect(hdc, &text_rect, static_cast<HBRUSH>(::GetStockObject(BLACK_BRUSH)));
+            std::array<char, 32> text{};
+            std::snprintf(text.data(), text.size(), "%s %u%%", widget == Widget::Cpu ? "CPU" : "MEM", value);
+            ::SetBkMode(hdc, TRANSPARENT);
+            ::SetTextColor(hdc, RGB(255, 255, 255));
+            ::DrawTextA(hdc, text.data(), -1, &text_rect, DT_LEFT | DT_TOP | DT_SINGLELINE);
+            m_gdi_surface.MarkDirty(widget_rect);
+        }
+
+    public:
+        explicit CSystemStatsOverlay(CMappedSurface& gdi_surface)
+            : m_gdi_surface{gdi_surface},
+              m_widget_timers{std::chrono::steady_clock::now()},
+              m_sampling_thread{
+                  [this](std::stop_token stop_token)
+                  {
+                      constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds{250};
+                      CSystemStatsSampler sampler{};
+                      while (!stop_token.stop_requested())
+                      {
+                          m_system_stats.Publish(sampler.Sample());
+                          std::this_thread::sleep_for(SAMPLE_INTERVAL);
+                      }
+                  }}
+        {
+            // 时间槽为一帧，同一帧内到期的控件只产生一次重绘；第一次采样完成后两个控件一起显示
+            m_widget_timers.Schedule(std::chrono::milliseconds{250}, std::chrono::milliseconds{250}, static_cast<std::uint64_t>(Widget::Cpu));
+            m_widget_timers.Schedule(std::chrono::milliseconds{250}, std::chrono::seconds{5}, static_cast<std::uint64_t>(Widget::Memory));
+        }
+        CSystemStatsOverlay(const CSystemStatsOverlay&) = delete;
+        CSystemStatsOverlay& operator=(const CSystemStatsOverlay&) = delete;
+
+        /**
+         * @brief 重绘刷新定时器已经到期的控件，只由渲染线程调用
+         */
+        void Update(std::chrono::steady_clock::time_point now)
+        {
+            const auto& expired_timers = m_widget_timers.Advance(now);
+            if (expired_timers.empty())
+            {
+                return;
+            }
+            m_system_stats.Update();
+            for (const auto& expired_timer : expired_timers)
+            {
+                DrawWidget(static_cast<Widget>(expired_timer.m_user_data), m_system_stats.Get());
+            }
+        }
+        auto GetNextDeadline() const noexcept
+            -> std::optional<std::chrono::steady_clock::time_point>
+        {
+            return m_widget_timers.GetNextDeadline();
+        }
+        /**
+         * @brief 停止采样线程，之后不再有新的快照
+         */
+        void StopSampling()
+        {
+            m_sampling_thread.request_stop();
+            m_sampling_thread.join();
+        }
+    };
+
+    /**
+     * @brief 渲染线程上的全部状态：选择合成路径、构建并呈现每一帧、处理UI线程的命令以及从设备丢失中恢复
+     */
+    class CWindowRenderer
+    {
+    private:
+        // 等待交换链时带超时，渲染线程才能及时响应退出
+        constexpr static DWORD FRAME_WAIT_TIMEOUT_MS = 100;
+
+        CWindowDevice& m_device;
+        WindowOptions m_options;
+        HANDLE m_render_wake_event;
+        CWindowGpuResources m_gpu_resources;
+        // 合成阶段包含上传、alpha修正和拉伸，呈现单独计时
+        std::uint32_t m_composite_pass;
+        CGdiSurfaceMemory m_gdi_surface_memory{};
+        CMappedSurface m_gdi_surface;
+        CD3D11GdiComposition m_d3d11_composition;
+        std::uint32_t m_present_pass;
+        CResolutionGovernor m_resolution_governor{};
+        CFunctionCompositor m_d3d11_compositor;
+        // CPU合成的结果直接写入交换链的后台缓冲区，省去全部管线状态设置和绘制调用
+        CCpuCompositor m_cpu_compositor;
+        std::optional<CCompositorSelector> m_compositor_selector{};
+        ICompositor* m_p_compositor;
+        CFrameReadback m_frame_readback;
+        CSystemStatsOverlay m_system_stats_overlay;
+        const std::vector<SurfaceRect> m_no_updated_rects{};
+        // 内容没有变化时不构建新的一帧，窗口保持上一次呈现的内容
+        bool m_is_redraw_needed{true};
+        bool m_is_capture_requested{};
+
+        /**
+         * @brief 表面尺寸改变时重新评估；覆盖率纹理只有D3D11路径支持
+         */
+        void SelectCompositor(std::uint32_t width, std::uint32_t height)
+        {
+            const auto kind = m_options.m_use_coverage_texture || !m_compositor_selector ? CompositorKind::D3D11 : m_compositor_selector->Select(width, height);
+            ICompositor* p_selected_compositor = kind == CompositorKind::Cpu ? static_cast<ICompositor*>(&m_cpu_compositor) : &m_d3d11_compositor;
+            p_selected_compositor->Resize(width, height);
+            if (p_selected_compositor != m_p_compositor)
+            {
+                // 新的路径没有之前合成的内容，整个表面重新上传
+                m_gdi_surface.MarkAllDirty();
+                m_p_compositor = p_selected_compositor;
+            }
+            if (m_compositor_selector)
+            {
+                const auto pixel_count = static_cast<std::uint64_t>(width) * height;
+                std::printf("compositor %ux%u: cpu %.2f us, d3d11 %.2f us, selected %s\n",
+                            width,
+                            height,
+                            m_compositor_selector->GetCost(CompositorKind::Cpu).EstimateMicroseconds(pixel_count, 1),
+                            m_compositor_selector->GetCost(CompositorKind::D3D11).EstimateMicroseconds(pixel_count, 1),
+                            GetCompositorKindName(kind));
+            }
+        }
+        /**
+         * @brief 初始的GDI表面分别经两条路径合成一次并比较结果，GPU混合的舍入允许相差1
+         */
+        void VerifyCompositors()
+        {
+            auto* p_device_context = m_device.GetDeviceContext();
+            auto& resource_registry = m_gpu_resources.GetResourceRegistry();
+            auto& gpu_timer_ring = m_gpu_resources.GetGpuTimerRing();
+            const auto& pipeline = m_d3d11_composition.GetPipeline();
+            const auto& updated_rects = m_gdi_surface.Flush();
+            constexpr std::array<FLOAT, 4> CLEAR_COLOR{0.0f, 0.0f, 0.0f, 0.0f};
+            p_device_context->ClearRenderTargetView(resource_registry.Get(pipeline.GetGdiFinalRenderTargetView()), CLEAR_COLOR.data());
+            gpu_timer_ring.BeginFrame();
+            m_d3d11_compositor.Composite(m_gdi_surface.GetFrontBuffer(), updated_rects);
+            m_cpu_compositor.Composite(m_gdi_surface.GetFrontBuffer(), updated_rects);
+            gpu_timer_ring.EndFrame();
+
+            D3D11_TEXTURE2D_DESC description{};
+            description.ArraySize = 1;
+            description.Usage = D3D11_USAGE_STAGING;
+            description.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+            description.Format = PIXEL_FORMAT;
+            description.Width = WINDOW_SIZE.cx;
+            description.Height = WINDOW_SIZE.cy;
+            description.MipLevels = 1;
+            description.SampleDesc.Count = 1;
+            ComPtr<ID3D11Texture2D> p_staging_texture{};
+            ThrowIfFailed(m_device.GetDevice()->CreateTexture2D(&description, NULL, &p_staging_texture));
+            p_device_context->CopyResource(p_staging_texture.Get(), resource_registry.Get(pipeline.GetGdiFinalTexture()));
+            // 只在--calibrate-compositors时执行一次，直接等待GPU完成
+            D3D11_MAPPED_SUBRESOURCE mapped{};
+            ThrowIfFailed(p_device_context->Map(p_staging_texture.Get(), 0, D3D11_MAP_READ, 0, &mapped));
+            const auto& cpu_target = m_cpu_compositor.GetTarget();
+            std::uint32_t max_difference = 0;
+            for (std::uint32_t y = 0; y < cpu_target.GetHeight(); ++y)
+            {
+                const auto* p_gpu_row = static_cast<const std::uint8_t*>(mapped.pData) + static_cast<std::size_t>(y) * mapped.RowPitch;
+                const auto* p_cpu_row = cpu_target.GetRow(y);
+                for (std::size_t i = 0; i < static_cast<std::size_t>(cpu_target.GetWidth()) * CBgraImage::BYTES_PER_PIXEL; ++i)
+                {
+                    const auto difference = p_gpu_row[i] > p_cpu_row[i] ? p_gpu_row[i] - p_cpu_row[i] : p_cpu_row[i] - p_gpu_row[i];
+                    max_difference = (std::max)(max_difference, static_cast<std::uint32_t>(difference));
+                }
+            }
+            p_device_context->Unmap(p_staging_texture.Get(), 0);
+            m_gdi_surface.MarkAllDirty();
+            std::printf("compositor check: max channel difference %u, %s\n",
+                        max_difference,
+                        max_difference <= 1 ? "consistent" : "MISMATCH");
+        }
+        /**
+         * @brief 在新设备上重建全部资源后重新绑定管线，表面和常量缓冲区全部重新上传
+         */
+        void RecoverFromDeviceLost()
+        {
+            m_frame_readback.Reset();
+            m_d3d11_composition.ResetUploadEngine();
+            const auto recovery = m_gpu_resources.Recreate();
+            if (m_options.m_is_verbose)
+            {
+                std::printf("device lost: restored %u resources with %u workers in %.3f ms (independent %.3f ms, views %.3f ms)\n",
+                            recovery.m_resource_count,
+                            recovery.m_worker_count,
+                            recovery.m_total_ms,
+                            recovery.m_independent_phase_ms,
+                            recovery.m_dependent_phase_ms);
+            }
+            m_d3d11_composition.Bind();
+            m_d3d11_composition.CreateUploadEngine();
+            m_frame_readback.Create();
+            m_gdi_surface.MarkAllDirty();
+            m_d3d11_composition.MarkConstantsDirty();
+        }
+        /**
+         * @brief 跟踪从清单中的全部资源开始，表面整体重新上传、管线全部重新绑定，回放时不依赖之前的帧
+         */
+        void BeginFrameTrace()
+        {
+            auto& frame_trace_writer = m_device.GetFrameTraceWriter();
+            const auto& presenter = m_gpu_resources.GetPresenter();
+            m_gdi_surface.MarkAllDirty();
+            m_d3d11_composition.MarkConstantsDirty();
+            frame_trace_writer.Clear();
+            m_gpu_resources.GetResourceManifest().RecordToTrace(frame_trace_writer);
+            D3D11_TEXTURE2D_DESC back_buffer_desc{};
+            presenter.GetBackBuffer()->GetDesc(&back_buffer_desc);
+            GpuTexture2DDescription back_buffer_description{};
+            back_buffer_description.m_width = back_buffer_desc.Width;
+            back_buffer_description.m_height = back_buffer_desc.Height;
+            back_buffer_description.m_format = static_cast<std::uint32_t>(back_buffer_desc.Format);
+            back_buffer_description.m_bind_flags = D3D11_BIND_RENDER_TARGET;
+            frame_trace_writer.CreateTexture2D(presenter.GetBackBuffer(), back_buffer_description, nullptr);
+            frame_trace_writer.CreateView(presenter.GetBackBufferRenderTargetView(), MockObjectType::RenderTargetView, presenter.GetBackBuffer());
+            frame_trace_writer.BeginFrame();
+            m_device.GetCapturingContext().StartCapture(frame_trace_writer);
+            m_d3d11_composition.Bind();
+        }
+        void EndFrameTrace()
+        {
+            auto& frame_trace_writer = m_device.GetFrameTraceWriter();
+            m_device.GetCapturingContext().StopCapture();
+            frame_trace_writer.WriteToFile(*m_options.m_frame_trace_path);
+            if (m_options.m_is_verbose)
+            {
+                const auto& trace_statistics = frame_trace_writer.GetStatistics();
+                std::printf("traced frame to %s: %u objects, %u commands, %.1f KiB data, %u untracked objects\n",
+                            m_options.m_frame_trace_path->c_str(),
+                            trace_statistics.m_object_count,
+                            trace_statistics.m_command_count,
+                            trace_statistics.m_blob_bytes / 1024.0,
+                            trace_statistics.m_unknown_object_count);
+            }
+            m_options.m_frame_trace_path.reset();
+        }
+        /**
+         * @brief 按本帧的负载调整内部渲染比例，只有D3D11路径支持
+         */
+        void UpdateRenderScale(std::chrono::steady_clock::time_point frame_begin)
+        {
+            FrameLoadSample load_sample{};
+            load_sample.m_cpu_frame_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame_begin).count();
+            // 呈现的耗时可能包含等待垂直同步，只按合成阶段估计GPU负载；结果落后几帧，还没有结果时为0
+            load_sample.m_gpu_frame_ms = m_gpu_resources.GetGpuTimerRing().GetPassTimings(m_composite_pass).GetLast();
+            const auto previous_scale = m_resolution_governor.GetScale();
+            const auto scale = m_resolution_governor.Update(load_sample);
+            if (m_options.m_is_verbose && scale != previous_scale)
+            {
+                std::printf("resolution governor: render scale %.2f -> %.2f, smoothed load %.2f\n",
+                            previous_scale,
+                            scale,
+                            m_resolution_governor.GetSmoothedLoad());
+            }
+        }
+        void ExportFrame()
+        {
+            if (m_p_compositor->GetKind() == CompositorKind::Cpu)
+            {
+                m_frame_readback.Export(m_cpu_compositor.GetTarget());
+            }
+            else
+            {
+                m_frame_readback.Export(m_d3d11_composition.GetPipeline().GetGdiFinalTexture().m_value);
+            }
+        }
+
+    public:
+        CWindowRenderer(CWindowDevice& device, HWND hwnd, const WindowOptions& options, HANDLE render_wake_event)
+            : m_device{device},
+              m_options{options},
+              m_render_wake_event{render_wake_event},
+              m_gpu_resources{device, hwnd},
+              m_composite_pass{m_gpu_resources.GetGpuTimerRing().RegisterPass("composite")},
+              m_gdi_surface{m_gdi_surface_memory, WINDOW_SIZE.cx, WINDOW_SIZE.cy},
+              m_d3d11_composition{device, m_gpu_resources, m_gdi_surface, options.m_use_coverage_texture},
+              m_present_pass{m_gpu_resources.GetGpuTimerRing().RegisterPass("present")},
+              m_d3d11_compositor{
+                  CompositorKind::D3D11,
+                  [this](const MappedSurfaceBuffer& source, const std::vector<SurfaceRect>& updated_rects)
+                  {
+                      m_d3d11_composition.Composite(source, updated_rects, m_resolution_governor.GetScale());
+                  }},
+              m_cpu_compositor{
+                  WINDOW_SIZE.cx,
+                  WINDOW_SIZE.cy,
+                  [this](const CBgraImage& target)
+                  {
+                      auto& gpu_timer_ring = m_gpu_resources.GetGpuTimerRing();
+                      const auto upload_pass = m_d3d11_composition.GetUploadPass();
+                      gpu_timer_ring.BeginPass(upload_pass);
+                      m_device.GetRenderContext().UpdateSubresource(m_gpu_resources.GetPresenter().GetBackBuffer(), 0, nullptr, target.GetData(), target.GetRowPitch(), 0);
+                      gpu_timer_ring.EndPass(upload_pass);
+                      m_device.GetRenderContext().RecordUploadedBytes(target.GetSizeInBytes());
+                  }},
+              m_p_compositor{&m_d3d11_compositor},
+              m_frame_readback{device, m_gpu_resources, options.m_export_shared_frames, options.m_is_verbose},
+              m_system_stats_overlay{m_gdi_surface}
+        {
+            {
+                auto hdc = static_cast<HDC>(m_gdi_surface.GetBackBuffer().m_p_native_handle);
+                RECT text_rect{0, 0, WINDOW_SIZE.cx, WINDOW_SIZE.cy};
+                ::SetBkMode(hdc, TRANSPARENT);
+                ::SetTextColor(hdc, RGB(255, 255, 255));
+                ::DrawTextA(hdc, CMAKE_PROJECT_NAME, -1, &text_rect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+                m_gdi_surface.MarkAllDirty();
+            }
+            // 测量时每次都等待GPU完成，耗时不能计入正常启动
+            if (m_options.m_calibrate_compositors)
+            {
+                m_compositor_selector.emplace(
+                    CompositorCostModel::Calibrate(
+                        [this](std::uint32_t width, std::uint32_t height, std::uint32_t draw_count)
+                        {
+                            return MeasureCpuCompositor(m_device, width, height, draw_count);
+                        }),
+                    CompositorCostModel::Calibrate(
+                        [this](std::uint32_t width, std::uint32_t height, std::uint32_t draw_count)
+                        {
+                            return m_d3d11_composition.MeasureMicroseconds(width, height, draw_count);
+                        }));
+            }
+            SelectCompositor(WINDOW_SIZE.cx, WINDOW_SIZE.cy);
+            // 覆盖率纹理只有D3D11路径支持，没有可比较的CPU结果
+            if (m_options.m_calibrate_compositors && !m_options.m_use_coverage_texture)
+            {
+                VerifyCompositors();
+            }
+            if (m_options.m_is_verbose && m_frame_readback.IsExporting())
+            {
+                std::printf("exporting frames to shared memory %s\n", SHARED_FRAME_NAME);
+            }
+        }
+        CWindowRenderer(const CWindowRenderer&) = delete;
+        CWindowRenderer& operator=(const CWindowRenderer&) = delete;
+
+        void HandleCommand(const RenderCommand& command)
+        {
+            switch (command.m_type)
+            {
+            case RenderCommandType::CaptureFrame:
+                m_is_capture_requested = true;
+                break;
+            case RenderCommandType::InvalidateSurface:
+                m_gdi_surface.MarkAllDirty();
+                break;
+            case RenderCommandType::SetAlphaIncrement:
+                m_d3d11_composition.SetAlphaIncrement(command.m_value);
+                m_cpu_compositor.GetRenderer().SetAlphaIncrement(static_cast<std::uint8_t>(command.m_value * 255.0f + 0.5f));
+                break;
+            }
+            m_is_redraw_needed = true;
+        }
+        /**
+         * @brief 构建并呈现一帧，内容没有变化时等待UI线程的命令或控件定时器
+         *
+         * @return 是否呈现了新的一帧
+         */
+        auto RenderFrame()
+            -> bool
+        {
+            const auto now = std::chrono::steady_clock::now();
+            m_system_stats_overlay.Update(now);
+            if (!m_is_redraw_needed && !m_gdi_surface.IsDirty())
+            {
+                // 空闲时只有一次等待：UI线程的命令或最早到期的控件定时器，以先到者为准
+                auto timeout_ms = FRAME_WAIT_TIMEOUT_MS;
+                if (const auto deadline = m_system_stats_overlay.GetNextDeadline())
+                {
+                    const auto remaining_ms = std::chrono::ceil<std::chrono::milliseconds>(*deadline - now).count();
+                    timeout_ms = static_cast<DWORD>(std::clamp<long long>(remaining_ms, 0, FRAME_WAIT_TIMEOUT_MS));
+                }
+                ::WaitForSingleObjectEx(m_render_wake_event, timeout_ms, TRUE);
+                return false;
+            }
+            auto& presenter = m_gpu_resources.GetPresenter();
+            if (!presenter.WaitForNextFrame(FRAME_WAIT_TIMEOUT_MS))
+            {
+                return false;
+            }
+            m_is_redraw_needed = false;
+            const auto frame_begin = std::chrono::steady_clock::now();
+            if (m_options.m_frame_trace_path)
+            {
+                BeginFrameTrace();
+            }
+            auto& gpu_timer_ring = m_gpu_resources.GetGpuTimerRing();
+            gpu_timer_ring.BeginFrame();
+            const auto& updated_rects = m_gdi_surface.IsDirty() ? m_gdi_surface.Flush() : m_no_updated_rects;
+            gpu_timer_ring.BeginPass(m_composite_pass);
+            m_p_compositor->Composite(m_gdi_surface.GetFrontBuffer(), updated_rects);
+            gpu_timer_ring.EndPass(m_composite_pass);
+            if (m_is_capture_requested)
+            {
+                // CPU合成的结果本来就在内存中
+                if (m_p_compositor->GetKind() == CompositorKind::Cpu)
+                {
+                    WriteCapture(m_cpu_compositor.GetTarget(), 0, m_options.m_is_verbose);
+                }
+                else
+                {
+                    m_frame_readback.RequestCapture(m_d3d11_composition.GetPipeline().GetGdiFinalTexture().m_value);
+                }
+                m_is_capture_requested = false;
+            }
+            if (m_frame_readback.IsExporting())
+            {
+                ExportFrame();
+                // 最后几帧仍在读回中，继续构建新帧把它们发布出去
+                m_is_redraw_needed = m_is_redraw_needed || m_frame_readback.HasPendingExport();
+            }
+            if (m_frame_readback.HasPendingCapture())
+            {
+                m_frame_readback.SaveCapture();
+                // 继续构建新帧直到读回完成
+                m_is_redraw_needed = m_frame_readback.HasPendingCapture();
+            }
+            gpu_timer_ring.BeginPass(m_present_pass);
+            const auto present_result = presenter.Present();
+            gpu_timer_ring.EndPass(m_present_pass);
+            gpu_timer_ring.EndFrame();
+            if (m_device.GetCapturingContext().IsCapturing())
+            {
+                EndFrameTrace();
+            }
+            if (m_p_compositor->GetKind() == CompositorKind::D3D11)
+            {
+                UpdateRenderScale(frame_begin);
+            }
+            if (present_result == DXGI_ERROR_DEVICE_REMOVED || present_result == DXGI_ERROR_DEVICE_RESET)
+            {
+                RecoverFromDeviceLost();
+                m_is_redraw_needed = true;
+                return false;
+            }
+            m_device.GetRenderContext().EndFrame();
+            m_gpu_resources.GetFrameFence().Signal();
+            m_gpu_resources.GetDeferredReleaseQueue().Collect();
+            return true;
+        }
+        void StopSampling()
+        {
+            m_system_stats_overlay.StopSampling();
+        }
+        /**
+         * @brief 输出显存预算、各阶段的GPU耗时和设备上下文的调用统计
+         */
+        void PrintStatistics() const
+        {
+            const auto& gpu_memory_statistics = m_gpu_resources.GetGpuMemoryBudget().GetStatistics();
+            for (std::size_t i = 0; i < GPU_MEMORY_CATEGORY_COUNT; ++i)
+            {
+                const auto& usage = gpu_memory_statistics.m_categories[i];
+                std::printf("gpu memory %s: %llu allocations, %.2f MiB, peak %.2f MiB\n",
+                            GetGpuMemoryCategoryName(static_cast<GpuMemoryCategory>(i)),
+                            static_cast<unsigned long long>(usage.m_allocation_count),
+                            usage.m_current_bytes / 1048576.0,
+                            usage.m_peak_bytes / 1048576.0);
+            }
+            std::printf("gpu memory: peak %.2f MiB, %llu evicted, %llu rejected\n",
+                        gpu_memory_statistics.m_peak_bytes / 1048576.0,
+                        static_cast<unsigned long long>(gpu_memory_statistics.m_evicted_count),
+                        static_cast<unsigned long long>(gpu_memory_statistics.m_rejected_count));
+            const auto& gpu_timer_ring = m_gpu_resources.GetGpuTimerRing();
+            for (std::uint32_t pass = 0; pass < gpu_timer_ring.GetPassCount(); ++pass)
+            {
+                const auto& timings = gpu_timer_ring.GetPassTimings(pass);
+                std::printf("gpu pass %s: avg %.3f ms, min %.3f ms, max %.3f ms over last %zu frames\n",
+                            gpu_timer_ring.GetPassName(pass).c_str(),
+                            timings.GetAverage(),
+                            timings.GetMin(),
+                            timings.GetMax(),
+                            timings.GetCount());
+            }
+            const auto& gpu_timer_statistics = gpu_timer_ring.GetStatistics();
+            std::printf("gpu timer: %llu/%llu frames resolved, %llu skipped, %llu disjoint, latency avg %.2f frames\n",
+                        static_cast<unsigned long long>(gpu_timer_statistics.m_resolved_frame_count),
+                        static_cast<unsigned long long>(gpu_timer_statistics.m_frame_count),
+                        static_cast<unsigned long long>(gpu_timer_statistics.m_skipped_frame_count),
+                        static_cast<unsigned long long>(gpu_timer_statistics.m_disjoint_frame_count),
+                        gpu_timer_statistics.m_resolved_frame_count == 0 ? 0.0 : static_cast<double>(gpu_timer_statistics.m_total_latency_frames) / gpu_timer_statistics.m_resolved_frame_count);
+            const auto& context_frames = m_device.GetRenderContext().GetFrames();
+            if (context_frames.GetCount() != 0)
+            {
+                const auto context_sum = context_frames.Sum();
+                const auto frame_count = static_cast<double>(context_frames.GetCount());
+                for (std::size_t i = 0; i < CONTEXT_CALL_CATEGORY_COUNT; ++i)
+                {
+                    std::printf("device context %s: %.1f calls, %.2f us per frame\n",
+                                GetContextCallCategoryName(static_cast<ContextCallCategory>(i)),
+                                context_sum.m_categories[i].m_call_count / frame_count,
+                                context_sum.m_categories[i].m_cpu_ns / frame_count / 1000.0);
+                }
+                std::printf("device context: last %zu frames, %.1f shader switches, %.1f redundant shader binds, %.0f indices, %.0f bytes uploaded per frame\n",
+                            context_frames.GetCount(),
+                            context_sum.m_shader_switch_count / frame_count,
+                            context_sum.m_redundant_shader_bind_count / frame_count,
+                            context_sum.m_index_count / frame_count,
+                            context_sum.m_uploaded_bytes / frame_count);
+            }
+        }
+    };
+
+    void PrintRenderThreadStatistics(const RenderThreadStatistics& statistics)
+    {
+        std::printf("render thread: %llu frames, %llu commands, max queue depth %llu, %llu full, %llu blocked posts\n",
+                    static_cast<unsigned long long>(statistics.m_frame_count),
+                    static_cast<unsigned long long>(statistics.m_queue.m_push_count),
+                    static_cast<unsigned long long>(statistics.m_queue.m_max_depth),
+                    static_cast<unsigned long long>(statistics.m_queue.m_full_count),
+                    static_cast<unsigned long long>(statistics.m_blocked_post_count));
+    }
+
+    /**
+     * @brief UI线程只处理窗口消息，并通过命令队列通知渲染线程
+     */
+    void RunMessageLoop(CRenderThread& render_thread, HANDLE render_wake_event)
+    {
+        float alpha_increment = AlphaIncreaseConstants{}.m_alpha_increment;
+        MSG msg{};
+        while (::GetMessage(&msg, NULL, 0, 0) > 0)
+        {
+            if (msg.message == WM_KEYDOWN && msg.wParam == VK_F12)
+            {
+                render_thread.Post({RenderCommandType::CaptureFrame});
+                ::SetEvent(render_wake_event);
+            }
+            else if (msg.message == WM_PAINT)
+            {
+                render_thread.Post({RenderCommandType::InvalidateSurface});
+                ::SetEvent(render_wake_event);
+            }
+            else if (msg.message == WM_KEYDOWN && (msg.wParam == VK_UP || msg.wParam == VK_DOWN))
+            {
+                constexpr float ALPHA_INCREMENT_STEP = 1.0f / 255.0f;
+                alpha_increment = (std::clamp)(alpha_increment + (msg.wParam == VK_UP ? ALPHA_INCREMENT_STEP : -ALPHA_INCREMENT_STEP), 0.0f, 1.0f);
+                render_thread.Post({RenderCommandType::SetAlphaIncrement, alpha_increment});
+                ::SetEvent(render_wake_event);
+            }
+            ::TranslateMessage(&msg); //转换
+            ::DispatchMessage(&msg);  //分发
+        }
+    }
+}
+
+auto WindowMode::ParseOptions(int argc, const char* const argv[])
+    -> WindowOptions
+{
+    auto find_option_value = [argc, argv](std::string_view name)
+        -> std::optional<std::string>
+    {
+        const auto p_option = std::find(argv + 1, argv + argc, name);
+        if (p_option == argv + argc || p_option + 1 == argv + argc)
+        {
+            return std::nullopt;
+        }
+        return std::string{*(p_option + 1)};
+    };
+    auto has_option = [argc, argv](std::string_view name)
+    {
+        return std::find(argv + 1, argv + argc, name) != argv + argc;
+    };
+    WindowOptions options{};
+    options.m_use_coverage_texture = has_option("--coverage");
+    options.m_export_shared_frames = has_option("--shared-frames");
+    options.m_calibrate_compositors = has_option("--calibrate-compositors");
+    options.m_is_verbose = has_option("--verbose");
+    options.m_frame_trace_path = find_option_value("--trace-frame");
+    options.m_replay_trace_path = find_option_value("--replay-trace");
+    return options;
+}
+
+int WindowMode::Run(const WindowOptions& options)
+{
+    HWND hwnd = CreateMainWindow();
+    CWindowDevice device{};
+    if (options.m_replay_trace_path)
+    {
+        return RunReplayTrace(*options.m_replay_trace_path, device);
+    }
+
+    // ComPtr<IDXGraphicsAnalysis> p_dxgi_analysis{};
+    //{
+    //     ThrowIfFailed(DXGIGetDebugInterface1(0, IID_PPV_ARGS(&p_dxgi_analysis)));
+    // }
+    // p_dxgi_analysis->BeginCapture();
+
+    // UI线程发送命令后唤醒空闲的渲染线程
+    std::unique_ptr<void, decltype(&::CloseHandle)> render_wake_event{::CreateEvent(NULL, FALSE, FALSE, NULL), &::CloseHandle};
+    if (render_wake_event == nullptr)
+    {
+        throw std::runtime_error{"CreateEvent failed."};
+    }
+    CWindowRenderer renderer{device, hwnd, options, render_wake_event.get()};
+
+    // p_dxgi_analysis->EndCapture();
+
+    // 渲染器此后只由渲染线程访问
+    const auto ui_thread_id = ::GetCurrentThreadId();
+    CRenderThread render_thread{
+        [&renderer](const RenderCommand& command)
+        {
+            renderer.HandleCommand(command);
+        },
+        [&]()
+            -> bool
+        {
+            try
+            {
+                return renderer.RenderFrame();
+            }
+            catch (...)
+            {
+                // 唤醒阻塞在GetMessage中的UI线程，异常由Stop重新抛出
+                ::PostThreadMessage(ui_thread_id, WM_QUIT, 0, 0);
+                throw;
+            }
+        }};
+    RunMessageLoop(render_thread, render_wake_event.get());
+    renderer.StopSampling();
+    const auto render_thread_statistics = render_thread.GetStatistics();
+    render_thread.Stop();
+    if (!options.m_is_verbose)
+    {
+        return 0;
+    }
+    PrintRenderThreadStatistics(render_thread_statistics);
+    renderer.PrintStatistics();
+    return 0;
+}
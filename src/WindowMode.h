@@ -0,0 +1,45 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <Windows.h>
+
+/**
+ * @brief 窗口模式的参数，对应命令行 \n
+ * [--coverage] [--shared-frames] [--calibrate-compositors] [--verbose] [--trace-frame 路径] [--replay-trace 路径]
+ */
+struct WindowOptions
+{
+    // --coverage：文字表面以R8覆盖率纹理上传，颜色在像素着色器中乘上
+    bool m_use_coverage_texture{};
+    // --shared-frames：把合成结果写入共享内存，供其它进程直接映射读取
+    bool m_export_shared_frames{};
+    // --calibrate-compositors：启动时在本机上测量两条合成路径并按耗时模型选择，再比较两条路径的合成结果；否则总是使用D3D11路径
+    bool m_calibrate_compositors{};
+    // --verbose：在控制台输出设备丢失、截图、跟踪和分辨率调整等事件，退出时输出各项统计
+    bool m_is_verbose{};
+    // --trace-frame 路径：把第一帧连同它用到的全部资源写入跟踪文件
+    std::optional<std::string> m_frame_trace_path{};
+    // --replay-trace 路径：在本机的设备上回放跟踪文件并输出耗时，不显示窗口内容
+    std::optional<std::string> m_replay_trace_path{};
+};
+
+/**
+ * @brief 默认的渲染模式：GDI绘制的文字经D3D11或CPU合成后显示在窗口中
+ */
+namespace WindowMode
+{
+    constexpr SIZE WINDOW_SIZE = {350, 100};
+
+    /**
+     * @brief 解析命令行，未指定的选项保持默认值
+     */
+    auto ParseOptions(int argc, const char* const argv[])
+        -> WindowOptions;
+
+    /**
+     * @brief 创建窗口并运行渲染线程和消息循环，直到窗口关闭
+     *
+     * @return int 进程返回值
+     */
+    int Run(const WindowOptions& options);
+}
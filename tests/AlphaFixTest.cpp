@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include "AlphaFix.h"
+#include "CBgraImage.h"
+#include "TestCheck.h"
+
+namespace
+{
+    void TestScalarReference()
+    {
+        const std::array<std::uint8_t, 8> source{10, 20, 30, 0, 40, 50, 60, 250};
+        std::array<std::uint8_t, 8> target{};
+        AlphaFix::IncreaseAlphaScalar(source.data(), 8, target.data(), 8, 2, 1, 17);
+        TEST_REQUIRE((target == std::array<std::uint8_t, 8>{10, 20, 30, 17, 40, 50, 60, 255}));
+    }
+
+    void TestUnsupportedKernelThrows()
+    {
+        for (std::size_t i = 0; i < ALPHA_FIX_KERNEL_COUNT; ++i)
+        {
+            const auto kernel = static_cast<AlphaFixKernel>(i);
+            if (AlphaFix::IsKernelSupported(kernel))
+            {
+                continue;
+            }
+            std::array<std::uint8_t, 4> pixel{};
+            TEST_REQUIRE(TestCheck::Throws<std::invalid_argument>([&]()
+                                                                  { AlphaFix::IncreaseAlpha(kernel, pixel.data(), 4, pixel.data(), 4, 1, 1, 1); }));
+        }
+        TEST_REQUIRE(AlphaFix::IsKernelSupported(AlphaFix::GetBestKernel()));
+    }
+
+    void TestKernelsMatchScalar()
+    {
+        // 宽度覆盖各实现的尾部处理；行距多出一段，检查各实现只写入每行的前width个像素
+        constexpr std::array<std::array<std::uint32_t, 2>, 5> SURFACE_SIZES{{{1, 1}, {7, 3}, {64, 64}, {129, 17}, {350, 100}}};
+        constexpr std::array<std::uint8_t, 4> ALPHA_INCREMENTS{0, 1, 17, 255};
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<std::uint32_t> byte_distribution{0, 255};
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            const auto row_pitch = width * CBgraImage::BYTES_PER_PIXEL + 64;
+            CBgraImage source{width, height, row_pitch};
+            std::generate(source.GetData(), source.GetData() + source.GetSizeInBytes(), [&]()
+                          { return static_cast<std::uint8_t>(byte_distribution(random_engine)); });
+            CBgraImage reference{width, height, row_pitch};
+            CBgraImage target{width, height, row_pitch};
+            for (std::size_t i = 0; i < ALPHA_FIX_KERNEL_COUNT; ++i)
+            {
+                const auto kernel = static_cast<AlphaFixKernel>(i);
+                if (!AlphaFix::IsKernelSupported(kernel))
+                {
+                    continue;
+                }
+                for (const auto alpha_increment : ALPHA_INCREMENTS)
+                {
+                    std::fill(reference.GetData(), reference.GetData() + reference.GetSizeInBytes(), std::uint8_t{0});
+                    std::fill(target.GetData(), target.GetData() + target.GetSizeInBytes(), std::uint8_t{0});
+                    AlphaFix::IncreaseAlphaScalar(source.GetData(), source.GetRowPitch(), reference.GetData(), reference.GetRowPitch(), width, height, alpha_increment);
+                    AlphaFix::IncreaseAlpha(kernel, source.GetData(), source.GetRowPitch(), target.GetData(), target.GetRowPitch(), width, height, alpha_increment);
+                    TEST_REQUIRE(std::equal(target.GetData(), target.GetData() + target.GetSizeInBytes(), reference.GetData()));
+
+                    // 原地修正
+                    std::copy(source.GetData(), source.GetData() + source.GetSizeInBytes(), target.GetData());
+                    AlphaFix::IncreaseAlpha(kernel, target.GetData(), target.GetRowPitch(), target.GetData(), target.GetRowPitch(), width, height, alpha_increment);
+                    for (std::uint32_t y = 0; y < height; ++y)
+                    {
+                        TEST_REQUIRE(std::equal(target.GetRow(y), target.GetRow(y) + static_cast<std::size_t>(width) * CBgraImage::BYTES_PER_PIXEL, reference.GetRow(y)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    TestScalarReference();
+    TestUnsupportedKernelThrows();
+    TestKernelsMatchScalar();
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "CGpuMemoryBudget.h"
+#include "GpuResourceDescription.h"
+#include "TestCheck.h"
+
+namespace
+{
+    /**
+     * @brief 记录被逐出分配的user_data
+     */
+    class CRecordingEvictor final : public IGpuMemoryEvictor
+    {
+    public:
+        std::vector<std::uint64_t> m_evicted_user_data{};
+
+        void Evict(GpuAllocationHandle, std::uint64_t user_data) override
+        {
+            m_evicted_user_data.push_back(user_data);
+        }
+    };
+
+    /**
+     * @brief 按页分配的图集：页面被逐出后下次使用时重新生成
+     */
+    class CAtlasCache final : public IGpuMemoryEvictor
+    {
+    public:
+        std::vector<GpuAllocationHandle> m_page_allocations{};
+        std::uint64_t m_resident_page_count{};
+
+        explicit CAtlasCache(std::uint32_t page_count)
+            : m_page_allocations(page_count)
+        {
+        }
+
+        void Evict(GpuAllocationHandle, std::uint64_t user_data) override
+        {
+            m_page_allocations[user_data] = {};
+            --m_resident_page_count;
+        }
+    };
+
+    auto MakeConfig(std::uint64_t budget_bytes, std::uint64_t hard_limit_bytes)
+        -> GpuMemoryBudgetConfig
+    {
+        GpuMemoryBudgetConfig config{};
+        config.m_budget_bytes = budget_bytes;
+        config.m_hard_limit_bytes = hard_limit_bytes;
+        return config;
+    }
+
+    void TestEstimateTexture2DBytes()
+    {
+        TEST_REQUIRE(EstimateTexture2DBytes(4, 4, GpuFormat::B8G8R8A8_UNORM, 1, 1) == 64);
+        // 完整的mip链：4x4、2x2、1x1
+        TEST_REQUIRE(EstimateTexture2DBytes(4, 4, GpuFormat::B8G8R8A8_UNORM, 0, 1) == 84);
+        // 非正方形的mip链：4x2、2x1、1x1
+        TEST_REQUIRE(EstimateTexture2DBytes(4, 2, GpuFormat::B8G8R8A8_UNORM, 0, 1) == 44);
+        TEST_REQUIRE(EstimateTexture2DBytes(4, 4, GpuFormat::B8G8R8A8_UNORM, 1, 3) == 192);
+        // 未知格式按每像素4字节估计
+        TEST_REQUIRE(EstimateTexture2DBytes(4, 4, 0xFFFF, 1, 1) == 64);
+    }
+
+    void TestInvalidConfig()
+    {
+        TEST_REQUIRE(TestCheck::Throws<std::invalid_argument>([]()
+                                                              { CGpuMemoryBudget budget{MakeConfig(200, 100)}; }));
+    }
+
+    void TestLruEviction()
+    {
+        CGpuMemoryBudget budget{MakeConfig(100, 150)};
+        CRecordingEvictor evictor{};
+        const auto a = budget.Reserve(GpuMemoryCategory::Atlas, 40, &evictor, 0);
+        const auto b = budget.Reserve(GpuMemoryCategory::Atlas, 40, &evictor, 1);
+        budget.Touch(a);
+        const auto c = budget.Reserve(GpuMemoryCategory::Atlas, 40, &evictor, 2);
+        // a刚被使用，先逐出b
+        TEST_REQUIRE((evictor.m_evicted_user_data == std::vector<std::uint64_t>{1}));
+        TEST_REQUIRE(!budget.IsActive(b));
+        TEST_REQUIRE(budget.IsActive(a) && budget.IsActive(c));
+
+        // 不可逐出的分配同样让可逐出的分配让出空间，直到回到预算以内
+        const auto intermediate = budget.Reserve(GpuMemoryCategory::Intermediate, 60);
+        TEST_REQUIRE((evictor.m_evicted_user_data == std::vector<std::uint64_t>{1, 0}));
+        TEST_REQUIRE(budget.IsActive(c));
+
+        const auto& statistics = budget.GetStatistics();
+        TEST_REQUIRE(statistics.m_current_bytes == 100);
+        TEST_REQUIRE(statistics.m_evicted_count == 2);
+        TEST_REQUIRE(statistics.m_evicted_bytes == 80);
+        TEST_REQUIRE(statistics.m_over_budget_count == 0);
+        TEST_REQUIRE(statistics.m_categories[static_cast<std::size_t>(GpuMemoryCategory::Atlas)].m_current_bytes == 40);
+        TEST_REQUIRE(statistics.m_categories[static_cast<std::size_t>(GpuMemoryCategory::Atlas)].m_peak_bytes == 80);
+        TEST_REQUIRE(statistics.m_categories[static_cast<std::size_t>(GpuMemoryCategory::Intermediate)].m_current_bytes == 60);
+
+        TEST_REQUIRE(!budget.Release(b));
+        TEST_REQUIRE(budget.Release(intermediate));
+        TEST_REQUIRE(!budget.Release(intermediate));
+        TEST_REQUIRE(budget.GetStatistics().m_current_bytes == 40);
+    }
+
+    void TestHardLimit()
+    {
+        CGpuMemoryBudget budget{MakeConfig(100, 150)};
+        CRecordingEvictor evictor{};
+        const auto cached = budget.Reserve(GpuMemoryCategory::Atlas, 50, &evictor, 0);
+        budget.Reserve(GpuMemoryCategory::Intermediate, 90);
+        TEST_REQUIRE(evictor.m_evicted_user_data.size() == 1);
+        // 超过软预算但未超过硬上限时接受并计数
+        TEST_REQUIRE(!budget.TryReserve(GpuMemoryCategory::Intermediate, 50).IsNull());
+        TEST_REQUIRE(budget.GetStatistics().m_over_budget_count == 1);
+
+        // 即使逐出全部可逐出的分配也放不下时拒绝，且不逐出缓存
+        const auto recached = budget.Reserve(GpuMemoryCategory::Atlas, 10, &evictor, 1);
+        TEST_REQUIRE(budget.TryReserve(GpuMemoryCategory::Intermediate, 20).IsNull());
+        TEST_REQUIRE(budget.IsActive(recached));
+        TEST_REQUIRE(TestCheck::Throws<std::runtime_error>([&]()
+                                                           { budget.Reserve(GpuMemoryCategory::Intermediate, 20); }));
+        TEST_REQUIRE(budget.GetStatistics().m_rejected_count == 2);
+        TEST_REQUIRE(budget.GetStatistics().m_current_bytes <= 150);
+        TEST_REQUIRE(!budget.IsActive(cached));
+    }
+
+    void TestAtlasStaysConsistent()
+    {
+        // 256x256的BGRA图集页，工作集为预算的四倍，访问集中在少数页面上
+        constexpr std::uint32_t PAGE_SIZE = 256;
+        constexpr std::uint32_t PAGE_COUNT = 512;
+        constexpr std::uint32_t ACCESS_COUNT = 100'000;
+        const auto page_bytes = EstimateTexture2DBytes(PAGE_SIZE, PAGE_SIZE, GpuFormat::B8G8R8A8_UNORM, 1, 1);
+        const auto config = MakeConfig(32ull << 20, 48ull << 20);
+        CGpuMemoryBudget budget{config};
+        budget.Reserve(GpuMemoryCategory::Intermediate, 8ull << 20);
+        CAtlasCache atlas{PAGE_COUNT};
+
+        std::mt19937 random_engine{7};
+        std::uniform_real_distribution<double> distribution{0.0, 1.0};
+        for (std::uint32_t i = 0; i < ACCESS_COUNT; ++i)
+        {
+            const auto page = (std::min)(PAGE_COUNT - 1, static_cast<std::uint32_t>(std::pow(distribution(random_engine), 3.0) * PAGE_COUNT));
+            auto& allocation = atlas.m_page_allocations[page];
+            if (!allocation.IsNull())
+            {
+                budget.Touch(allocation);
+                continue;
+            }
+            allocation = budget.TryReserve(GpuMemoryCategory::Atlas, page_bytes, &atlas, page);
+            atlas.m_resident_page_count += allocation.IsNull() ? 0 : 1;
+            TEST_REQUIRE(budget.GetStatistics().m_current_bytes <= config.m_budget_bytes);
+        }
+        const auto& statistics = budget.GetStatistics();
+        TEST_REQUIRE(statistics.m_categories[static_cast<std::size_t>(GpuMemoryCategory::Atlas)].m_current_bytes == atlas.m_resident_page_count * page_bytes);
+        TEST_REQUIRE(statistics.m_evicted_count != 0);
+        TEST_REQUIRE(statistics.m_rejected_count == 0);
+    }
+
+    void TestReservation()
+    {
+        CGpuMemoryBudget budget{};
+        {
+            CGpuMemoryReservation reservation{&budget, GpuMemoryCategory::SwapChain, 1024};
+            TEST_REQUIRE(budget.GetStatistics().m_current_bytes == 1024);
+            CGpuMemoryReservation moved{std::move(reservation)};
+            TEST_REQUIRE(budget.GetStatistics().m_current_bytes == 1024);
+        }
+        TEST_REQUIRE(budget.GetStatistics().m_current_bytes == 0);
+        TEST_REQUIRE(budget.GetStatistics().m_released_count == 1);
+        CGpuMemoryReservation unbudgeted{nullptr, GpuMemoryCategory::SwapChain, 1024};
+    }
+}
+
+int main()
+{
+    TestEstimateTexture2DBytes();
+    TestInvalidConfig();
+    TestLruEviction();
+    TestHardLimit();
+    TestAtlasStaysConsistent();
+    TestReservation();
+    return 0;
+}
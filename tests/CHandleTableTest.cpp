@@ -0,0 +1,77 @@
+#include <string>
+#include "CHandleTable.h"
+#include "TestCheck.h"
+
+namespace
+{
+    void TestHandleLayout()
+    {
+        using TestHandle = Handle<int>;
+        const auto handle = TestHandle::Make(5, 3);
+        TEST_REQUIRE(handle.GetIndex() == 5);
+        TEST_REQUIRE(handle.GetGeneration() == 3);
+        TEST_REQUIRE(!handle.IsNull());
+        TEST_REQUIRE(TestHandle{}.IsNull());
+        TEST_REQUIRE(TestHandle::Make(TestHandle::INDEX_MASK, TestHandle::GENERATION_MASK).GetIndex() == TestHandle::INDEX_MASK);
+        TEST_REQUIRE(TestHandle::Make(TestHandle::INDEX_MASK, TestHandle::GENERATION_MASK).GetGeneration() == TestHandle::GENERATION_MASK);
+    }
+
+    void TestInsertGetRemove()
+    {
+        CHandleTable<std::string> table{};
+        const auto a = table.Insert("a");
+        const auto b = table.Insert("b");
+        const auto c = table.Insert("c");
+        TEST_REQUIRE(table.GetSize() == 3);
+        TEST_REQUIRE(!a.IsNull() && !b.IsNull() && !c.IsNull());
+        TEST_REQUIRE(*table.Get(b) == "b");
+
+        // 删除中间的对象时最后一个对象移入空位，其它句柄仍然有效
+        std::string removed{};
+        TEST_REQUIRE(table.Remove(a, &removed));
+        TEST_REQUIRE(removed == "a");
+        TEST_REQUIRE(table.GetSize() == 2);
+        TEST_REQUIRE(!table.IsValid(a));
+        TEST_REQUIRE(table.Get(a) == nullptr);
+        TEST_REQUIRE(!table.Remove(a));
+        TEST_REQUIRE(*table.Get(b) == "b");
+        TEST_REQUIRE(*table.Get(c) == "c");
+        TEST_REQUIRE(table.GetObjects()[0] == "c");
+        TEST_REQUIRE(table.GetHandleAt(0) == c);
+        TEST_REQUIRE(table.GetHandleAt(1) == b);
+    }
+
+    void TestStaleHandleAfterSlotReuse()
+    {
+        CHandleTable<int> table{};
+        const auto old_handle = table.Insert(1);
+        TEST_REQUIRE(table.Remove(old_handle));
+        const auto new_handle = table.Insert(2);
+        TEST_REQUIRE(new_handle.GetIndex() == old_handle.GetIndex());
+        TEST_REQUIRE(new_handle.GetGeneration() != old_handle.GetGeneration());
+        TEST_REQUIRE(!table.IsValid(old_handle));
+        TEST_REQUIRE(*table.Get(new_handle) == 2);
+    }
+
+    void TestGenerationSkipsZero()
+    {
+        // 代数回绕时跳过0，同一个槽位的句柄永远不是空句柄
+        CHandleTable<int> table{};
+        for (std::uint32_t i = 0; i <= Handle<int>::GENERATION_MASK + 1; ++i)
+        {
+            const auto handle = table.Insert(0);
+            TEST_REQUIRE(handle.GetIndex() == 0);
+            TEST_REQUIRE(handle.GetGeneration() != 0);
+            TEST_REQUIRE(table.Remove(handle));
+        }
+    }
+}
+
+int main()
+{
+    TestHandleLayout();
+    TestInsertGetRemove();
+    TestStaleHandleAfterSlotReuse();
+    TestGenerationSkipsZero();
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include "CBgraImage.h"
+#include "CMockD3D11Device.h"
+#include "MockComposition.h"
+#include "TestCheck.h"
+
+namespace
+{
+    struct ValidationCase
+    {
+        const char* m_p_name;
+        bool m_is_valid;
+        void (*m_p_create)(CMockD3D11Device& device);
+    };
+
+    void TestValidation()
+    {
+        // 非法的描述应被拒绝，合法的描述应被接受
+        const std::array<ValidationCase, 10> cases{{
+            {"immutable buffer without data", false, [](CMockD3D11Device& device)
+             { device.CreateBuffer({16, GpuUsage::IMMUTABLE, GpuBindFlag::VERTEX_BUFFER, 0}, nullptr); }},
+            {"constant buffer size 20", false, [](CMockD3D11Device& device)
+             { device.CreateBuffer({20, GpuUsage::DYNAMIC, GpuBindFlag::CONSTANT_BUFFER, GpuCpuAccessFlag::WRITE}, nullptr); }},
+            {"dynamic buffer without cpu write", false, [](CMockD3D11Device& device)
+             { device.CreateBuffer({16, GpuUsage::DYNAMIC, GpuBindFlag::VERTEX_BUFFER, 0}, nullptr); }},
+            {"staging texture with bind flags", false, [](CMockD3D11Device& device)
+             { device.CreateTexture2D({64, 64, 1, 1, GpuFormat::B8G8R8A8_UNORM, 1, GpuUsage::STAGING, GpuBindFlag::SHADER_RESOURCE, GpuCpuAccessFlag::READ}, nullptr); }},
+            {"texture with too many mips", false, [](CMockD3D11Device& device)
+             { device.CreateTexture2D({64, 64, 8, 1, GpuFormat::B8G8R8A8_UNORM, 1, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0}, nullptr); }},
+            {"render target view of srv texture", false, [](CMockD3D11Device& device)
+             { device.CreateRenderTargetView(device.CreateTexture2D({64, 64, 1, 1, GpuFormat::B8G8R8A8_UNORM, 1, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0}, nullptr)); }},
+            {"8-bit index buffer binding", false, [](CMockD3D11Device& device)
+             { device.GetImmediateContext().IASetIndexBuffer(device.CreateBuffer({16, GpuUsage::DEFAULT, GpuBindFlag::INDEX_BUFFER, 0}, nullptr), GpuFormat::R8_UINT, 0); }},
+            {"full mip chain texture", true, [](CMockD3D11Device& device)
+             { device.CreateTexture2D({64, 32, 0, 1, GpuFormat::B8G8R8A8_UNORM, 1, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0}, nullptr); }},
+            {"staging readback texture", true, [](CMockD3D11Device& device)
+             { device.CreateTexture2D({64, 64, 1, 1, GpuFormat::B8G8R8A8_UNORM, 1, GpuUsage::STAGING, 0, GpuCpuAccessFlag::READ}, nullptr); }},
+            {"composition pipeline", true, [](CMockD3D11Device& device)
+             { MockComposition composition{device}; }},
+        }};
+        for (const auto& validation_case : cases)
+        {
+            CMockD3D11Device device{};
+            const bool is_accepted = !TestCheck::Throws<std::invalid_argument>([&]()
+                                                                               { validation_case.m_p_create(device); });
+            if (is_accepted != validation_case.m_is_valid)
+            {
+                std::fprintf(stderr, "mock-device case \"%s\": %s\n", validation_case.m_p_name, is_accepted ? "accepted" : "rejected");
+            }
+            TEST_REQUIRE(is_accepted == validation_case.m_is_valid);
+        }
+    }
+
+    void TestCompositedFramesAreValid()
+    {
+        // 不缩放时alpha修正直接写入后台缓冲区，缩放时多一次缩放输出
+        CMockD3D11Device device{};
+        const MockComposition composition{device};
+        CBgraImage surface{MOCK_SURFACE_WIDTH, MOCK_SURFACE_HEIGHT};
+        auto& context = device.GetImmediateContext();
+        composition.m_pipeline.Bind(context);
+        CompositeMockFrame(context, composition, surface, 1.0f);
+        CompositeMockFrame(context, composition, surface, 0.5f);
+        const auto& statistics = context.GetStatistics();
+        TEST_REQUIRE(statistics.m_call_counts[static_cast<std::size_t>(MockCallType::DrawIndexed)] == 3);
+        TEST_REQUIRE(statistics.m_invalid_draw_count == 0);
+        TEST_REQUIRE(statistics.m_binding_hazard_count == 0);
+        TEST_REQUIRE(statistics.m_uploaded_bytes != 0);
+    }
+}
+
+int main()
+{
+    TestValidation();
+    TestCompositedFramesAreValid();
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "CBgraImage.h"
+#include "CCpuReadbackBackend.h"
+#include "CReadbackRing.h"
+#include "TestCheck.h"
+
+namespace
+{
+    constexpr std::uint32_t WIDTH = 350;
+    constexpr std::uint32_t HEIGHT = 100;
+
+    auto MakeConfig(std::uint32_t ring_depth)
+        -> ReadbackRingConfig
+    {
+        ReadbackRingConfig config{};
+        config.m_width = WIDTH;
+        config.m_height = HEIGHT;
+        config.m_ring_depth = ring_depth;
+        return config;
+    }
+
+    /**
+     * @brief 在源图像第一行写入帧序号，每行最后一个像素写入行号
+     */
+    void StampFrame(CBgraImage& source, std::uint32_t frame)
+    {
+        std::memcpy(source.GetRow(0), &frame, sizeof(frame));
+        for (std::uint32_t y = 0; y < source.GetHeight(); ++y)
+        {
+            source.GetPixel(source.GetWidth() - 1, y)[0] = static_cast<std::uint8_t>(y);
+        }
+    }
+
+    auto ReadStampedFrame(const ReadbackView& view)
+        -> std::uint32_t
+    {
+        std::uint32_t frame{};
+        std::memcpy(&frame, view.GetRow(0), sizeof(frame));
+        return frame;
+    }
+
+    void TestInvalidConfig()
+    {
+        CCpuReadbackBackend backend{};
+        TEST_REQUIRE(TestCheck::Throws<std::invalid_argument>([&]()
+                                                              { CReadbackRing ring{backend, MakeConfig(0)}; }));
+    }
+
+    void TestSkipAndSupersede()
+    {
+        CBgraImage source{WIDTH, HEIGHT};
+        CCpuReadbackBackend backend{};
+        const auto source_id = backend.RegisterSource(source);
+        CReadbackRing ring{backend, MakeConfig(3)};
+        TEST_REQUIRE(!ring.TryAcquireLatest());
+
+        for (std::uint32_t frame = 1; frame <= 3; ++frame)
+        {
+            StampFrame(source, frame);
+            TEST_REQUIRE(ring.Request(source_id));
+        }
+        // 三个暂存槽都在途，第四帧被跳过而不是等待
+        TEST_REQUIRE(!ring.Request(source_id));
+        TEST_REQUIRE(!ring.TryAcquireLatest());
+
+        // 前两帧完成时只读取第二帧，第一帧被取代
+        backend.Complete(2);
+        const auto view = ring.TryAcquireLatest();
+        TEST_REQUIRE(view);
+        TEST_REQUIRE(view->m_frame_index == 2);
+        TEST_REQUIRE(ReadStampedFrame(*view) == 2);
+        TEST_REQUIRE(view->m_row_pitch >= WIDTH * CBgraImage::BYTES_PER_PIXEL);
+        for (std::uint32_t y = 0; y < HEIGHT; ++y)
+        {
+            TEST_REQUIRE(view->GetRow(y)[static_cast<std::size_t>(WIDTH - 1) * view->m_bytes_per_pixel] == static_cast<std::uint8_t>(y));
+        }
+        ring.Release();
+        TEST_REQUIRE(ring.HasPendingRequest());
+
+        backend.CompleteAll();
+        const auto latest_view = ring.TryAcquireLatest();
+        TEST_REQUIRE(latest_view);
+        TEST_REQUIRE(latest_view->m_frame_index == 3);
+        TEST_REQUIRE(ReadStampedFrame(*latest_view) == 3);
+        ring.Release();
+        TEST_REQUIRE(!ring.HasPendingRequest());
+
+        const auto& statistics = ring.GetStatistics();
+        TEST_REQUIRE(statistics.m_request_count == 4);
+        TEST_REQUIRE(statistics.m_acquired_count == 2);
+        TEST_REQUIRE(statistics.m_skipped_count == 1);
+        TEST_REQUIRE(statistics.m_superseded_count == 1);
+        TEST_REQUIRE(statistics.m_max_latency_frames == 2);
+    }
+
+    void TestStreamingFrameStamps()
+    {
+        // 模拟GPU落后CPU两帧执行复制命令，读到的内容必须是视图标注的那一帧
+        constexpr std::uint64_t GPU_LATENCY_FRAMES = 2;
+        constexpr std::uint32_t FRAME_COUNT = 240;
+        constexpr std::array<std::uint32_t, 3> RING_DEPTHS{1, 2, 3};
+        for (const auto ring_depth : RING_DEPTHS)
+        {
+            CBgraImage source{WIDTH, HEIGHT};
+            CCpuReadbackBackend backend{};
+            const auto source_id = backend.RegisterSource(source);
+            CReadbackRing ring{backend, MakeConfig(ring_depth)};
+            std::vector<std::uint64_t> submitted_counts(FRAME_COUNT + 1);
+            for (std::uint32_t frame = 1; frame <= FRAME_COUNT; ++frame)
+            {
+                StampFrame(source, frame);
+                ring.Request(source_id);
+                submitted_counts[frame] = backend.GetSubmittedCount();
+                if (frame > GPU_LATENCY_FRAMES)
+                {
+                    backend.Complete(submitted_counts[frame - GPU_LATENCY_FRAMES]);
+                }
+                if (const auto view = ring.TryAcquireLatest())
+                {
+                    TEST_REQUIRE(ReadStampedFrame(*view) == view->m_frame_index);
+                    TEST_REQUIRE(view->m_frame_index + GPU_LATENCY_FRAMES <= frame);
+                    ring.Release();
+                }
+            }
+            TEST_REQUIRE(ring.GetStatistics().m_acquired_count != 0);
+        }
+    }
+}
+
+int main()
+{
+    TestInvalidConfig();
+    TestSkipAndSupersede();
+    TestStreamingFrameStamps();
+    return 0;
+}
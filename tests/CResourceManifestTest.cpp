@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "CBgraImage.h"
+#include "CMockD3D11Device.h"
+#include "MockComposition.h"
+#include "TestCheck.h"
+
+namespace
+{
+    void TestRecoveryRestoresPipeline()
+    {
+        // 模拟两次设备丢失：每次都在新设备上按清单重建全部资源，旧设备随后销毁
+        auto p_device = std::make_unique<CMockD3D11Device>();
+        MockComposition composition{*p_device};
+        const auto resource_count = composition.m_manifest.GetResourceCount();
+        TEST_REQUIRE(resource_count != 0);
+        for (int i = 0; i < 2; ++i)
+        {
+            auto p_new_device = std::make_unique<CMockD3D11Device>();
+            const auto recovery = composition.m_manifest.Recreate(*p_new_device);
+            p_device = std::move(p_new_device);
+            TEST_REQUIRE(recovery.m_resource_count == resource_count);
+            TEST_REQUIRE(p_device->GetStatistics().m_created_count == resource_count);
+        }
+
+        // 与窗口模式相同，交换链在新设备上重新创建，然后重新绑定管线并合成
+        GpuTexture2DDescription back_buffer_description{};
+        back_buffer_description.m_width = MOCK_SURFACE_WIDTH;
+        back_buffer_description.m_height = MOCK_SURFACE_HEIGHT;
+        back_buffer_description.m_bind_flags = GpuBindFlag::RENDER_TARGET;
+        composition.m_p_back_buffer = p_device->CreateTexture2D(back_buffer_description, nullptr);
+        composition.m_p_back_buffer_rtv = p_device->CreateRenderTargetView(composition.m_p_back_buffer);
+        CBgraImage surface{MOCK_SURFACE_WIDTH, MOCK_SURFACE_HEIGHT};
+        auto& context = p_device->GetImmediateContext();
+        composition.m_pipeline.Bind(context);
+        CompositeMockFrame(context, composition, surface, 1.0f);
+        CompositeMockFrame(context, composition, surface, 0.5f);
+        const auto& context_statistics = context.GetStatistics();
+        TEST_REQUIRE(context_statistics.m_call_counts[static_cast<std::size_t>(MockCallType::DrawIndexed)] == 3);
+        TEST_REQUIRE(context_statistics.m_invalid_draw_count == 0);
+        TEST_REQUIRE(context_statistics.m_binding_hazard_count == 0);
+    }
+}
+
+int main()
+{
+    TestRecoveryRestoresPipeline();
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CBgraImage.h"
+#include "CSharedFrameRing.h"
+#include "TestCheck.h"
+
+namespace
+{
+    auto MakeUniqueName(const char* p_suffix)
+        -> std::string
+    {
+        return std::string{"DX11Rendering2DDemoTest"} + p_suffix + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    auto ReadStampedSequence(const SharedFrameView& view)
+        -> std::uint64_t
+    {
+        std::uint64_t sequence{};
+        std::memcpy(&sequence, view.GetRow(0), sizeof(sequence));
+        return sequence;
+    }
+
+    void TestPublishAndAcquire()
+    {
+        constexpr std::uint32_t WIDTH = 64;
+        constexpr std::uint32_t HEIGHT = 16;
+        const auto name = MakeUniqueName("Publish");
+        CSharedFrameWriter writer{name, WIDTH, HEIGHT};
+        const CSharedFrameReader reader{name};
+        TEST_REQUIRE(reader.GetWidth() == WIDTH);
+        TEST_REQUIRE(reader.GetHeight() == HEIGHT);
+        TEST_REQUIRE(!reader.TryAcquireLatest(0));
+
+        CBgraImage source{WIDTH, HEIGHT};
+        source.GetPixel(WIDTH - 1, HEIGHT - 1)[2] = 0x5A;
+        std::uint64_t stamp = 1;
+        std::memcpy(source.GetRow(0), &stamp, sizeof(stamp));
+        TEST_REQUIRE(writer.Publish(source.GetData(), source.GetRowPitch(), {}) == 1);
+        const auto first_view = reader.TryAcquireLatest(0);
+        TEST_REQUIRE(first_view);
+        TEST_REQUIRE(first_view->m_sequence == 1);
+        TEST_REQUIRE(first_view->m_width == WIDTH && first_view->m_height == HEIGHT);
+        TEST_REQUIRE(ReadStampedSequence(*first_view) == 1);
+        TEST_REQUIRE(first_view->GetRow(HEIGHT - 1)[(WIDTH - 1) * 4 + 2] == 0x5A);
+        TEST_REQUIRE(reader.Validate(*first_view));
+        TEST_REQUIRE(!reader.TryAcquireLatest(1));
+
+        // 只有脏矩形变化的一帧，读者拿到相同的脏矩形
+        stamp = 2;
+        std::memcpy(source.GetRow(0), &stamp, sizeof(stamp));
+        const SurfaceRect dirty_rect{0, 0, 8, 2};
+        TEST_REQUIRE(writer.Publish(source.GetData(), source.GetRowPitch(), {dirty_rect}) == 2);
+        const auto second_view = reader.TryAcquireLatest(1);
+        TEST_REQUIRE(second_view);
+        TEST_REQUIRE(second_view->m_sequence == 2);
+        TEST_REQUIRE(ReadStampedSequence(*second_view) == 2);
+        TEST_REQUIRE(second_view->GetRow(HEIGHT - 1)[(WIDTH - 1) * 4 + 2] == 0x5A);
+        TEST_REQUIRE(second_view->m_dirty_rect_count == 1);
+        TEST_REQUIRE(second_view->m_p_dirty_rects[0].m_x == dirty_rect.m_x);
+        TEST_REQUIRE(second_view->m_p_dirty_rects[0].m_y == dirty_rect.m_y);
+        TEST_REQUIRE(second_view->m_p_dirty_rects[0].m_width == dirty_rect.m_width);
+        TEST_REQUIRE(second_view->m_p_dirty_rects[0].m_height == dirty_rect.m_height);
+        TEST_REQUIRE(reader.Validate(*second_view));
+        TEST_REQUIRE(writer.GetStatistics().m_frame_count == 2);
+    }
+
+    void TestConcurrentReaderSeesConsistentFrames()
+    {
+        // 写入者不限速地发布帧并在第一行写入序号，读者通过Validate的帧必须与其序号一致
+        constexpr std::uint32_t WIDTH = 350;
+        constexpr std::uint32_t HEIGHT = 100;
+        constexpr std::uint64_t FRAME_COUNT = 20'000;
+        const auto name = MakeUniqueName("Concurrent");
+        CSharedFrameWriter writer{name, WIDTH, HEIGHT};
+        const std::vector<SurfaceRect> dirty_rects{{0, 0, 64, 16}};
+
+        std::atomic<bool> is_writing{true};
+        std::uint64_t mismatch_count = 0;
+        std::uint64_t regression_count = 0;
+        std::thread reader_thread{[&]()
+                                  {
+                                      const CSharedFrameReader reader{name};
+                                      std::uint64_t last_sequence = 0;
+                                      while (is_writing.load(std::memory_order_acquire))
+                                      {
+                                          const auto view = reader.TryAcquireLatest(last_sequence);
+                                          if (!view)
+                                          {
+                                              std::this_thread::yield();
+                                              continue;
+                                          }
+                                          const auto stamped_sequence = ReadStampedSequence(*view);
+                                          if (!reader.Validate(*view))
+                                          {
+                                              continue;
+                                          }
+                                          mismatch_count += stamped_sequence == view->m_sequence ? 0 : 1;
+                                          regression_count += view->m_sequence > last_sequence ? 0 : 1;
+                                          last_sequence = view->m_sequence;
+                                      }
+                                  }};
+
+        CBgraImage source{WIDTH, HEIGHT};
+        for (std::uint64_t sequence = 1; sequence <= FRAME_COUNT; ++sequence)
+        {
+            std::memcpy(source.GetRow(0), &sequence, sizeof(sequence));
+            TEST_REQUIRE(writer.Publish(source.GetData(), source.GetRowPitch(), dirty_rects) == sequence);
+        }
+        is_writing.store(false, std::memory_order_release);
+        reader_thread.join();
+        TEST_REQUIRE(mismatch_count == 0);
+        TEST_REQUIRE(regression_count == 0);
+    }
+}
+
+int main()
+{
+    TestPublishAndAcquire();
+    TestConcurrentReaderSeesConsistentFrames();
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include "CRenderThread.h"
+#include "CSpscQueue.h"
+#include "TestCheck.h"
+
+namespace
+{
+    void TestCapacityMustBePowerOfTwo()
+    {
+        TEST_REQUIRE(TestCheck::Throws<std::invalid_argument>([]()
+                                                              { CSpscQueue<int> queue{0}; }));
+        TEST_REQUIRE(TestCheck::Throws<std::invalid_argument>([]()
+                                                              { CSpscQueue<int> queue{3}; }));
+        CSpscQueue<int> queue{8};
+        TEST_REQUIRE(queue.GetCapacity() == 8);
+    }
+
+    void TestFullAndEmpty()
+    {
+        CSpscQueue<int> queue{4};
+        int value = -1;
+        TEST_REQUIRE(!queue.TryPop(value));
+        TEST_REQUIRE(value == -1);
+        for (int i = 0; i < 4; ++i)
+        {
+            TEST_REQUIRE(queue.TryPush(i));
+        }
+        TEST_REQUIRE(!queue.TryPush(4));
+        TEST_REQUIRE(queue.GetDepth() == 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            TEST_REQUIRE(queue.TryPop(value));
+            TEST_REQUIRE(value == i);
+        }
+        TEST_REQUIRE(!queue.TryPop(value));
+
+        const auto statistics = queue.GetStatistics();
+        TEST_REQUIRE(statistics.m_push_count == 4);
+        TEST_REQUIRE(statistics.m_pop_count == 4);
+        TEST_REQUIRE(statistics.m_full_count == 1);
+        TEST_REQUIRE(statistics.m_max_depth == 4);
+    }
+
+    void TestConcurrentOrder()
+    {
+        // 生产者写入递增序号，消费者检查顺序；也适合在ThreadSanitizer下运行
+        constexpr std::uint64_t ITEM_COUNT = 200'000;
+        CSpscQueue<std::uint64_t> queue{16};
+        std::uint64_t out_of_order_count = 0;
+        std::thread consumer{
+            [&queue, &out_of_order_count]()
+            {
+                std::uint64_t expected = 0;
+                std::uint64_t value = 0;
+                while (expected < ITEM_COUNT)
+                {
+                    if (!queue.TryPop(value))
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    out_of_order_count += value == expected ? 0 : 1;
+                    expected = value + 1;
+                }
+            }};
+        for (std::uint64_t i = 0; i < ITEM_COUNT; ++i)
+        {
+            while (!queue.TryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+        consumer.join();
+        TEST_REQUIRE(out_of_order_count == 0);
+        TEST_REQUIRE(queue.GetStatistics().m_pop_count == ITEM_COUNT);
+    }
+
+    void TestRenderThreadHandlesEveryCommand()
+    {
+        // 渲染线程忙于构建帧时连续发送命令，队列满时Post等待而不丢弃
+        constexpr std::uint32_t COMMAND_COUNT = 2'000;
+        float last_value = 0.0f;
+        std::uint32_t handled_count = 0;
+        CRenderThread render_thread{
+            [&last_value, &handled_count](const RenderCommand& command)
+            {
+                last_value = command.m_value;
+                ++handled_count;
+            },
+            []()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds{200});
+                return true;
+            },
+            16};
+        for (std::uint32_t i = 1; i <= COMMAND_COUNT; ++i)
+        {
+            render_thread.Post({RenderCommandType::SetAlphaIncrement, static_cast<float>(i)});
+        }
+        while (render_thread.GetStatistics().m_queue_depth != 0)
+        {
+            std::this_thread::yield();
+        }
+        render_thread.Stop();
+        TEST_REQUIRE(handled_count == COMMAND_COUNT);
+        TEST_REQUIRE(last_value == static_cast<float>(COMMAND_COUNT));
+    }
+}
+
+int main()
+{
+    TestCapacityMustBePowerOfTwo();
+    TestFullAndEmpty();
+    TestConcurrentOrder();
+    TestRenderThreadHandlesEveryCommand();
+    return 0;
+}
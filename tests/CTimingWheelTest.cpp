@@ -0,0 +1,125 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CTimingWheel.h"
+#include "TestCheck.h"
+
+namespace
+{
+    class CTimingWheelFixture
+    {
+    public:
+        TimingWheelConfig m_config{};
+        CTimingWheel::Clock::time_point m_start_time{CTimingWheel::Clock::now()};
+        CTimingWheel m_wheel{m_start_time, m_config};
+
+        auto GetTimeAtTick(std::uint64_t tick) const
+            -> CTimingWheel::Clock::time_point
+        {
+            return m_start_time + tick * m_config.m_tick_duration;
+        }
+        auto GetTicks(std::uint64_t tick_count) const
+            -> CTimingWheel::Clock::duration
+        {
+            return tick_count * m_config.m_tick_duration;
+        }
+    };
+
+    void TestOneShotTimer()
+    {
+        CTimingWheelFixture fixture{};
+        auto& wheel = fixture.m_wheel;
+        TEST_REQUIRE(!wheel.GetNextDeadline());
+
+        const auto handle = wheel.Schedule(fixture.GetTicks(5), {}, 42);
+        TEST_REQUIRE(wheel.IsActive(handle));
+        TEST_REQUIRE(wheel.GetNextDeadline() == fixture.GetTimeAtTick(5));
+        TEST_REQUIRE(wheel.Advance(fixture.GetTimeAtTick(4)).empty());
+
+        const auto& expired_timers = wheel.Advance(fixture.GetTimeAtTick(5));
+        TEST_REQUIRE(expired_timers.size() == 1);
+        TEST_REQUIRE(expired_timers.front().m_handle == handle);
+        TEST_REQUIRE(expired_timers.front().m_user_data == 42);
+        TEST_REQUIRE(!wheel.IsActive(handle));
+        TEST_REQUIRE(!wheel.Cancel(handle));
+        TEST_REQUIRE(wheel.GetActiveCount() == 0);
+        TEST_REQUIRE(!wheel.GetNextDeadline());
+    }
+
+    void TestCancel()
+    {
+        CTimingWheelFixture fixture{};
+        auto& wheel = fixture.m_wheel;
+        const auto cancelled = wheel.Schedule(fixture.GetTicks(3), fixture.GetTicks(3), 1);
+        const auto kept = wheel.Schedule(fixture.GetTicks(3), fixture.GetTicks(3), 2);
+        TEST_REQUIRE(wheel.Cancel(cancelled));
+        TEST_REQUIRE(!wheel.Cancel(cancelled));
+        TEST_REQUIRE(!wheel.IsActive(cancelled));
+        TEST_REQUIRE(wheel.IsActive(kept));
+
+        const auto& expired_timers = wheel.Advance(fixture.GetTimeAtTick(3));
+        TEST_REQUIRE(expired_timers.size() == 1);
+        TEST_REQUIRE(expired_timers.front().m_user_data == 2);
+        TEST_REQUIRE(wheel.GetStatistics().m_cancelled_count == 1);
+    }
+
+    void TestCoalescedExpiries()
+    {
+        // 两个周期不同的控件在公倍数处同时到期，一次Advance返回两者
+        CTimingWheelFixture fixture{};
+        auto& wheel = fixture.m_wheel;
+        wheel.Schedule(fixture.GetTicks(2), fixture.GetTicks(2), 0);
+        wheel.Schedule(fixture.GetTicks(3), fixture.GetTicks(3), 1);
+        for (std::uint64_t tick = 1; tick <= 5; ++tick)
+        {
+            TEST_REQUIRE(wheel.Advance(fixture.GetTimeAtTick(tick)).size() == (tick % 2 == 0 || tick % 3 == 0 ? 1u : 0u));
+        }
+        TEST_REQUIRE(wheel.Advance(fixture.GetTimeAtTick(6)).size() == 2);
+        const auto& statistics = wheel.GetStatistics();
+        TEST_REQUIRE(statistics.m_fired_count == 5);
+        TEST_REQUIRE(statistics.m_expiring_tick_count == 4);
+    }
+
+    void TestExactFireTicksAcrossLevels()
+    {
+        // 周期取对数均匀分布，覆盖时间轮的每一层；逐槽推进时每次到期都应恰好落在周期的整数倍上
+        constexpr std::uint32_t TIMER_COUNT = 2'000;
+        constexpr std::uint64_t TICK_COUNT = 20'000;
+        CTimingWheelFixture fixture{};
+        auto& wheel = fixture.m_wheel;
+        std::mt19937 random_engine{42};
+        std::uniform_real_distribution<double> exponent_distribution{0.0, 1.0};
+        std::vector<std::uint64_t> period_ticks(TIMER_COUNT);
+        for (std::uint32_t i = 0; i < TIMER_COUNT; ++i)
+        {
+            period_ticks[i] = static_cast<std::uint64_t>(15.0 * std::pow(14'400.0, exponent_distribution(random_engine)));
+            wheel.Schedule(fixture.GetTicks(period_ticks[i]), fixture.GetTicks(period_ticks[i]), i);
+        }
+        std::vector<std::uint64_t> fire_counts(TIMER_COUNT);
+        for (std::uint64_t tick = 1; tick <= TICK_COUNT; ++tick)
+        {
+            for (const auto& expired_timer : wheel.Advance(fixture.GetTimeAtTick(tick)))
+            {
+                const auto index = expired_timer.m_user_data;
+                TEST_REQUIRE(tick % period_ticks[index] == 0);
+                ++fire_counts[index];
+            }
+        }
+        for (std::uint32_t i = 0; i < TIMER_COUNT; ++i)
+        {
+            TEST_REQUIRE(fire_counts[i] == TICK_COUNT / period_ticks[i]);
+        }
+        TEST_REQUIRE(wheel.GetActiveCount() == TIMER_COUNT);
+        TEST_REQUIRE(wheel.GetStatistics().m_cascaded_count != 0);
+    }
+}
+
+int main()
+{
+    TestOneShotTimer();
+    TestCancel();
+    TestCoalescedExpiries();
+    TestExactFireTicksAcrossLevels();
+    return 0;
+}
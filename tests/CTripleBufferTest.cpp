@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "CTripleBuffer.h"
+#include "TestCheck.h"
+
+namespace
+{
+    // 64字节的控件快照，所有字段相同，消费者据此检查是否读到了写了一半的快照
+    struct WidgetSnapshot
+    {
+        std::uint64_t m_sequence{};
+        std::array<std::uint64_t, 7> m_values{};
+    };
+
+    auto MakeSnapshot(std::uint64_t sequence)
+        -> WidgetSnapshot
+    {
+        WidgetSnapshot snapshot{};
+        snapshot.m_sequence = sequence;
+        snapshot.m_values.fill(sequence);
+        return snapshot;
+    }
+
+    void TestLatestWins()
+    {
+        CTripleBuffer<WidgetSnapshot> buffer{MakeSnapshot(7)};
+        TEST_REQUIRE(!buffer.Update());
+        TEST_REQUIRE(buffer.Get().m_sequence == 7);
+
+        TEST_REQUIRE(buffer.Publish(MakeSnapshot(1)));
+        TEST_REQUIRE(buffer.Publish(MakeSnapshot(2)));
+        TEST_REQUIRE(buffer.Update());
+        TEST_REQUIRE(buffer.Get().m_sequence == 2);
+        TEST_REQUIRE(!buffer.Update());
+        TEST_REQUIRE(buffer.Get().m_sequence == 2);
+
+        const auto statistics = buffer.GetStatistics();
+        TEST_REQUIRE(statistics.m_publish_count == 2);
+        TEST_REQUIRE(statistics.m_consume_count == 1);
+        TEST_REQUIRE(statistics.m_overwritten_count == 1);
+    }
+
+    void TestUnchangedPublishIsSkipped()
+    {
+        CTripleBuffer<WidgetSnapshot> buffer{};
+        TEST_REQUIRE(buffer.Publish(MakeSnapshot(3)));
+        TEST_REQUIRE(buffer.Update());
+        TEST_REQUIRE(!buffer.Publish(MakeSnapshot(3)));
+        TEST_REQUIRE(!buffer.Update());
+
+        const auto statistics = buffer.GetStatistics();
+        TEST_REQUIRE(statistics.m_publish_count == 1);
+        TEST_REQUIRE(statistics.m_unchanged_publish_count == 1);
+    }
+
+    void TestConcurrentSnapshotsAreWholeAndMonotonic()
+    {
+        constexpr std::uint64_t PUBLISH_COUNT = 200'000;
+        CTripleBuffer<WidgetSnapshot> buffer{};
+        std::atomic<bool> is_producer_done{false};
+        std::uint64_t torn_count = 0;
+        std::uint64_t regression_count = 0;
+        std::uint64_t last_sequence = 0;
+        std::thread consumer{
+            [&]()
+            {
+                auto consume = [&]()
+                {
+                    if (!buffer.Update())
+                    {
+                        return;
+                    }
+                    const auto& snapshot = buffer.Get();
+                    if (std::any_of(snapshot.m_values.begin(), snapshot.m_values.end(), [&snapshot](std::uint64_t value)
+                                    { return value != snapshot.m_sequence; }))
+                    {
+                        ++torn_count;
+                    }
+                    regression_count += snapshot.m_sequence <= last_sequence ? 1 : 0;
+                    last_sequence = snapshot.m_sequence;
+                };
+                while (!is_producer_done.load(std::memory_order_acquire))
+                {
+                    consume();
+                }
+                consume();
+            }};
+        for (std::uint64_t i = 1; i <= PUBLISH_COUNT; ++i)
+        {
+            buffer.Publish(MakeSnapshot(i));
+        }
+        is_producer_done.store(true, std::memory_order_release);
+        consumer.join();
+        TEST_REQUIRE(torn_count == 0);
+        TEST_REQUIRE(regression_count == 0);
+        TEST_REQUIRE(last_sequence == PUBLISH_COUNT);
+    }
+}
+
+int main()
+{
+    TestLatestWins();
+    TestUnchangedPublishIsSkipped();
+    TestConcurrentSnapshotsAreWholeAndMonotonic();
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include "CBgraImage.h"
+#include "CCoverageImage.h"
+#include "CSoftwareRenderer.h"
+#include "CoverageConversion.h"
+#include "TestCheck.h"
+
+namespace
+{
+    /**
+     * @brief 模拟GDI在黑色背景上绘制白色文字：b=g=r=覆盖率，alpha为0
+     */
+    auto MakeGdiOutput(std::uint32_t width, std::uint32_t height)
+        -> CBgraImage
+    {
+        CBgraImage gdi_output{width, height};
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<std::uint32_t> coverage_distribution{0, 255};
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                auto* p_pixel = gdi_output.GetPixel(x, y);
+                p_pixel[0] = p_pixel[1] = p_pixel[2] = static_cast<std::uint8_t>(coverage_distribution(random_engine));
+            }
+        }
+        return gdi_output;
+    }
+
+    void TestSimdMatchesScalar()
+    {
+        // 宽度覆盖SIMD实现的尾部处理
+        constexpr std::array<std::array<std::uint32_t, 2>, 4> SURFACE_SIZES{{{1, 1}, {17, 3}, {350, 100}, {1023, 7}}};
+        for (const auto& [width, height] : SURFACE_SIZES)
+        {
+            const auto gdi_output = MakeGdiOutput(width, height);
+            CCoverageImage scalar_coverage{width, height};
+            CCoverageImage coverage{width, height};
+            CoverageConversion::ConvertBgraToCoverageScalar(gdi_output.GetData(), gdi_output.GetRowPitch(), scalar_coverage.GetData(), scalar_coverage.GetRowPitch(), width, height);
+            CoverageConversion::ConvertBgraToCoverage(gdi_output.GetData(), gdi_output.GetRowPitch(), coverage.GetData(), coverage.GetRowPitch(), width, height);
+            for (std::uint32_t y = 0; y < height; ++y)
+            {
+                TEST_REQUIRE(std::equal(coverage.GetRow(y), coverage.GetRow(y) + width, scalar_coverage.GetRow(y)));
+            }
+        }
+    }
+
+    void TestCoveragePassMatchesBgraPass()
+    {
+        // 覆盖率纹理经过alpha修正后与直接使用GDI输出的结果完全相同
+        constexpr std::uint32_t WIDTH = 350;
+        constexpr std::uint32_t HEIGHT = 100;
+        const auto gdi_output = MakeGdiOutput(WIDTH, HEIGHT);
+        CCoverageImage coverage{WIDTH, HEIGHT};
+        CoverageConversion::ConvertBgraToCoverage(gdi_output.GetData(), gdi_output.GetRowPitch(), coverage.GetData(), coverage.GetRowPitch(), WIDTH, HEIGHT);
+
+        const CSoftwareRenderer renderer{};
+        CBgraImage bgra_target{WIDTH, HEIGHT};
+        CBgraImage coverage_target{WIDTH, HEIGHT};
+        bgra_target.Fill(0, 0, 0, 0);
+        coverage_target.Fill(0, 0, 0, 0);
+        renderer.RenderAlphaIncreasePass(gdi_output, bgra_target);
+        renderer.RenderCoverageAlphaIncreasePass(coverage, coverage_target);
+        TEST_REQUIRE(std::equal(bgra_target.GetData(), bgra_target.GetData() + bgra_target.GetSizeInBytes(), coverage_target.GetData()));
+    }
+}
+
+int main()
+{
+    TestSimdMatchesScalar();
+    TestCoveragePassMatchesBgraPass();
+    return 0;
+}
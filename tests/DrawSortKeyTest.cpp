@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CDrawQueue.h"
+#include "DrawSortKey.h"
+#include "TestCheck.h"
+
+namespace
+{
+    bool IsEqual(const DrawSortKey::Fields& lhs, const DrawSortKey::Fields& rhs)
+    {
+        return lhs.m_layer == rhs.m_layer &&
+               lhs.m_is_translucent == rhs.m_is_translucent &&
+               lhs.m_shader == rhs.m_shader &&
+               lhs.m_texture == rhs.m_texture &&
+               lhs.m_state == rhs.m_state &&
+               lhs.m_sequence == rhs.m_sequence;
+    }
+
+    void TestPackRoundTrip()
+    {
+        using namespace DrawSortKey;
+        for (const bool is_translucent : {false, true})
+        {
+            const Fields zero{0, is_translucent, 0, 0, 0, 0};
+            const Fields maximum{MAX_LAYER, is_translucent, MAX_SHADER, MAX_TEXTURE, MAX_STATE, MAX_SEQUENCE};
+            const Fields mixed{3, is_translucent, 7, 9, 11, 13};
+            TEST_REQUIRE(IsEqual(Unpack(Pack(zero)), zero));
+            TEST_REQUIRE(IsEqual(Unpack(Pack(maximum)), maximum));
+            TEST_REQUIRE(IsEqual(Unpack(Pack(mixed)), mixed));
+        }
+    }
+
+    void TestKeyOrder()
+    {
+        using namespace DrawSortKey;
+        // 层优先；同一层内不透明在前，不透明按着色器、纹理、状态排序，半透明按序号排序
+        TEST_REQUIRE(Pack({1, false, 0, 0, 0, 0}) > Pack({0, true, MAX_SHADER, MAX_TEXTURE, MAX_STATE, MAX_SEQUENCE}));
+        TEST_REQUIRE(Pack({0, true, 0, 0, 0, 0}) > Pack({0, false, MAX_SHADER, MAX_TEXTURE, MAX_STATE, MAX_SEQUENCE}));
+        TEST_REQUIRE(Pack({0, false, 1, 0, 0, 0}) > Pack({0, false, 0, MAX_TEXTURE, MAX_STATE, MAX_SEQUENCE}));
+        TEST_REQUIRE(Pack({0, false, 0, 1, 0, 0}) > Pack({0, false, 0, 0, MAX_STATE, MAX_SEQUENCE}));
+        TEST_REQUIRE(Pack({0, true, 0, 0, 0, 1}) > Pack({0, true, MAX_SHADER, MAX_TEXTURE, MAX_STATE, 0}));
+    }
+
+    void TestDrawQueueOrder()
+    {
+        constexpr std::uint32_t DRAW_COUNT = 10'000;
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<std::uint32_t> shader_distribution{0, 15};
+        std::uniform_int_distribution<std::uint32_t> texture_distribution{0, 255};
+        std::uniform_int_distribution<std::uint32_t> state_distribution{0, 7};
+        std::uniform_int_distribution<std::uint32_t> layer_distribution{0, 3};
+        std::bernoulli_distribution translucent_distribution{0.2};
+
+        CDrawQueue queue{};
+        std::vector<std::uint32_t> layers(DRAW_COUNT);
+        std::vector<bool> translucent_flags(DRAW_COUNT);
+        for (std::uint32_t i = 0; i < DRAW_COUNT; ++i)
+        {
+            DrawCommand command{};
+            command.m_shader = shader_distribution(random_engine);
+            command.m_texture = texture_distribution(random_engine);
+            command.m_state = state_distribution(random_engine);
+            // 用起始索引记录提交顺序
+            command.m_start_index_location = i;
+            layers[i] = layer_distribution(random_engine);
+            translucent_flags[i] = translucent_distribution(random_engine);
+            queue.Submit(command, layers[i], translucent_flags[i]);
+        }
+        auto expected_items = queue.GetSortedItems();
+        std::stable_sort(expected_items.begin(), expected_items.end(), [](const DrawSortItem& lhs, const DrawSortItem& rhs)
+                         { return lhs.m_key < rhs.m_key; });
+        const auto unsorted_state_changes = queue.CountStateChanges(false);
+
+        std::vector<std::uint32_t> order{};
+        queue.ForEachSorted([&order](const DrawCommand& command)
+                            { order.push_back(command.m_start_index_location); });
+        TEST_REQUIRE(order.size() == DRAW_COUNT);
+        for (std::uint32_t i = 0; i < DRAW_COUNT; ++i)
+        {
+            TEST_REQUIRE(order[i] == expected_items[i].m_index);
+        }
+        // 同一层的半透明绘制保持提交顺序
+        for (std::uint32_t i = 1; i < DRAW_COUNT; ++i)
+        {
+            const auto previous = order[i - 1];
+            const auto current = order[i];
+            if (translucent_flags[previous] && translucent_flags[current] && layers[previous] == layers[current])
+            {
+                TEST_REQUIRE(previous < current);
+            }
+        }
+        TEST_REQUIRE(queue.CountStateChanges(true) < unsorted_state_changes);
+    }
+}
+
+int main()
+{
+    TestPackRoundTrip();
+    TestKeyOrder();
+    TestDrawQueueOrder();
+    return 0;
+}
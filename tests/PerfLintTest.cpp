@@ -0,0 +1,76 @@
+#include <array>
+#include <cstdio>
+#include <string>
+#include "PerfLint.h"
+#include "TestCheck.h"
+
+namespace
+{
+    struct LintCase
+    {
+        const char* m_p_name;
+        PerfLintSubject m_subject;
+        // 为空表示不应产生警告
+        const char* m_p_expected_rule_id;
+    };
+
+    // 每条规则一个违反的描述和一个修正后的描述，前三组来自窗口模式中原先的设置
+    const std::array<LintCase, 14> LINT_CASES{{
+        {"device debug layer in release", LintDeviceDescription{GpuDeviceCreationFlag::DEBUG_LAYER | GpuDeviceCreationFlag::BGRA_SUPPORT, false}, "device-debug-layer"},
+        {"index buffer DEFAULT", LintBufferDescription{12, GpuUsage::DEFAULT, GpuBindFlag::INDEX_BUFFER, 0, true}, "buffer-static-default-usage"},
+        {"linear sampler at 1:1", LintSamplerDescription{GpuFilter::MIN_MAG_MIP_LINEAR, 1, 1.0f}, "sampler-filtering-at-unit-scale"},
+        {"shader resource texture DEFAULT", LintTextureDescription{256, 256, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0, true}, "texture-static-default-usage"},
+        {"render target with data", LintTextureDescription{256, 256, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::DEFAULT, GpuBindFlag::RENDER_TARGET, 0, true}, "texture-render-target-initial-data"},
+        {"staging mip chain", LintTextureDescription{256, 256, 0, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::STAGING, 0, 0, false}, "texture-staging-mip-chain"},
+        {"pass-through blend", LintBlendDescription{true, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD}, "blend-pass-through"},
+        {"device debug layer in debug", LintDeviceDescription{GpuDeviceCreationFlag::DEBUG_LAYER | GpuDeviceCreationFlag::BGRA_SUPPORT, true}, nullptr},
+        {"index buffer IMMUTABLE", LintBufferDescription{12, GpuUsage::IMMUTABLE, GpuBindFlag::INDEX_BUFFER, 0, true}, nullptr},
+        {"point sampler at 1:1", LintSamplerDescription{GpuFilter::MIN_MAG_MIP_POINT, 1, 1.0f}, nullptr},
+        {"linear sampler scaled", LintSamplerDescription{GpuFilter::MIN_MAG_MIP_LINEAR, 1, 0.0f}, nullptr},
+        {"uploaded texture DEFAULT", LintTextureDescription{350, 100, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::DEFAULT, GpuBindFlag::SHADER_RESOURCE, 0, false}, nullptr},
+        {"staging single mip", LintTextureDescription{256, 256, 1, 1, GpuFormat::B8G8R8A8_UNORM, GpuUsage::STAGING, 0, 0, false}, nullptr},
+        {"alpha blend", LintBlendDescription{true, 5, 8, GpuBlend::OP_ADD, GpuBlend::ONE, GpuBlend::ZERO, GpuBlend::OP_ADD}, nullptr},
+    }};
+
+    void TestRules()
+    {
+        for (const auto& lint_case : LINT_CASES)
+        {
+            const auto violated_rules = PerfLint::Evaluate(lint_case.m_subject);
+            const bool is_passed = lint_case.m_p_expected_rule_id == nullptr
+                                       ? violated_rules.empty()
+                                       : violated_rules.size() == 1 && std::string{violated_rules.front()->m_p_id} == lint_case.m_p_expected_rule_id;
+            if (!is_passed)
+            {
+                std::fprintf(stderr, "perf-lint case \"%s\": %s\n", lint_case.m_p_name, violated_rules.empty() ? "no warning" : violated_rules.front()->m_p_id);
+            }
+            TEST_REQUIRE(is_passed);
+        }
+    }
+
+    void TestLinterReportsAndDisables()
+    {
+        std::size_t sink_count = 0;
+        CPerfLinter linter{[&sink_count](const PerfLintWarning&)
+                           { ++sink_count; }};
+        const auto& violating_case = LINT_CASES.front();
+        TEST_REQUIRE(linter.Check(violating_case.m_subject) == 1);
+        TEST_REQUIRE(linter.Check(LINT_CASES.back().m_subject) == 0);
+        TEST_REQUIRE(sink_count == 1);
+        TEST_REQUIRE(linter.GetWarnings().size() == 1);
+        TEST_REQUIRE(std::string{linter.GetWarnings().front().m_p_rule->m_p_id} == violating_case.m_p_expected_rule_id);
+        TEST_REQUIRE(!PerfLint::FormatWarning(linter.GetWarnings().front()).empty());
+
+        linter.DisableRule(violating_case.m_p_expected_rule_id);
+        TEST_REQUIRE(linter.Check(violating_case.m_subject) == 0);
+        TEST_REQUIRE(linter.GetStatistics().m_checked_count == 3);
+        TEST_REQUIRE(linter.GetStatistics().m_warning_count == 1);
+    }
+}
+
+int main()
+{
+    TestRules();
+    TestLinterReportsAndDisables();
+    return 0;
+}
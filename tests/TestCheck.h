@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief 条件不成立时打印所在位置并以1退出，CTest据此判定测试失败
+ */
+#define TEST_REQUIRE(condition)                                                                         \
+    do                                                                                                  \
+    {                                                                                                   \
+        if (!(condition))                                                                               \
+        {                                                                                               \
+            std::fprintf(stderr, "%s:%d: TEST_REQUIRE(%s) failed\n", __FILE__, __LINE__, #condition); \
+            std::exit(1);                                                                               \
+        }                                                                                               \
+    } while (false)
+
+namespace TestCheck
+{
+    /**
+     * @brief function是否抛出了Exception类型的异常
+     */
+    template <class Exception, class Function>
+    bool Throws(Function function)
+    {
+        try
+        {
+            function();
+        }
+        catch (const Exception&)
+        {
+            return true;
+        }
+        return false;
+    }
+}